@@ -2,6 +2,7 @@
 
 #include "3dmanager/lego3dmanager.h"
 #include "decomp.h"
+#include "isleheadless.h"
 #include "legoanimationmanager.h"
 #include "legobuildingmanager.h"
 #include "legogamestate.h"
@@ -19,6 +20,7 @@
 #include "mxmisc.h"
 #include "mxomnicreateflags.h"
 #include "mxomnicreateparam.h"
+#include "mxsoundmixer.h"
 #include "mxstreamer.h"
 #include "mxticklemanager.h"
 #include "mxtimer.h"
@@ -65,6 +67,11 @@ int g_targetDepth = 16;
 // GLOBAL: ISLE 0x410064
 BOOL g_reqEnableRMDevice = FALSE;
 
+// Set for the whole process if -headless was given
+IsleHeadless* g_isleHeadless = NULL;
+
+char* g_soundMixerFile = NULL;
+
 // STRING: ISLE 0x4101c4
 #define WNDCLASS_NAME "Lego Island MainNoM App"
 
@@ -239,9 +246,18 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		return 0;
 	}
 
-	// Attempt to create DirectSound instance
-	BOOL soundReady = FALSE;
-	for (int i = 0; i < 20; i++) {
+	if (IsleHeadless::IsRequested(lpCmdLine)) {
+		g_isleHeadless = new IsleHeadless();
+
+		if (g_isleHeadless->Create(lpCmdLine) != SUCCESS) {
+			delete g_isleHeadless;
+			return 1;
+		}
+	}
+
+	// Attempt to create DirectSound instance. A headless run mixes into a null sink and needs no sound card.
+	BOOL soundReady = g_isleHeadless != NULL;
+	for (int i = 0; !soundReady && i < 20; i++) {
 		if (StartDirectSound()) {
 			soundReady = TRUE;
 			break;
@@ -266,6 +282,10 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 
 	// Create window
 	if (g_isle->SetupWindow(hInstance, lpCmdLine) != SUCCESS) {
+		if (g_isleHeadless) {
+			return 1;
+		}
+
 		MessageBoxA(
 			NULL,
 			"\"LEGO\xAE Island\" failed to start.  Please quit all other applications and try again.",
@@ -291,6 +311,35 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 
 	MSG msg;
 
+	if (g_isleHeadless) {
+		while (!g_closed && !g_isleHeadless->IsDone()) {
+			while (PeekMessageA(&msg, NULL, 0, 0, PM_REMOVE)) {
+				TranslateMessage(&msg);
+				DispatchMessageA(&msg);
+			}
+
+			if (g_isle) {
+				g_isleHeadless->BeginFrame(g_isle);
+				g_isle->Tick(FALSE);
+				g_isleHeadless->EndFrame();
+			}
+		}
+
+		// Shutting down waits for tickle passes, which need a clock that moves by itself
+		MxTimer::SetFixedStep(0);
+
+		if (g_isle) {
+			delete g_isle;
+			g_isle = NULL;
+			g_closed = TRUE;
+		}
+
+		delete g_isleHeadless;
+		g_isleHeadless = NULL;
+		DestroyWindow(window);
+		return 0;
+	}
+
 	while (!g_closed) {
 		while (!PeekMessageA(&msg, NULL, 0, 0, PM_NOREMOVE)) {
 			if (g_isle) {
@@ -378,11 +427,18 @@ LRESULT WINAPI WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 	switch (uMsg) {
 	case WM_PAINT:
-		return DefWindowProcA(hWnd, uMsg, wParam, lParam);
+	case WM_MOVE:
 	case WM_ACTIVATE:
+		// Frames only present what changed, what is on screen now has to be replaced as a whole
+		if (LegoOmni::GetInstance() && VideoManager()) {
+			VideoManager()->RedrawAll();
+		}
 		return DefWindowProcA(hWnd, uMsg, wParam, lParam);
 	case WM_ACTIVATEAPP:
 		if (g_isle) {
+			if (wParam != 0 && LegoOmni::GetInstance() && VideoManager()) {
+				VideoManager()->RedrawAll();
+			}
 			if ((wParam != 0) && (g_isle->GetFullScreen())) {
 				MoveWindow(
 					hWnd,
@@ -516,7 +572,8 @@ LRESULT WINAPI WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 		return DefWindowProcA(hWnd, uMsg, wParam, lParam);
 	}
 
-	if (g_isle) {
+	// A headless run only takes input from its script
+	if (g_isle && !g_isleHeadless) {
 		if (InputManager()) {
 			InputManager()->QueueEvent(type, wParam, LOWORD(lParam), HIWORD(lParam), keyCode);
 		}
@@ -544,6 +601,15 @@ MxResult IsleApp::SetupWindow(HINSTANCE hInstance, LPSTR lpCmdLine)
 
 	LoadConfig();
 
+	if (g_isleHeadless) {
+		// Windowed and without page flipping or a joystick, so the run depends on neither the display nor devices
+		m_fullScreen = FALSE;
+		m_flipSurfaces = FALSE;
+		m_useJoystick = FALSE;
+		m_drawCursor = FALSE;
+		g_isleHeadless->Configure();
+	}
+
 	SetupVideoFlags(
 		m_fullScreen,
 		m_flipSurfaces,
@@ -558,7 +624,7 @@ MxResult IsleApp::SetupWindow(HINSTANCE hInstance, LPSTR lpCmdLine)
 
 	MxOmni::SetSound3D(m_use3dSound);
 
-	srand(timeGetTime() / 1000);
+	srand(g_isleHeadless ? 0 : timeGetTime() / 1000);
 	SystemParametersInfoA(SPI_SETMOUSETRAILS, 0, NULL, 0);
 
 	ZeroMemory(&wndclass, sizeof(WNDCLASSA));
@@ -800,6 +866,24 @@ void IsleApp::LoadConfig()
 		m_savePath = new char[strlen(buffer) + 1];
 		strcpy(m_savePath, buffer);
 	}
+
+	// The software mixer is opt-in: 0 keeps a DirectSound buffer per sound, otherwise one of MxSoundMixer::Output
+	int soundMixer;
+	if (ReadRegInt("Sound Mixer", &soundMixer)) {
+		if (soundMixer == MxSoundMixer::e_waveFile) {
+			if (ReadReg("Sound Mixer File", buffer, sizeof(buffer))) {
+				g_soundMixerFile = new char[strlen(buffer) + 1];
+				strcpy(g_soundMixerFile, buffer);
+			}
+			else {
+				soundMixer = MxSoundMixer::e_none;
+			}
+		}
+
+		if (soundMixer >= MxSoundMixer::e_none && soundMixer <= MxSoundMixer::e_waveFile) {
+			MxSoundMixer::SetOutput(soundMixer, g_soundMixerFile);
+		}
+	}
 }
 
 // FUNCTION: ISLE 0x402c20
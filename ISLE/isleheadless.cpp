@@ -0,0 +1,292 @@
+#include "isleheadless.h"
+
+#include "decomp.h"
+#include "isleapp.h"
+#include "legoanimationmanager.h"
+#include "legoinputmanager.h"
+#include "legosoundmanager.h"
+#include "legovideomanager.h"
+#include "misc.h"
+#include "misc/legocontainer.h"
+#include "mxeventmanager.h"
+#include "mxmisc.h"
+#include "mxmusicmanager.h"
+#include "mxomni.h"
+#include "mxstreamcontroller.h"
+#include "mxstreamer.h"
+#include "mxticklemanager.h"
+#include "mxtimer.h"
+#include "viewmanager/viewmanager.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define HEADLESS_ARGUMENT "-headless"
+
+IsleHeadless::IsleHeadless()
+{
+	m_numFrames = 1000;
+	m_frame = 0;
+	m_step = 16;
+	m_events = NULL;
+	m_numEvents = 0;
+	m_nextEvent = 0;
+	m_timings = NULL;
+	m_viewUpdateTime = 0.0;
+	m_frameStart = 0.0;
+}
+
+IsleHeadless::~IsleHeadless()
+{
+	delete[] m_events;
+
+	if (m_timings) {
+		fclose(m_timings);
+	}
+}
+
+BOOL IsleHeadless::IsRequested(LPSTR lpCmdLine)
+{
+	const char* match = lpCmdLine;
+	MxU32 length = strlen(HEADLESS_ARGUMENT);
+
+	while ((match = strstr(match, HEADLESS_ARGUMENT)) != NULL) {
+		if ((match == lpCmdLine || match[-1] == ' ') && (match[length] == '\0' || match[length] == ' ')) {
+			return TRUE;
+		}
+
+		match += length;
+	}
+
+	return FALSE;
+}
+
+MxResult IsleHeadless::Create(LPSTR lpCmdLine)
+{
+	char* arguments = new char[strlen(lpCmdLine) + 1];
+	const char* input = NULL;
+	const char* timings = NULL;
+	MxResult result = SUCCESS;
+
+	strcpy(arguments, lpCmdLine);
+
+	for (char* option = strtok(arguments, " "); option != NULL; option = strtok(NULL, " ")) {
+		if (!strcmp(option, HEADLESS_ARGUMENT)) {
+			continue;
+		}
+
+		char* value = strtok(NULL, " ");
+
+		if (value == NULL) {
+			result = FAILURE;
+		}
+		else if (!strcmp(option, "-frames")) {
+			m_numFrames = atoi(value);
+		}
+		else if (!strcmp(option, "-step")) {
+			m_step = atoi(value);
+		}
+		else if (!strcmp(option, "-input")) {
+			input = value;
+		}
+		else if (!strcmp(option, "-timings")) {
+			timings = value;
+		}
+		else {
+			result = FAILURE;
+		}
+
+		if (result != SUCCESS) {
+			break;
+		}
+	}
+
+	if (m_step <= 0) {
+		result = FAILURE;
+	}
+
+	if (result == SUCCESS && input != NULL) {
+		result = ReadInput(input);
+	}
+
+	if (result == SUCCESS && timings != NULL) {
+		if ((m_timings = fopen(timings, "w")) == NULL) {
+			result = FAILURE;
+		}
+		else {
+			fprintf(
+				m_timings,
+				"frame,time,tickle,streaming,presenters,view_update,animation,texture_hits,texture_misses,texture_bytes\n"
+			);
+		}
+	}
+
+	delete[] arguments;
+	return result;
+}
+
+MxResult IsleHeadless::ReadInput(const char* p_filename)
+{
+	static const struct {
+		const char* m_name;
+		NotificationId m_type;
+	} g_eventTypes[] = {
+		{"keydown", c_notificationKeyPress},
+		{"buttondown", c_notificationButtonDown},
+		{"buttonup", c_notificationButtonUp},
+		{"mousemove", c_notificationMouseMove},
+		{"timer", c_notificationTimer}
+	};
+
+	char line[256];
+	FILE* file = fopen(p_filename, "r");
+
+	if (file == NULL) {
+		return FAILURE;
+	}
+
+	MxU32 numLines = 0;
+	while (fgets(line, sizeof(line), file) != NULL) {
+		numLines++;
+	}
+
+	m_events = new Event[numLines];
+	rewind(file);
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		char name[32];
+		MxU32 frame, modifier, key;
+		MxS32 x, y;
+
+		if (sscanf(line, " %31s", name) != 1 || name[0] == '#') {
+			continue;
+		}
+
+		if (sscanf(line, "%u %31s %u %d %d %u", &frame, name, &modifier, &x, &y, &key) != 6) {
+			break;
+		}
+
+		if (m_numEvents != 0 && frame < m_events[m_numEvents - 1].m_frame) {
+			break;
+		}
+
+		MxU32 i;
+		for (i = 0; i < sizeOfArray(g_eventTypes); i++) {
+			if (!strcmp(name, g_eventTypes[i].m_name)) {
+				break;
+			}
+		}
+
+		if (i == sizeOfArray(g_eventTypes)) {
+			break;
+		}
+
+		Event& event = m_events[m_numEvents++];
+		event.m_frame = frame;
+		event.m_type = g_eventTypes[i].m_type;
+		event.m_modifier = modifier;
+		event.m_x = x;
+		event.m_y = y;
+		event.m_key = key;
+	}
+
+	// Anything left unread is a malformed line
+	MxResult result = feof(file) ? SUCCESS : FAILURE;
+	fclose(file);
+	return result;
+}
+
+void IsleHeadless::Configure()
+{
+	MxTimer::SetFixedStep(m_step);
+	MxOmni::SetHeadless(TRUE);
+}
+
+void IsleHeadless::BeginFrame(IsleApp* p_app)
+{
+	QueueEvents();
+	MxTimer::Step();
+
+	// Focus changes of the window must not pause the run
+	p_app->SetWindowActive(TRUE);
+
+	if (TickleManager()) {
+		TickleManager()->SetProfiling(TRUE);
+		TickleManager()->ResetTickleCosts();
+	}
+
+	m_viewUpdateTime = ViewManager::GetTotalUpdateSeconds();
+	m_frameStart = MxTimer::GetProfileTime();
+}
+
+void IsleHeadless::EndFrame()
+{
+	WriteTimings(MxTimer::GetProfileTime() - m_frameStart);
+	m_frame++;
+}
+
+void IsleHeadless::QueueEvents()
+{
+	for (; m_nextEvent < m_numEvents && m_events[m_nextEvent].m_frame <= m_frame; m_nextEvent++) {
+		const Event& event = m_events[m_nextEvent];
+
+		if (InputManager()) {
+			InputManager()
+				->QueueEvent((NotificationId) event.m_type, event.m_modifier, event.m_x, event.m_y, event.m_key);
+		}
+	}
+}
+
+void IsleHeadless::WriteTimings(MxDouble p_tickle)
+{
+	if (m_timings == NULL || !Lego()) {
+		return;
+	}
+
+	MxDouble streaming = 0.0;
+
+	if (Streamer()) {
+		const list<MxStreamController*>& controllers = Streamer()->GetControllers();
+
+		for (list<MxStreamController*>::const_iterator it = controllers.begin(); it != controllers.end(); it++) {
+			streaming += GetClientCost(*it);
+		}
+	}
+
+	MxDouble viewUpdate = (ViewManager::GetTotalUpdateSeconds() - m_viewUpdateTime) * 1000.0;
+	MxDouble presenters = GetClientCost(VideoManager()) + GetClientCost(SoundManager()) +
+		GetClientCost(EventManager()) + GetClientCost(MusicManager()) - viewUpdate;
+
+	if (presenters < 0.0) {
+		presenters = 0.0;
+	}
+
+	LegoTextureContainer* textures = TextureContainer();
+
+	fprintf(
+		m_timings,
+		"%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%u,%u,%u\n",
+		m_frame,
+		(m_frame + 1) * (MxU32) m_step,
+		p_tickle,
+		streaming,
+		presenters,
+		viewUpdate,
+		GetClientCost(AnimationManager()),
+		textures ? textures->GetCacheHits() : 0,
+		textures ? textures->GetCacheMisses() : 0,
+		textures ? textures->GetResidentBytes() : 0
+	);
+}
+
+MxDouble IsleHeadless::GetClientCost(MxCore* p_client)
+{
+	MxU32 count;
+	MxDouble total, peak;
+
+	if (p_client == NULL || TickleManager()->GetClientTickleCost(p_client, count, total, peak) != SUCCESS) {
+		return 0.0;
+	}
+
+	return total;
+}
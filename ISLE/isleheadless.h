@@ -0,0 +1,101 @@
+#ifndef ISLEHEADLESS_H
+#define ISLEHEADLESS_H
+
+#include "mxtypes.h"
+
+#include <stdio.h>
+#include <windows.h>
+
+class IsleApp;
+class MxCore;
+
+/**
+ * @brief [AI] Headless benchmark run of IsleApp, selected with -headless on the command line.
+ * @details [AI] Every frame advances MxTimer by a fixed step, hands the events the input script has for that
+ * frame to LegoInputManager::QueueEvent and does exactly one tickle pass, so the game logic sees the same times
+ * and input in every run. Runs are not fully deterministic: the streaming and disk threads still deliver data
+ * asynchronously, so when a presenter starts can differ between runs. Input from the window itself is ignored.
+ * The engine runs with MxOmni::SetHeadless: nothing is rasterized or presented and sound is mixed into a null sink.
+ *
+ * Options: -frames N (default 1000), -step MS (default 16, must exceed IsleApp's frame delta of 10 ms for every
+ * frame to tickle), -input FILE and -timings FILE.
+ *
+ * The input script has one event per line: "frame event modifier x y key", where event is one of keydown,
+ * buttondown, buttonup, mousemove and timer, and the remaining fields are passed to QueueEvent unchanged.
+ * Lines must be in frame order; empty lines and lines starting with '#' are skipped.
+ *
+ * The timings file gets one CSV row per frame, all times in ms of real time: the whole tickle pass, the stream
+ * controllers, the media managers' presenters (excluding ViewManager::Update, which runs inside the video
+ * manager's Tickle), ViewManager::Update and LegoAnimationManager. Client times come from the tickle manager's
+ * per-client profiling. The last three columns are LegoTextureContainer's running cache hits and misses and the bytes
+ * held by its shared texture entries.
+ */
+class IsleHeadless {
+public:
+	IsleHeadless();
+	~IsleHeadless();
+
+	/**
+	 * @brief [AI] Returns TRUE if -headless is among the command line arguments. [AI]
+	 */
+	static BOOL IsRequested(LPSTR lpCmdLine);
+
+	/**
+	 * @brief [AI] Parses the options, reads the input script and opens the timings file.
+	 * @return [AI] FAILURE on an unknown option or a file that cannot be read or written.
+	 */
+	MxResult Create(LPSTR lpCmdLine);
+
+	/**
+	 * @brief [AI] Selects the fixed timer step and the headless engine mode. Must be called before the engine
+	 * is created. [AI]
+	 */
+	void Configure();
+
+	/**
+	 * @brief [AI] Starts a frame: queues the scripted events, steps the timer and resets the tickle costs.
+	 * The caller then runs IsleApp::Tick and calls EndFrame. [AI]
+	 */
+	void BeginFrame(IsleApp* p_app);
+
+	/**
+	 * @brief [AI] Ends a frame and writes its timings. [AI]
+	 */
+	void EndFrame();
+
+	/**
+	 * @brief [AI] Returns TRUE once all frames have run. [AI]
+	 */
+	BOOL IsDone() { return m_frame >= m_numFrames; }
+
+private:
+	MxResult ReadInput(const char* p_filename);
+	void QueueEvents();
+	void WriteTimings(MxDouble p_tickle);
+
+	static MxDouble GetClientCost(MxCore* p_client);
+
+	/**
+	 * @brief [AI] One line of the input script. [AI]
+	 */
+	struct Event {
+		MxU32 m_frame;
+		MxU32 m_type;
+		MxU8 m_modifier;
+		MxLong m_x;
+		MxLong m_y;
+		MxU8 m_key;
+	};
+
+	MxU32 m_numFrames;         ///< [AI] Number of frames to run.
+	MxU32 m_frame;             ///< [AI] Index of the next frame.
+	MxLong m_step;             ///< [AI] Timer step per frame in ms.
+	Event* m_events;           ///< [AI] Input script, in frame order.
+	MxU32 m_numEvents;         ///< [AI] Number of entries in m_events.
+	MxU32 m_nextEvent;         ///< [AI] First event not yet queued.
+	FILE* m_timings;           ///< [AI] CSV output, or NULL.
+	MxDouble m_viewUpdateTime; ///< [AI] ViewManager::GetTotalUpdateSeconds at the start of the frame.
+	MxDouble m_frameStart;     ///< [AI] MxTimer::GetProfileTime at the start of the frame.
+};
+
+#endif // ISLEHEADLESS_H
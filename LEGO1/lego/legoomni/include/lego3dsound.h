@@ -8,6 +8,7 @@
 
 class LegoActor;
 class LegoROI;
+class ViewROI;
 
 /// @brief [AI] Implements 3D positional sound logic for LEGO Island using DirectSound 3D buffers. 
 /// Responsible for associating 3D sound buffer positions with game object positions (mainly LegoROI / LegoActor), 
@@ -59,6 +60,9 @@ class Lego3DSound {
 	// Lego3DSound::`scalar deleting destructor'
 
 private:
+	/// @brief [AI] Sets volume and pan of a software mixer voice from the distance and direction of p_position as seen from p_pov.
+	void UpdateMixerGain(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const float* p_position, ViewROI* p_pov);
+
 	LPDIRECTSOUND3DBUFFER m_ds3dBuffer; ///< [AI] Pointer to associated DirectSound 3D buffer interface, or NULL if not using 3D sound.
 	LegoROI* m_roi;                     ///< [AI] The tracked in-world object (ROI), typically a character or a specific scene element.
 	LegoROI* m_positionROI;             ///< [AI] The tracked ROI for positional updates, which may be a special "head" ROI for actors.
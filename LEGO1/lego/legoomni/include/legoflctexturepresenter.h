@@ -61,7 +61,7 @@ class LegoFlcTexturePresenter : public MxFlcPresenter {
 
 	/// @brief [AI] Uploads the newly decoded FLC frame to the associated LegoTextureInfo, updating the active texture. [AI]
 	/// @details [AI]
-	/// If a target texture is loaded and there are dirty rectangles (rectCount != 0), uploads the new frame region(s) to the texture and resets state.
+	/// If a target texture is loaded and there are dirty rectangles (rectCount != 0), uploads only those regions of the frame to the texture and resets state.
 	/// [AI]
 	void PutFrame() override;
 
@@ -74,6 +74,7 @@ class LegoFlcTexturePresenter : public MxFlcPresenter {
 
 	MxS32 m_rectCount;          ///< @brief [AI] Number of FLC update rectangles in the current frame. Used to track dirty regions for texture updates. [AI]
 	LegoTextureInfo* m_texture; ///< @brief [AI] Pointer to the LEGO texture object this FLC animation is driving. [AI]
+	MxRect32 m_rects[4];        ///< @brief [AI] Regions changed since the last PutFrame, in rows of m_frameBitmap's image. [AI]
 };
 
 #endif // LEGOFLCTEXTUREPRESENTER_H
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <string.h>
 
 class LegoFile;
+class LegoSaveWriter;
 class LegoState;
 class LegoStorage;
 class MxVariableTable;
@@ -232,6 +233,7 @@ class LegoGameState {
 	void ResetROI();
 
 	/// @brief Saves persistent game state (world variables, actor, etc.) to a file slot. [AI]
+	/// The state is serialized into memory right away; the file is written by a background thread. [AI]
 	/// @param p_slot Save slot index. [AI]
 	MxResult Save(MxULong p_slot);
 
@@ -262,6 +264,7 @@ class LegoGameState {
 	MxS16 FindPlayer(Username& p_player);
 
 	/// @brief Serializes the score history table to score file. [AI]
+	/// Writing goes through the background save thread, like Save. [AI]
 	/// @param p_flags File mode flags (read/write) for the score file. [AI]
 	void SerializeScoreHistory(MxS16 p_flags);
 
@@ -377,6 +380,7 @@ class LegoGameState {
 	LegoBackgroundColor* m_backgroundColor;     ///< Persistent variable object holding background color. [AI]
 	LegoBackgroundColor* m_tempBackgroundColor; ///< Temporary background color object; for visual transitions. [AI]
 	LegoFullScreenMovie* m_fullScreenMovie;     ///< Controls movie playback variable ("enable"/"disable"). [AI]
+	LegoSaveWriter* m_saveWriter;               ///< Writes save and score history snapshots in the background. [AI]
 
 	// === Exposed/game-managed slots for player and area data ===
 
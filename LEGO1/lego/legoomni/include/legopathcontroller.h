@@ -201,6 +201,30 @@ class LegoPathController : public MxCore {
 	 */
 	LegoPathBoundary* GetPathBoundary(const char* p_name);
 
+	/**
+	 * @brief [AI] Runs the collision test of p_actor (VTable0x6c) on every boundary near a swept sphere. [AI]
+	 * @details [AI] The actor's own boundary is tested first. The other boundaries come from a uniform grid over the
+	 * boundaries of this controller, so the cost depends on how many boundaries and actors are close to the segment
+	 * rather than on how many neighbours the actor's boundary has. A boundary is tested if its bounding rectangle comes
+	 * within p_f2 plus the largest collision extent of any actor on this controller of the segment. [AI]
+	 * @param p_v1 [AI] Segment start.
+	 * @param p_v2 [AI] Normalized segment direction.
+	 * @param p_f1 [AI] Segment length.
+	 * @param p_f2 [AI] Radius of the moving actor.
+	 * @param p_v3 [AI] Receives the hit position.
+	 * @param p_result [AI] Receives the first non-zero result of VTable0x6c, or 0 if nothing was hit.
+	 * @return [AI] FAILURE if the actor is not on one of this controller's boundaries, p_result is not set then.
+	 */
+	MxResult Collide(
+		LegoPathActor* p_actor,
+		Vector3& p_v1,
+		Vector3& p_v2,
+		float p_f1,
+		float p_f2,
+		Vector3& p_v3,
+		MxU32& p_result
+	);
+
 	/**
 	 * @brief [AI] Enables or disables the controller's registration with the tickle manager, controlling per-frame updates. [AI]
 	 * @param p_enable [AI] TRUE to enable, FALSE to disable. [AI]
@@ -321,6 +345,45 @@ class LegoPathController : public MxCore {
 	 */
 	static LegoPathBoundary* GetControlBoundaryB(MxS32 p_index) { return g_ctrlBoundariesB[p_index].m_boundary; }
 
+	/**
+	 * @brief [AI] Per-edge state of the route search in FUN_10048310. [AI]
+	 */
+	struct PathNode {
+		MxFloat m_cost;           ///< [AI] Shortest known distance from the start position to the edge's midpoint.
+		LegoPathBoundary* m_from; ///< [AI] Boundary the edge is crossed from on that route.
+		MxS32 m_prev;             ///< [AI] Index of the previous edge on that route, or -1 for the first edge.
+		MxU32 m_search;           ///< [AI] Search the fields above belong to; entries from older searches count as unvisited.
+		MxU8 m_closed;            ///< [AI] TRUE once no shorter route to the edge can be found.
+	};
+
+	/**
+	 * @brief [AI] Entry in the open list of the route search. [AI]
+	 */
+	struct PathOpenEntry {
+		MxFloat m_estimate; ///< [AI] m_cost plus the straight-line distance from the edge's midpoint to the goal position.
+		MxFloat m_cost;     ///< [AI] Distance travelled so far; an entry above its node's current cost is stale.
+		MxS32 m_node;       ///< [AI] Edge index, or m_numE plus the index of the last edge for a route that has reached the goal.
+	};
+
+	/**
+	 * @brief [AI] Cached route between two positions, for a given traversal mask. [AI]
+	 */
+	struct PathRoute {
+		LegoPathBoundary* m_start;  ///< [AI] Boundary the route starts in, or NULL if the slot is unused.
+		LegoPathBoundary* m_goal;   ///< [AI] Boundary the route ends in.
+		MxFloat m_startPosition[3]; ///< [AI] Position the route was searched from.
+		MxFloat m_goalPosition[3];  ///< [AI] Position the route was searched to.
+		MxU32 m_lastUse;            ///< [AI] Value of m_routeClock when the route was last used.
+		MxU16* m_edges;             ///< [AI] Indices of the edges crossed, in order.
+		MxU16 m_numEdges;           ///< [AI] Number of entries in m_edges.
+		LegoU8 m_mask;              ///< [AI] Traversal mask the route was searched with.
+	};
+
+	enum {
+		c_numCachedRoutes = 16, ///< [AI] Number of routes kept by the route cache.
+		c_maxGridSize = 64      ///< [AI] Largest number of rows or columns of the boundary grid.
+	};
+
 private:
 	/**
 	 * @brief [AI] Internal per-frame update; animates all active actors managed by this controller. [AI]
@@ -390,6 +453,101 @@ class LegoPathController : public MxCore {
 	 */
 	static MxU32 FUN_100c17a0(MxFloat p_v1, MxFloat p_v2, MxFloat p_a, MxFloat p_b);
 
+	/**
+	 * @brief [AI] Builds the edge midpoints, per-boundary edge lists and search buffers used by FUN_10048310. [AI]
+	 */
+	void CreatePathGraph();
+
+	/**
+	 * @brief [AI] Releases everything allocated by CreatePathGraph, including the route cache. [AI]
+	 */
+	void DestroyPathGraph();
+
+	/**
+	 * @brief [AI] Builds the grid of boundaries used by Collide. [AI]
+	 */
+	void CreateBoundaryGrid();
+
+	/**
+	 * @brief [AI] Releases everything allocated by CreateBoundaryGrid. [AI]
+	 */
+	void DestroyBoundaryGrid();
+
+	/**
+	 * @brief [AI] Grows m_gridMargin to cover the collision extent of p_actor. [AI]
+	 */
+	void UpdateGridMargin(LegoPathActor* p_actor);
+
+	/**
+	 * @brief [AI] A* search over the edges for the shortest route from p_oldBoundary to p_newBoundary. [AI]
+	 * @details [AI] Costs are distances between consecutive edge midpoints, plus the distances from the start position
+	 * to the first midpoint and from the last midpoint to the goal position. The straight-line distance to the goal
+	 * position is the heuristic. The route can be read back through m_pathNodes.
+	 * @param p_cost [AI] Receives the length of the route found.
+	 * @return [AI] Index of the last edge of the route, or -1 if there is none.
+	 */
+	MxS32 SearchPath(
+		const Vector3& p_oldPosition,
+		LegoPathBoundary* p_oldBoundary,
+		const Vector3& p_newPosition,
+		LegoPathBoundary* p_newBoundary,
+		LegoU8 p_mask,
+		MxFloat& p_cost
+	);
+
+	/**
+	 * @brief [AI] Looks up a cached route and loads it into m_pathNodes as if SearchPath had found it. [AI]
+	 * @details [AI] Only a route searched between the same two positions with the same mask is reused, so a hit is
+	 * the route SearchPath would find. The whole cache is dropped once any boundary is enabled or disabled.
+	 * @param p_cost [AI] Receives the length of the route for the given positions.
+	 * @return [AI] Index of the last edge of the route, or -1 on a cache miss.
+	 */
+	MxS32 LookupRoute(
+		const Vector3& p_oldPosition,
+		LegoPathBoundary* p_oldBoundary,
+		const Vector3& p_newPosition,
+		LegoPathBoundary* p_newBoundary,
+		LegoU8 p_mask,
+		MxFloat& p_cost
+	);
+
+	/**
+	 * @brief [AI] Adds the route ending at p_last in m_pathNodes to the cache, evicting the least recently used one. [AI]
+	 */
+	void StoreRoute(
+		const Vector3& p_oldPosition,
+		LegoPathBoundary* p_oldBoundary,
+		const Vector3& p_newPosition,
+		LegoPathBoundary* p_newBoundary,
+		LegoU8 p_mask,
+		MxS32 p_last
+	);
+
+	/**
+	 * @brief [AI] Empties the route cache. [AI]
+	 */
+	void FlushRoutes();
+
+	/**
+	 * @brief [AI] Distance from the midpoint of edge p_edge to p_position. [AI]
+	 */
+	MxFloat MidpointDistance(MxS32 p_edge, const Vector3& p_position);
+
+	/**
+	 * @brief [AI] Distance between the midpoints of edges p_a and p_b. [AI]
+	 */
+	MxFloat MidpointDistance(MxS32 p_a, MxS32 p_b);
+
+	/**
+	 * @brief [AI] Adds an entry to the open list. [AI]
+	 */
+	void PushOpen(MxFloat p_estimate, MxFloat p_cost, MxS32 p_node);
+
+	/**
+	 * @brief [AI] Removes the entry with the lowest estimate from the open list. [AI]
+	 */
+	void PopOpen(PathOpenEntry& p_entry);
+
 	LegoPathBoundary* m_boundaries; ///< @brief [AI] Dynamically allocated array of path boundaries (segments) managed by the controller. [AI]
 	LegoPathCtrlEdge* m_edges;      ///< @brief [AI] Dynamically allocated array of control edges, specifying connectivity between boundaries. [AI]
 	Mx3DPointFloat* m_unk0x10;      ///< @brief [AI] Array of 3D float points; typically used as edge endpoints or other geometry anchors. [AI]
@@ -398,8 +556,28 @@ class LegoPathController : public MxCore {
 	MxU16 m_numE;                   ///< @brief [AI] Number of edges. [AI]
 	MxU16 m_numN;                   ///< @brief [AI] Number of nodes/points in m_unk0x10. [AI]
 	MxU16 m_numT;                   ///< @brief [AI] Number of trigger structs in m_structs. [AI]
-	LegoPathCtrlEdgeSet m_pfsE;     ///< @brief [AI] Set of pointers to control edges, for efficient lookup and filtering. [AI]
 	LegoPathActorSet m_actors;      ///< @brief [AI] Set of actors currently managed by this controller. [AI]
+	MxFloat* m_midpoints;           ///< @brief [AI] Midpoint of each edge, three floats per edge. [AI]
+	MxU16* m_boundaryEdges;         ///< @brief [AI] Indices of the passable (GetMask0x03) edges of every boundary, grouped by boundary. [AI]
+	MxU16* m_boundaryEdgeStart;     ///< @brief [AI] Start of each boundary's group in m_boundaryEdges; m_numL + 1 entries. [AI]
+	PathNode* m_pathNodes;          ///< @brief [AI] Route search state, one entry per edge. [AI]
+	PathOpenEntry* m_open;          ///< @brief [AI] Open list of the route search, a binary min-heap on m_estimate. [AI]
+	MxU32 m_numOpen;                ///< @brief [AI] Number of entries in m_open. [AI]
+	MxU32 m_search;                 ///< @brief [AI] Number of the current route search. [AI]
+	MxU32 m_routeClock;             ///< @brief [AI] Incremented on every route cache access. [AI]
+	MxU32 m_routeGeneration;        ///< @brief [AI] LegoWEGEdge::GetFlagGeneration() the cached routes were searched at. [AI]
+	PathRoute m_routes[c_numCachedRoutes]; ///< @brief [AI] Least recently used cache of searched routes. [AI]
+	MxFloat* m_boundaryRects;              ///< @brief [AI] Bounding rectangle of each boundary on the XZ plane: min x, min z, max x, max z.
+	MxU32* m_gridCellStart;                ///< @brief [AI] Start of each grid cell's group in m_gridBoundaries; one entry more than cells.
+	MxU16* m_gridBoundaries;               ///< @brief [AI] Indices of the boundaries whose rectangle overlaps each cell, grouped by cell.
+	MxU32* m_gridStamps;                   ///< @brief [AI] Value of m_gridQuery when each boundary was last tested by Collide.
+	MxU32 m_gridQuery;                     ///< @brief [AI] Number of the current Collide call.
+	MxFloat m_gridMinX;                    ///< @brief [AI] X coordinate of the grid's first column.
+	MxFloat m_gridMinZ;                    ///< @brief [AI] Z coordinate of the grid's first row.
+	MxFloat m_gridCellSize;                ///< @brief [AI] Width and depth of a grid cell.
+	MxU16 m_gridWidth;                     ///< @brief [AI] Number of grid columns.
+	MxU16 m_gridDepth;                     ///< @brief [AI] Number of grid rows.
+	MxFloat m_gridMargin;                  ///< @brief [AI] Largest collision extent seen of an actor on this controller.
 
 	// Names verified by BETA10
 
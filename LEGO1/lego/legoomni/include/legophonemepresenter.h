@@ -9,7 +9,7 @@
 class LegoTextureInfo;
 
 // VTABLE: LEGO1 0x100d8040
-// SIZE 0x88
+// SIZE 0xc8
 /**
  * @brief Class responsible for presenting lip-synced ("phoneme") mouth animations on LEGO character head textures using FLC animations. [AI]
  *
@@ -69,7 +69,7 @@ class LegoPhonemePresenter : public MxFlcPresenter {
 	/**
 	 * @brief Applies the loaded frame data to the cached texture, updating the target ROI's mouth/phoneme region. [AI]
 	 *
-	 * @details If a texture is available and there are updated mouth regions, calls the texture update method and resets the rect count for the next frame. [AI]
+	 * @details If a texture is available and there are updated mouth regions, copies only those regions to the texture and resets the rect count for the next frame. [AI]
 	 */
 	void PutFrame() override;                        // vtable+0x6c
 
@@ -87,6 +87,7 @@ class LegoPhonemePresenter : public MxFlcPresenter {
 	MxBool m_unk0x70;               ///< Unknown; used as a flag when updating a cached/duplicate phoneme entry. [AI]
 	MxString m_roiName;             ///< Name (string) of the ROI (character/entity) being lip-synced. [AI]
 	MxBool m_unk0x84;               ///< Unknown; used as a flag for variant ROI selection (mainly for composite presenters). [AI]
+	MxRect32 m_rects[4];            ///< Regions changed since the last PutFrame, in rows of m_frameBitmap's image. [AI]
 };
 
 // TEMPLATE: LEGO1 0x1004eb20
@@ -0,0 +1,90 @@
+#ifndef LEGOSAVEWRITER_H
+#define LEGOSAVEWRITER_H
+
+#include "compat.h"
+#include "mxcriticalsection.h"
+#include "mxsemaphore.h"
+#include "mxstring.h"
+#include "mxthread.h"
+#include "mxtypes.h"
+
+class LegoMemory;
+
+/**
+ * @brief [AI] Background thread that writes save game snapshots to disk.
+ * @details [AI] LegoGameState serializes a save into a LegoMemory on the main thread, which only copies fields, and
+ * hands the buffer over with Queue. The thread writes each snapshot to a temporary file next to its target and then
+ * renames it over the target, so a failed write leaves the previous save intact. A snapshot queued for a file that
+ * already has one waiting replaces it, only the latest state of a file is worth writing. Failed background writes are
+ * reported by the next Wait or TakeFailures.
+ */
+class LegoSaveWriter : public MxThread {
+public:
+	LegoSaveWriter();
+	~LegoSaveWriter() override;
+
+	/**
+	 * @brief [AI] Starts the writer thread.
+	 * @return SUCCESS if snapshots are written in the background, FAILURE if Queue will write them synchronously. [AI]
+	 */
+	MxResult Create();
+
+	/**
+	 * @brief [AI] Writes all queued snapshots and stops the writer thread. [AI]
+	 */
+	void Destroy();
+
+	/**
+	 * @brief [AI] Thread entry point; writes queued snapshots until Destroy is called. [AI]
+	 */
+	MxResult Run() override;
+
+	/**
+	 * @brief [AI] Queues a snapshot to be written to a file.
+	 * @param p_path Path of the file to replace. [AI]
+	 * @param p_snapshot Storage holding the file contents. Its buffer is taken over, the storage is left empty. [AI]
+	 * @return SUCCESS if the snapshot was queued or, without a writer thread, written. [AI]
+	 */
+	MxResult Queue(const char* p_path, LegoMemory& p_snapshot);
+
+	/**
+	 * @brief [AI] Waits until every queued snapshot is on disk.
+	 * @details [AI] Called before save files are read, moved or deleted. [AI]
+	 * @return FAILURE if a snapshot written in the background since the last Wait or TakeFailures failed. [AI]
+	 */
+	MxResult Wait();
+
+	/**
+	 * @brief [AI] Returns the number of background writes that failed since the last Wait or TakeFailures. [AI]
+	 */
+	MxU32 TakeFailures();
+
+	/**
+	 * @brief [AI] Returns the number of snapshots that could not be written. [AI]
+	 */
+	MxU32 GetFailures() const { return m_failures; }
+
+	/**
+	 * @brief [AI] A snapshot waiting to be written. [AI]
+	 */
+	struct Job {
+		MxString m_path; ///< [AI] Target file.
+		MxU8* m_data;    ///< [AI] File contents, allocated with new[].
+		MxU32 m_size;    ///< [AI] Size of m_data in bytes.
+		Job* m_next;     ///< [AI] Next job in queue order.
+	};
+
+private:
+	static MxResult WriteSnapshot(const char* p_path, const MxU8* p_data, MxU32 p_size);
+
+	Job* m_queue;             ///< [AI] Jobs in the order they were queued.
+	MxBool m_writing;         ///< [AI] TRUE while the thread writes a job it took off the queue.
+	MxBool m_active;          ///< [AI] TRUE while the writer thread should keep running.
+	MxU32 m_failures;         ///< [AI] Snapshots that could not be written.
+	MxU32 m_unreported;       ///< [AI] Background writes that failed since the last Wait or TakeFailures.
+	HANDLE m_idle;            ///< [AI] Manual-reset event, signaled while the queue is empty and nothing is written.
+	MxSemaphore m_work;       ///< [AI] Counts queued jobs; the thread waits on it.
+	MxCriticalSection m_lock; ///< [AI] Guards m_queue, m_writing, m_failures, m_unreported and m_idle's state.
+};
+
+#endif // LEGOSAVEWRITER_H
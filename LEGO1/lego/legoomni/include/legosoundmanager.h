@@ -9,7 +9,7 @@ class LegoCacheSoundManager;
 /// \brief [AI] Manages 3D sound effects and music playback for LEGO Island, integrating with DirectSound and providing caching.
 /// \details [AI] This class extends MxSoundManager to add LEGO-specific sound management, including 3D audio listener control and caching of sound resources through LegoCacheSoundManager.
 /// It is responsible for initializing DirectSound interfaces, updating the listener's position/orientation for 3D sound, and coordinating sound resource caches.
-/// Size: 0x44 bytes.
+/// Size: 0x48 bytes.
 /// VTABLE: LEGO1 0x100d6b10 / BETA10 0x101bec30
 class LegoSoundManager : public MxSoundManager {
 public:
@@ -52,8 +52,8 @@ class LegoSoundManager : public MxSoundManager {
 	/// \param p_fromDestructor [AI] If TRUE, indicates this is being called by the class destructor itself.
 	void Destroy(MxBool p_fromDestructor);
 
-	LPDIRECTSOUND3DLISTENER m_listener;         ///< [AI] DirectSound 3D listener interface for spatial audio. Used to set position/orientation. Offset 0x3c.
-	LegoCacheSoundManager* m_cacheSoundManager; ///< [AI] Pointer to the LEGO sound resource cache for reused samples. Offset 0x40.
+	LPDIRECTSOUND3DLISTENER m_listener;         ///< [AI] DirectSound 3D listener interface for spatial audio. Used to set position/orientation. Offset 0x40.
+	LegoCacheSoundManager* m_cacheSoundManager; ///< [AI] Pointer to the LEGO sound resource cache for reused samples. Offset 0x44.
 };
 
 // GLOBAL: LEGO1 0x100db6d0 [AI] IID_IDirectSound3DListener (COM Interface GUID for DirectSound 3D Listener)
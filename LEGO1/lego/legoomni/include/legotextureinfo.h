@@ -2,12 +2,35 @@
 #define LEGOTEXTUREINFO_H
 
 #include "misc/legotypes.h"
+#include "mxtypes.h"
 #include "tgl/tgl.h"
 
 #include <d3drmobj.h>
 #include <ddraw.h>
 
 class LegoTexture;
+class LegoTextureContainer;
+class MxRect32;
+
+/**
+ * @brief [AI] Texture content shared by every LegoTextureInfo created from the same image and palette.
+ * @details [AI] Owned by LegoTextureContainer, which finds entries by m_hash. The entry holds its own references to
+ * the DirectDraw and Direct3DRM objects, so it can be handed out again after all of its users are gone, until the
+ * container evicts it.
+ */
+struct LegoTextureCacheEntry {
+	MxU64 m_hash;                      ///< [AI] 64-bit FNV-1a hash of the image size, palette and bits.
+	LegoU32 m_width;                   ///< [AI] Image width in pixels.
+	LegoU32 m_height;                  ///< [AI] Image height in pixels.
+	LPDIRECTDRAWSURFACE m_surface;     ///< [AI] Shared surface holding the original bits; never written.
+	LPDIRECTDRAWPALETTE m_palette;     ///< [AI] Shared palette.
+	LPDIRECT3DRMTEXTURE2 m_texture;    ///< [AI] Shared Direct3DRM texture.
+	LegoU32 m_refCount;                ///< [AI] Number of LegoTextureInfo objects currently using this entry.
+	LegoU32 m_size;                    ///< [AI] Approximate memory held by the entry, in bytes.
+	LegoU32 m_stamp;                   ///< [AI] Value of the container's clock when the entry was last handed out.
+	LegoTextureContainer* m_container; ///< [AI] Container owning the entry, told when m_refCount drops to zero.
+	LegoTextureCacheEntry* m_next;     ///< [AI] Next entry in the same hash bucket.
+};
 
 /**
  * @brief [AI] Contains DirectDraw and Direct3DRM handles and metadata for a texture used in the LEGO Island rendering system.
@@ -56,6 +79,28 @@ class LegoTextureInfo {
 	 */
 	static BOOL GetGroupTexture(Tgl::Mesh* pMesh, LegoTextureInfo*& p_textureInfo);
 
+	/**
+	 * @brief [AI] Forgets which texture info the mesh group was bound to. Called before the mesh is deleted.
+	 * @param pMesh [AI] Mesh previously passed to SetGroupTexture.
+	 */
+	static void ReleaseGroupTexture(Tgl::Mesh* pMesh);
+
+	/**
+	 * @brief [AI] Records that a shallow clone of a mesh shares the texture of its source.
+	 * @param p_source [AI] Mesh that was cloned.
+	 * @param p_clone [AI] The clone, which inherited the source's group texture.
+	 */
+	static void CloneGroupTexture(Tgl::Mesh* p_source, Tgl::Mesh* p_clone);
+
+	/**
+	 * @brief [AI] Gives this texture info private copies of a shared surface and texture before it is written.
+	 * @return SUCCESS if the surface can now be written without affecting other texture infos. [AI]
+	 * @details [AI] Does nothing unless the info was handed out by LegoTextureContainer::Create from a shared cache
+	 * entry. Otherwise the surface is copied, a new Direct3DRM texture is created from the copy and every mesh group
+	 * bound through this info is rebound to it. The palette stays shared, it is never written.
+	 */
+	LegoResult Detach();
+
 	/**
 	 * @brief [AI] Updates the pixel bits for the current surface/texture with the provided bitmap data. 
 	 * @param p_bits [AI] Pointer to the updated 8-bit indexed image pixel data to load into the DirectDrawSurface (same format as originally loaded).
@@ -65,6 +110,26 @@ class LegoTextureInfo {
 	 */
 	LegoResult FUN_10066010(const LegoU8* p_bits);
 
+	/**
+	 * @brief [AI] Updates only the given regions of the surface from the provided bitmap data.
+	 * @param p_bits [AI] 8-bit indexed image pixel data, laid out like for FUN_10066010.
+	 * @param p_rects [AI] Changed regions with inclusive right/bottom edges, in rows of p_bits.
+	 * @param p_rectCount [AI] Number of entries in p_rects.
+	 * @return SUCCESS if the update succeeded and the texture is marked as changed, FAILURE otherwise. [AI]
+	 * @details [AI] Used by animated textures, whose frames usually change a small part of the image. The cost of
+	 * the copy is proportional to the changed pixels instead of the whole texture.
+	 */
+	LegoResult LoadBits(const LegoU8* p_bits, const MxRect32* p_rects, MxS32 p_rectCount);
+
+	/**
+	 * @brief [AI] Adds a changed region to the regions pending for LoadBits.
+	 * @param p_rects [AI] Array of at least p_maxRects pending regions.
+	 * @param p_rectCount [AI] Number of pending regions, updated.
+	 * @param p_maxRects [AI] Capacity of p_rects. Once it is full, further regions are merged into the last one.
+	 * @param p_rect [AI] The region to add.
+	 */
+	static void AddDirtyRect(MxRect32* p_rects, MxS32& p_rectCount, MxS32 p_maxRects, const MxRect32& p_rect);
+
 	// private:
 
 	/**
@@ -86,6 +151,16 @@ class LegoTextureInfo {
 	 * @brief [AI] Direct3DRM texture object used by retained-mode rendering. Receives updates from m_surface.
 	 */
 	LPDIRECT3DRMTEXTURE2 m_texture; // 0x0c
+
+	/**
+	 * @brief [AI] Shared cache entry whose surface, palette and texture this info uses, or NULL once detached.
+	 */
+	LegoTextureCacheEntry* m_cacheEntry; // 0x10
+
+	/**
+	 * @brief [AI] Number of mesh groups bound to this info through SetGroupTexture.
+	 */
+	LegoU32 m_bindingCount; // 0x14
 };
 
 // GLOBAL: LEGO1 0x100db6f0
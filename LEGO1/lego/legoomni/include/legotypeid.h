@@ -0,0 +1,20 @@
+#ifndef LEGOTYPEID_H
+#define LEGOTYPEID_H
+
+#include "mxtypeid.h"
+
+// Interned names of LEGO Island classes tested on hot paths, see MxTypeId
+
+DECLARE_MX_TYPEID(LegoActionControlPresenter);
+DECLARE_MX_TYPEID(LegoAnimPresenter);
+DECLARE_MX_TYPEID(LegoCacheSound);
+DECLARE_MX_TYPEID(LegoHideAnimPresenter);
+DECLARE_MX_TYPEID(LegoLocomotionAnimPresenter);
+DECLARE_MX_TYPEID(LegoLoopingAnimPresenter);
+DECLARE_MX_TYPEID(LegoPathActor);
+DECLARE_MX_TYPEID(LegoPathController);
+DECLARE_MX_TYPEID(LegoWorld);
+DECLARE_MX_TYPEID(LegoWorldPresenter);
+DECLARE_MX_TYPEID(MxControlPresenter);
+
+#endif // LEGOTYPEID_H
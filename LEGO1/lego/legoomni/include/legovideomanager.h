@@ -25,7 +25,7 @@ class Renderer;
  * @details [AI] This manager is responsible for handling both 2D (video overlays, cursor, movies) and 3D rendering using Direct3D Retained Mode, palette manipulations, and integrating multiple engine components including Lego3DManager, phoneme reference lists for speech, and presenter-layer management. It also manages DirectDraw surfaces for custom overlays like the cursor and FPS meter, handles switching between fullscreen movies and gameplay, and exposes logic for enabling/disabling the 3D device state. [AI]
  */
 // VTABLE: LEGO1 0x100d9c88
-// SIZE 0x590
+// SIZE 0x594
 class LegoVideoManager : public MxVideoManager {
 public:
 	/**
@@ -76,6 +76,13 @@ class LegoVideoManager : public MxVideoManager {
 	 */
 	void ToggleFPS(MxBool p_visible);
 
+	/**
+	 * @brief [AI] Makes the next frame composite and present the whole screen again. [AI]
+	 * @details [AI] Called when the front buffer was uncovered, moved or restored, which the dirty areas of the
+	 * presenters do not account for. [AI]
+	 */
+	void RedrawAll() { m_partialRedraw = FALSE; }
+
 	/**
 	 * @brief [AI] Performs per-frame update for all video, 3D, and interface layers. Includes tickling all presenters, handling overlays, and performing buffer swaps. [AI]
 	 * @return [AI] Always returns SUCCESS. [AI]
@@ -359,6 +366,9 @@ class LegoVideoManager : public MxVideoManager {
 
 	/// @brief Number of backbuffers for D3DRM rendering. [AI]
 	DWORD m_bufferCount;                  // 0x58c
+
+	/// @brief TRUE if the last frame only recomposited the invalidated region, see Tickle. [AI]
+	MxBool m_partialRedraw;               // 0x590
 };
 
 // SYNTHETIC: LEGO1 0x1007ab20
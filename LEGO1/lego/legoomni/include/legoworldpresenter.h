@@ -99,7 +99,7 @@ class LegoWorldPresenter : public LegoEntityPresenter {
 	/**
 	 * @brief [AI] Loads a single part from the world database file, reads and caches its chunk, and hands it to the LegoPartPresenter. Called for each ModelDbPart in the loaded world.
 	 * @param p_part Model database part to load. [AI]
-	 * @param p_wdbFile Opened file pointer to world.wdb. [AI]
+	 * @param p_wdbFile Opened file pointer to world.wdb; only read from if the file could not be memory-mapped. [AI]
 	 * @return SUCCESS if part chunk stored successfully, FAILURE otherwise. [AI]
 	 */
 	MxResult LoadWorldPart(ModelDbPart& p_part, FILE* p_wdbFile);
@@ -107,7 +107,7 @@ class LegoWorldPresenter : public LegoEntityPresenter {
 	/**
 	 * @brief [AI] Loads a single model (geometry instance) from the world database, creates a corresponding presenter, entity, and attaches it to the world. Handles actor/entity/model types based on their presenter type.
 	 * @param p_model The model database model to load (location, direction, presenter, etc). [AI]
-	 * @param p_wdbFile Opened file pointer to world.wdb. [AI]
+	 * @param p_wdbFile Opened file pointer to world.wdb; only read from if the file could not be memory-mapped. [AI]
 	 * @param p_world The LegoWorld object the model gets attached to. [AI]
 	 * @return SUCCESS if model loaded and presenter/entity created, FAILURE otherwise. [AI]
 	 */
@@ -7,10 +7,17 @@
 #include "misc.h"
 #include "mxomni.h"
 
+#include <math.h>
 #include <vec.h>
 
 DECOMP_SIZE_ASSERT(Lego3DSound, 0x30)
 
+// Distance model used with the software mixer. The distances match the ones
+// Create gives DirectSound3D; at full pan the far ear is 20 dB quieter.
+#define LEGO3DSOUND_MIN_DISTANCE 15.0f
+#define LEGO3DSOUND_MAX_DISTANCE 100.0f
+#define LEGO3DSOUND_MAX_PAN 2000.0f
+
 // FUNCTION: LEGO1 0x10011630
 Lego3DSound::Lego3DSound()
 {
@@ -53,7 +60,7 @@ MxResult Lego3DSound::Create(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const char
 		m_ds3dBuffer->SetConeOutsideVolume(-10000, DS3D_IMMEDIATE);
 	}
 
-	if (m_ds3dBuffer == NULL || p_name == NULL) {
+	if ((m_ds3dBuffer == NULL && SoundManager()->GetMixer() == NULL) || p_name == NULL) {
 		return SUCCESS;
 	}
 
@@ -88,6 +95,9 @@ MxResult Lego3DSound::Create(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const char
 		const float* position = m_positionROI->GetWorldPosition();
 		m_ds3dBuffer->SetPosition(position[0], position[1], position[2], DS3D_IMMEDIATE);
 	}
+	else if (VideoManager()->GetViewROI() != NULL) {
+		UpdateMixerGain(p_directSoundBuffer, m_positionROI->GetWorldPosition(), VideoManager()->GetViewROI());
+	}
 
 	LegoEntity* entity = m_roi->GetEntity();
 	if (entity != NULL && entity->IsA("LegoActor") && ((LegoActor*) entity)->GetSoundFrequencyFactor() != 0.0f) {
@@ -149,6 +159,9 @@ MxU32 Lego3DSound::UpdatePosition(LPDIRECTSOUNDBUFFER p_directSoundBuffer)
 		if (m_ds3dBuffer != NULL) {
 			m_ds3dBuffer->SetPosition(position[0], position[1], position[2], DS3D_IMMEDIATE);
 		}
+		else if (SoundManager()->GetMixer() != NULL) {
+			UpdateMixerGain(p_directSoundBuffer, position, pov);
+		}
 		else {
 			MxS32 newVolume = m_volume;
 			if (distance < 100.0f) {
@@ -237,7 +250,10 @@ void Lego3DSound::FUN_10011a60(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const ch
 			const float* position = m_positionROI->GetWorldPosition();
 			ViewROI* pov = VideoManager()->GetViewROI();
 
-			if (pov != NULL) {
+			if (pov != NULL && SoundManager()->GetMixer() != NULL) {
+				UpdateMixerGain(p_directSoundBuffer, position, pov);
+			}
+			else if (pov != NULL) {
 				const float* povPosition = pov->GetWorldPosition();
 				float distance = DISTSQRD3(povPosition, position);
 
@@ -278,6 +294,38 @@ void Lego3DSound::FUN_10011a60(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const ch
 	}
 }
 
+void Lego3DSound::UpdateMixerGain(LPDIRECTSOUNDBUFFER p_directSoundBuffer, const float* p_position, ViewROI* p_pov)
+{
+	float delta[3];
+	VMV3(delta, p_position, p_pov->GetWorldPosition());
+
+	float distance = sqrt(NORMSQRD3(delta));
+	MxS32 newVolume;
+	LONG pan = DSBPAN_CENTER;
+
+	// Inverse distance rolloff like DirectSound3D, faded out to silence at the maximum distance
+	if (distance <= LEGO3DSOUND_MIN_DISTANCE) {
+		newVolume = m_volume;
+	}
+	else if (distance < LEGO3DSOUND_MAX_DISTANCE) {
+		newVolume = m_volume * (LEGO3DSOUND_MIN_DISTANCE / distance) * (LEGO3DSOUND_MAX_DISTANCE - distance) /
+					(LEGO3DSOUND_MAX_DISTANCE - LEGO3DSOUND_MIN_DISTANCE);
+	}
+	else {
+		newVolume = 0;
+	}
+
+	if (distance > 0.001f) {
+		float right[3];
+		VXV3(right, p_pov->GetWorldUp(), p_pov->GetWorldDirection());
+		pan = (LONG) (DOT3(delta, right) / distance * LEGO3DSOUND_MAX_PAN);
+	}
+
+	newVolume = newVolume * SoundManager()->GetVolume() / 100;
+	p_directSoundBuffer->SetVolume(SoundManager()->GetAttenuation(newVolume));
+	p_directSoundBuffer->SetPan(pan);
+}
+
 // FUNCTION: LEGO1 0x10011ca0
 void Lego3DSound::Reset()
 {
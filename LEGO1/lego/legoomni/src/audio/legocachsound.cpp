@@ -73,7 +73,7 @@ MxResult LegoCacheSound::Create(
 	desc.dwBufferBytes = p_dataSize;
 	desc.lpwfxFormat = &wfx;
 
-	if (SoundManager()->GetDirectSound()->CreateSoundBuffer(&desc, &m_dsBuffer, NULL) != DS_OK) {
+	if (SoundManager()->CreateSoundBuffer(&desc, &m_dsBuffer) != DS_OK) {
 		return FAILURE;
 	}
 
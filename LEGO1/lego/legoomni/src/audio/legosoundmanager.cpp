@@ -6,7 +6,7 @@
 
 #include <assert.h>
 
-DECOMP_SIZE_ASSERT(LegoSoundManager, 0x44)
+DECOMP_SIZE_ASSERT(LegoSoundManager, 0x48)
 
 // FUNCTION: LEGO1 0x100298a0
 LegoSoundManager::LegoSoundManager()
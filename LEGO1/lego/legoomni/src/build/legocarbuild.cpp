@@ -24,6 +24,7 @@
 #include "mxsoundpresenter.h"
 #include "mxstillpresenter.h"
 #include "mxticklemanager.h"
+#include "mxtimer.h"
 #include "mxtransitionmanager.h"
 #include "mxvariabletable.h"
 #include "racecar.h"
@@ -551,7 +552,7 @@ MxResult LegoCarBuild::Tickle()
 	}
 
 	if (m_unk0x10a) {
-		DWORD time = timeGetTime();
+		DWORD time = MxTimer::GetClock();
 		DWORD dTime = (time - m_unk0x10c) / 100;
 
 		if (m_carId == RaceCar_Actor) {
@@ -1596,7 +1597,7 @@ void LegoCarBuild::FUN_10025720(undefined4 p_param)
 #endif
 
 	if (m_unk0x10a != 0) {
-		m_unk0x10c = timeGetTime();
+		m_unk0x10c = MxTimer::GetClock();
 	}
 }
 
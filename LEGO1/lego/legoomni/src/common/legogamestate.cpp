@@ -36,6 +36,7 @@
 #include "legomain.h"
 #include "legonavcontroller.h"
 #include "legoplantmanager.h"
+#include "legosavewriter.h"
 #include "legostate.h"
 #include "legoutils.h"
 #include "legovideomanager.h"
@@ -65,7 +66,7 @@
 DECOMP_SIZE_ASSERT(LegoGameState::Username, 0x0e)
 DECOMP_SIZE_ASSERT(LegoGameState::ScoreItem, 0x2c)
 DECOMP_SIZE_ASSERT(LegoGameState::History, 0x374)
-DECOMP_SIZE_ASSERT(LegoGameState, 0x430)
+DECOMP_SIZE_ASSERT(LegoGameState, 0x434)
 DECOMP_SIZE_ASSERT(ColorStringStruct, 0x08)
 DECOMP_SIZE_ASSERT(LegoBackgroundColor, 0x30)
 DECOMP_SIZE_ASSERT(LegoFullScreenMovie, 0x24)
@@ -160,6 +161,10 @@ LegoGameState::LegoGameState()
 	m_loadedAct = e_actNotFound;
 	SetCurrentAct(e_act1);
 
+	// Without the thread, snapshots are written synchronously
+	m_saveWriter = new LegoSaveWriter();
+	m_saveWriter->Create();
+
 	m_backgroundColor = new LegoBackgroundColor("backgroundcolor", "set 56 54 68");
 	VariableTable()->SetVariable(m_backgroundColor);
 
@@ -176,6 +181,9 @@ LegoGameState::LegoGameState()
 // FUNCTION: LEGO1 0x10039720
 LegoGameState::~LegoGameState()
 {
+	// Finishes writing pending saves
+	delete m_saveWriter;
+
 	LegoROI::SetColorOverride(NULL);
 
 	if (m_stateCount) {
@@ -262,7 +270,7 @@ MxResult LegoGameState::Save(MxULong p_slot)
 	}
 
 	MxResult result = FAILURE;
-	LegoFile storage;
+	LegoMemory storage;
 	MxVariableTable* variableTable = VariableTable();
 	MxS16 count = 0;
 	MxU32 i;
@@ -272,10 +280,7 @@ MxResult LegoGameState::Save(MxULong p_slot)
 	MxString savePath;
 	GetFileSavePath(&savePath, p_slot);
 
-	if (storage.Open(savePath.GetData(), LegoFile::c_write) == FAILURE) {
-		goto done;
-	}
-
+	// Serializing into memory only copies fields, the file itself is written by m_saveWriter
 	storage.WriteS32(0x1000c);
 	storage.WriteS16(m_unk0x24);
 	storage.WriteU16(m_currentAct);
@@ -315,8 +320,21 @@ MxResult LegoGameState::Save(MxULong p_slot)
 
 	area = m_unk0x42c;
 	storage.WriteU16(area);
+
+	if (m_saveWriter->Queue(savePath.GetData(), storage) != SUCCESS) {
+		result = FAILURE;
+	}
+
+	// An earlier save failed on disk after it was queued; staying dirty makes the game save again
+	if (m_saveWriter->TakeFailures()) {
+		result = FAILURE;
+	}
+
 	SerializeScoreHistory(2);
-	m_isDirty = FALSE;
+
+	if (result == SUCCESS) {
+		m_isDirty = FALSE;
+	}
 
 done:
 	return result;
@@ -355,6 +373,7 @@ MxResult LegoGameState::Load(MxULong p_slot)
 
 	MxString savePath;
 	GetFileSavePath(&savePath, p_slot);
+	m_saveWriter->Wait();
 
 	if (storage.Open(savePath.GetData(), LegoFile::c_read) == FAILURE) {
 		goto done;
@@ -600,6 +619,8 @@ MxResult LegoGameState::AddPlayer(Username& p_player)
 {
 	MxString from, to;
 
+	m_saveWriter->Wait();
+
 	if (m_playerCount == 9) {
 		GetFileSavePath(&from, 8);
 		DeleteFile(from.GetData());
@@ -630,6 +651,8 @@ void LegoGameState::SwitchPlayer(MxS16 p_playerId)
 	if (p_playerId > 0) {
 		MxString from, temp, to;
 
+		m_saveWriter->Wait();
+
 		GetFileSavePath(&from, p_playerId);
 		GetFileSavePath(&temp, 36);
 
@@ -1575,9 +1598,16 @@ void LegoGameState::SerializeScoreHistory(MxS16 p_flags)
 	savePath += g_historyGSI;
 
 	if (p_flags == LegoFile::c_write) {
+		LegoMemory snapshot;
+
 		m_history.WriteScoreHistory();
+		m_history.Serialize(&snapshot);
+		m_saveWriter->Queue(savePath.GetData(), snapshot);
+		return;
 	}
 
+	m_saveWriter->Wait();
+
 	if (storage.Open(savePath.GetData(), p_flags) == SUCCESS) {
 		m_history.Serialize(&storage);
 	}
@@ -0,0 +1,219 @@
+#include "legosavewriter.h"
+
+#include "misc/legostorage.h"
+#include "mxautolock.h"
+
+LegoSaveWriter::LegoSaveWriter() : MxThread()
+{
+	m_queue = NULL;
+	m_writing = FALSE;
+	m_active = FALSE;
+	m_failures = 0;
+	m_unreported = 0;
+	m_idle = NULL;
+}
+
+LegoSaveWriter::~LegoSaveWriter()
+{
+	Destroy();
+}
+
+MxResult LegoSaveWriter::Create()
+{
+	if (m_active) {
+		return SUCCESS;
+	}
+
+	if (m_work.Init(0, 100) != SUCCESS) {
+		return FAILURE;
+	}
+
+	if ((m_idle = CreateEvent(NULL, TRUE, TRUE, NULL)) == NULL) {
+		return FAILURE;
+	}
+
+	m_active = TRUE;
+	if (Start(0x1000, 0) != SUCCESS) {
+		m_active = FALSE;
+		CloseHandle(m_idle);
+		m_idle = NULL;
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+void LegoSaveWriter::Destroy()
+{
+	if (m_active) {
+		WaitForSingleObject(m_idle, INFINITE);
+		m_active = FALSE;
+		m_work.Release(1);
+		Terminate();
+		CloseHandle(m_idle);
+		m_idle = NULL;
+	}
+
+	// Only reached with jobs left if the thread stopped early, the saves must not be lost
+	while (m_queue != NULL) {
+		Job* job = m_queue;
+		m_queue = job->m_next;
+
+		MxResult result = WriteSnapshot(job->m_path.GetData(), job->m_data, job->m_size);
+
+		if (result != SUCCESS) {
+			AUTOLOCK(m_lock);
+			m_failures++;
+			m_unreported++;
+		}
+
+		delete[] job->m_data;
+		delete job;
+	}
+}
+
+MxResult LegoSaveWriter::Run()
+{
+	while (m_active) {
+		m_work.Wait(INFINITE);
+
+		while (TRUE) {
+			Job* job;
+
+			{
+				AUTOLOCK(m_lock);
+
+				job = m_queue;
+				if (job == NULL) {
+					break;
+				}
+
+				m_queue = job->m_next;
+				m_writing = TRUE;
+			}
+
+			MxResult result = WriteSnapshot(job->m_path.GetData(), job->m_data, job->m_size);
+
+			{
+				AUTOLOCK(m_lock);
+
+				if (result != SUCCESS) {
+					m_failures++;
+					m_unreported++;
+				}
+
+				m_writing = FALSE;
+
+				if (m_queue == NULL) {
+					SetEvent(m_idle);
+				}
+			}
+
+			delete[] job->m_data;
+			delete job;
+		}
+	}
+
+	return MxThread::Run();
+}
+
+MxResult LegoSaveWriter::Queue(const char* p_path, LegoMemory& p_snapshot)
+{
+	MxU32 size = p_snapshot.GetSize();
+	MxU8* data = p_snapshot.ReleaseBuffer();
+
+	if (!m_active) {
+		MxResult result = WriteSnapshot(p_path, data, size);
+
+		// The caller sees this failure in the result, it is not reported again
+		if (result != SUCCESS) {
+			AUTOLOCK(m_lock);
+			m_failures++;
+		}
+
+		delete[] data;
+		return result;
+	}
+
+	{
+		AUTOLOCK(m_lock);
+
+		Job** link = &m_queue;
+
+		for (; *link != NULL; link = &(*link)->m_next) {
+			if (!strcmp((*link)->m_path.GetData(), p_path)) {
+				delete[] (*link)->m_data;
+				(*link)->m_data = data;
+				(*link)->m_size = size;
+				return SUCCESS;
+			}
+		}
+
+		Job* job = new Job;
+		job->m_path = p_path;
+		job->m_data = data;
+		job->m_size = size;
+		job->m_next = NULL;
+		*link = job;
+		ResetEvent(m_idle);
+	}
+
+	m_work.Release(1);
+	return SUCCESS;
+}
+
+MxResult LegoSaveWriter::Wait()
+{
+	if (m_active) {
+		WaitForSingleObject(m_idle, INFINITE);
+	}
+
+	return TakeFailures() ? FAILURE : SUCCESS;
+}
+
+MxU32 LegoSaveWriter::TakeFailures()
+{
+	AUTOLOCK(m_lock);
+
+	MxU32 failures = m_unreported;
+	m_unreported = 0;
+	return failures;
+}
+
+MxResult LegoSaveWriter::WriteSnapshot(const char* p_path, const MxU8* p_data, MxU32 p_size)
+{
+	LegoFile file;
+	MxString temp(p_path);
+	temp += ".tmp";
+
+	if (file.Open(temp.GetData(), LegoFile::c_write) != SUCCESS) {
+		return FAILURE;
+	}
+
+	MxResult result = SUCCESS;
+
+	if (p_size && file.Write(p_data, p_size) != SUCCESS) {
+		result = FAILURE;
+	}
+
+	if (file.Close() != SUCCESS) {
+		result = FAILURE;
+	}
+
+	if (result != SUCCESS) {
+		DeleteFile(temp.GetData());
+		return FAILURE;
+	}
+
+	// MoveFileEx is not available on Windows 95, which replaces the target in two steps instead
+	if (!MoveFileEx(temp.GetData(), p_path, MOVEFILE_REPLACE_EXISTING)) {
+		DeleteFile(p_path);
+
+		if (!MoveFile(temp.GetData(), p_path)) {
+			DeleteFile(temp.GetData());
+			return FAILURE;
+		}
+	}
+
+	return SUCCESS;
+}
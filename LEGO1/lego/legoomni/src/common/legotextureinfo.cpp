@@ -2,12 +2,26 @@
 
 #include "legovideomanager.h"
 #include "misc.h"
+#include "misc/legocontainer.h"
 #include "misc/legoimage.h"
 #include "misc/legotexture.h"
 #include "mxdirectx/mxdirect3d.h"
+#include "mxgeometry.h"
+#include "mxstl/stlcompat.h"
 #include "tgl/d3drm/impl.h"
 
-DECOMP_SIZE_ASSERT(LegoTextureInfo, 0x10)
+DECOMP_SIZE_ASSERT(LegoTextureInfo, 0x18)
+
+// Orders mesh pointers by address
+struct LegoTextureBindingComparator {
+	LegoBool operator()(Tgl::Mesh* const& p_key0, Tgl::Mesh* const& p_key1) const { return p_key0 < p_key1; }
+};
+
+typedef map<Tgl::Mesh*, LegoTextureInfo*, LegoTextureBindingComparator> LegoTextureBindingMap;
+
+// Texture info each textured mesh group was bound through. Textures created by LegoTextureContainer::Create
+// are shared between names, so the texture's app data cannot tell which name a mesh uses.
+LegoTextureBindingMap g_textureBindings;
 
 // FUNCTION: LEGO1 0x10065bf0
 LegoTextureInfo::LegoTextureInfo()
@@ -16,11 +30,36 @@ LegoTextureInfo::LegoTextureInfo()
 	m_surface = NULL;
 	m_palette = NULL;
 	m_texture = NULL;
+	m_cacheEntry = NULL;
+	m_bindingCount = 0;
 }
 
 // FUNCTION: LEGO1 0x10065c00
 LegoTextureInfo::~LegoTextureInfo()
 {
+	if (m_bindingCount) {
+		LegoTextureBindingMap::iterator it = g_textureBindings.begin();
+
+		while (it != g_textureBindings.end()) {
+			if ((*it).second == this) {
+				g_textureBindings.erase(it++);
+			}
+			else {
+				it++;
+			}
+		}
+	}
+
+	if (m_cacheEntry) {
+		// The entry outlives this info, don't leave its texture pointing here
+		if (m_texture && m_texture->GetAppData() == (DWORD) this) {
+			m_texture->SetAppData(0);
+		}
+
+		m_cacheEntry->m_container->ReleaseCacheEntry(m_cacheEntry);
+		m_cacheEntry = NULL;
+	}
+
 	if (m_name) {
 		delete[] m_name;
 		m_name = NULL;
@@ -158,12 +197,31 @@ BOOL LegoTextureInfo::SetGroupTexture(Tgl::Mesh* pMesh, LegoTextureInfo* p_textu
 {
 	TglImpl::MeshImpl::MeshData* data = ((TglImpl::MeshImpl*) pMesh)->ImplementationData();
 	data->groupMesh->SetGroupTexture(data->groupIndex, p_textureInfo->m_texture);
+
+	LegoTextureBindingMap::iterator it = g_textureBindings.find(pMesh);
+
+	if (it != g_textureBindings.end()) {
+		(*it).second->m_bindingCount--;
+		(*it).second = p_textureInfo;
+	}
+	else {
+		g_textureBindings[pMesh] = p_textureInfo;
+	}
+
+	p_textureInfo->m_bindingCount++;
 	return TRUE;
 }
 
 // FUNCTION: LEGO1 0x10065f90
 BOOL LegoTextureInfo::GetGroupTexture(Tgl::Mesh* pMesh, LegoTextureInfo*& p_textureInfo)
 {
+	LegoTextureBindingMap::iterator it = g_textureBindings.find(pMesh);
+
+	if (it != g_textureBindings.end()) {
+		p_textureInfo = (*it).second;
+		return TRUE;
+	}
+
 	TglImpl::MeshImpl::MeshData* data = ((TglImpl::MeshImpl*) pMesh)->ImplementationData();
 
 	IDirect3DRMMesh* mesh = data->groupMesh;
@@ -185,10 +243,96 @@ BOOL LegoTextureInfo::GetGroupTexture(Tgl::Mesh* pMesh, LegoTextureInfo*& p_text
 	return FALSE;
 }
 
+void LegoTextureInfo::ReleaseGroupTexture(Tgl::Mesh* pMesh)
+{
+	LegoTextureBindingMap::iterator it = g_textureBindings.find(pMesh);
+
+	if (it != g_textureBindings.end()) {
+		(*it).second->m_bindingCount--;
+		g_textureBindings.erase(it);
+	}
+}
+
+void LegoTextureInfo::CloneGroupTexture(Tgl::Mesh* p_source, Tgl::Mesh* p_clone)
+{
+	LegoTextureBindingMap::iterator it = g_textureBindings.find(p_source);
+
+	if (it != g_textureBindings.end()) {
+		LegoTextureInfo* textureInfo = (*it).second;
+		g_textureBindings[p_clone] = textureInfo;
+		textureInfo->m_bindingCount++;
+	}
+}
+
+LegoResult LegoTextureInfo::Detach()
+{
+	if (m_cacheEntry == NULL) {
+		return SUCCESS;
+	}
+
+	DDSURFACEDESC desc;
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+	desc.dwFlags = DDSD_PIXELFORMAT | DDSD_WIDTH | DDSD_HEIGHT | DDSD_CAPS;
+	desc.dwWidth = m_cacheEntry->m_width;
+	desc.dwHeight = m_cacheEntry->m_height;
+	desc.ddsCaps.dwCaps = DDCAPS_OVERLAYCANTCLIP | DDCAPS_OVERLAY;
+	desc.ddpfPixelFormat.dwSize = sizeof(desc.ddpfPixelFormat);
+	desc.ddpfPixelFormat.dwFlags = DDPF_RGB | DDPF_PALETTEINDEXED8;
+	desc.ddpfPixelFormat.dwRGBBitCount = 8;
+
+	LPDIRECTDRAWSURFACE surface = NULL;
+	LPDIRECT3DRMTEXTURE2 texture = NULL;
+
+	if (VideoManager()->GetDirect3D()->DirectDraw()->CreateSurface(&desc, &surface, NULL) != DD_OK) {
+		return FAILURE;
+	}
+
+	RECT rect;
+	rect.left = 0;
+	rect.top = 0;
+	rect.right = desc.dwWidth;
+	rect.bottom = desc.dwHeight;
+
+	surface->SetPalette(m_palette);
+
+	if (surface->BltFast(0, 0, m_surface, &rect, DDBLTFAST_WAIT) != DD_OK ||
+		((TglImpl::RendererImpl*) VideoManager()->GetRenderer())->CreateTextureFromSurface(surface, &texture) !=
+			D3DRM_OK) {
+		surface->Release();
+		return FAILURE;
+	}
+
+	texture->SetAppData((DWORD) this);
+
+	if (m_bindingCount) {
+		for (LegoTextureBindingMap::iterator it = g_textureBindings.begin(); it != g_textureBindings.end(); it++) {
+			if ((*it).second == this) {
+				TglImpl::MeshImpl::MeshData* data = ((TglImpl::MeshImpl*) (*it).first)->ImplementationData();
+				data->groupMesh->SetGroupTexture(data->groupIndex, texture);
+			}
+		}
+	}
+
+	if (m_texture->GetAppData() == (DWORD) this) {
+		m_texture->SetAppData(0);
+	}
+
+	m_surface->Release();
+	m_texture->Release();
+	m_surface = surface;
+	m_texture = texture;
+
+	// The entry keeps the original bits for the next texture created with them
+	m_cacheEntry->m_container->ReleaseCacheEntry(m_cacheEntry);
+	m_cacheEntry = NULL;
+	return SUCCESS;
+}
+
 // FUNCTION: LEGO1 0x10066010
 LegoResult LegoTextureInfo::FUN_10066010(const LegoU8* p_bits)
 {
-	if (m_surface != NULL && m_texture != NULL) {
+	if (Detach() == SUCCESS && m_surface != NULL && m_texture != NULL) {
 		DDSURFACEDESC desc;
 		memset(&desc, 0, sizeof(desc));
 		desc.dwSize = sizeof(desc);
@@ -216,3 +360,53 @@ LegoResult LegoTextureInfo::FUN_10066010(const LegoU8* p_bits)
 
 	return FAILURE;
 }
+
+LegoResult LegoTextureInfo::LoadBits(const LegoU8* p_bits, const MxRect32* p_rects, MxS32 p_rectCount)
+{
+	if (Detach() == SUCCESS && m_surface != NULL && m_texture != NULL) {
+		DDSURFACEDESC desc;
+		memset(&desc, 0, sizeof(desc));
+		desc.dwSize = sizeof(desc);
+
+		if (m_surface->Lock(NULL, &desc, 0, NULL) == DD_OK) {
+			MxRect32 bounds(0, 0, desc.dwWidth - 1, desc.dwHeight - 1);
+
+			for (MxS32 i = 0; i < p_rectCount; i++) {
+				MxRect32 rect(p_rects[i]);
+				rect &= bounds;
+
+				if (rect.GetLeft() > rect.GetRight() || rect.GetTop() > rect.GetBottom()) {
+					continue;
+				}
+
+				MxU8* surface = (MxU8*) desc.lpSurface + rect.GetTop() * desc.lPitch + rect.GetLeft();
+				const LegoU8* bits = p_bits + rect.GetTop() * desc.dwWidth + rect.GetLeft();
+				MxS32 width = rect.GetWidth();
+
+				for (MxS32 y = rect.GetTop(); y <= rect.GetBottom(); y++) {
+					memcpy(surface, bits, width);
+					surface += desc.lPitch;
+					bits += desc.dwWidth;
+				}
+			}
+
+			m_surface->Unlock(desc.lpSurface);
+
+			// IDirect3DRMTexture2 has no notion of changed regions, the copy above is what scales with them
+			m_texture->Changed(TRUE, FALSE);
+			return SUCCESS;
+		}
+	}
+
+	return FAILURE;
+}
+
+void LegoTextureInfo::AddDirtyRect(MxRect32* p_rects, MxS32& p_rectCount, MxS32 p_maxRects, const MxRect32& p_rect)
+{
+	if (p_rectCount < p_maxRects) {
+		p_rects[p_rectCount++] = p_rect;
+	}
+	else {
+		p_rects[p_maxRects - 1] |= p_rect;
+	}
+}
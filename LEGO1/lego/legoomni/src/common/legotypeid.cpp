@@ -0,0 +1,13 @@
+#include "legotypeid.h"
+
+DEFINE_MX_TYPEID(LegoActionControlPresenter);
+DEFINE_MX_TYPEID(LegoAnimPresenter);
+DEFINE_MX_TYPEID(LegoCacheSound);
+DEFINE_MX_TYPEID(LegoHideAnimPresenter);
+DEFINE_MX_TYPEID(LegoLocomotionAnimPresenter);
+DEFINE_MX_TYPEID(LegoLoopingAnimPresenter);
+DEFINE_MX_TYPEID(LegoPathActor);
+DEFINE_MX_TYPEID(LegoPathController);
+DEFINE_MX_TYPEID(LegoWorld);
+DEFINE_MX_TYPEID(LegoWorldPresenter);
+DEFINE_MX_TYPEID(MxControlPresenter);
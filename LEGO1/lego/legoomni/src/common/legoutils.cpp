@@ -692,7 +692,8 @@ void WriteDefaultTexture(LegoStorage* p_storage, const char* p_name)
 	MxString name(p_name);
 	LegoTextureInfo* textureInfo = TextureContainer()->Get(p_name);
 
-	if (textureInfo != NULL) {
+	// The surface is overwritten below, it must not share it with other textures
+	if (textureInfo != NULL && textureInfo->Detach() == SUCCESS) {
 		DDSURFACEDESC desc;
 		LegoPaletteEntry paletteEntries[256];
 
@@ -10,6 +10,7 @@
 #include "mxmisc.h"
 #include "mxparam.h"
 #include "mxticklemanager.h"
+#include "mxtimer.h"
 #include "mxvideopresenter.h"
 
 DECOMP_SIZE_ASSERT(MxTransitionManager, 0x900)
@@ -55,11 +56,11 @@ MxResult MxTransitionManager::GetDDrawSurfaceFromVideoManager() // vtable+0x14
 MxResult MxTransitionManager::Tickle()
 {
 	MxULong time = m_animationSpeed + m_systemTime;
-	if (time > timeGetTime()) {
+	if (time > (MxULong) MxTimer::GetClock()) {
 		return SUCCESS;
 	}
 
-	m_systemTime = timeGetTime();
+	m_systemTime = MxTimer::GetClock();
 
 	switch (m_mode) {
 	case e_noAnimation:
@@ -113,7 +114,7 @@ MxResult MxTransitionManager::StartTransition(
 			action->SetFlags(action->GetFlags() | MxDSAction::c_bit10);
 		}
 
-		MxU32 time = timeGetTime();
+		MxU32 time = MxTimer::GetClock();
 		m_systemTime = time;
 
 		m_animationSpeed = p_speed;
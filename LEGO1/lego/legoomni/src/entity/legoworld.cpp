@@ -13,6 +13,7 @@
 #include "legonavcontroller.h"
 #include "legoplantmanager.h"
 #include "legosoundmanager.h"
+#include "legotypeid.h"
 #include "legoutils.h"
 #include "legovideomanager.h"
 #include "misc.h"
@@ -115,7 +116,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 
 		MxDSAction* action = presenter->GetAction();
 		if (action) {
-			if (presenter->IsA("LegoLocomotionAnimPresenter")) {
+			if (presenter->IsKindOf(MX_TYPEID(LegoLocomotionAnimPresenter))) {
 				LegoLocomotionAnimPresenter* animPresenter = (LegoLocomotionAnimPresenter*) presenter;
 
 				animPresenter->DecrementUnknown0xd4();
@@ -136,7 +137,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 		MxCore* object = *it;
 		m_set0xa8.erase(it);
 
-		if (object->IsA("MxPresenter")) {
+		if (object->IsKindOf(MX_TYPEID(MxPresenter))) {
 			MxPresenter* presenter = (MxPresenter*) object;
 			MxDSAction* action = presenter->GetAction();
 
@@ -417,12 +418,13 @@ MxResult LegoWorld::GetCurrPathInfo(LegoPathBoundary** p_boundaries, MxS32& p_nu
 // FUNCTION: BETA10 0x100da90b
 void LegoWorld::Add(MxCore* p_object)
 {
-	if (p_object == NULL || p_object->IsA("LegoWorld") || p_object->IsA("LegoWorldPresenter")) {
+	if (p_object == NULL || p_object->IsKindOf(MX_TYPEID(LegoWorld)) ||
+		p_object->IsKindOf(MX_TYPEID(LegoWorldPresenter))) {
 		return;
 	}
 
 #ifndef BETA10
-	if (p_object->IsA("LegoAnimPresenter")) {
+	if (p_object->IsKindOf(MX_TYPEID(LegoAnimPresenter))) {
 		if (!strcmpi(((LegoAnimPresenter*) p_object)->GetAction()->GetObjectName(), "ConfigAnimation")) {
 			FUN_1003e050((LegoAnimPresenter*) p_object);
 			((LegoAnimPresenter*) p_object)
@@ -432,7 +434,7 @@ void LegoWorld::Add(MxCore* p_object)
 	}
 #endif
 
-	if (p_object->IsA("MxControlPresenter")) {
+	if (p_object->IsKindOf(MX_TYPEID(MxControlPresenter))) {
 		MxPresenterListCursor cursor(&m_controlPresenters);
 
 		if (cursor.Find((MxPresenter*) p_object)) {
@@ -442,7 +444,7 @@ void LegoWorld::Add(MxCore* p_object)
 
 		m_controlPresenters.Append((MxPresenter*) p_object);
 	}
-	else if (p_object->IsA("MxEntity")) {
+	else if (p_object->IsKindOf(MX_TYPEID(MxEntity))) {
 		LegoEntityListCursor cursor(m_entityList);
 
 		if (cursor.Find((LegoEntity*) p_object)) {
@@ -452,7 +454,9 @@ void LegoWorld::Add(MxCore* p_object)
 
 		m_entityList->Append((LegoEntity*) p_object);
 	}
-	else if (p_object->IsA("LegoLocomotionAnimPresenter") || p_object->IsA("LegoHideAnimPresenter") || p_object->IsA("LegoLoopingAnimPresenter")) {
+	else if (p_object->IsKindOf(MX_TYPEID(LegoLocomotionAnimPresenter)) ||
+		p_object->IsKindOf(MX_TYPEID(LegoHideAnimPresenter)) ||
+		p_object->IsKindOf(MX_TYPEID(LegoLoopingAnimPresenter))) {
 		MxPresenterListCursor cursor(&m_animPresenters);
 
 		if (cursor.Find((MxPresenter*) p_object)) {
@@ -463,12 +467,12 @@ void LegoWorld::Add(MxCore* p_object)
 		((MxPresenter*) p_object)->SendToCompositePresenter(Lego());
 		m_animPresenters.Append(((MxPresenter*) p_object));
 
-		if (p_object->IsA("LegoHideAnimPresenter")) {
+		if (p_object->IsKindOf(MX_TYPEID(LegoHideAnimPresenter))) {
 			m_hideAnim = (LegoHideAnimPresenter*) p_object;
 		}
 	}
 #ifndef BETA10
-	else if (p_object->IsA("LegoCacheSound")) {
+	else if (p_object->IsKindOf(MX_TYPEID(LegoCacheSound))) {
 		LegoCacheSoundListCursor cursor(m_cacheSoundList);
 
 		if (cursor.Find((LegoCacheSound*) p_object)) {
@@ -483,7 +487,7 @@ void LegoWorld::Add(MxCore* p_object)
 		MxCoreSet::iterator it = m_set0xa8.find(p_object);
 		if (it == m_set0xa8.end()) {
 #ifdef BETA10
-			if (p_object->IsA("MxPresenter")) {
+			if (p_object->IsKindOf(MX_TYPEID(MxPresenter))) {
 				assert(static_cast<MxPresenter*>(p_object)->GetAction());
 			}
 #endif
@@ -495,7 +499,7 @@ void LegoWorld::Add(MxCore* p_object)
 		}
 	}
 
-	if (m_set0xd0.size() != 0 && p_object->IsA("MxPresenter")) {
+	if (m_set0xd0.size() != 0 && p_object->IsKindOf(MX_TYPEID(MxPresenter))) {
 		if (((MxPresenter*) p_object)->IsEnabled()) {
 			((MxPresenter*) p_object)->Enable(FALSE);
 			m_set0xd0.insert(p_object);
@@ -513,7 +517,7 @@ void LegoWorld::Remove(MxCore* p_object)
 		return;
 	}
 
-	if (p_object->IsA("MxControlPresenter")) {
+	if (p_object->IsKindOf(MX_TYPEID(MxControlPresenter))) {
 		MxPresenterListCursor cursor(&m_controlPresenters);
 
 		if (cursor.Find((MxControlPresenter*) p_object)) {
@@ -522,19 +526,21 @@ void LegoWorld::Remove(MxCore* p_object)
 			((MxControlPresenter*) p_object)->VTable0x68(TRUE);
 		}
 	}
-	else if (p_object->IsA("LegoLocomotionAnimPresenter") || p_object->IsA("LegoHideAnimPresenter") || p_object->IsA("LegoLoopingAnimPresenter")) {
+	else if (p_object->IsKindOf(MX_TYPEID(LegoLocomotionAnimPresenter)) ||
+		p_object->IsKindOf(MX_TYPEID(LegoHideAnimPresenter)) ||
+		p_object->IsKindOf(MX_TYPEID(LegoLoopingAnimPresenter))) {
 		MxPresenterListCursor cursor(&m_animPresenters);
 
 		if (cursor.Find((MxPresenter*) p_object)) {
 			cursor.Detach();
 		}
 
-		if (p_object->IsA("LegoHideAnimPresenter")) {
+		if (p_object->IsKindOf(MX_TYPEID(LegoHideAnimPresenter))) {
 			m_hideAnim = NULL;
 		}
 	}
-	else if (p_object->IsA("MxEntity")) {
-		if (p_object->IsA("LegoPathActor")) {
+	else if (p_object->IsKindOf(MX_TYPEID(MxEntity))) {
+		if (p_object->IsKindOf(MX_TYPEID(LegoPathActor))) {
 			RemoveActor((LegoPathActor*) p_object);
 		}
 
@@ -547,7 +553,7 @@ void LegoWorld::Remove(MxCore* p_object)
 		}
 	}
 #ifndef BETA10
-	else if (p_object->IsA("LegoCacheSound")) {
+	else if (p_object->IsKindOf(MX_TYPEID(LegoCacheSound))) {
 		LegoCacheSoundListCursor cursor(m_cacheSoundList);
 
 		if (cursor.Find((LegoCacheSound*) p_object)) {
@@ -617,7 +623,8 @@ MxCore* LegoWorld::Find(const char* p_class, const char* p_name)
 	}
 
 	for (MxCoreSet::iterator i = m_set0xa8.begin(); i != m_set0xa8.end(); i++) {
-		if ((*i)->IsA(p_class) && (*i)->IsA("MxPresenter")) {
+		// The class name comes from the caller, so test the cheap cached check first
+		if ((*i)->IsKindOf(MX_TYPEID(MxPresenter)) && (*i)->IsA(p_class)) {
 			assert(((MxPresenter*) (*i))->GetAction());
 
 			if (!strcmp(((MxPresenter*) (*i))->GetAction()->GetObjectName(), p_name)) {
@@ -666,7 +673,7 @@ MxCore* LegoWorld::Find(const MxAtomId& p_atom, MxS32 p_entityId)
 	for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
 		MxCore* core = *it;
 
-		if (core->IsA("MxPresenter")) {
+		if (core->IsKindOf(MX_TYPEID(MxPresenter))) {
 			MxPresenter* presenter = (MxPresenter*) *it;
 			MxDSAction* action = presenter->GetAction();
 
@@ -711,10 +718,10 @@ void LegoWorld::Enable(MxBool p_enable)
 		while (m_set0xd0.size() != 0) {
 			it = m_set0xd0.begin();
 
-			if ((*it)->IsA("MxPresenter")) {
+			if ((*it)->IsKindOf(MX_TYPEID(MxPresenter))) {
 				((MxPresenter*) *it)->Enable(TRUE);
 			}
-			else if ((*it)->IsA("LegoPathController")) {
+			else if ((*it)->IsKindOf(MX_TYPEID(LegoPathController))) {
 				((LegoPathController*) *it)->Enable(TRUE);
 			}
 
@@ -771,8 +778,8 @@ void LegoWorld::Enable(MxBool p_enable)
 		}
 
 		for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
-			if ((*it)->IsA("LegoActionControlPresenter") ||
-				((*it)->IsA("MxPresenter") && ((MxPresenter*) *it)->IsEnabled())) {
+			if ((*it)->IsKindOf(MX_TYPEID(LegoActionControlPresenter)) ||
+				((*it)->IsKindOf(MX_TYPEID(MxPresenter)) && ((MxPresenter*) *it)->IsEnabled())) {
 				m_set0xd0.insert(*it);
 				((MxPresenter*) *it)->Enable(FALSE);
 			}
@@ -844,7 +851,7 @@ MxBool LegoWorld::PresentersPending()
 
 	while (animPresenterCursor.Next(presenter)) {
 		if (presenter->IsEnabled()) {
-			if (presenter->IsA("LegoLocomotionAnimPresenter")) {
+			if (presenter->IsKindOf(MX_TYPEID(LegoLocomotionAnimPresenter))) {
 				if (!presenter->HasTickleStatePassed(MxPresenter::e_ready)) {
 					return TRUE;
 				}
@@ -858,7 +865,7 @@ MxBool LegoWorld::PresentersPending()
 	}
 
 	for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
-		if ((*it)->IsA("MxPresenter")) {
+		if ((*it)->IsKindOf(MX_TYPEID(MxPresenter))) {
 			presenter = (MxPresenter*) *it;
 
 			if (presenter->IsEnabled() && !presenter->HasTickleStatePassed(MxPresenter::e_starting)) {
@@ -10,6 +10,7 @@
 #include "legopartpresenter.h"
 #include "legoplantmanager.h"
 #include "legotexturepresenter.h"
+#include "legotypeid.h"
 #include "legovideomanager.h"
 #include "legoworld.h"
 #include "misc.h"
@@ -20,6 +21,7 @@
 #include "mxdschunk.h"
 #include "mxdsmediaaction.h"
 #include "mxdsmultiaction.h"
+#include "mxio.h"
 #include "mxmisc.h"
 #include "mxnotificationmanager.h"
 #include "mxobjectfactory.h"
@@ -37,6 +39,52 @@ MxS32 g_legoWorldPresenterQuality = 1;
 // GLOBAL: LEGO1 0x100f75d8
 MxLong g_wdbOffset = 0;
 
+// Copy-on-write view of world.wdb, mapped on the first LoadWorld and kept for the
+// rest of the session like g_wdbOffset. Parts and models are parsed straight out
+// of it instead of being read into a fresh buffer each.
+MxU8* g_wdbView = NULL;
+MxULong g_wdbViewSize = 0;
+
+static void MapWorldDb(const char* p_path)
+{
+	MXIOINFO io;
+
+	if (io.Open(p_path, OF_READ) == 0) {
+		g_wdbView = io.MapView(&g_wdbViewSize);
+		io.Close(0);
+	}
+
+	if (g_wdbView == NULL) {
+		g_wdbViewSize = 0;
+	}
+}
+
+// Returns p_length bytes of world.wdb starting at p_offset, either from the mapped
+// view or, if the file could not be mapped, read into p_buff, which the caller
+// must delete[]. Leaves p_wdbFile positioned after the data in both cases.
+static MxU8* ReadWorldDb(FILE* p_wdbFile, MxLong p_offset, MxU32 p_length, MxU8*& p_buff)
+{
+	p_buff = NULL;
+
+	if (g_wdbView != NULL && p_offset >= 0 && (MxULong) p_offset + p_length <= g_wdbViewSize) {
+		if (fseek(p_wdbFile, p_offset + p_length, SEEK_SET) != 0) {
+			return NULL;
+		}
+
+		return g_wdbView + p_offset;
+	}
+
+	p_buff = new MxU8[p_length];
+
+	if (fseek(p_wdbFile, p_offset, SEEK_SET) != 0 || fread(p_buff, p_length, 1, p_wdbFile) != 1) {
+		delete[] p_buff;
+		p_buff = NULL;
+		return NULL;
+	}
+
+	return p_buff;
+}
+
 // FUNCTION: LEGO1 0x100665b0
 void LegoWorldPresenter::configureLegoWorldPresenter(MxS32 p_legoWorldPresenterQuality)
 {
@@ -143,7 +191,7 @@ void LegoWorldPresenter::ReadyTickle()
 // FUNCTION: LEGO1 0x10066ac0
 void LegoWorldPresenter::StartingTickle()
 {
-	if (m_action->IsA("MxDSSerialAction")) {
+	if (m_action->IsKindOf(MX_TYPEID(MxDSSerialAction))) {
 		MxPresenter* presenter = *m_list.begin();
 		if (presenter->GetCurrentTickleState() == e_idle) {
 			presenter->SetTickleState(e_ready);
@@ -190,12 +238,17 @@ MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 	MxS32 numWorlds, i, j;
 	MxU32 size;
 	MxU8* buff;
+	MxU8* data;
 	FILE* wdbFile = fopen(wdbPath, "rb");
 
 	if (wdbFile == NULL) {
 		return FAILURE;
 	}
 
+	if (g_wdbView == NULL) {
+		MapWorldDb(wdbPath);
+	}
+
 	ReadModelDbWorlds(wdbFile, worlds, numWorlds);
 
 	for (i = 0; i < numWorlds; i++) {
@@ -213,14 +266,14 @@ MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 			return FAILURE;
 		}
 
-		buff = new MxU8[size];
-		if (fread(buff, size, 1, wdbFile) != 1) {
+		data = ReadWorldDb(wdbFile, ftell(wdbFile), size, buff);
+		if (data == NULL) {
 			return FAILURE;
 		}
 
 		MxDSChunk chunk;
 		chunk.SetLength(size);
-		chunk.SetData(buff);
+		chunk.SetData(data);
 
 		LegoTexturePresenter texturePresenter;
 		if (texturePresenter.Read(chunk) == SUCCESS) {
@@ -233,13 +286,13 @@ MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 			return FAILURE;
 		}
 
-		buff = new MxU8[size];
-		if (fread(buff, size, 1, wdbFile) != 1) {
+		data = ReadWorldDb(wdbFile, ftell(wdbFile), size, buff);
+		if (data == NULL) {
 			return FAILURE;
 		}
 
 		chunk.SetLength(size);
-		chunk.SetData(buff);
+		chunk.SetData(data);
 
 		LegoPartPresenter partPresenter;
 		if (partPresenter.Read(chunk) == SUCCESS) {
@@ -317,16 +370,16 @@ MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 MxResult LegoWorldPresenter::LoadWorldPart(ModelDbPart& p_part, FILE* p_wdbFile)
 {
 	MxResult result;
-	MxU8* buff = new MxU8[p_part.m_partDataLength];
+	MxU8* buff;
+	MxU8* data = ReadWorldDb(p_wdbFile, p_part.m_partDataOffset, p_part.m_partDataLength, buff);
 
-	fseek(p_wdbFile, p_part.m_partDataOffset, SEEK_SET);
-	if (fread(buff, p_part.m_partDataLength, 1, p_wdbFile) != 1) {
+	if (data == NULL) {
 		return FAILURE;
 	}
 
 	MxDSChunk chunk;
 	chunk.SetLength(p_part.m_partDataLength);
-	chunk.SetData(buff);
+	chunk.SetData(data);
 
 	LegoPartPresenter partPresenter;
 	result = partPresenter.Read(chunk);
@@ -342,16 +395,16 @@ MxResult LegoWorldPresenter::LoadWorldPart(ModelDbPart& p_part, FILE* p_wdbFile)
 // FUNCTION: LEGO1 0x100674b0
 MxResult LegoWorldPresenter::LoadWorldModel(ModelDbModel& p_model, FILE* p_wdbFile, LegoWorld* p_world)
 {
-	MxU8* buff = new MxU8[p_model.m_modelDataLength];
+	MxU8* buff;
+	MxU8* data = ReadWorldDb(p_wdbFile, p_model.m_modelDataOffset, p_model.m_modelDataLength, buff);
 
-	fseek(p_wdbFile, p_model.m_modelDataOffset, SEEK_SET);
-	if (fread(buff, p_model.m_modelDataLength, 1, p_wdbFile) != 1) {
+	if (data == NULL) {
 		return FAILURE;
 	}
 
 	MxDSChunk chunk;
 	chunk.SetLength(p_model.m_modelDataLength);
-	chunk.SetData(buff);
+	chunk.SetData(data);
 
 	MxDSAction action;
 	MxAtomId atom;
@@ -406,7 +459,7 @@ void LegoWorldPresenter::VTable0x60(MxPresenter* p_presenter)
 	MxDSAction* action = p_presenter->GetAction();
 
 	if (action->GetDuration() != -1 && (action->GetFlags() & MxDSAction::c_looping) == 0) {
-		if (!action->IsA("MxDSMediaAction")) {
+		if (!action->IsKindOf(MX_TYPEID(MxDSMediaAction))) {
 			return;
 		}
 
@@ -415,8 +468,8 @@ void LegoWorldPresenter::VTable0x60(MxPresenter* p_presenter)
 		}
 	}
 
-	if (!p_presenter->IsA("LegoAnimPresenter") && !p_presenter->IsA("MxControlPresenter") &&
-		!p_presenter->IsA("MxCompositePresenter")) {
+	if (!p_presenter->IsKindOf(MX_TYPEID(LegoAnimPresenter)) && !p_presenter->IsKindOf(MX_TYPEID(MxControlPresenter)) &&
+		!p_presenter->IsKindOf(MX_TYPEID(MxCompositePresenter))) {
 		p_presenter->SendToCompositePresenter(Lego());
 		((LegoWorld*) m_entity)->Add(p_presenter);
 	}
@@ -468,21 +468,20 @@ MxU32 LegoPathActor::VTable0x6c(
 	}
 
 	LegoPathActorSet& plpas = p_boundary->GetActors();
-	LegoPathActorSet lpas(plpas);
 
-	for (LegoPathActorSet::iterator itpa = lpas.begin(); itpa != lpas.end(); itpa++) {
-		if (plpas.find(*itpa) != plpas.end()) {
-			LegoPathActor* actor = *itpa;
+	// No snapshot of the set is needed: the loop is left as soon as HitActor has
+	// been called, so the set cannot change underneath the iterator.
+	for (LegoPathActorSet::iterator itpa = plpas.begin(); itpa != plpas.end(); itpa++) {
+		LegoPathActor* actor = *itpa;
 
-			if (this != actor && !(actor->GetActorState() & LegoPathActor::c_noCollide)) {
-				LegoROI* roi = actor->GetROI();
+		if (this != actor && !(actor->GetActorState() & LegoPathActor::c_noCollide)) {
+			LegoROI* roi = actor->GetROI();
 
-				if (roi != NULL && (roi->GetVisibility() || actor->GetCameraFlag())) {
-					if (roi->FUN_100a9410(p_v1, p_v2, p_f1, p_f2, p_v3, m_collideBox && actor->m_collideBox)) {
-						HitActor(actor, TRUE);
-						actor->HitActor(this, FALSE);
-						return 2;
-					}
+			if (roi != NULL && (roi->GetVisibility() || actor->GetCameraFlag())) {
+				if (roi->FUN_100a9410(p_v1, p_v2, p_f1, p_f2, p_v3, m_collideBox && actor->m_collideBox)) {
+					HitActor(actor, TRUE);
+					actor->HitActor(this, FALSE);
+					return 2;
 				}
 			}
 		}
@@ -560,8 +559,16 @@ MxS32 LegoPathActor::VTable0x68(Vector3& p_v1, Vector3& p_v2, Vector3& p_v3)
 	v2 /= len;
 
 	float radius = m_roi->GetWorldBoundingSphere().Radius();
-	list<LegoPathBoundary*> boundaries;
+	MxU32 result;
+
+	// The controller's boundary grid finds the boundaries near the segment, walking the neighbours
+	// of the current boundary is only needed for actors outside of it
+	if (m_pathController != NULL &&
+		m_pathController->Collide(this, p_v1, v2, len, radius, p_v3, result) == SUCCESS) {
+		return result;
+	}
 
+	list<LegoPathBoundary*> boundaries;
 	return FUN_1002edd0(boundaries, m_boundary, p_v1, v2, len, radius, p_v3, 0);
 }
 
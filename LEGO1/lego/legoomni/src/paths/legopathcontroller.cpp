@@ -5,8 +5,11 @@
 #include "mxmisc.h"
 #include "mxticklemanager.h"
 #include "mxtimer.h"
+#include "roi/legoroi.h"
 
-DECOMP_SIZE_ASSERT(LegoPathController, 0x40)
+#include <float.h>
+
+DECOMP_SIZE_ASSERT(LegoPathController, 0x33c)
 DECOMP_SIZE_ASSERT(LegoPathCtrlEdge, 0x40)
 DECOMP_SIZE_ASSERT(LegoPathController::CtrlBoundary, 0x08)
 DECOMP_SIZE_ASSERT(LegoPathController::CtrlEdge, 0x08)
@@ -65,6 +68,9 @@ LegoPathController::CtrlBoundary* LegoPathController::g_ctrlBoundariesB = NULL;
 // GLOBAL: LEGO1 0x100f435c
 LegoPathController::CtrlEdge* LegoPathController::g_ctrlEdgesB = NULL;
 
+// Smallest margin Collide searches around a segment, the reach of LegoExtraActor's test against the user's actor
+static const MxFloat g_minGridMargin = 1.0f;
+
 // FUNCTION: LEGO1 0x10044f40
 // FUNCTION: BETA10 0x100b6860
 LegoPathController::LegoPathController()
@@ -77,6 +83,24 @@ LegoPathController::LegoPathController()
 	m_numE = 0;
 	m_numN = 0;
 	m_numT = 0;
+	m_midpoints = NULL;
+	m_boundaryEdges = NULL;
+	m_boundaryEdgeStart = NULL;
+	m_pathNodes = NULL;
+	m_open = NULL;
+	m_numOpen = 0;
+	m_search = 0;
+	m_routeClock = 0;
+	m_routeGeneration = 0;
+	memset(m_routes, 0, sizeof(m_routes));
+	m_boundaryRects = NULL;
+	m_gridCellStart = NULL;
+	m_gridBoundaries = NULL;
+	m_gridStamps = NULL;
+	m_gridQuery = 0;
+	m_gridWidth = 0;
+	m_gridDepth = 0;
+	m_gridMargin = g_minGridMargin;
 }
 
 // FUNCTION: LEGO1 0x10045880
@@ -122,6 +146,8 @@ MxResult LegoPathController::Create(MxU8* p_data, const Vector3& p_location, con
 			}
 		}
 
+		CreatePathGraph();
+		CreateBoundaryGrid();
 		TickleManager()->RegisterClient(this, 10);
 	}
 
@@ -137,6 +163,8 @@ MxResult LegoPathController::Create(MxU8* p_data, const Vector3& p_location, con
 void LegoPathController::Destroy()
 {
 	TickleManager()->UnregisterClient(this);
+	DestroyPathGraph();
+	DestroyBoundaryGrid();
 
 	if (m_boundaries != NULL) {
 		delete[] m_boundaries;
@@ -233,6 +261,7 @@ MxResult LegoPathController::PlaceActor(
 
 	p_actor->SetController(this);
 	m_actors.insert(p_actor);
+	UpdateGridMargin(p_actor);
 	return SUCCESS;
 }
 
@@ -302,6 +331,7 @@ MxResult LegoPathController::PlaceActor(
 			if (p_actor->VTable0x84(boundary, time, p_position, p_direction, *edge, 0.5f) == SUCCESS) {
 				p_actor->SetController(this);
 				m_actors.insert(p_actor);
+				UpdateGridMargin(p_actor);
 				return SUCCESS;
 			}
 		}
@@ -402,6 +432,105 @@ LegoPathBoundary* LegoPathController::GetPathBoundary(const char* p_name)
 	return NULL;
 }
 
+MxResult LegoPathController::Collide(
+	LegoPathActor* p_actor,
+	Vector3& p_v1,
+	Vector3& p_v2,
+	float p_f1,
+	float p_f2,
+	Vector3& p_v3,
+	MxU32& p_result
+)
+{
+	LegoPathBoundary* boundary = p_actor->GetBoundary();
+
+	if (m_gridCellStart == NULL || boundary < m_boundaries || boundary >= m_boundaries + m_numL) {
+		return FAILURE;
+	}
+
+	UpdateGridMargin(p_actor);
+
+	MxU32 query = ++m_gridQuery;
+	m_gridStamps[boundary - m_boundaries] = query;
+
+	p_result = p_actor->VTable0x6c(boundary, p_v1, p_v2, p_f1, p_f2, p_v3);
+
+	if (p_result != 0) {
+		return SUCCESS;
+	}
+
+	float reach = p_f2 + m_gridMargin;
+	float endX = p_v1[0] + p_v2[0] * p_f1;
+	float endZ = p_v1[2] + p_v2[2] * p_f1;
+	float minX = (p_v1[0] < endX ? p_v1[0] : endX) - reach;
+	float maxX = (p_v1[0] < endX ? endX : p_v1[0]) + reach;
+	float minZ = (p_v1[2] < endZ ? p_v1[2] : endZ) - reach;
+	float maxZ = (p_v1[2] < endZ ? endZ : p_v1[2]) + reach;
+
+	MxS32 x0 = (MxS32) ((minX - m_gridMinX) / m_gridCellSize);
+	MxS32 x1 = (MxS32) ((maxX - m_gridMinX) / m_gridCellSize);
+	MxS32 z0 = (MxS32) ((minZ - m_gridMinZ) / m_gridCellSize);
+	MxS32 z1 = (MxS32) ((maxZ - m_gridMinZ) / m_gridCellSize);
+
+	if (x0 < 0) {
+		x0 = 0;
+	}
+	if (z0 < 0) {
+		z0 = 0;
+	}
+	if (x1 >= m_gridWidth) {
+		x1 = m_gridWidth - 1;
+	}
+	if (z1 >= m_gridDepth) {
+		z1 = m_gridDepth - 1;
+	}
+
+	for (MxS32 z = z0; z <= z1; z++) {
+		for (MxS32 x = x0; x <= x1; x++) {
+			MxU32 cell = z * m_gridWidth + x;
+
+			for (MxU32 i = m_gridCellStart[cell]; i < m_gridCellStart[cell + 1]; i++) {
+				MxU16 index = m_gridBoundaries[i];
+
+				// A boundary spanning several cells is tested once. Tests run from VTable0x6c may start
+				// a Collide of their own, which at worst makes this one test a boundary twice.
+				if (m_gridStamps[index] == query) {
+					continue;
+				}
+
+				m_gridStamps[index] = query;
+
+				const MxFloat* rect = &m_boundaryRects[index * 4];
+
+				if (rect[0] > maxX || rect[1] > maxZ || rect[2] < minX || rect[3] < minZ) {
+					continue;
+				}
+
+				p_result = p_actor->VTable0x6c(&m_boundaries[index], p_v1, p_v2, p_f1, p_f2, p_v3);
+
+				if (p_result != 0) {
+					return SUCCESS;
+				}
+			}
+		}
+	}
+
+	return SUCCESS;
+}
+
+void LegoPathController::UpdateGridMargin(LegoPathActor* p_actor)
+{
+	LegoROI* roi = p_actor->GetROI();
+
+	if (roi != NULL) {
+		float extent = roi->GetCollisionExtent();
+
+		if (extent > m_gridMargin) {
+			m_gridMargin = extent;
+		}
+	}
+}
+
 // FUNCTION: LEGO1 0x10046bb0
 // FUNCTION: BETA10 0x100b75bc
 void LegoPathController::FUN_10046bb0(LegoWorld* p_world)
@@ -509,10 +638,6 @@ MxResult LegoPathController::Read(LegoStorage* p_storage)
 		return FAILURE;
 	}
 
-	for (MxS32 j = 0; j < m_numE; j++) {
-		m_pfsE.insert(&m_edges[j]);
-	}
-
 	return SUCCESS;
 }
 
@@ -763,15 +888,6 @@ MxResult LegoPathController::FUN_10048310(
 		return SUCCESS;
 	}
 
-	list<LegoBEWithFloat> boundaryList;
-	list<LegoBEWithFloat>::iterator boundaryListIt;
-
-	LegoBEWithFloatSet boundarySet;
-	LegoBEWithFloatSet::iterator boundarySetItA;
-	LegoBEWithFloatSet::iterator boundarySetItB;
-
-	LegoPathCtrlEdgeSet pathCtrlEdgeSet(m_pfsE);
-
 	MxFloat local14 = 999999.0f;
 
 	p_grec->SetBit1(FALSE);
@@ -782,118 +898,40 @@ MxResult LegoPathController::FUN_10048310(
 		if (edge->GetMask0x03()) {
 			LegoPathBoundary* otherFace = (LegoPathBoundary*) edge->OtherFace(p_oldBoundary);
 
-			if (otherFace != NULL && edge->BETA_1004a830(*otherFace, p_mask)) {
-				if (p_newBoundary == otherFace) {
-					float dist;
-					if ((dist = edge->DistanceToMidpoint(p_oldPosition) + edge->DistanceToMidpoint(p_newPosition)) <
-						local14) {
-						local14 = dist;
-						p_grec->erase(p_grec->begin(), p_grec->end());
-						p_grec->SetBit1(TRUE);
-						p_grec->push_back(LegoBoundaryEdge(edge, p_oldBoundary));
-					}
-				}
-				else {
-					boundaryList.push_back(LegoBEWithFloat(edge, p_oldBoundary, edge->DistanceToMidpoint(p_oldPosition))
-					);
-					boundarySet.insert(&boundaryList.back());
+			if (otherFace != NULL && p_newBoundary == otherFace && edge->BETA_1004a830(*otherFace, p_mask)) {
+				float dist;
+				if ((dist = edge->DistanceToMidpoint(p_oldPosition) + edge->DistanceToMidpoint(p_newPosition)) <
+					local14) {
+					local14 = dist;
+					p_grec->erase(p_grec->begin(), p_grec->end());
+					p_grec->SetBit1(TRUE);
+					p_grec->push_back(LegoBoundaryEdge(edge, p_oldBoundary));
 				}
 			}
 		}
-
-		pathCtrlEdgeSet.erase(edge);
 	}
 
 	if (!p_grec->GetBit1()) {
-		while (pathCtrlEdgeSet.size() > 0) {
-			LegoBEWithFloat edgeWithFloat;
-			MxFloat local70 = 999999.0f;
+		MxFloat cost;
+		MxS32 last = LookupRoute(p_oldPosition, p_oldBoundary, p_newPosition, p_newBoundary, p_mask, cost);
 
-			boundarySetItA = boundarySetItB = boundarySet.begin();
+		if (last < 0) {
+			last = SearchPath(p_oldPosition, p_oldBoundary, p_newPosition, p_newBoundary, p_mask, cost);
 
-			if (boundarySetItB != boundarySet.end()) {
-				boundarySetItB++;
+			if (last >= 0) {
+				StoreRoute(p_oldPosition, p_oldBoundary, p_newPosition, p_newBoundary, p_mask, last);
 			}
+		}
 
-			while (boundarySetItA != boundarySet.end()) {
-				MxU32 shouldRemove = TRUE;
-
-				LegoUnknown100db7f4* e = (*boundarySetItA)->m_edge;
-				LegoPathBoundary* b = (*boundarySetItA)->m_boundary;
-				assert(e && b);
-
-				LegoPathBoundary* bOther = (LegoPathBoundary*) e->OtherFace(b);
-				assert(bOther);
-
-				if (!e->BETA_1004a830(*bOther, p_mask)) {
-					// This branch is empty, but present in the BETA - probably had comments only
-				}
-				else {
-					if (bOther == p_newBoundary) {
-						shouldRemove = FALSE;
-
-						LegoBEWithFloat* pfs = *boundarySetItA;
-						assert(pfs);
-
-						float dist;
-						if ((dist = pfs->m_edge->DistanceToMidpoint(p_newPosition) + pfs->m_unk0x0c) < local70) {
-							edgeWithFloat.m_edge = NULL;
-							local70 = dist;
-
-							// TODO: Match
-							if (dist < local14) {
-								local14 = dist;
-								p_grec->erase(p_grec->begin(), p_grec->end());
-								p_grec->SetBit1(TRUE);
-
-								do {
-									p_grec->push_front(LegoBoundaryEdge(pfs->m_edge, pfs->m_boundary));
-									pfs = pfs->m_next;
-								} while (pfs != NULL);
-							}
-						}
-					}
-					else {
-						for (MxS32 i = 0; i < bOther->GetNumEdges(); i++) {
-							LegoPathCtrlEdge* edge = (LegoPathCtrlEdge*) bOther->GetEdges()[i];
-
-							if (edge->GetMask0x03()) {
-								if (pathCtrlEdgeSet.find(edge) != pathCtrlEdgeSet.end()) {
-									shouldRemove = FALSE;
-
-									float dist;
-									if ((dist = edge->DistanceBetweenMidpoints(*e) + (*boundarySetItA)->m_unk0x0c) <
-										local70) {
-										local70 = dist;
-										edgeWithFloat = LegoBEWithFloat(edge, bOther, *boundarySetItA, dist);
-									}
-								}
-							}
-						}
-					}
-				}
-
-				if (shouldRemove) {
-					boundarySet.erase(boundarySetItA);
-				}
-
-				if (boundarySetItB != boundarySet.end()) {
-					boundarySetItA = boundarySetItB;
-					boundarySetItB++;
-				}
-				else {
-					break;
-				}
-			}
+		if (last >= 0) {
+			local14 = cost;
+			p_grec->erase(p_grec->begin(), p_grec->end());
+			p_grec->SetBit1(TRUE);
 
-			if (edgeWithFloat.m_edge != NULL) {
-				pathCtrlEdgeSet.erase(edgeWithFloat.m_edge);
-				boundaryList.push_back(edgeWithFloat);
-				boundarySet.insert(&boundaryList.back());
-			}
-			else {
-				break;
-			}
+			do {
+				p_grec->push_front(LegoBoundaryEdge(&m_edges[last], m_pathNodes[last].m_from));
+				last = m_pathNodes[last].m_prev;
+			} while (last >= 0);
 		}
 	}
 
@@ -928,6 +966,525 @@ MxResult LegoPathController::FUN_10048310(
 	return FAILURE;
 }
 
+void LegoPathController::CreatePathGraph()
+{
+	MxS32 i, j, k;
+	MxU32 maxOpen = m_numE;
+
+	DestroyPathGraph();
+
+	if (m_numE == 0 || m_numL == 0) {
+		return;
+	}
+
+	m_midpoints = new MxFloat[m_numE * 3];
+
+	for (i = 0; i < m_numE; i++) {
+		Vector3& a = *m_edges[i].GetPointA();
+		Vector3& b = *m_edges[i].GetPointB();
+
+		for (k = 0; k < 3; k++) {
+			m_midpoints[i * 3 + k] = (a[k] + b[k]) * 0.5f;
+		}
+	}
+
+	m_boundaryEdgeStart = new MxU16[m_numL + 1];
+	m_boundaryEdgeStart[0] = 0;
+
+	for (i = 0; i < m_numL; i++) {
+		MxU16 numEdges = 0;
+
+		for (j = 0; j < m_boundaries[i].GetNumEdges(); j++) {
+			if (m_boundaries[i].GetEdges()[j]->GetMask0x03()) {
+				numEdges++;
+			}
+		}
+
+		m_boundaryEdgeStart[i + 1] = m_boundaryEdgeStart[i] + numEdges;
+
+		// Every edge is expanded at most once, into a boundary it belongs to, and then
+		// adds at most one open entry per passable edge of that boundary.
+		maxOpen += numEdges * numEdges;
+	}
+
+	m_boundaryEdges = new MxU16[m_boundaryEdgeStart[m_numL] > 0 ? m_boundaryEdgeStart[m_numL] : 1];
+
+	for (i = 0, k = 0; i < m_numL; i++) {
+		for (j = 0; j < m_boundaries[i].GetNumEdges(); j++) {
+			LegoPathCtrlEdge* edge = (LegoPathCtrlEdge*) m_boundaries[i].GetEdges()[j];
+
+			if (edge->GetMask0x03()) {
+				m_boundaryEdges[k++] = edge - m_edges;
+			}
+		}
+	}
+
+	m_pathNodes = new PathNode[m_numE];
+	memset(m_pathNodes, 0, m_numE * sizeof(*m_pathNodes));
+
+	m_open = new PathOpenEntry[maxOpen];
+	m_numOpen = 0;
+	m_search = 0;
+}
+
+void LegoPathController::DestroyPathGraph()
+{
+	delete[] m_midpoints;
+	m_midpoints = NULL;
+
+	delete[] m_boundaryEdges;
+	m_boundaryEdges = NULL;
+
+	delete[] m_boundaryEdgeStart;
+	m_boundaryEdgeStart = NULL;
+
+	delete[] m_pathNodes;
+	m_pathNodes = NULL;
+
+	delete[] m_open;
+	m_open = NULL;
+	m_numOpen = 0;
+
+	FlushRoutes();
+}
+
+void LegoPathController::CreateBoundaryGrid()
+{
+	MxS32 i, x, z;
+
+	DestroyBoundaryGrid();
+
+	if (m_numL == 0) {
+		return;
+	}
+
+	// An actor is always inside the polygon of its boundary, so the rectangle around the polygon's
+	// points bounds where the actors of a boundary can be
+	m_boundaryRects = new MxFloat[m_numL * 4];
+
+	for (i = 0; i < m_numL; i++) {
+		LegoPathBoundary& boundary = m_boundaries[i];
+		MxFloat* rect = &m_boundaryRects[i * 4];
+
+		rect[0] = rect[1] = FLT_MAX;
+		rect[2] = rect[3] = -FLT_MAX;
+
+		for (MxS32 j = 0; j < boundary.GetNumEdges(); j++) {
+			LegoEdge* edge = boundary.GetEdges()[j];
+			Vector3* points[2] = {edge->GetPointA(), edge->GetPointB()};
+
+			for (MxS32 k = 0; k < 2; k++) {
+				Vector3& point = *points[k];
+
+				if (point[0] < rect[0]) {
+					rect[0] = point[0];
+				}
+				if (point[2] < rect[1]) {
+					rect[1] = point[2];
+				}
+				if (point[0] > rect[2]) {
+					rect[2] = point[0];
+				}
+				if (point[2] > rect[3]) {
+					rect[3] = point[2];
+				}
+			}
+		}
+	}
+
+	MxFloat minX = FLT_MAX, minZ = FLT_MAX, maxX = -FLT_MAX, maxZ = -FLT_MAX;
+
+	for (i = 0; i < m_numL; i++) {
+		const MxFloat* rect = &m_boundaryRects[i * 4];
+
+		if (rect[0] < minX) {
+			minX = rect[0];
+		}
+		if (rect[1] < minZ) {
+			minZ = rect[1];
+		}
+		if (rect[2] > maxX) {
+			maxX = rect[2];
+		}
+		if (rect[3] > maxZ) {
+			maxZ = rect[3];
+		}
+	}
+
+	if (minX > maxX || minZ > maxZ) {
+		DestroyBoundaryGrid();
+		return;
+	}
+
+	// Roughly one cell per boundary
+	MxFloat width = maxX - minX;
+	MxFloat depth = maxZ - minZ;
+	MxFloat cellSize = sqrt(width * depth / m_numL);
+	MxFloat largest = width > depth ? width : depth;
+
+	if (cellSize * c_maxGridSize < largest) {
+		cellSize = largest / c_maxGridSize;
+	}
+	if (cellSize < 1.0f) {
+		cellSize = 1.0f;
+	}
+
+	m_gridMinX = minX;
+	m_gridMinZ = minZ;
+	m_gridCellSize = cellSize;
+	m_gridWidth = (MxU16) (width / cellSize) + 1;
+	m_gridDepth = (MxU16) (depth / cellSize) + 1;
+
+	MxU32 numCells = m_gridWidth * m_gridDepth;
+	m_gridCellStart = new MxU32[numCells + 1];
+	memset(m_gridCellStart, 0, (numCells + 1) * sizeof(*m_gridCellStart));
+
+	// Count the boundaries of every cell, then turn the counts into start offsets and fill the cells
+	for (MxS32 pass = 0; pass < 2; pass++) {
+		for (i = 0; i < m_numL; i++) {
+			const MxFloat* rect = &m_boundaryRects[i * 4];
+			MxS32 x0 = (MxS32) ((rect[0] - minX) / cellSize);
+			MxS32 z0 = (MxS32) ((rect[1] - minZ) / cellSize);
+			MxS32 x1 = (MxS32) ((rect[2] - minX) / cellSize);
+			MxS32 z1 = (MxS32) ((rect[3] - minZ) / cellSize);
+
+			for (z = z0; z <= z1 && z < m_gridDepth; z++) {
+				for (x = x0; x <= x1 && x < m_gridWidth; x++) {
+					if (pass == 0) {
+						m_gridCellStart[z * m_gridWidth + x + 1]++;
+					}
+					else {
+						m_gridBoundaries[m_gridCellStart[z * m_gridWidth + x]++] = i;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (MxU32 cell = 0; cell < numCells; cell++) {
+				m_gridCellStart[cell + 1] += m_gridCellStart[cell];
+			}
+
+			m_gridBoundaries = new MxU16[m_gridCellStart[numCells] > 0 ? m_gridCellStart[numCells] : 1];
+		}
+	}
+
+	// Filling advanced every start to the start of the next cell
+	for (MxU32 cell = numCells; cell > 0; cell--) {
+		m_gridCellStart[cell] = m_gridCellStart[cell - 1];
+	}
+	m_gridCellStart[0] = 0;
+
+	m_gridStamps = new MxU32[m_numL];
+	memset(m_gridStamps, 0, m_numL * sizeof(*m_gridStamps));
+	m_gridQuery = 0;
+}
+
+void LegoPathController::DestroyBoundaryGrid()
+{
+	delete[] m_boundaryRects;
+	m_boundaryRects = NULL;
+
+	delete[] m_gridCellStart;
+	m_gridCellStart = NULL;
+
+	delete[] m_gridBoundaries;
+	m_gridBoundaries = NULL;
+
+	delete[] m_gridStamps;
+	m_gridStamps = NULL;
+
+	m_gridWidth = 0;
+	m_gridDepth = 0;
+}
+
+MxS32 LegoPathController::SearchPath(
+	const Vector3& p_oldPosition,
+	LegoPathBoundary* p_oldBoundary,
+	const Vector3& p_newPosition,
+	LegoPathBoundary* p_newBoundary,
+	LegoU8 p_mask,
+	MxFloat& p_cost
+)
+{
+	if (m_pathNodes == NULL || p_oldBoundary < m_boundaries || p_oldBoundary >= m_boundaries + m_numL) {
+		return -1;
+	}
+
+	MxS32 i, boundary = p_oldBoundary - m_boundaries;
+
+	m_search++;
+	m_numOpen = 0;
+
+	// The edges of the start boundary are reached directly from the start position and
+	// are never entered again from elsewhere.
+	for (i = m_boundaryEdgeStart[boundary]; i < m_boundaryEdgeStart[boundary + 1]; i++) {
+		MxS32 e = m_boundaryEdges[i];
+		PathNode& node = m_pathNodes[e];
+		LegoPathBoundary* otherFace = (LegoPathBoundary*) m_edges[e].OtherFace(p_oldBoundary);
+
+		node.m_cost = MidpointDistance(e, p_oldPosition);
+		node.m_from = p_oldBoundary;
+		node.m_prev = -1;
+		node.m_search = m_search;
+		node.m_closed = TRUE;
+
+		if (otherFace != NULL && otherFace != p_newBoundary && m_edges[e].BETA_1004a830(*otherFace, p_mask)) {
+			PushOpen(node.m_cost + MidpointDistance(e, p_newPosition), node.m_cost, e);
+		}
+	}
+
+	while (m_numOpen > 0) {
+		PathOpenEntry entry;
+		PopOpen(entry);
+
+		if (entry.m_node >= m_numE) {
+			p_cost = entry.m_cost;
+			return entry.m_node - m_numE;
+		}
+
+		PathNode& node = m_pathNodes[entry.m_node];
+
+		if (entry.m_cost > node.m_cost) {
+			continue;
+		}
+
+		node.m_closed = TRUE;
+
+		LegoPathCtrlEdge& edge = m_edges[entry.m_node];
+		LegoPathBoundary* otherFace = (LegoPathBoundary*) edge.OtherFace(node.m_from);
+
+		if (otherFace == NULL || !edge.BETA_1004a830(*otherFace, p_mask)) {
+			continue;
+		}
+
+		if (otherFace == p_newBoundary) {
+			MxFloat cost = node.m_cost + MidpointDistance(entry.m_node, p_newPosition);
+			PushOpen(cost, cost, m_numE + entry.m_node);
+			continue;
+		}
+
+		boundary = otherFace - m_boundaries;
+
+		for (i = m_boundaryEdgeStart[boundary]; i < m_boundaryEdgeStart[boundary + 1]; i++) {
+			MxS32 e = m_boundaryEdges[i];
+			PathNode& next = m_pathNodes[e];
+			MxFloat cost = node.m_cost + MidpointDistance(entry.m_node, e);
+
+			if (next.m_search != m_search) {
+				next.m_search = m_search;
+				next.m_closed = FALSE;
+			}
+			else if (next.m_closed || cost >= next.m_cost) {
+				continue;
+			}
+
+			next.m_cost = cost;
+			next.m_from = otherFace;
+			next.m_prev = entry.m_node;
+			PushOpen(cost + MidpointDistance(e, p_newPosition), cost, e);
+		}
+	}
+
+	return -1;
+}
+
+MxS32 LegoPathController::LookupRoute(
+	const Vector3& p_oldPosition,
+	LegoPathBoundary* p_oldBoundary,
+	const Vector3& p_newPosition,
+	LegoPathBoundary* p_newBoundary,
+	LegoU8 p_mask,
+	MxFloat& p_cost
+)
+{
+	PathRoute* route = NULL;
+	MxS32 i;
+
+	// A boundary was enabled or disabled since the routes were searched, so a shorter one may be open now
+	if (m_routeGeneration != LegoWEGEdge::GetFlagGeneration()) {
+		FlushRoutes();
+		m_routeGeneration = LegoWEGEdge::GetFlagGeneration();
+		return -1;
+	}
+
+	// Other positions in the same boundaries can have a shorter route, so only an identical query is a hit
+	for (i = 0; i < c_numCachedRoutes; i++) {
+		PathRoute& cached = m_routes[i];
+
+		if (cached.m_start == p_oldBoundary && cached.m_goal == p_newBoundary && cached.m_mask == p_mask &&
+			cached.m_startPosition[0] == p_oldPosition[0] && cached.m_startPosition[1] == p_oldPosition[1] &&
+			cached.m_startPosition[2] == p_oldPosition[2] && cached.m_goalPosition[0] == p_newPosition[0] &&
+			cached.m_goalPosition[1] == p_newPosition[1] && cached.m_goalPosition[2] == p_newPosition[2]) {
+			route = &cached;
+			break;
+		}
+	}
+
+	if (route == NULL) {
+		return -1;
+	}
+
+	LegoPathBoundary* from = p_oldBoundary;
+	MxS32 prev = -1;
+	MxFloat cost = 0.0f;
+
+	m_search++;
+
+	for (i = 0; i < route->m_numEdges; i++) {
+		MxS32 e = route->m_edges[i];
+		LegoPathCtrlEdge& edge = m_edges[e];
+		LegoPathBoundary* otherFace = (LegoPathBoundary*) edge.OtherFace(from);
+
+		// The flag generation only covers boundaries, so the edges are still checked before the route is used
+		if (otherFace == NULL || !edge.BETA_1004a830(*otherFace, p_mask)) {
+			delete[] route->m_edges;
+			memset(route, 0, sizeof(*route));
+			return -1;
+		}
+
+		cost += prev < 0 ? MidpointDistance(e, p_oldPosition) : MidpointDistance(prev, e);
+
+		PathNode& node = m_pathNodes[e];
+		node.m_cost = cost;
+		node.m_from = from;
+		node.m_prev = prev;
+		node.m_search = m_search;
+		node.m_closed = TRUE;
+
+		from = otherFace;
+		prev = e;
+	}
+
+	p_cost = cost + MidpointDistance(prev, p_newPosition);
+	route->m_lastUse = ++m_routeClock;
+	return prev;
+}
+
+void LegoPathController::StoreRoute(
+	const Vector3& p_oldPosition,
+	LegoPathBoundary* p_oldBoundary,
+	const Vector3& p_newPosition,
+	LegoPathBoundary* p_newBoundary,
+	LegoU8 p_mask,
+	MxS32 p_last
+)
+{
+	PathRoute* route = &m_routes[0];
+	MxS32 i, numEdges = 0;
+
+	for (i = 0; i < c_numCachedRoutes; i++) {
+		if (m_routes[i].m_start == NULL) {
+			route = &m_routes[i];
+			break;
+		}
+
+		if (m_routes[i].m_lastUse < route->m_lastUse) {
+			route = &m_routes[i];
+		}
+	}
+
+	for (i = p_last; i >= 0; i = m_pathNodes[i].m_prev) {
+		numEdges++;
+	}
+
+	delete[] route->m_edges;
+
+	route->m_start = p_oldBoundary;
+	route->m_goal = p_newBoundary;
+
+	for (i = 0; i < 3; i++) {
+		route->m_startPosition[i] = p_oldPosition[i];
+		route->m_goalPosition[i] = p_newPosition[i];
+	}
+
+	route->m_mask = p_mask;
+	route->m_lastUse = ++m_routeClock;
+	route->m_edges = new MxU16[numEdges];
+	route->m_numEdges = numEdges;
+
+	for (i = p_last; i >= 0; i = m_pathNodes[i].m_prev) {
+		route->m_edges[--numEdges] = i;
+	}
+}
+
+void LegoPathController::FlushRoutes()
+{
+	for (MxS32 i = 0; i < c_numCachedRoutes; i++) {
+		delete[] m_routes[i].m_edges;
+	}
+
+	memset(m_routes, 0, sizeof(m_routes));
+}
+
+MxFloat LegoPathController::MidpointDistance(MxS32 p_edge, const Vector3& p_position)
+{
+	const MxFloat* mid = &m_midpoints[p_edge * 3];
+	MxFloat x = mid[0] - p_position[0];
+	MxFloat y = mid[1] - p_position[1];
+	MxFloat z = mid[2] - p_position[2];
+	return sqrt(x * x + y * y + z * z);
+}
+
+MxFloat LegoPathController::MidpointDistance(MxS32 p_a, MxS32 p_b)
+{
+	const MxFloat* a = &m_midpoints[p_a * 3];
+	const MxFloat* b = &m_midpoints[p_b * 3];
+	MxFloat x = a[0] - b[0];
+	MxFloat y = a[1] - b[1];
+	MxFloat z = a[2] - b[2];
+	return sqrt(x * x + y * y + z * z);
+}
+
+void LegoPathController::PushOpen(MxFloat p_estimate, MxFloat p_cost, MxS32 p_node)
+{
+	MxU32 i = m_numOpen++;
+
+	while (i > 0) {
+		MxU32 parent = (i - 1) / 2;
+
+		if (m_open[parent].m_estimate <= p_estimate) {
+			break;
+		}
+
+		m_open[i] = m_open[parent];
+		i = parent;
+	}
+
+	m_open[i].m_estimate = p_estimate;
+	m_open[i].m_cost = p_cost;
+	m_open[i].m_node = p_node;
+}
+
+void LegoPathController::PopOpen(PathOpenEntry& p_entry)
+{
+	p_entry = m_open[0];
+
+	PathOpenEntry last = m_open[--m_numOpen];
+	MxU32 i = 0;
+
+	while (TRUE) {
+		MxU32 child = i * 2 + 1;
+
+		if (child >= m_numOpen) {
+			break;
+		}
+
+		if (child + 1 < m_numOpen && m_open[child + 1].m_estimate < m_open[child].m_estimate) {
+			child++;
+		}
+
+		if (last.m_estimate <= m_open[child].m_estimate) {
+			break;
+		}
+
+		m_open[i] = m_open[child];
+		i = child;
+	}
+
+	m_open[i] = last;
+}
+
 // FUNCTION: LEGO1 0x1004a240
 // FUNCTION: BETA10 0x100b9160
 MxS32 LegoPathController::FUN_1004a240(
@@ -436,65 +436,49 @@ inline MxU32 LegoCarRaceActor::VTable0x6c(
 	}
 
 	LegoPathActorSet& plpas = p_boundary->GetActors();
-	LegoPathActorSet lpas(plpas);
-
-	for (LegoPathActorSet::iterator itpa = lpas.begin(); itpa != lpas.end(); itpa++) {
-		if (plpas.end() != plpas.find(*itpa)) {
-			LegoPathActor* actor = *itpa;
-
-			if (actor != this) {
-				LegoROI* roi = actor->GetROI();
-
-				if (roi != NULL && (roi->GetVisibility() || actor->GetCameraFlag())) {
-					if (strncmp(roi->GetName(), str_rcdor, 5) == 0) {
-						const CompoundObject* co = roi->GetComp(); // name verified by BETA10 0x100cf8ba
-
-						if (co) {
-							assert(co->size() == 2);
-
-							LegoROI* firstROI = (LegoROI*) co->front();
-
-							if (firstROI->FUN_100a9410(
-									p_v1,
-									p_v2,
-									p_f1,
-									p_f2,
-									p_v3,
-									m_collideBox && actor->GetCollideBox()
-								)) {
-								HitActor(actor, TRUE);
-
-								if (actor->HitActor(this, FALSE) < 0) {
-									return 0;
-								}
-								else {
-									return 2;
-								}
-							}
+	for (LegoPathActorSet::iterator itpa = plpas.begin(); itpa != plpas.end(); itpa++) {
+		LegoPathActor* actor = *itpa;
+
+		if (actor != this) {
+			LegoROI* roi = actor->GetROI();
+
+			if (roi != NULL && (roi->GetVisibility() || actor->GetCameraFlag())) {
+				if (strncmp(roi->GetName(), str_rcdor, 5) == 0) {
+					const CompoundObject* co = roi->GetComp(); // name verified by BETA10 0x100cf8ba
+
+					if (co) {
+						assert(co->size() == 2);
+
+						LegoROI* firstROI = (LegoROI*) co->front();
 
-							LegoROI* lastROI = (LegoROI*) co->back();
-
-							if (lastROI->FUN_100a9410(
-									p_v1,
-									p_v2,
-									p_f1,
-									p_f2,
-									p_v3,
-									m_collideBox && actor->GetCollideBox()
-								)) {
-								HitActor(actor, TRUE);
-
-								if (actor->HitActor(this, FALSE) < 0) {
-									return 0;
-								}
-								else {
-									return 2;
-								}
+						if (firstROI->FUN_100a9410(
+								p_v1,
+								p_v2,
+								p_f1,
+								p_f2,
+								p_v3,
+								m_collideBox && actor->GetCollideBox()
+							)) {
+							HitActor(actor, TRUE);
+
+							if (actor->HitActor(this, FALSE) < 0) {
+								return 0;
+							}
+							else {
+								return 2;
 							}
 						}
-					}
-					else {
-						if (roi->FUN_100a9410(p_v1, p_v2, p_f1, p_f2, p_v3, m_collideBox && actor->GetCollideBox())) {
+
+						LegoROI* lastROI = (LegoROI*) co->back();
+
+						if (lastROI->FUN_100a9410(
+								p_v1,
+								p_v2,
+								p_f1,
+								p_f2,
+								p_v3,
+								m_collideBox && actor->GetCollideBox()
+							)) {
 							HitActor(actor, TRUE);
 
 							if (actor->HitActor(this, FALSE) < 0) {
@@ -506,6 +490,18 @@ inline MxU32 LegoCarRaceActor::VTable0x6c(
 						}
 					}
 				}
+				else {
+					if (roi->FUN_100a9410(p_v1, p_v2, p_f1, p_f2, p_v3, m_collideBox && actor->GetCollideBox())) {
+						HitActor(actor, TRUE);
+
+						if (actor->HitActor(this, FALSE) < 0) {
+							return 0;
+						}
+						else {
+							return 2;
+						}
+					}
+				}
 			}
 		}
 	}
@@ -532,25 +528,21 @@ inline MxU32 LegoJetskiRaceActor::VTable0x6c(
 	}
 
 	LegoPathActorSet& plpas = p_boundary->GetActors();
-	LegoPathActorSet lpas(plpas);
+	for (LegoPathActorSet::iterator itpa = plpas.begin(); itpa != plpas.end(); itpa++) {
+		LegoPathActor* actor = *itpa;
 
-	for (LegoPathActorSet::iterator itpa = lpas.begin(); itpa != lpas.end(); itpa++) {
-		if (plpas.find(*itpa) != plpas.end()) {
-			LegoPathActor* actor = *itpa;
+		if (this != actor) {
+			LegoROI* roi = actor->GetROI();
 
-			if (this != actor) {
-				LegoROI* roi = actor->GetROI();
+			if (roi != NULL && (roi->GetVisibility() || actor->GetCameraFlag())) {
+				if (roi->FUN_100a9410(p_v1, p_v2, p_f1, p_f2, p_v3, m_collideBox && actor->GetCollideBox())) {
+					HitActor(actor, TRUE);
 
-				if (roi != NULL && (roi->GetVisibility() || actor->GetCameraFlag())) {
-					if (roi->FUN_100a9410(p_v1, p_v2, p_f1, p_f2, p_v3, m_collideBox && actor->GetCollideBox())) {
-						HitActor(actor, TRUE);
-
-						if (actor->HitActor(this, FALSE) < 0) {
-							return 0;
-						}
-						else {
-							return 2;
-						}
+					if (actor->HitActor(this, FALSE) < 0) {
+						return 0;
+					}
+					else {
+						return 2;
 					}
 				}
 			}
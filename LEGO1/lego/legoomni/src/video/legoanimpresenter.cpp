@@ -1057,7 +1057,7 @@ void LegoAnimPresenter::VTable0xa0(Matrix4& p_matrix)
 MxResult LegoAnimPresenter::StartAction(MxStreamController* p_controller, MxDSAction* p_action)
 {
 	MxResult result = MxVideoPresenter::StartAction(p_controller, p_action);
-	m_displayZ = 0;
+	SetDisplayZ(0);
 	return result;
 }
 
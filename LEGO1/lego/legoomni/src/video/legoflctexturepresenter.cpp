@@ -4,7 +4,7 @@
 #include "misc/legocontainer.h"
 #include "mxdsaction.h"
 
-DECOMP_SIZE_ASSERT(LegoFlcTexturePresenter, 0x70)
+DECOMP_SIZE_ASSERT(LegoFlcTexturePresenter, 0xb0)
 
 // FUNCTION: LEGO1 0x1005de80
 LegoFlcTexturePresenter::LegoFlcTexturePresenter()
@@ -43,11 +43,11 @@ void LegoFlcTexturePresenter::LoadFrame(MxStreamChunk* p_chunk)
 {
 	MxU8* data = p_chunk->GetData();
 
-	m_rectCount = *(MxS32*) data;
+	MxS32 rectCount = *(MxS32*) data;
 	data += sizeof(MxS32);
 
 	MxRect32* rects = (MxRect32*) data;
-	data += m_rectCount * sizeof(MxRect32);
+	data += rectCount * sizeof(MxRect32);
 
 	MxBool decodedColorMap;
 	DecodeFLCFrame(
@@ -57,6 +57,19 @@ void LegoFlcTexturePresenter::LoadFrame(MxStreamChunk* p_chunk)
 		(FLIC_FRAME*) data,
 		&decodedColorMap
 	);
+
+	// Frames may be loaded more than once before the next PutFrame, so the regions accumulate until then
+	MxS32 height = m_frameBitmap->GetBmiHeightAbs();
+
+	for (MxS32 i = 0; i < rectCount; i++) {
+		MxRect32 rect(rects[i]);
+
+		if (!m_frameBitmap->IsTopDown()) {
+			rect = MxRect32(rect.GetLeft(), height - 1 - rect.GetBottom(), rect.GetRight(), height - 1 - rect.GetTop());
+		}
+
+		LegoTextureInfo::AddDirtyRect(m_rects, m_rectCount, sizeOfArray(m_rects), rect);
+	}
 }
 
 // FUNCTION: LEGO1 0x1005e100
@@ -64,7 +77,7 @@ void LegoFlcTexturePresenter::LoadFrame(MxStreamChunk* p_chunk)
 void LegoFlcTexturePresenter::PutFrame()
 {
 	if (m_texture != NULL && m_rectCount != 0) {
-		m_texture->FUN_10066010(m_frameBitmap->GetImage());
+		m_texture->LoadBits(m_frameBitmap->GetImage(), m_rects, m_rectCount);
 		m_rectCount = 0;
 	}
 }
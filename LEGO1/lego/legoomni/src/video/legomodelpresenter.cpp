@@ -131,7 +131,7 @@ MxResult LegoModelPresenter::CreateROI(MxDSChunk* p_chunk)
 
 		if (!skipTextures) {
 			if (TextureContainer()->Get(textureName) == NULL) {
-				textureInfo = LegoTextureInfo::Create(textureName, texture);
+				textureInfo = TextureContainer()->Create(textureName, texture);
 
 				if (textureInfo == NULL) {
 					goto done;
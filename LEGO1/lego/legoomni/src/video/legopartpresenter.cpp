@@ -124,7 +124,7 @@ MxResult LegoPartPresenter::Read(MxDSChunk& p_chunk)
 		}
 
 		if (TextureContainer()->Get(textureName) == NULL) {
-			textureInfo = LegoTextureInfo::Create(textureName, texture);
+			textureInfo = TextureContainer()->Create(textureName, texture);
 
 			if (textureInfo == NULL) {
 				goto done;
@@ -7,7 +7,7 @@
 #include "mxcompositepresenter.h"
 #include "mxdsaction.h"
 
-DECOMP_SIZE_ASSERT(LegoPhonemePresenter, 0x88)
+DECOMP_SIZE_ASSERT(LegoPhonemePresenter, 0xc8)
 
 // FUNCTION: LEGO1 0x1004e180
 LegoPhonemePresenter::LegoPhonemePresenter()
@@ -93,11 +93,11 @@ void LegoPhonemePresenter::LoadFrame(MxStreamChunk* p_chunk)
 {
 	MxU8* data = p_chunk->GetData();
 
-	m_rectCount = *(MxS32*) data;
+	MxS32 rectCount = *(MxS32*) data;
 	data += sizeof(MxS32);
 
 	MxRect32* rects = (MxRect32*) data;
-	data += m_rectCount * sizeof(MxRect32);
+	data += rectCount * sizeof(MxRect32);
 
 	MxBool decodedColorMap;
 	DecodeFLCFrame(
@@ -107,6 +107,19 @@ void LegoPhonemePresenter::LoadFrame(MxStreamChunk* p_chunk)
 		(FLIC_FRAME*) data,
 		&decodedColorMap
 	);
+
+	// Frames may be loaded more than once before the next PutFrame, so the regions accumulate until then
+	MxS32 height = m_frameBitmap->GetBmiHeightAbs();
+
+	for (MxS32 i = 0; i < rectCount; i++) {
+		MxRect32 rect(rects[i]);
+
+		if (!m_frameBitmap->IsTopDown()) {
+			rect = MxRect32(rect.GetLeft(), height - 1 - rect.GetBottom(), rect.GetRight(), height - 1 - rect.GetTop());
+		}
+
+		LegoTextureInfo::AddDirtyRect(m_rects, m_rectCount, sizeOfArray(m_rects), rect);
+	}
 }
 
 // FUNCTION: LEGO1 0x1004e840
@@ -114,7 +127,7 @@ void LegoPhonemePresenter::LoadFrame(MxStreamChunk* p_chunk)
 void LegoPhonemePresenter::PutFrame()
 {
 	if (m_textureInfo != NULL && m_rectCount != 0) {
-		m_textureInfo->FUN_10066010(m_frameBitmap->GetImage());
+		m_textureInfo->LoadBits(m_frameBitmap->GetImage(), m_rects, m_rectCount);
 		m_rectCount = 0;
 	}
 }
@@ -97,7 +97,7 @@ MxResult LegoTexturePresenter::Store()
 		LegoTextureInfo* textureInfo = TextureContainer()->Get(namedTexture->GetName()->GetData());
 
 		if (textureInfo == NULL) {
-			textureInfo = LegoTextureInfo::Create(namedTexture->GetName()->GetData(), texture);
+			textureInfo = TextureContainer()->Create(namedTexture->GetName()->GetData(), texture);
 
 			if (textureInfo != NULL) {
 				TextureContainer()->Add(namedTexture->GetName()->GetData(), textureInfo);
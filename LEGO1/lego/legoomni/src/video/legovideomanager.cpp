@@ -21,7 +21,7 @@
 
 #include <stdio.h>
 
-DECOMP_SIZE_ASSERT(LegoVideoManager, 0x590)
+DECOMP_SIZE_ASSERT(LegoVideoManager, 0x594)
 DECOMP_SIZE_ASSERT(MxStopWatch, 0x18)
 DECOMP_SIZE_ASSERT(MxFrequencyMeter, 0x20)
 
@@ -51,6 +51,7 @@ LegoVideoManager::LegoVideoManager()
 	m_unk0xe5 = FALSE;
 	m_unk0x554 = FALSE;
 	m_paused = FALSE;
+	m_partialRedraw = FALSE;
 }
 
 // FUNCTION: LEGO1 0x1007ab40
@@ -189,6 +190,11 @@ MxResult LegoVideoManager::Create(MxVideoParam& p_videoParam, MxU32 p_frequencyM
 		goto done;
 	}
 
+	// Headless, ViewManager::Update still runs every frame but the scene is never rasterized
+	if (MxOmni::IsHeadless()) {
+		m_3dManager->GetLego3DView()->SetStopRendering(TRUE);
+	}
+
 	ViewLODList* pLODList;
 
 	if (ConfigureD3DRM() != SUCCESS) {
@@ -298,6 +304,12 @@ MxResult LegoVideoManager::Tickle()
 	m_stopWatch->Reset();
 	m_stopWatch->Start();
 
+	// Lost surfaces come back with undefined contents
+	if (m_displaySurface->GetDirectDrawSurface1()->IsLost() == DDERR_SURFACELOST ||
+		m_displaySurface->GetDirectDrawSurface2()->IsLost() == DDERR_SURFACELOST) {
+		m_partialRedraw = FALSE;
+	}
+
 	m_direct3d->RestoreSurfaces();
 
 	SortPresenterList();
@@ -313,8 +325,28 @@ MxResult LegoVideoManager::Tickle()
 		m_3dManager->GetLego3DView()->GetView()->Clear();
 	}
 
-	MxRect32 rect(0, 0, m_videoParam.GetRect().GetWidth() - 1, m_videoParam.GetRect().GetHeight() - 1);
-	InvalidateRect(rect);
+	// Without the 3D view, page flipping or a transition the back buffer keeps its contents between frames,
+	// so only what the presenters invalidated has to be composited again. The first such frame is still full.
+	MxBool partialRedraw = m_unk0xe5 && !m_render3d && !m_paused && !m_drawFPS &&
+		!m_videoParam.Flags().GetFlipSurfaces() &&
+		TransitionManager()->GetTransitionType() == MxTransitionManager::e_idle;
+
+	if (!partialRedraw || !m_partialRedraw) {
+		MxRect32 rect(0, 0, m_videoParam.GetRect().GetWidth() - 1, m_videoParam.GetRect().GetHeight() - 1);
+		InvalidateRect(rect);
+	}
+	else if (m_drawCursor) {
+		// Repaint what the cursor covered last frame
+		MxRect32 rect(
+			m_cursorXCopy,
+			m_cursorYCopy,
+			m_cursorXCopy + m_cursorRect.right,
+			m_cursorYCopy + m_cursorRect.bottom
+		);
+		InvalidateRect(rect);
+	}
+
+	m_partialRedraw = partialRedraw;
 
 	if (!m_paused && (m_render3d || m_unk0xe5)) {
 		cursor.Reset();
@@ -336,6 +368,16 @@ MxResult LegoVideoManager::Tickle()
 
 		if (m_drawCursor) {
 			DrawCursor();
+
+			if (partialRedraw) {
+				MxRect32 rect(
+					m_cursorXCopy,
+					m_cursorYCopy,
+					m_cursorXCopy + m_cursorRect.right,
+					m_cursorYCopy + m_cursorRect.bottom
+				);
+				InvalidateRect(rect);
+			}
 		}
 
 		if (m_drawFPS) {
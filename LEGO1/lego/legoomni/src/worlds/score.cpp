@@ -241,7 +241,8 @@ void Score::Paint()
 {
 	LegoTextureInfo* cube = TextureContainer()->Get("bigcube.gif");
 
-	if (cube != NULL) {
+	// The cube is painted in place, it must not share its surface with other textures
+	if (cube != NULL && cube->Detach() == SUCCESS) {
 		JetskiRaceState* jetskiRaceState = (JetskiRaceState*) GameState()->GetState("JetskiRaceState");
 		CarRaceState* carRaceState = (CarRaceState*) GameState()->GetState("CarRaceState");
 		TowTrackMissionState* towTrackMissionState =
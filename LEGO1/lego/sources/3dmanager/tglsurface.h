@@ -113,6 +113,12 @@ class TglSurface {
 	 */
 	Tgl::Group* GetScene() const { return m_pScene; }
 
+	/**
+	 * @brief [AI] Makes Render skip drawing the scene (and report a render time of zero) while set.
+	 * @param p_stopRendering [AI] TRUE to skip drawing.
+	 */
+	void SetStopRendering(BOOL p_stopRendering) { m_stopRendering = p_stopRendering; }
+
 	/**
 	 * @brief [AI] Returns the width (in pixels) of the rendered surface.
 	 * @return [AI] The current device width.
@@ -4,6 +4,7 @@
 #include "mxgeometry/mxquaternion.h"
 
 #include <limits.h>
+#include <vec.h>
 
 DECOMP_SIZE_ASSERT(LegoAnimKey, 0x08)
 DECOMP_SIZE_ASSERT(LegoTranslationKey, 0x14)
@@ -11,7 +12,7 @@ DECOMP_SIZE_ASSERT(LegoRotationKey, 0x18)
 DECOMP_SIZE_ASSERT(LegoScaleKey, 0x14)
 DECOMP_SIZE_ASSERT(LegoMorphKey, 0x0c)
 DECOMP_SIZE_ASSERT(LegoUnknownKey, 0x0c)
-DECOMP_SIZE_ASSERT(LegoAnimNodeData, 0x34)
+DECOMP_SIZE_ASSERT(LegoAnimNodeData, 0x38)
 DECOMP_SIZE_ASSERT(LegoAnimActorEntry, 0x08)
 DECOMP_SIZE_ASSERT(LegoAnimScene, 0x24)
 DECOMP_SIZE_ASSERT(LegoAnim, 0x18)
@@ -531,6 +532,7 @@ LegoAnimNodeData::LegoAnimNodeData()
 	m_rotationIndex = 0;
 	m_scaleIndex = 0;
 	m_morphIndex = 0;
+	m_keyTimes = NULL;
 }
 
 // FUNCTION: LEGO1 0x1009fda0
@@ -551,6 +553,9 @@ LegoAnimNodeData::~LegoAnimNodeData()
 	if (m_morphKeys) {
 		delete[] m_morphKeys;
 	}
+	if (m_keyTimes) {
+		delete[] m_keyTimes;
+	}
 }
 
 // FUNCTION: LEGO1 0x1009fe60
@@ -578,6 +583,8 @@ LegoResult LegoAnimNodeData::Read(LegoStorage* p_storage)
 
 	LegoU32 i;
 
+	ClearKeyTimes();
+
 	if ((result = p_storage->Read(&m_numTranslationKeys, sizeof(m_numTranslationKeys))) != SUCCESS) {
 		return result;
 	}
@@ -642,6 +649,7 @@ LegoResult LegoAnimNodeData::Read(LegoStorage* p_storage)
 		}
 	}
 
+	UpdateKeyTimes();
 	return SUCCESS;
 }
 
@@ -724,6 +732,40 @@ void LegoAnimNodeData::SetName(LegoChar* p_name)
 	strcpy(m_name, p_name);
 }
 
+void LegoAnimNodeData::UpdateKeyTimes()
+{
+	LegoU32 i;
+	LegoU32 total = m_numTranslationKeys + m_numRotationKeys + m_numScaleKeys + m_numMorphKeys;
+
+	ClearKeyTimes();
+
+	// A key array can be missing while its count is set (e.g. mid-way through the car build swapping keys)
+	if (total == 0 || (m_numTranslationKeys && !m_translationKeys) || (m_numRotationKeys && !m_rotationKeys) ||
+		(m_numScaleKeys && !m_scaleKeys) || (m_numMorphKeys && !m_morphKeys)) {
+		return;
+	}
+
+	m_keyTimes = new LegoFloat[total];
+	if (m_keyTimes == NULL) {
+		return;
+	}
+
+	LegoFloat* times = m_keyTimes;
+
+	for (i = 0; i < m_numTranslationKeys; i++) {
+		*times++ = m_translationKeys[i].GetTime();
+	}
+	for (i = 0; i < m_numRotationKeys; i++) {
+		*times++ = m_rotationKeys[i].GetTime();
+	}
+	for (i = 0; i < m_numScaleKeys; i++) {
+		*times++ = m_scaleKeys[i].GetTime();
+	}
+	for (i = 0; i < m_numMorphKeys; i++) {
+		*times++ = m_morphKeys[i].GetTime();
+	}
+}
+
 // FUNCTION: LEGO1 0x100a03c0
 LegoResult LegoAnimNodeData::CreateLocalTransform(LegoFloat p_time, Matrix4& p_matrix)
 {
@@ -731,30 +773,31 @@ LegoResult LegoAnimNodeData::CreateLocalTransform(LegoFloat p_time, Matrix4& p_m
 
 	if (m_scaleKeys != NULL) {
 		index = GetScaleIndex();
-		GetScale(m_numScaleKeys, m_scaleKeys, p_time, p_matrix, index);
+		GetScale(m_numScaleKeys, m_scaleKeys, p_time, p_matrix, index, GetScaleTimes());
 		SetScaleIndex(index);
 
 		if (m_rotationKeys != NULL) {
-			MxMatrix a, b;
+			MxMatrix a;
+			float b[4][4];
 			a.SetIdentity();
 
 			index = GetRotationIndex();
-			GetRotation(m_numRotationKeys, m_rotationKeys, p_time, a, index);
+			GetRotation(m_numRotationKeys, m_rotationKeys, p_time, a, index, GetRotationTimes());
 			SetRotationIndex(index);
 
-			b = p_matrix;
-			p_matrix.Product(b, a);
+			SETMAT4(b, p_matrix);
+			MXM4(p_matrix, b, a);
 		}
 	}
 	else if (m_rotationKeys != NULL) {
 		index = GetRotationIndex();
-		GetRotation(m_numRotationKeys, m_rotationKeys, p_time, p_matrix, index);
+		GetRotation(m_numRotationKeys, m_rotationKeys, p_time, p_matrix, index, GetRotationTimes());
 		SetRotationIndex(index);
 	}
 
 	if (m_translationKeys != NULL) {
 		index = GetTranslationIndex();
-		GetTranslation(m_numTranslationKeys, m_translationKeys, p_time, p_matrix, index);
+		GetTranslation(m_numTranslationKeys, m_translationKeys, p_time, p_matrix, index, GetTranslationTimes());
 		SetTranslationIndex(index);
 	}
 
@@ -767,19 +810,26 @@ inline void LegoAnimNodeData::GetTranslation(
 	LegoTranslationKey* p_translationKeys,
 	LegoFloat p_time,
 	Matrix4& p_matrix,
-	LegoU32& p_old_index
+	LegoU32& p_old_index,
+	const LegoFloat* p_times
 )
 {
 	LegoU32 i, n;
 	LegoFloat x, y, z;
-	n = FindKeys(
-		p_time,
-		p_numTranslationKeys & USHRT_MAX,
-		p_translationKeys,
-		sizeof(*p_translationKeys),
-		i,
-		p_old_index
-	);
+
+	if (p_times != NULL) {
+		n = FindKeys(p_time, p_numTranslationKeys & USHRT_MAX, p_times, i, p_old_index);
+	}
+	else {
+		n = FindKeys(
+			p_time,
+			p_numTranslationKeys & USHRT_MAX,
+			p_translationKeys,
+			sizeof(*p_translationKeys),
+			i,
+			p_old_index
+		);
+	}
 
 	switch (n) {
 	case 0:
@@ -831,11 +881,18 @@ inline void LegoAnimNodeData::GetTranslation(
 	LegoRotationKey* p_rotationKeys,
 	LegoFloat p_time,
 	Matrix4& p_matrix,
-	LegoU32& p_old_index
+	LegoU32& p_old_index,
+	const LegoFloat* p_times
 )
 {
 	LegoU32 i, n;
-	n = FindKeys(p_time, p_numRotationKeys & USHRT_MAX, p_rotationKeys, sizeof(*p_rotationKeys), i, p_old_index);
+
+	if (p_times != NULL) {
+		n = FindKeys(p_time, p_numRotationKeys & USHRT_MAX, p_times, i, p_old_index);
+	}
+	else {
+		n = FindKeys(p_time, p_numRotationKeys & USHRT_MAX, p_rotationKeys, sizeof(*p_rotationKeys), i, p_old_index);
+	}
 
 	switch (n) {
 	case 0:
@@ -894,12 +951,19 @@ inline void LegoAnimNodeData::GetScale(
 	LegoScaleKey* p_scaleKeys,
 	LegoFloat p_time,
 	Matrix4& p_matrix,
-	LegoU32& p_old_index
+	LegoU32& p_old_index,
+	const LegoFloat* p_times
 )
 {
 	LegoU32 i, n;
 	LegoFloat x, y, z;
-	n = FindKeys(p_time, p_numScaleKeys & USHRT_MAX, p_scaleKeys, sizeof(*p_scaleKeys), i, p_old_index);
+
+	if (p_times != NULL) {
+		n = FindKeys(p_time, p_numScaleKeys & USHRT_MAX, p_times, i, p_old_index);
+	}
+	else {
+		n = FindKeys(p_time, p_numScaleKeys & USHRT_MAX, p_scaleKeys, sizeof(*p_scaleKeys), i, p_old_index);
+	}
 
 	switch (n) {
 	case 0:
@@ -926,7 +990,15 @@ LegoBool LegoAnimNodeData::FUN_100a0990(LegoFloat p_time)
 	LegoU32 index = GetMorphIndex();
 	LegoBool result;
 
-	n = FindKeys(p_time, m_numMorphKeys, m_morphKeys, sizeof(*m_morphKeys), i, index);
+	const LegoFloat* times = GetMorphTimes();
+
+	if (times != NULL) {
+		n = FindKeys(p_time, m_numMorphKeys, times, i, index);
+	}
+	else {
+		n = FindKeys(p_time, m_numMorphKeys, m_morphKeys, sizeof(*m_morphKeys), i, index);
+	}
+
 	SetMorphIndex(index);
 
 	switch (n) {
@@ -951,34 +1023,82 @@ LegoU32 LegoAnimNodeData::FindKeys(
 	LegoU32& p_new_index,
 	LegoU32& p_old_index
 )
+{
+	return SearchKeys(p_time, p_numKeys, (const LegoU8*) &p_keys->m_time, p_size, p_new_index, p_old_index);
+}
+
+LegoU32 LegoAnimNodeData::FindKeys(
+	LegoFloat p_time,
+	LegoU32 p_numKeys,
+	const LegoFloat* p_times,
+	LegoU32& p_new_index,
+	LegoU32& p_old_index
+)
+{
+	return SearchKeys(p_time, p_numKeys, (const LegoU8*) p_times, sizeof(*p_times), p_new_index, p_old_index);
+}
+
+#define KEY_TIME(i) (*(const LegoFloat*) (p_times + (i) * p_stride))
+
+LegoU32 LegoAnimNodeData::SearchKeys(
+	LegoFloat p_time,
+	LegoU32 p_numKeys,
+	const LegoU8* p_times,
+	LegoU32 p_stride,
+	LegoU32& p_new_index,
+	LegoU32& p_old_index
+)
 {
 	LegoU32 numKeys;
 	if (p_numKeys == 0) {
 		numKeys = 0;
 	}
-	else if (p_time < GetKey(0, p_keys, p_size).GetTime()) {
+	else if (p_time < KEY_TIME(0)) {
 		numKeys = 0;
 	}
-	else if (p_time > GetKey(p_numKeys - 1, p_keys, p_size).GetTime()) {
+	else if (p_time > KEY_TIME(p_numKeys - 1)) {
 		p_new_index = p_numKeys - 1;
 		numKeys = 1;
 	}
 	else {
-		if (GetKey(p_old_index, p_keys, p_size).GetTime() <= p_time) {
-			for (p_new_index = p_old_index;
-				 p_new_index < p_numKeys - 1 && p_time >= GetKey(p_new_index + 1, p_keys, p_size).GetTime();
-				 p_new_index++) {
-			}
+		// Find the last key at or before p_time. Bracket it by galloping from the cached
+		// index, towards the start if time went backwards, then binary search the bracket.
+		LegoU32 low = p_old_index < p_numKeys ? p_old_index : 0;
+		LegoU32 high;
+		LegoU32 step = 1;
+
+		if (KEY_TIME(low) > p_time) {
+			do {
+				high = low;
+				low = low > step ? low - step : 0;
+				step <<= 1;
+			} while (KEY_TIME(low) > p_time);
 		}
 		else {
-			for (p_new_index = 0;
-				 p_new_index < p_numKeys - 1 && p_time >= GetKey(p_new_index + 1, p_keys, p_size).GetTime();
-				 p_new_index++) {
+			high = low + 1;
+
+			while (high < p_numKeys && KEY_TIME(high) <= p_time) {
+				low = high;
+				high = high + step < p_numKeys ? high + step : p_numKeys;
+				step <<= 1;
+			}
+		}
+
+		// Invariant: KEY_TIME(low) <= p_time, and high == p_numKeys or KEY_TIME(high) > p_time
+		while (high - low > 1) {
+			LegoU32 mid = low + (high - low) / 2;
+
+			if (KEY_TIME(mid) <= p_time) {
+				low = mid;
+			}
+			else {
+				high = mid;
 			}
 		}
 
+		p_new_index = low;
 		p_old_index = p_new_index;
-		if (p_time == GetKey(p_new_index, p_keys, p_size).GetTime()) {
+		if (p_time == KEY_TIME(p_new_index)) {
 			numKeys = 1;
 		}
 		else if (p_new_index < p_numKeys - 1) {
@@ -992,6 +1112,8 @@ LegoU32 LegoAnimNodeData::FindKeys(
 	return numKeys;
 }
 
+#undef KEY_TIME
+
 // FUNCTION: LEGO1 0x100a0b00
 inline LegoFloat LegoAnimNodeData::Interpolate(
 	LegoFloat p_time,
@@ -42,6 +42,8 @@ class LegoAnimKey {
 	}
 
 protected:
+	friend class LegoAnimNodeData;
+
 	LegoU8 m_flags;   ///< [AI] Flags controlling key behavior or interpolation (see Flags enum).
 	LegoFloat m_time; ///< [AI] Time/sample/frame when this key occurs.
 };
@@ -163,13 +165,19 @@ class LegoAnimNodeData : public LegoTreeNodeData {
 	LegoChar* GetName() { return m_name; } ///< @brief [AI] Name of this animation node (used for lookup/mapping to scene graph).
 	LegoU16 GetNumTranslationKeys() { return m_numTranslationKeys; } ///< @brief [AI] Number of translation keys for this node.
 	LegoU16 GetNumRotationKeys() { return m_numRotationKeys; } ///< @brief [AI] Number of rotation keys for this node.
-	void SetNumRotationKeys(LegoU16 p_numRotationKeys) { m_numRotationKeys = p_numRotationKeys; } ///< @brief [AI] Sets the number of rotation keys for this node.
+	/// @brief [AI] Sets the number of rotation keys for this node. The key times are rebuilt by SetRotationKeys().
+	void SetNumRotationKeys(LegoU16 p_numRotationKeys)
+	{
+		m_numRotationKeys = p_numRotationKeys;
+		ClearKeyTimes();
+	}
 
-	/// @brief [AI] Sets the node's rotation keys array, resets rotation index.
+	/// @brief [AI] Sets the node's rotation keys array, resets rotation index. Set the key count first.
 	void SetRotationKeys(LegoRotationKey* p_keys)
 	{
 		m_rotationKeys = p_keys;
 		m_rotationIndex = 0;
+		UpdateKeyTimes();
 	}
 
 	LegoU32 GetTranslationIndex() { return m_translationIndex; } ///< @brief [AI] Gets last used/optimized translation index for interpolation.
@@ -194,9 +202,15 @@ class LegoAnimNodeData : public LegoTreeNodeData {
 	{
 		m_morphKeys = p_morphKeys;
 		m_morphIndex = 0;
+		UpdateKeyTimes();
 	}
 
-	void SetNumMorphKeys(LegoU16 p_numMorphKeys) { m_numMorphKeys = p_numMorphKeys; } ///< @brief [AI] Sets morph key count.
+	/// @brief [AI] Sets morph key count. The key times are rebuilt by SetMorphKeys().
+	void SetNumMorphKeys(LegoU16 p_numMorphKeys)
+	{
+		m_numMorphKeys = p_numMorphKeys;
+		ClearKeyTimes();
+	}
 	void SetUnknown0x20(LegoU16 p_unk0x20) { m_unk0x20 = p_unk0x20; } ///< @brief [AI] Sets unknown parameter (possibly camera/scene state).
 	void SetUnknown0x22(LegoU16 p_unk0x22) { m_unk0x22 = p_unk0x22; } ///< @brief [AI] Sets unknown parameter (possibly camera/scene state).
 
@@ -217,12 +231,14 @@ class LegoAnimNodeData : public LegoTreeNodeData {
 	/// @param p_time Animation time [AI]
 	/// @param p_matrix Matrix to be set [AI]
 	/// @param p_old_index Key search starting index (pass in/out optimized for playback) [AI]
+	/// @param p_times Optional contiguous copy of the key times, searched instead of the key array [AI]
 	inline static void GetTranslation(
 		LegoU16 p_numTranslationKeys,
 		LegoTranslationKey* p_translationKeys,
 		LegoFloat p_time,
 		Matrix4& p_matrix,
-		LegoU32& p_old_index
+		LegoU32& p_old_index,
+		const LegoFloat* p_times = NULL
 	);
 
 	/// @brief [AI] Computes interpolated rotation at a given time, filling p_matrix.
@@ -231,12 +247,14 @@ class LegoAnimNodeData : public LegoTreeNodeData {
 	/// @param p_time Animation time [AI]
 	/// @param p_matrix Matrix to set [AI]
 	/// @param p_old_index Key search starting index (pass in/out) [AI]
+	/// @param p_times Optional contiguous copy of the key times, searched instead of the key array [AI]
 	static void GetRotation(
 		LegoU16 p_numRotationKeys,
 		LegoRotationKey* p_rotationKeys,
 		LegoFloat p_time,
 		Matrix4& p_matrix,
-		LegoU32& p_old_index
+		LegoU32& p_old_index,
+		const LegoFloat* p_times = NULL
 	);
 
 	/// @brief [AI] Computes interpolated scaling on a node at given time, updating p_matrix.
@@ -245,12 +263,14 @@ class LegoAnimNodeData : public LegoTreeNodeData {
 	/// @param p_time Animation time [AI]
 	/// @param p_matrix Matrix to update [AI]
 	/// @param p_old_index Key search starting index (pass in/out) [AI]
+	/// @param p_times Optional contiguous copy of the key times, searched instead of the key array [AI]
 	inline static void GetScale(
 		LegoU16 p_numScaleKeys,
 		LegoScaleKey* p_scaleKeys,
 		LegoFloat p_time,
 		Matrix4& p_matrix,
-		LegoU32& p_old_index
+		LegoU32& p_old_index,
+		const LegoFloat* p_times = NULL
 	);
 
 	/// @brief [AI] Performs linear interpolation between two key values for the given time.
@@ -290,7 +310,62 @@ class LegoAnimNodeData : public LegoTreeNodeData {
 		LegoU32& p_old_index
 	);
 
+	/// @brief [AI] Same as the key-array FindKeys, but searches a contiguous array of key times.
+	/// @param p_time Current animation time [AI]
+	/// @param p_numKeys Number of keys in array [AI]
+	/// @param p_times Key times, one per key, in key order [AI]
+	/// @param p_new_index Resulting key index [AI]
+	/// @param p_old_index Key search starting index (in/out) [AI]
+	/// @return Number of keys found: 0 (none), 1 (exact), or 2 (between) [AI]
+	static LegoU32 FindKeys(
+		LegoFloat p_time,
+		LegoU32 p_numKeys,
+		const LegoFloat* p_times,
+		LegoU32& p_new_index,
+		LegoU32& p_old_index
+	);
+
 protected:
+	/// @brief [AI] Searches p_numKeys times spaced p_stride bytes apart, starting from the cached index.
+	/// @details [AI] Gallops outward from p_old_index (forwards or backwards) and finishes with a binary search, so
+	/// playback costs O(1) per frame and seeking costs O(log distance) instead of a linear scan from the start.
+	static LegoU32 SearchKeys(
+		LegoFloat p_time,
+		LegoU32 p_numKeys,
+		const LegoU8* p_times,
+		LegoU32 p_stride,
+		LegoU32& p_new_index,
+		LegoU32& p_old_index
+	);
+
+	/// @brief [AI] Rebuilds m_keyTimes from the current key arrays. [AI]
+	void UpdateKeyTimes();
+
+	/// @brief [AI] Drops m_keyTimes; lookups fall back to the key arrays until it is rebuilt. [AI]
+	void ClearKeyTimes()
+	{
+		delete[] m_keyTimes;
+		m_keyTimes = NULL;
+	}
+
+	/// @brief [AI] Translation key times, or NULL if m_keyTimes is not built.
+	const LegoFloat* GetTranslationTimes() { return m_keyTimes; }
+
+	/// @brief [AI] Rotation key times, or NULL if m_keyTimes is not built.
+	const LegoFloat* GetRotationTimes() { return m_keyTimes ? m_keyTimes + m_numTranslationKeys : NULL; }
+
+	/// @brief [AI] Scale key times, or NULL if m_keyTimes is not built.
+	const LegoFloat* GetScaleTimes()
+	{
+		return m_keyTimes ? m_keyTimes + m_numTranslationKeys + m_numRotationKeys : NULL;
+	}
+
+	/// @brief [AI] Morph key times, or NULL if m_keyTimes is not built.
+	const LegoFloat* GetMorphTimes()
+	{
+		return m_keyTimes ? m_keyTimes + m_numTranslationKeys + m_numRotationKeys + m_numScaleKeys : NULL;
+	}
+
 	LegoChar* m_name;                      ///< [AI] Animation node name.
 	LegoU16 m_numTranslationKeys;          ///< [AI] Number of translation keyframes.
 	LegoU16 m_numRotationKeys;             ///< [AI] Number of rotation keyframes.
@@ -306,6 +381,7 @@ class LegoAnimNodeData : public LegoTreeNodeData {
 	LegoU32 m_rotationIndex;               ///< [AI] Index cache for optimized rotation lookup/interpolation.
 	LegoU32 m_scaleIndex;                  ///< [AI] Index cache for optimized scale lookup/interpolation.
 	LegoU32 m_morphIndex;                  ///< [AI] Index cache for optimized morph lookup/interpolation.
+	LegoFloat* m_keyTimes;                 ///< [AI] Times of all translation, rotation, scale and morph keys, in that order, kept contiguous for searching.
 };
 
 /// @brief [AI] Describes a single actor or model referenced by an animation.
@@ -7,6 +7,8 @@
 DECOMP_SIZE_ASSERT(LegoWEGEdge, 0x54)
 DECOMP_SIZE_ASSERT(PathWithTrigger, 0x0c)
 
+LegoU32 LegoWEGEdge::g_flagGeneration = 0;
+
 // FUNCTION: LEGO1 0x1009a730
 // FUNCTION: BETA10 0x101830ec
 LegoWEGEdge::LegoWEGEdge()
@@ -84,14 +84,24 @@ class LegoWEGEdge : public LegoWEEdge {
 	/// @param p_disable Whether to disable (TRUE) or enable (FALSE) this edge. [AI]
 	void SetFlag0x10(LegoU32 p_disable)
 	{
+		LegoU8 flags = m_flags;
+
 		if (p_disable) {
 			m_flags &= ~c_bit5;
 		}
 		else {
 			m_flags |= c_bit5;
 		}
+
+		if (m_flags != flags) {
+			g_flagGeneration++;
+		}
 	}
 
+	/// [AI] Returns a counter that SetFlag0x10 increments whenever it enables or disables any edge.
+	/// Lets caches of routes over the edges notice that passability changed. [AI]
+	static LegoU32 GetFlagGeneration() { return g_flagGeneration; }
+
 	/// [AI] Returns a two-bit mask of the first two edge state flags (bit1, bit2).
 	/// Useful for quickly getting the basic state/type of this edge (e.g., path eligibility/state flags). [AI]
 	/// @return Bitwise OR of c_bit1 and c_bit2 flags. [AI]
@@ -106,6 +116,8 @@ class LegoWEGEdge : public LegoWEEdge {
 	/// @return Result code (0 OK, negative if error on geometry consistency) [AI]
 	LegoS32 FUN_1009aea0();
 
+	static LegoU32 g_flagGeneration; ///< [AI] See GetFlagGeneration. [AI]
+
 	LegoU8 m_flags;                 ///< [AI] Flags indicating edge state, enabled/disabled, and type bits. [AI]
 	LegoU8 m_unk0x0d;               ///< [AI] Unknown, used for internal status/tracking. [AI]
 	LegoChar* m_name;               ///< [AI] Edge's name string, dynamically allocated for debug/lookup. [AI]
@@ -2,16 +2,213 @@
 
 #include "lego/legoomni/include/legovideomanager.h"
 #include "lego/legoomni/include/misc.h"
+#include "legoimage.h"
 #include "mxdirectx/mxdirect3d.h"
 #include "tgl/d3drm/impl.h"
 
 DECOMP_SIZE_ASSERT(LegoContainerInfo<LegoTexture>, 0x10);
-// DECOMP_SIZE_ASSERT(LegoContainer<LegoTexture>, 0x18);
-DECOMP_SIZE_ASSERT(LegoTextureContainer, 0x24);
+// DECOMP_SIZE_ASSERT(LegoContainer<LegoTexture>, 0x24);
+DECOMP_SIZE_ASSERT(LegoTextureContainer, 0x448);
+
+LegoContainerIndex::LegoContainerIndex()
+{
+	m_slots = NULL;
+	m_capacity = 0;
+	m_count = 0;
+}
+
+LegoContainerIndex::~LegoContainerIndex()
+{
+	delete[] m_slots;
+}
+
+LegoU32 LegoContainerIndex::Hash(const char* p_key)
+{
+	LegoU32 value = 2166136261U;
+
+	for (LegoS32 i = 0; p_key[i]; i++) {
+		value ^= (LegoU8) p_key[i];
+		value *= 16777619U;
+	}
+
+	return value;
+}
+
+void* LegoContainerIndex::Find(const char* p_key) const
+{
+	if (m_count == 0) {
+		return NULL;
+	}
+
+	LegoU32 hash = Hash(p_key);
+
+	for (LegoU32 i = hash & (m_capacity - 1); m_slots[i].m_key != NULL; i = (i + 1) & (m_capacity - 1)) {
+		if (m_slots[i].m_hash == hash && !strcmp(m_slots[i].m_key, p_key)) {
+			return m_slots[i].m_value;
+		}
+	}
+
+	return NULL;
+}
+
+void LegoContainerIndex::Insert(const char* p_key, void* p_value)
+{
+	if ((m_count + 1) * 4 > m_capacity * 3) {
+		Grow();
+	}
+
+	LegoU32 hash = Hash(p_key);
+	LegoU32 i;
+
+	for (i = hash & (m_capacity - 1); m_slots[i].m_key != NULL; i = (i + 1) & (m_capacity - 1)) {
+		if (m_slots[i].m_hash == hash && !strcmp(m_slots[i].m_key, p_key)) {
+			m_slots[i].m_value = p_value;
+			return;
+		}
+	}
+
+	m_slots[i].m_key = p_key;
+	m_slots[i].m_hash = hash;
+	m_slots[i].m_value = p_value;
+	m_count++;
+}
+
+void LegoContainerIndex::Grow()
+{
+	LegoU32 capacity = m_capacity ? m_capacity * 2 : 64;
+	Slot* slots = new Slot[capacity];
+	LegoU32 i;
+
+	for (i = 0; i < capacity; i++) {
+		slots[i].m_key = NULL;
+	}
+
+	for (i = 0; i < m_capacity; i++) {
+		if (m_slots[i].m_key != NULL) {
+			LegoU32 j = m_slots[i].m_hash & (capacity - 1);
+
+			while (slots[j].m_key != NULL) {
+				j = (j + 1) & (capacity - 1);
+			}
+
+			slots[j] = m_slots[i];
+		}
+	}
+
+	delete[] m_slots;
+	m_slots = slots;
+	m_capacity = capacity;
+}
+
+// 64-bit FNV-1a. The constants are assembled from halves, there are no 64-bit literals to write them with.
+inline static void HashBytes(MxU64& p_hash, const void* p_data, LegoU32 p_size)
+{
+	const MxU64 prime = ((MxU64) 1 << 40) | 0x1b3;
+	const LegoU8* data = (const LegoU8*) p_data;
+
+	for (LegoU32 i = 0; i < p_size; i++) {
+		p_hash ^= data[i];
+		p_hash *= prime;
+	}
+}
+
+static MxU64 HashImage(LegoImage* p_image)
+{
+	MxU64 hash = ((MxU64) 0xcbf29ce4 << 32) | 0x84222325;
+	LegoU32 size[3];
+
+	size[0] = p_image->GetWidth();
+	size[1] = p_image->GetHeight();
+	size[2] = p_image->GetCount();
+	HashBytes(hash, size, sizeof(size));
+
+	for (LegoU32 i = 0; i < p_image->GetCount(); i++) {
+		LegoU8 color[3];
+		color[0] = p_image->GetPaletteEntry(i).GetRed();
+		color[1] = p_image->GetPaletteEntry(i).GetGreen();
+		color[2] = p_image->GetPaletteEntry(i).GetBlue();
+		HashBytes(hash, color, sizeof(color));
+	}
+
+	HashBytes(hash, p_image->GetBits(), size[0] * size[1]);
+	return hash;
+}
+
+// Compares the entry's surface and palette with the image, so that a hash collision can't hand out the wrong texture
+static LegoBool MatchCacheEntry(LegoTextureCacheEntry* p_entry, LegoImage* p_image)
+{
+	if (p_entry->m_width != p_image->GetWidth() || p_entry->m_height != p_image->GetHeight()) {
+		return FALSE;
+	}
+
+	PALETTEENTRY entries[256];
+	LegoU32 i;
+
+	if (p_entry->m_palette->GetEntries(0, 0, sizeOfArray(entries), entries) != DD_OK) {
+		return FALSE;
+	}
+
+	for (i = 0; i < p_image->GetCount() && i < sizeOfArray(entries); i++) {
+		LegoPaletteEntry& color = p_image->GetPaletteEntry(i);
+
+		if (entries[i].peRed != color.GetRed() || entries[i].peGreen != color.GetGreen() ||
+			entries[i].peBlue != color.GetBlue()) {
+			return FALSE;
+		}
+	}
+
+	DDSURFACEDESC desc;
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+
+	if (p_entry->m_surface->Lock(NULL, &desc, DDLOCK_SURFACEMEMORYPTR, NULL) != DD_OK) {
+		return FALSE;
+	}
+
+	const LegoU8* surface = (const LegoU8*) desc.lpSurface;
+	const LegoU8* bits = p_image->GetBits();
+	LegoBool match = TRUE;
+
+	for (i = 0; i < p_entry->m_height && match; i++) {
+		match = !memcmp(surface, bits, p_entry->m_width);
+		surface += desc.lPitch;
+		bits += p_entry->m_width;
+	}
+
+	p_entry->m_surface->Unlock(desc.lpSurface);
+	return match;
+}
+
+static void DestroyCacheEntry(LegoTextureCacheEntry* p_entry)
+{
+	p_entry->m_texture->Release();
+	p_entry->m_surface->Release();
+	p_entry->m_palette->Release();
+	delete p_entry;
+}
+
+LegoTextureContainer::LegoTextureContainer()
+{
+	memset(m_cacheBuckets, 0, sizeof(m_cacheBuckets));
+	m_cacheHits = 0;
+	m_cacheMisses = 0;
+	m_residentBytes = 0;
+	m_unusedBytes = 0;
+	m_cacheBudget = c_defaultCacheBudget;
+	m_cacheClock = 0;
+}
 
 // FUNCTION: LEGO1 0x10099870
 LegoTextureContainer::~LegoTextureContainer()
 {
+	// Texture infos are deleted by Clear beforehand, nothing refers to the entries anymore
+	for (LegoU32 i = 0; i < sizeOfArray(m_cacheBuckets); i++) {
+		while (m_cacheBuckets[i] != NULL) {
+			LegoTextureCacheEntry* entry = m_cacheBuckets[i];
+			m_cacheBuckets[i] = entry->m_next;
+			DestroyCacheEntry(entry);
+		}
+	}
 }
 
 // FUNCTION: LEGO1 0x100998e0
@@ -136,3 +333,110 @@ void LegoTextureContainer::EraseCached(LegoTextureInfo* p_textureInfo)
 		}
 	}
 }
+
+LegoTextureInfo* LegoTextureContainer::Create(const char* p_name, LegoTexture* p_texture)
+{
+	if (p_name == NULL || p_texture == NULL) {
+		return NULL;
+	}
+
+	LegoImage* image = p_texture->GetImage();
+	MxU64 hash = HashImage(image);
+	LegoTextureCacheEntry** bucket = &m_cacheBuckets[(LegoU32) hash & (c_numCacheBuckets - 1)];
+	LegoTextureCacheEntry* entry;
+	LegoTextureInfo* textureInfo;
+
+	for (entry = *bucket; entry != NULL; entry = entry->m_next) {
+		if (entry->m_hash == hash && MatchCacheEntry(entry, image)) {
+			textureInfo = new LegoTextureInfo();
+			textureInfo->m_name = new char[strlen(p_name) + 1];
+			strcpy(textureInfo->m_name, p_name);
+
+			textureInfo->m_surface = entry->m_surface;
+			textureInfo->m_surface->AddRef();
+			textureInfo->m_palette = entry->m_palette;
+			textureInfo->m_palette->AddRef();
+			textureInfo->m_texture = entry->m_texture;
+			textureInfo->m_texture->AddRef();
+			textureInfo->m_cacheEntry = entry;
+
+			if (entry->m_refCount++ == 0) {
+				m_unusedBytes -= entry->m_size;
+			}
+
+			entry->m_stamp = ++m_cacheClock;
+			m_cacheHits++;
+			return textureInfo;
+		}
+	}
+
+	textureInfo = LegoTextureInfo::Create(p_name, p_texture);
+
+	if (textureInfo == NULL) {
+		return NULL;
+	}
+
+	m_cacheMisses++;
+
+	entry = new LegoTextureCacheEntry;
+	entry->m_hash = hash;
+	entry->m_width = image->GetWidth();
+	entry->m_height = image->GetHeight();
+	entry->m_surface = textureInfo->m_surface;
+	entry->m_surface->AddRef();
+	entry->m_palette = textureInfo->m_palette;
+	entry->m_palette->AddRef();
+	entry->m_texture = textureInfo->m_texture;
+	entry->m_texture->AddRef();
+	entry->m_refCount = 1;
+	entry->m_size = entry->m_width * entry->m_height + sizeof(PALETTEENTRY) * 256;
+	entry->m_stamp = ++m_cacheClock;
+	entry->m_container = this;
+	entry->m_next = *bucket;
+	*bucket = entry;
+
+	m_residentBytes += entry->m_size;
+	textureInfo->m_cacheEntry = entry;
+
+	EvictCache();
+	return textureInfo;
+}
+
+void LegoTextureContainer::SetCacheBudget(LegoU32 p_budget)
+{
+	m_cacheBudget = p_budget;
+	EvictCache();
+}
+
+void LegoTextureContainer::ReleaseCacheEntry(LegoTextureCacheEntry* p_entry)
+{
+	if (--p_entry->m_refCount == 0) {
+		m_unusedBytes += p_entry->m_size;
+	}
+}
+
+void LegoTextureContainer::EvictCache()
+{
+	// Only entries without users can go, don't scan the buckets while every entry is in use
+	while (m_residentBytes > m_cacheBudget && m_unusedBytes != 0) {
+		LegoTextureCacheEntry** oldest = NULL;
+
+		for (LegoU32 i = 0; i < sizeOfArray(m_cacheBuckets); i++) {
+			for (LegoTextureCacheEntry** link = &m_cacheBuckets[i]; *link != NULL; link = &(*link)->m_next) {
+				if ((*link)->m_refCount == 0 && (oldest == NULL || (*link)->m_stamp < (*oldest)->m_stamp)) {
+					oldest = link;
+				}
+			}
+		}
+
+		if (oldest == NULL) {
+			break;
+		}
+
+		LegoTextureCacheEntry* entry = *oldest;
+		*oldest = entry->m_next;
+		m_residentBytes -= entry->m_size;
+		m_unusedBytes -= entry->m_size;
+		DestroyCacheEntry(entry);
+	}
+}
@@ -31,6 +31,51 @@ struct LegoContainerInfoComparator {
 template <class T>
 class LegoContainerInfo : public map<const char*, T*, LegoContainerInfoComparator> {}; // [AI]
 
+/**
+ * @brief Open-addressing hash index from C-string keys to object pointers. [AI]
+ * @details [AI] Lets LegoContainer find an element by name in constant time instead of walking its map. Keys are not
+ * copied, they are the strings owned by the container's map. There is no removal, LegoContainer never erases keys. [AI]
+ */
+class LegoContainerIndex {
+public:
+	LegoContainerIndex();
+	~LegoContainerIndex();
+
+	/**
+	 * @brief Returns the value stored for the key, or NULL if the key is not in the index. [AI]
+	 * @param p_key Key to look up, compared with strcmp. [AI]
+	 */
+	void* Find(const char* p_key) const;
+
+	/**
+	 * @brief Adds the key, or replaces its value if it is already in the index. [AI]
+	 * @param p_key Key to add. Must stay valid for as long as the index exists. [AI]
+	 * @param p_value Value to store. [AI]
+	 */
+	void Insert(const char* p_key, void* p_value);
+
+	/**
+	 * @brief Case sensitive FNV-1a hash of a C-string. [AI]
+	 */
+	static LegoU32 Hash(const char* p_key);
+
+private:
+	/**
+	 * @brief One slot of the table. An empty slot has a NULL key. [AI]
+	 */
+	struct Slot {
+		const char* m_key; ///< [AI]
+		LegoU32 m_hash;    ///< [AI] Hash of m_key, saves a strcmp for most mismatching slots.
+		void* m_value;     ///< [AI]
+	};
+
+	void Grow();
+
+	Slot* m_slots;      ///< [AI] Table of m_capacity slots, a power of two.
+	LegoU32 m_capacity; ///< [AI]
+	LegoU32 m_count;    ///< [AI] Number of used slots, kept below three quarters of m_capacity.
+};
+
 /**
  * @brief Template container associating string names with object pointers, optional lifetime management. [AI]
  * @tparam T Object type, used as pointer. [AI]
@@ -87,23 +132,36 @@ class LegoContainer {
 	 * @brief Retrieve the element mapped to the given name, or nullptr if missing. [AI]
 	 * @param p_name Name of the element (C-string). [AI]
 	 * @return Pointer to the element if found, otherwise nullptr. [AI]
-	 * @details [AI] Looks up the map for the name (using comparator). [AI]
+	 * @details [AI] Looks up the name in the hash index rather than the map. [AI]
+	 */
+	T* Get(const char* p_name) { return (T*) m_index.Find(p_name); }
+
+	/**
+	 * @brief Retrieve the elements mapped to a batch of names. [AI]
+	 * @param p_names Names to look up; NULL entries are skipped and yield NULL. [AI]
+	 * @param p_values Receives the element for each name, or NULL if it is missing. [AI]
+	 * @param p_count Number of names. [AI]
+	 * @return Number of non-NULL names that were not found. [AI]
 	 */
-	T* Get(const char* p_name)
+	LegoU32 Get(const char* const* p_names, T** p_values, LegoU32 p_count)
 	{
-		T* value = NULL;
+		LegoU32 missing = 0;
 
-#ifdef COMPAT_MODE
-		typename LegoContainerInfo<T>::iterator it = m_map.find(p_name);
-#else
-		LegoContainerInfo<T>::iterator it = m_map.find(p_name);
-#endif
+		for (LegoU32 i = 0; i < p_count; i++) {
+			p_values[i] = NULL;
 
-		if (it != m_map.end()) {
-			value = (*it).second;
+			if (p_names[i] == NULL) {
+				continue;
+			}
+
+			p_values[i] = Get(p_names[i]);
+
+			if (p_values[i] == NULL) {
+				missing++;
+			}
 		}
 
-		return value;
+		return missing;
 	}
 
 	/**
@@ -134,6 +192,7 @@ class LegoContainer {
 		}
 
 		m_map[name] = p_value;
+		m_index.Insert(name, p_value);
 	}
 
 	/**
@@ -145,6 +204,7 @@ class LegoContainer {
 protected:
 	LegoBool m_ownership;       ///< If TRUE, container owns objects and keys; else no cleanup on destruction. [AI]
 	LegoContainerInfo<T> m_map; ///< Underlying map from name strings to objects. [AI]
+	LegoContainerIndex m_index; ///< Hash index over m_map, used by Get. [AI]
 };
 
 /**
@@ -168,6 +228,16 @@ typedef list<LegoCachedTexture> LegoCachedTextureList;
  */
 class LegoTextureContainer : public LegoContainer<LegoTextureInfo> {
 public:
+	enum {
+		c_numCacheBuckets = 256,        ///< [AI] Number of hash buckets for shared texture entries.
+		c_defaultCacheBudget = 0x200000 ///< [AI] Default budget in bytes before unused entries are evicted.
+	};
+
+	/**
+	 * @brief Constructor. Starts with an empty texture cache and the default budget. [AI]
+	 */
+	LegoTextureContainer();
+
 	/**
 	 * @brief Destructor. Cleans up all cached textures as well as the standard container cleanup. [AI]
 	 * @details [AI] Ensures that texture resources in m_cached are released. [AI]
@@ -189,8 +259,58 @@ class LegoTextureContainer : public LegoContainer<LegoTextureInfo> {
 	 */
 	void EraseCached(LegoTextureInfo* p_textureInfo);
 
+	/**
+	 * @brief Creates a texture info for a name, sharing its surface and texture with equal textures. [AI]
+	 * @param p_name Name of the texture. [AI]
+	 * @param p_texture Image and palette of the texture. [AI]
+	 * @return New texture info, or NULL if creation fails. The caller adds it to the container. [AI]
+	 * @details [AI] Textures are looked up by a 64-bit hash of the image size, palette and bits, and the match is
+	 * verified against the shared surface. On a hit the new info only references the shared DirectDraw and
+	 * Direct3DRM objects. On a miss the texture is created by LegoTextureInfo::Create and a new entry is added, after
+	 * which unused entries are evicted while the cache is over budget. Infos detach from their entry before they are
+	 * written, see LegoTextureInfo::Detach. [AI]
+	 */
+	LegoTextureInfo* Create(const char* p_name, LegoTexture* p_texture);
+
+	/**
+	 * @brief Sets how many bytes of texture entries may be resident before unused ones are evicted. [AI]
+	 */
+	void SetCacheBudget(LegoU32 p_budget);
+
+	/**
+	 * @brief Returns the number of textures that were served from a shared entry. [AI]
+	 */
+	LegoU32 GetCacheHits() const { return m_cacheHits; }
+
+	/**
+	 * @brief Returns the number of textures that had to be created. [AI]
+	 */
+	LegoU32 GetCacheMisses() const { return m_cacheMisses; }
+
+	/**
+	 * @brief Returns the approximate memory held by shared texture entries, in bytes. [AI]
+	 */
+	LegoU32 GetResidentBytes() const { return m_residentBytes; }
+
+	/**
+	 * @brief Drops one user of p_entry; called by LegoTextureInfo when it stops using the entry. [AI]
+	 * @details [AI] Entries without users count towards the bytes EvictCache may free.
+	 */
+	void ReleaseCacheEntry(LegoTextureCacheEntry* p_entry);
+
 protected:
+	void EvictCache();
+
 	LegoCachedTextureList m_cached; ///< List of cached temporary texture objects, pairing texture info with a cache/in-use flag. [AI]
+
+	LegoTextureCacheEntry* m_cacheBuckets[c_numCacheBuckets]; ///< Shared texture entries, chained by hash. [AI]
+
+	LegoU32 m_cacheHits;     ///< [AI]
+	LegoU32 m_cacheMisses;   ///< [AI]
+	LegoU32 m_residentBytes; ///< Sum of m_size of all entries. [AI]
+	LegoU32 m_unusedBytes;   ///< Sum of m_size of the entries with no users, the most EvictCache can free. [AI]
+	LegoU32 m_cacheBudget;   ///< [AI]
+	LegoU32 m_cacheClock;    ///< Incremented whenever an entry is handed out, source of the entries' m_stamp. [AI]
 };
 
 #endif // LEGOCONTAINER_H
@@ -6,14 +6,35 @@
 #include <string.h>
 
 DECOMP_SIZE_ASSERT(LegoStorage, 0x08);
-DECOMP_SIZE_ASSERT(LegoMemory, 0x10);
-DECOMP_SIZE_ASSERT(LegoFile, 0x0c);
+DECOMP_SIZE_ASSERT(LegoMemory, 0x1c);
+DECOMP_SIZE_ASSERT(LegoFile, 0x1c);
 
 // FUNCTION: LEGO1 0x10099080
 LegoMemory::LegoMemory(void* p_buffer) : LegoStorage()
 {
 	m_buffer = (LegoU8*) p_buffer;
 	m_position = 0;
+	m_capacity = 0;
+	m_size = 0;
+	m_ownsBuffer = FALSE;
+}
+
+LegoMemory::LegoMemory() : LegoStorage()
+{
+	m_buffer = NULL;
+	m_position = 0;
+	m_capacity = 0;
+	m_size = 0;
+	m_ownsBuffer = TRUE;
+	m_mode = c_write;
+}
+
+// FUNCTION: LEGO1 0x10045a80
+LegoMemory::~LegoMemory()
+{
+	if (m_ownsBuffer) {
+		delete[] m_buffer;
+	}
 }
 
 // FUNCTION: LEGO1 0x10099160
@@ -27,23 +48,80 @@ LegoResult LegoMemory::Read(void* p_buffer, LegoU32 p_size)
 // FUNCTION: LEGO1 0x10099190
 LegoResult LegoMemory::Write(const void* p_buffer, LegoU32 p_size)
 {
+	if (m_ownsBuffer && m_position + p_size > m_capacity && Grow(m_position + p_size) != SUCCESS) {
+		return FAILURE;
+	}
+
 	memcpy(m_buffer + m_position, p_buffer, p_size);
 	m_position += p_size;
+
+	if (m_position > m_size) {
+		m_size = m_position;
+	}
+
+	return SUCCESS;
+}
+
+LegoResult LegoMemory::Grow(LegoU32 p_size)
+{
+	LegoU32 capacity = m_capacity ? m_capacity : 0x1000;
+
+	while (capacity < p_size) {
+		capacity *= 2;
+	}
+
+	LegoU8* buffer = new LegoU8[capacity];
+
+	if (buffer == NULL) {
+		return FAILURE;
+	}
+
+	// Bytes skipped over with SetPosition read back as zero
+	memcpy(buffer, m_buffer, m_size);
+	memset(buffer + m_size, 0, capacity - m_size);
+
+	delete[] m_buffer;
+	m_buffer = buffer;
+	m_capacity = capacity;
 	return SUCCESS;
 }
 
+LegoU8* LegoMemory::ReleaseBuffer()
+{
+	if (!m_ownsBuffer) {
+		return NULL;
+	}
+
+	LegoU8* buffer = m_buffer;
+	m_buffer = NULL;
+	m_position = 0;
+	m_capacity = 0;
+	m_size = 0;
+	return buffer;
+}
+
+const void* LegoMemory::View(LegoU32 p_size)
+{
+	const void* data = m_buffer + m_position;
+	m_position += p_size;
+	return data;
+}
+
 // FUNCTION: LEGO1 0x100991c0
 LegoFile::LegoFile()
 {
 	m_file = NULL;
+	m_buffer = NULL;
+	m_bufferPos = 0;
+	m_bufferLength = 0;
+	m_pending = 0;
 }
 
 // FUNCTION: LEGO1 0x10099250
 LegoFile::~LegoFile()
 {
-	if (m_file) {
-		fclose(m_file);
-	}
+	Close();
+	delete[] m_buffer;
 }
 
 // FUNCTION: LEGO1 0x100992c0
@@ -52,9 +130,42 @@ LegoResult LegoFile::Read(void* p_buffer, LegoU32 p_size)
 	if (!m_file) {
 		return FAILURE;
 	}
-	if (fread(p_buffer, 1, p_size, m_file) != p_size) {
+
+	if (m_pending && Flush() != SUCCESS) {
 		return FAILURE;
 	}
+
+	LegoU8* buffer = (LegoU8*) p_buffer;
+	LegoU32 available = m_bufferLength - m_bufferPos;
+
+	if (p_size <= available) {
+		memcpy(buffer, m_buffer + m_bufferPos, p_size);
+		m_bufferPos += p_size;
+		return SUCCESS;
+	}
+
+	memcpy(buffer, m_buffer + m_bufferPos, available);
+	buffer += available;
+	p_size -= available;
+	m_bufferPos = 0;
+	m_bufferLength = 0;
+
+	if (p_size >= c_bufferSize) {
+		if (fread(buffer, 1, p_size, m_file) != p_size) {
+			return FAILURE;
+		}
+		return SUCCESS;
+	}
+
+	m_bufferLength = fread(m_buffer, 1, c_bufferSize, m_file);
+
+	if (m_bufferLength < p_size) {
+		m_bufferPos = m_bufferLength;
+		return FAILURE;
+	}
+
+	memcpy(buffer, m_buffer, p_size);
+	m_bufferPos = p_size;
 	return SUCCESS;
 }
 
@@ -64,9 +175,26 @@ LegoResult LegoFile::Write(const void* p_buffer, LegoU32 p_size)
 	if (!m_file) {
 		return FAILURE;
 	}
-	if (fwrite(p_buffer, 1, p_size, m_file) != p_size) {
+
+	if (m_bufferLength && Sync() != SUCCESS) {
 		return FAILURE;
 	}
+
+	if (m_pending + p_size > c_bufferSize) {
+		if (Flush() != SUCCESS) {
+			return FAILURE;
+		}
+
+		if (p_size >= c_bufferSize) {
+			if (fwrite(p_buffer, 1, p_size, m_file) != p_size) {
+				return FAILURE;
+			}
+			return SUCCESS;
+		}
+	}
+
+	memcpy(m_buffer + m_pending, p_buffer, p_size);
+	m_pending += p_size;
 	return SUCCESS;
 }
 
@@ -80,7 +208,7 @@ LegoResult LegoFile::GetPosition(LegoU32& p_position)
 	if (position == -1) {
 		return FAILURE;
 	}
-	p_position = position;
+	p_position = position + m_pending - (m_bufferLength - m_bufferPos);
 	return SUCCESS;
 }
 
@@ -90,6 +218,9 @@ LegoResult LegoFile::SetPosition(LegoU32 p_position)
 	if (!m_file) {
 		return FAILURE;
 	}
+	if (Sync() != SUCCESS) {
+		return FAILURE;
+	}
 	if (fseek(m_file, p_position, SEEK_SET) != 0) {
 		return FAILURE;
 	}
@@ -99,9 +230,8 @@ LegoResult LegoFile::SetPosition(LegoU32 p_position)
 // FUNCTION: LEGO1 0x100993a0
 LegoResult LegoFile::Open(const char* p_name, LegoU32 p_mode)
 {
-	if (m_file) {
-		fclose(m_file);
-	}
+	Close();
+
 	char mode[4];
 	mode[0] = '\0';
 	if (p_mode & c_read) {
@@ -121,8 +251,66 @@ LegoResult LegoFile::Open(const char* p_name, LegoU32 p_mode)
 		strcat(mode, "b");
 	}
 
-	if (!(m_file = fopen(p_name, mode))) {
+	if (m_buffer == NULL) {
+		m_buffer = new LegoU8[c_bufferSize];
+	}
+
+	if (m_buffer == NULL || !(m_file = fopen(p_name, mode))) {
+		return FAILURE;
+	}
+	return SUCCESS;
+}
+
+LegoResult LegoFile::Flush()
+{
+	if (!m_file) {
 		return FAILURE;
 	}
+
+	LegoU32 pending = m_pending;
+	m_pending = 0;
+
+	if (pending && fwrite(m_buffer, 1, pending, m_file) != pending) {
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+LegoResult LegoFile::Close()
+{
+	if (!m_file) {
+		return SUCCESS;
+	}
+
+	LegoResult result = Flush();
+
+	if (fclose(m_file) != 0) {
+		result = FAILURE;
+	}
+
+	m_file = NULL;
+	m_bufferPos = 0;
+	m_bufferLength = 0;
+	return result;
+}
+
+// Moves the file position to where the caller is, dropping the read-ahead and writing pending data
+LegoResult LegoFile::Sync()
+{
+	if (m_pending) {
+		return Flush();
+	}
+
+	if (m_bufferLength) {
+		LegoU32 unread = m_bufferLength - m_bufferPos;
+		m_bufferPos = 0;
+		m_bufferLength = 0;
+
+		if (unread && fseek(m_file, -(long) unread, SEEK_CUR) != 0) {
+			return FAILURE;
+		}
+	}
+
 	return SUCCESS;
 }
@@ -77,6 +77,19 @@ class LegoStorage {
 	 */
 	virtual LegoBool IsReadMode() { return m_mode == c_read; } // vtable+0x18
 
+	/**
+	 * @brief [AI] Returns TRUE if View can return data in place, which is the case for a LegoMemory. [AI]
+	 */
+	virtual LegoBool CanView() { return FALSE; } // vtable+0x1c
+
+	/**
+	 * @brief [AI] Returns the next p_size bytes in place, without copying them, and advances past them.
+	 * @details [AI] Only a LegoMemory can do this. For any other storage NULL is returned and the position is left
+	 * unchanged, so the caller falls back to Read.
+	 * @param p_size Number of bytes to view [AI]
+	 */
+	virtual const void* View(LegoU32 p_size) { return NULL; } // vtable+0x20
+
 	/**
 	 * @brief Writes a length-prefixed string to storage. [AI]
 	 * @details String is prefixed by a 16-bit length, then content without null terminator. [AI]
@@ -309,7 +322,7 @@ class LegoStorage {
 };
 
 // VTABLE: LEGO1 0x100db710
-// SIZE 0x10
+// SIZE 0x1c
 /**
  * @brief Implementation of LegoStorage for memory-backed buffers. [AI]
  * @details Provides read/write operations on a raw memory buffer, keeping track of the current offset. [AI]
@@ -322,6 +335,18 @@ class LegoMemory : public LegoStorage {
 	 */
 	LegoMemory(void* p_buffer);
 
+	/**
+	 * @brief Constructor for a storage that owns its buffer and grows it as it is written. [AI]
+	 * @details [AI] Opened in write mode, so serializers that check IsWriteMode write into it. Used to take a snapshot
+	 * of data that is written to a file later. [AI]
+	 */
+	LegoMemory();
+
+	/**
+	 * @brief Destructor. Frees the buffer if this storage owns it. [AI]
+	 */
+	~LegoMemory() override;
+
 	/**
 	 * @brief Reads bytes from memory buffer at current position. [AI]
 	 * @param p_buffer Output buffer to receive bytes [AI]
@@ -360,8 +385,33 @@ class LegoMemory : public LegoStorage {
 		return SUCCESS;
 	}
 
-	// SYNTHETIC: LEGO1 0x10045a80
-	// LegoMemory::~LegoMemory
+	/**
+	 * @brief [AI] Returns TRUE, the buffer can be viewed in place. [AI]
+	 */
+	LegoBool CanView() override { return TRUE; } // vtable+0x1c
+
+	/**
+	 * @brief [AI] Returns the next p_size bytes of the buffer and advances past them.
+	 * @details [AI] The pointer is valid as long as the buffer is and may be unaligned.
+	 * @param p_size Number of bytes to view [AI]
+	 */
+	const void* View(LegoU32 p_size) override; // vtable+0x20
+
+	/**
+	 * @brief [AI] Returns the buffer. [AI]
+	 */
+	LegoU8* GetBuffer() { return m_buffer; }
+
+	/**
+	 * @brief [AI] Returns the number of bytes written, i.e. the end of the furthest write. [AI]
+	 */
+	LegoU32 GetSize() { return m_size; }
+
+	/**
+	 * @brief [AI] Hands an owned buffer over to the caller, who frees it with delete[], and empties this storage.
+	 * @return The buffer, or NULL if this storage does not own one. [AI]
+	 */
+	LegoU8* ReleaseBuffer();
 
 	// SYNTHETIC: LEGO1 0x100990f0
 	// LegoMemory::`scalar deleting destructor'
@@ -376,16 +426,40 @@ class LegoMemory : public LegoStorage {
 	 * @brief Current read/write offset in buffer. [AI]
 	 */
 	LegoU32 m_position; // 0x08
+
+	/**
+	 * @brief [AI] Size of an owned buffer in bytes. Unknown, and 0, for a buffer passed to the constructor.
+	 */
+	LegoU32 m_capacity; // 0x10
+
+	/**
+	 * @brief [AI] End of the furthest write. [AI]
+	 */
+	LegoU32 m_size; // 0x14
+
+	/**
+	 * @brief [AI] TRUE if the buffer was allocated by this storage, which then grows it on demand. [AI]
+	 */
+	LegoBool m_ownsBuffer; // 0x18
+
+private:
+	LegoResult Grow(LegoU32 p_size);
 };
 
 // VTABLE: LEGO1 0x100db730
-// SIZE 0x0c
+// SIZE 0x1c
 /**
  * @brief Implementation of LegoStorage for file-backed storage using stdio FILE*. [AI]
- * @details Provides read/write operations using C file I/O, tracks current file pointer position. [AI]
+ * @details Provides read/write operations using C file I/O, tracks current file pointer position. Reads and writes
+ * go through a buffer of c_bufferSize bytes, so the many small field reads and writes of a serializer cost a copy
+ * each rather than a call into the C runtime. [AI]
  */
 class LegoFile : public LegoStorage {
 public:
+	enum {
+		c_bufferSize = 0x1000 ///< [AI] Size of the read/write buffer.
+	};
+
 	/**
 	 * @brief Default constructor initializes with NULL file pointer. [AI]
 	 */
@@ -435,6 +509,20 @@ class LegoFile : public LegoStorage {
 	 */
 	LegoResult Open(const char* p_name, LegoU32 p_mode);
 
+	/**
+	 * @brief [AI] Writes buffered data to the file.
+	 * @return SUCCESS if everything written so far reached the C runtime, FAILURE otherwise. [AI]
+	 * @details [AI] Buffered writes can only fail here, a caller that needs to know whether the file is complete
+	 * checks this or the result of Close. [AI]
+	 */
+	LegoResult Flush();
+
+	/**
+	 * @brief [AI] Flushes and closes the file.
+	 * @return SUCCESS if all data was written and the file closed cleanly, FAILURE otherwise. [AI]
+	 */
+	LegoResult Close();
+
 	// SYNTHETIC: LEGO1 0x10099230
 	// LegoFile::`scalar deleting destructor'
 
@@ -443,6 +531,29 @@ class LegoFile : public LegoStorage {
 	 * @brief C runtime file pointer backing storage. [AI]
 	 */
 	FILE* m_file; // 0x08
+
+	/**
+	 * @brief [AI] Buffer of c_bufferSize bytes, allocated by Open. [AI]
+	 */
+	LegoU8* m_buffer; // 0x0c
+
+	/**
+	 * @brief [AI] Read cursor into the bytes read ahead into m_buffer. [AI]
+	 */
+	LegoU32 m_bufferPos; // 0x10
+
+	/**
+	 * @brief [AI] Number of bytes read ahead into m_buffer. The file position is at their end. [AI]
+	 */
+	LegoU32 m_bufferLength; // 0x14
+
+	/**
+	 * @brief [AI] Number of bytes written to m_buffer and not yet to the file. [AI]
+	 */
+	LegoU32 m_pending; // 0x18
+
+private:
+	LegoResult Sync();
 };
 
 #endif // __LEGOSTORAGE_H
\ No newline at end of file
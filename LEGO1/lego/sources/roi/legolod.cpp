@@ -41,6 +41,10 @@ LegoLOD::~LegoLOD()
 	if (m_numMeshes && m_melems != NULL) {
 		for (LegoU32 i = 0; i < m_numMeshes; i++) {
 			if (m_melems[i].m_tglMesh != NULL) {
+				if (m_melems[i].m_unk0x04) {
+					LegoTextureInfo::ReleaseGroupTexture(m_melems[i].m_tglMesh);
+				}
+
 				delete m_melems[i].m_tglMesh;
 				m_melems[i].m_tglMesh = NULL;
 			}
@@ -52,121 +56,248 @@ LegoLOD::~LegoLOD()
 	}
 }
 
+LegoLODData::LegoLODData()
+{
+	m_flags = 0;
+	m_numMeshes = 0;
+	m_numVertices = 0;
+	m_numPolys = 0;
+	m_meshOffset = 0;
+	m_vertices = NULL;
+	m_normals = NULL;
+	m_textureVertices = NULL;
+	m_meshes = NULL;
+	m_ownsArrays = FALSE;
+}
+
+LegoLODData::~LegoLODData()
+{
+	if (m_meshes != NULL) {
+		for (LegoU32 i = 0; i < m_numMeshes; i++) {
+			delete m_meshes[i].m_mesh;
+
+			if (m_ownsArrays) {
+				delete[] (LegoU8*) m_meshes[i].m_polyIndices;
+				delete[] (LegoU8*) m_meshes[i].m_textureIndices;
+			}
+		}
+
+		delete[] m_meshes;
+	}
+
+	if (m_ownsArrays) {
+		delete[] (LegoU8*) m_vertices;
+		delete[] (LegoU8*) m_normals;
+		delete[] (LegoU8*) m_textureVertices;
+	}
+}
+
+// Returns p_size bytes of p_storage, viewed in place if it is a LegoMemory and read
+// into a new array otherwise. NULL if p_size is 0 or the read failed.
+static const void* ReadArray(LegoStorage* p_storage, LegoU32 p_size, LegoBool p_copy)
+{
+	if (p_size == 0) {
+		return NULL;
+	}
+
+	if (!p_copy) {
+		return p_storage->View(p_size);
+	}
+
+	LegoU8* array = new LegoU8[p_size];
+
+	if (p_storage->Read(array, p_size) != SUCCESS) {
+		delete[] array;
+		return NULL;
+	}
+
+	return array;
+}
+
 // FUNCTION: LEGO1 0x100aa510
 LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_textureContainer, LegoStorage* p_storage)
 {
-	float(*normals)[3] = NULL;
-	float(*vertices)[3] = NULL;
-	float(*textureVertices)[2] = NULL;
-	LegoS32 numVerts = 0;
-	LegoS32 numNormals = 0;
-	LegoS32 numTextureVertices = 0;
-	LegoMesh* mesh = NULL;
-	LegoU32(*polyIndices)[3] = NULL;
-	LegoU32(*textureIndices)[3] = NULL;
-	LegoTextureInfo* textureInfo = NULL;
+	LegoLODData data;
+
+	if (Decode(p_storage, data) != SUCCESS) {
+		return FAILURE;
+	}
+
+	return Upload(p_renderer, p_textureContainer, data);
+}
 
+LegoResult LegoLOD::Decode(LegoStorage* p_storage, LegoLODData& p_data)
+{
+	LegoS32 numVerts, numNormals, numTextureVertices;
 	LegoU32 i, meshUnd1, meshUnd2, tempNumVertsAndNormals;
-	unsigned char paletteEntries[256];
+	LegoMesh* mesh;
+	LegoBool copy;
 
-	if (p_storage->Read(&m_unk0x08, sizeof(m_unk0x08)) != SUCCESS) {
-		goto done;
+	p_data.m_ownsArrays = copy = !p_storage->CanView();
+
+	if (p_storage->Read(&p_data.m_flags, sizeof(p_data.m_flags)) != SUCCESS) {
+		return FAILURE;
 	}
 
-	if (GetUnknown0x08Test4()) {
+	// See ViewLOD::GetUnknown0x08Test4
+	if (p_data.m_flags & 0x04) {
 		return SUCCESS;
 	}
 
-	m_meshBuilder = p_renderer->CreateMeshBuilder();
-
-	if (p_storage->Read(&m_numMeshes, sizeof(m_numMeshes)) != SUCCESS) {
-		goto done;
+	if (p_storage->Read(&p_data.m_numMeshes, sizeof(p_data.m_numMeshes)) != SUCCESS) {
+		return FAILURE;
 	}
 
-	if (m_numMeshes == 0) {
-		ClearFlag(c_bit4);
+	if (p_data.m_numMeshes == 0) {
 		return SUCCESS;
 	}
 
-	SetFlag(c_bit4);
+	p_data.m_meshes = new LegoLODData::Mesh[p_data.m_numMeshes];
+	memset(p_data.m_meshes, 0, sizeof(*p_data.m_meshes) * p_data.m_numMeshes);
 
-	m_melems = new Mesh[m_numMeshes];
-	memset(m_melems, 0, sizeof(*m_melems) * m_numMeshes);
-
-	meshUnd1 = m_numMeshes - 1;
+	meshUnd1 = p_data.m_numMeshes - 1;
 	meshUnd2 = 0;
 
 	if (p_storage->Read(&tempNumVertsAndNormals, sizeof(tempNumVertsAndNormals)) != SUCCESS) {
-		goto done;
+		return FAILURE;
 	}
 
 	numVerts = *((LegoU16*) &tempNumVertsAndNormals) & MAXSHORT;
 	numNormals = (*((LegoU16*) &tempNumVertsAndNormals + 1) >> 1) & MAXSHORT;
 
 	if (p_storage->Read(&numTextureVertices, sizeof(numTextureVertices)) != SUCCESS) {
-		goto done;
+		return FAILURE;
 	}
 
 	if (numVerts > 0) {
-		vertices = new float[numVerts][sizeOfArray(*vertices)];
-		if (p_storage->Read(vertices, numVerts * sizeof(*vertices)) != SUCCESS) {
-			goto done;
+		p_data.m_vertices = (const float(*)[3]) ReadArray(p_storage, numVerts * sizeof(*p_data.m_vertices), copy);
+		if (p_data.m_vertices == NULL) {
+			return FAILURE;
 		}
 	}
 
 	if (numNormals > 0) {
-		normals = new float[numNormals][sizeOfArray(*normals)];
-		if (p_storage->Read(normals, numNormals * sizeof(*normals)) != SUCCESS) {
-			goto done;
+		p_data.m_normals = (const float(*)[3]) ReadArray(p_storage, numNormals * sizeof(*p_data.m_normals), copy);
+		if (p_data.m_normals == NULL) {
+			return FAILURE;
 		}
 	}
 
 	if (numTextureVertices > 0) {
-		textureVertices = new float[numTextureVertices][sizeOfArray(*textureVertices)];
-		if (p_storage->Read(textureVertices, numTextureVertices * sizeof(*textureVertices)) != SUCCESS) {
-			goto done;
+		LegoU32 size = numTextureVertices * sizeof(*p_data.m_textureVertices);
+		p_data.m_textureVertices = (const float(*)[2]) ReadArray(p_storage, size, copy);
+		if (p_data.m_textureVertices == NULL) {
+			return FAILURE;
 		}
 	}
 
-	for (i = 0; i < m_numMeshes; i++) {
-		LegoU32 numPolys, numVertices, numTextureIndices, meshIndex;
-		const LegoChar *textureName, *materialName;
-		Tgl::ShadingModel shadingModel;
+	for (i = 0; i < p_data.m_numMeshes; i++) {
+		LegoLODData::Mesh& meshData = p_data.m_meshes[i];
+		LegoU32 numPolys, numVertices, numTextureIndices, indicesSize;
 
 		if (p_storage->Read(&numPolys, 2) != SUCCESS) {
-			goto done;
+			return FAILURE;
 		}
 
-		m_numPolys += numPolys & USHRT_MAX;
+		meshData.m_numPolys = numPolys & USHRT_MAX;
+		p_data.m_numPolys += meshData.m_numPolys;
 
 		if (p_storage->Read(&numVertices, 2) != SUCCESS) {
-			goto done;
+			return FAILURE;
 		}
 
-		polyIndices = new LegoU32[numPolys & USHRT_MAX][sizeOfArray(*polyIndices)];
-		if (p_storage->Read(polyIndices, (numPolys & USHRT_MAX) * sizeof(*polyIndices)) != SUCCESS) {
-			goto done;
+		meshData.m_numVertices = numVertices & USHRT_MAX;
+		p_data.m_numVertices += meshData.m_numVertices;
+
+		indicesSize = meshData.m_numPolys * sizeof(*meshData.m_polyIndices);
+
+		meshData.m_polyIndices = (const LegoU32(*)[3]) ReadArray(p_storage, indicesSize, copy);
+		if (meshData.m_polyIndices == NULL && indicesSize != 0) {
+			return FAILURE;
 		}
 
 		if (p_storage->Read(&numTextureIndices, sizeof(numTextureIndices)) != SUCCESS) {
-			goto done;
+			return FAILURE;
 		}
 
 		if (numTextureIndices > 0) {
-			textureIndices = new LegoU32[numPolys & USHRT_MAX][sizeOfArray(*textureIndices)];
-			if (p_storage->Read(textureIndices, (numPolys & USHRT_MAX) * sizeof(*textureIndices)) != SUCCESS) {
-				goto done;
+			meshData.m_textureIndices = (const LegoU32(*)[3]) ReadArray(p_storage, indicesSize, copy);
+			if (meshData.m_textureIndices == NULL && indicesSize != 0) {
+				return FAILURE;
 			}
 		}
-		else {
-			textureIndices = NULL;
-		}
 
-		mesh = new LegoMesh();
+		meshData.m_mesh = mesh = new LegoMesh();
 
 		if (mesh->Read(p_storage) != SUCCESS) {
-			goto done;
+			return FAILURE;
+		}
+
+		if (FUN_100aae20(mesh->GetTextureName()) || FUN_100aae20(mesh->GetMaterialName())) {
+			meshData.m_index = meshUnd1;
+			meshUnd1--;
+		}
+		else {
+			meshData.m_index = meshUnd2;
+			meshUnd2++;
 		}
+	}
+
+	p_data.m_meshOffset = meshUnd2;
+	return SUCCESS;
+}
+
+LegoResult LegoLOD::Upload(
+	Tgl::Renderer* p_renderer,
+	LegoTextureContainer* p_textureContainer,
+	const LegoLODData& p_data
+)
+{
+	const LegoChar** textureNames = NULL;
+	LegoTextureInfo** textureInfos = NULL;
+	LegoResult result = FAILURE;
+	LegoU32 i;
+	unsigned char paletteEntries[256];
+
+	m_unk0x08 = p_data.m_flags;
+
+	if (GetUnknown0x08Test4()) {
+		return SUCCESS;
+	}
+
+	m_meshBuilder = p_renderer->CreateMeshBuilder();
+
+	if (p_data.m_numMeshes == 0) {
+		ClearFlag(c_bit4);
+		return SUCCESS;
+	}
+
+	SetFlag(c_bit4);
+
+	m_numMeshes = p_data.m_numMeshes;
+	m_numVertices = p_data.m_numVertices;
+	m_numPolys = p_data.m_numPolys;
+
+	m_melems = new Mesh[m_numMeshes];
+	memset(m_melems, 0, sizeof(*m_melems) * m_numMeshes);
+
+	// Resolve all texture names before creating any mesh
+	textureNames = new const LegoChar*[m_numMeshes];
+	textureInfos = new LegoTextureInfo*[m_numMeshes];
+
+	for (i = 0; i < m_numMeshes; i++) {
+		textureNames[i] = p_data.m_meshes[i].m_mesh->GetTextureName();
+	}
+
+	if (p_textureContainer->Get(textureNames, textureInfos, m_numMeshes) != 0) {
+		goto done;
+	}
+
+	for (i = 0; i < m_numMeshes; i++) {
+		const LegoLODData::Mesh& meshData = p_data.m_meshes[i];
+		LegoMesh* mesh = meshData.m_mesh;
+		Mesh& melem = m_melems[meshData.m_index];
+		Tgl::ShadingModel shadingModel;
 
 		switch (mesh->GetShading()) {
 		case LegoMesh::e_flat:
@@ -179,51 +310,32 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 			shadingModel = Tgl::Gouraud;
 		}
 
-		m_numVertices += numVertices & USHRT_MAX;
-
-		textureName = mesh->GetTextureName();
-		materialName = mesh->GetMaterialName();
-
-		if (FUN_100aae20(textureName) || FUN_100aae20(materialName)) {
-			meshIndex = meshUnd1;
-			meshUnd1--;
-		}
-		else {
-			meshIndex = meshUnd2;
-			meshUnd2++;
-		}
-
-		m_melems[meshIndex].m_tglMesh = m_meshBuilder->CreateMesh(
-			numPolys & USHRT_MAX,
-			numVertices & USHRT_MAX,
-			vertices,
-			normals,
-			textureVertices,
-			polyIndices,
-			textureIndices,
+		// CreateMesh only reads the arrays, they are not modified
+		melem.m_tglMesh = m_meshBuilder->CreateMesh(
+			meshData.m_numPolys,
+			meshData.m_numVertices,
+			(float(*)[3]) p_data.m_vertices,
+			(float(*)[3]) p_data.m_normals,
+			(float(*)[2]) p_data.m_textureVertices,
+			(unsigned long(*)[3]) meshData.m_polyIndices,
+			(unsigned long(*)[3]) meshData.m_textureIndices,
 			shadingModel
 		);
 
-		if (m_melems[meshIndex].m_tglMesh == NULL) {
+		if (melem.m_tglMesh == NULL) {
 			goto done;
 		}
 
-		m_melems[meshIndex].m_tglMesh->SetShadingModel(shadingModel);
+		melem.m_tglMesh->SetShadingModel(shadingModel);
 
-		if (textureName != NULL) {
+		if (textureNames[i] != NULL) {
 			if (mesh->GetUnknown0x21()) {
-				LegoROI::GetPaletteEntries(textureName, paletteEntries, sizeOfArray(paletteEntries));
+				LegoROI::GetPaletteEntries(textureNames[i], paletteEntries, sizeOfArray(paletteEntries));
 			}
 
-			textureInfo = p_textureContainer->Get(mesh->GetTextureName());
-
-			if (textureInfo == NULL) {
-				goto done;
-			}
-
-			m_melems[meshIndex].m_tglMesh->SetColor(1.0F, 1.0F, 1.0F, 0.0F);
-			LegoTextureInfo::SetGroupTexture(m_melems[meshIndex].m_tglMesh, textureInfo);
-			m_melems[meshIndex].m_unk0x04 = TRUE;
+			melem.m_tglMesh->SetColor(1.0F, 1.0F, 1.0F, 0.0F);
+			LegoTextureInfo::SetGroupTexture(melem.m_tglMesh, textureInfos[i]);
+			melem.m_unk0x04 = TRUE;
 		}
 		else {
 			LegoFloat red = 1.0F;
@@ -232,7 +344,7 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 			LegoFloat alpha = 0.0F;
 
 			if (mesh->GetUnknown0x21()) {
-				LegoROI::GetRGBAColor(materialName, red, green, blue, alpha);
+				LegoROI::GetRGBAColor(mesh->GetMaterialName(), red, green, blue, alpha);
 			}
 			else {
 				red = mesh->GetColor().GetRed() / 255.0;
@@ -241,65 +353,24 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 				alpha = mesh->GetAlpha();
 			}
 
-			m_melems[meshIndex].m_tglMesh->SetColor(red, green, blue, alpha);
+			melem.m_tglMesh->SetColor(red, green, blue, alpha);
 		}
 
 		if (mesh->GetUnknown0x0d() > 0) {
-			IDirect3DRMMesh* mesh;
+			IDirect3DRMMesh* d3dMesh;
 			D3DRMGROUPINDEX index;
-			GetMeshData(mesh, index, m_melems[meshIndex].m_tglMesh);
-			mesh->SetGroupMaterial(index, g_unk0x101013d4);
-		}
-
-		if (mesh != NULL) {
-			delete mesh;
-			mesh = NULL;
-		}
-		if (polyIndices != NULL) {
-			delete[] polyIndices;
-			polyIndices = NULL;
-		}
-		if (textureIndices != NULL) {
-			delete[] textureIndices;
-			textureIndices = NULL;
+			GetMeshData(d3dMesh, index, melem.m_tglMesh);
+			d3dMesh->SetGroupMaterial(index, g_unk0x101013d4);
 		}
 	}
 
-	m_meshOffset = meshUnd2;
-
-	if (textureVertices != NULL) {
-		delete[] textureVertices;
-	}
-	if (normals != NULL) {
-		delete[] normals;
-	}
-	if (vertices != NULL) {
-		delete[] vertices;
-	}
-
-	return SUCCESS;
+	m_meshOffset = p_data.m_meshOffset;
+	result = SUCCESS;
 
 done:
-	if (normals != NULL) {
-		delete[] normals;
-	}
-	if (vertices != NULL) {
-		delete[] vertices;
-	}
-	if (textureVertices != NULL) {
-		delete[] textureVertices;
-	}
-	if (mesh != NULL) {
-		delete mesh;
-	}
-	if (polyIndices != NULL) {
-		delete[] polyIndices;
-	}
-	if (textureIndices != NULL) {
-		delete[] textureIndices;
-	}
-
-	return FAILURE;
+	delete[] textureNames;
+	delete[] textureInfos;
+	return result;
 }
 
 // FUNCTION: LEGO1 0x100aabb0
@@ -313,6 +384,10 @@ LegoLOD* LegoLOD::Clone(Tgl::Renderer* p_renderer)
 	for (LegoU32 i = 0; i < m_numMeshes; i++) {
 		dupLod->m_melems[i].m_tglMesh = m_melems[i].m_tglMesh->ShallowClone(dupLod->m_meshBuilder);
 		dupLod->m_melems[i].m_unk0x04 = m_melems[i].m_unk0x04;
+
+		if (m_melems[i].m_unk0x04) {
+			LegoTextureInfo::CloneGroupTexture(m_melems[i].m_tglMesh, dupLod->m_melems[i].m_tglMesh);
+		}
 	}
 
 	dupLod->m_unk0x08 = m_unk0x08;
@@ -4,10 +4,50 @@
 #include "misc/legotypes.h"
 #include "viewmanager/viewlod.h"
 
+class LegoMesh;
 class LegoTextureContainer;
 class LegoTextureInfo;
 class LegoStorage;
 
+/**
+ * @brief [AI] Renderer-independent geometry of one LegoLOD, produced by LegoLOD::Decode and consumed by
+ * LegoLOD::Upload.
+ * @details [AI] Decoding only parses the storage: it touches neither the renderer nor the texture container, so
+ * several LODs can be decoded on worker threads (each with its own storage) and uploaded on the main thread
+ * afterwards.
+ *
+ * When the storage is a LegoMemory, the vertex, normal, texture coordinate and index arrays point into its buffer,
+ * which must then outlive the upload. Otherwise they are read into arrays owned by this object.
+ */
+class LegoLODData {
+public:
+	/**
+	 * @brief [AI] One sub-mesh of the LOD. [AI]
+	 */
+	struct Mesh {
+		LegoU32 m_numPolys;                   ///< [AI] Number of triangles.
+		LegoU32 m_numVertices;                ///< [AI] Number of vertices of the Tgl mesh.
+		const LegoU32 (*m_polyIndices)[3];    ///< [AI] Packed position/normal indices per triangle corner.
+		const LegoU32 (*m_textureIndices)[3]; ///< [AI] Texture coordinate indices, or NULL.
+		LegoMesh* m_mesh;                     ///< [AI] Color, shading and texture/material names; owned.
+		LegoU32 m_index;                      ///< [AI] Slot in LegoLOD::m_melems.
+	};
+
+	LegoLODData();
+	~LegoLODData();
+
+	undefined4 m_flags;                  ///< [AI] Becomes ViewLOD::m_unk0x08.
+	LegoU32 m_numMeshes;                 ///< [AI] Number of entries in m_meshes.
+	LegoU32 m_numVertices;               ///< [AI] Sum of the meshes' vertex counts.
+	LegoU32 m_numPolys;                  ///< [AI] Sum of the meshes' triangle counts.
+	LegoU32 m_meshOffset;                ///< [AI] First mesh that is not an "inh" mesh.
+	const float (*m_vertices)[3];        ///< [AI] Shared vertex positions, or NULL.
+	const float (*m_normals)[3];         ///< [AI] Shared normals, or NULL.
+	const float (*m_textureVertices)[2]; ///< [AI] Shared texture coordinates, or NULL.
+	Mesh* m_meshes;                      ///< [AI] Sub-meshes in storage order.
+	LegoBool m_ownsArrays;               ///< [AI] TRUE if the arrays were copied out of the storage.
+};
+
 // VTABLE: LEGO1 0x100dbf10
 // SIZE 0x20
 /**
@@ -69,9 +109,29 @@ class LegoLOD : public ViewLOD {
 	 * @param p_textureContainer Container to look up (by name) textures/material groups. [AI]
 	 * @param p_storage Stream/storage to read LOD binary data from. [AI]
 	 * @return Result code indicating success/failure of load. [AI]
+	 * @details [AI] Runs Decode and Upload back to back.
 	 */
 	LegoResult Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_textureContainer, LegoStorage* p_storage);
 
+	/**
+	 * @brief [AI] First half of Read: parses one LOD from storage into p_data.
+	 * @details [AI] Pure CPU work that may run off the main thread; see LegoLODData. [AI]
+	 * @param p_storage Stream/storage positioned at the LOD. [AI]
+	 * @param p_data Empty LegoLODData to fill. [AI]
+	 * @return FAILURE if the storage could not be read. [AI]
+	 */
+	static LegoResult Decode(LegoStorage* p_storage, LegoLODData& p_data);
+
+	/**
+	 * @brief [AI] Second half of Read: builds the Tgl meshes of this LOD from decoded data.
+	 * @details [AI] The texture names of all meshes are resolved in one batch before any mesh is created. [AI]
+	 * @param p_renderer Renderer to allocate resources for. [AI]
+	 * @param p_textureContainer Container to look up textures by name. [AI]
+	 * @param p_data Data produced by Decode. [AI]
+	 * @return FAILURE if a mesh could not be created or a texture is missing. [AI]
+	 */
+	LegoResult Upload(Tgl::Renderer* p_renderer, LegoTextureContainer* p_textureContainer, const LegoLODData& p_data);
+
 	/**
 	 * @brief [AI] Create an exact copy of this LOD, including cloned meshes, for another (or the same) renderer.
 	 * 
@@ -392,7 +392,7 @@ LegoResult LegoROI::FUN_100a8da0(LegoTreeNode* p_node, const Matrix4& p_matrix,
 
 	if (roi != NULL) {
 		FUN_100a8cb0(data, p_time, mat);
-		roi->m_local2world.Product(mat, p_matrix);
+		MXM4(roi->m_local2world, mat, p_matrix);
 		roi->VTable0x1c();
 
 		LegoBool und = data->FUN_100a0990(p_time);
@@ -420,7 +420,7 @@ void LegoROI::FUN_100a8e80(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_t
 
 	LegoROI* roi = p_roiMap[data->GetUnknown0x20()];
 	if (roi != NULL) {
-		roi->m_local2world.Product(mat, p_matrix);
+		MXM4(roi->m_local2world, mat, p_matrix);
 		roi->VTable0x1c();
 
 		LegoBool und = data->FUN_100a0990(p_time);
@@ -432,7 +432,7 @@ void LegoROI::FUN_100a8e80(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_t
 	}
 	else {
 		MxMatrix local2world;
-		local2world.Product(mat, p_matrix);
+		MXM4(local2world, mat, p_matrix);
 
 		for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
 			FUN_100a8e80(p_node->GetChild(i), local2world, p_time, p_roiMap);
@@ -451,7 +451,7 @@ void LegoROI::FUN_100a8fd0(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_t
 
 	LegoROI* roi = p_roiMap[data->GetUnknown0x20()];
 	if (roi != NULL) {
-		roi->m_local2world.Product(mat, p_matrix);
+		MXM4(roi->m_local2world, mat, p_matrix);
 
 		for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
 			FUN_100a8fd0(p_node->GetChild(i), roi->m_local2world, p_time, p_roiMap);
@@ -459,7 +459,7 @@ void LegoROI::FUN_100a8fd0(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_t
 	}
 	else {
 		MxMatrix local2world;
-		local2world.Product(mat, p_matrix);
+		MXM4(local2world, mat, p_matrix);
 
 		for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
 			FUN_100a8fd0(p_node->GetChild(i), local2world, p_time, p_roiMap);
@@ -589,6 +589,79 @@ LegoResult LegoROI::FUN_100a93b0(const LegoChar* p_name)
 	return 0;
 }
 
+// Conservative early-out for the box test in FUN_100a9410: returns FALSE if no point
+// p_start + t * p_dir, 0 <= t <= p_length, comes within the bounding sphere of the
+// box p_box transformed by p_local2world.
+static LegoBool SegmentReachesBox(
+	const BoundingBox& p_box,
+	const Matrix4& p_local2world,
+	const Vector3& p_start,
+	const Vector3& p_dir,
+	float p_length
+)
+{
+	float center[3], half[3], corner[3], offset[3];
+	float radiusSquared = 0.0f;
+	LegoS32 i, j, k;
+
+	for (i = 0; i < 3; i++) {
+		half[i] = (p_box.Max()[i] - p_box.Min()[i]) * 0.5f;
+		corner[i] = (p_box.Max()[i] + p_box.Min()[i]) * 0.5f;
+	}
+
+	for (j = 0; j < 3; j++) {
+		center[j] = p_local2world[3][j];
+
+		for (i = 0; i < 3; i++) {
+			center[j] += corner[i] * p_local2world[i][j];
+		}
+	}
+
+	// The farthest corner from the center; with a sheared matrix it need not be (+,+,+)
+	for (k = 0; k < 4; k++) {
+		float s1 = k & 1 ? -half[1] : half[1];
+		float s2 = k & 2 ? -half[2] : half[2];
+		float distSquared = 0.0f;
+
+		for (j = 0; j < 3; j++) {
+			float d = half[0] * p_local2world[0][j] + s1 * p_local2world[1][j] + s2 * p_local2world[2][j];
+			distSquared += d * d;
+		}
+
+		if (distSquared > radiusSquared) {
+			radiusSquared = distSquared;
+		}
+	}
+
+	float dirSquared = 0.0f;
+	float along = 0.0f;
+
+	for (j = 0; j < 3; j++) {
+		offset[j] = p_start[j] - center[j];
+		dirSquared += p_dir[j] * p_dir[j];
+		along -= offset[j] * p_dir[j];
+	}
+
+	float t = dirSquared > 0.0f ? along / dirSquared : 0.0f;
+
+	if (t < 0.0f) {
+		t = 0.0f;
+	}
+	else if (t > p_length) {
+		t = p_length;
+	}
+
+	float closestSquared = 0.0f;
+
+	for (j = 0; j < 3; j++) {
+		float d = offset[j] + t * p_dir[j];
+		closestSquared += d * d;
+	}
+
+	// Small slack so that grazing hits the plane tests would accept are never skipped
+	return closestSquared <= radiusSquared * 1.0001f + 0.0001f;
+}
+
 // FUNCTION: LEGO1 0x100a9410
 // FUNCTION: BETA10 0x1018b324
 LegoU32 LegoROI::FUN_100a9410(
@@ -601,6 +674,11 @@ LegoU32 LegoROI::FUN_100a9410(
 )
 {
 	if (p_collideBox) {
+		if (!SegmentReachesBox(m_unk0x80, m_local2world, p_v1, p_v2, p_f1)) {
+			p_v3 = m_local2world[3];
+			return 0;
+		}
+
 		Mx3DPointFloat v2(p_v2);
 		v2 *= p_f1;
 		v2 += p_v1;
@@ -729,6 +807,46 @@ LegoU32 LegoROI::FUN_100a9410(
 	return 0;
 }
 
+float LegoROI::GetCollisionExtent()
+{
+	const BoundingSphere& sphere = GetWorldBoundingSphere();
+	float offsetSquared = 0.0f;
+	LegoS32 i, j, k;
+
+	for (j = 0; j < 3; j++) {
+		float d = sphere.Center()[j] - m_local2world[3][j];
+		offsetSquared += d * d;
+	}
+
+	float extent = sqrt((double) offsetSquared) + sphere.Radius();
+	float extentSquared = 0.0f;
+
+	// Corners of m_unk0x80 relative to the origin, for the box test
+	for (k = 0; k < 8; k++) {
+		float distSquared = 0.0f;
+
+		for (j = 0; j < 3; j++) {
+			float d = 0.0f;
+
+			for (i = 0; i < 3; i++) {
+				d += (k & (1 << i) ? m_unk0x80.Max()[i] : m_unk0x80.Min()[i]) * m_local2world[i][j];
+			}
+
+			distSquared += d * d;
+		}
+
+		if (distSquared > extentSquared) {
+			extentSquared = distSquared;
+		}
+	}
+
+	if (extentSquared > extent * extent) {
+		extent = sqrt((double) extentSquared);
+	}
+
+	return extent;
+}
+
 // FUNCTION: LEGO1 0x100a9a50
 TimeROI::TimeROI(Tgl::Renderer* p_renderer, ViewLODList* p_lodList, LegoTime p_time) : LegoROI(p_renderer, p_lodList)
 {
@@ -186,6 +186,13 @@ class LegoROI : public ViewROI {
 	 */
 	LegoU32 FUN_100a9410(Vector3& p_v1, Vector3& p_v2, float p_f1, float p_f2, Vector3& p_v3, LegoBool p_collideBox);
 
+	/**
+	 * @brief [AI] Distance from the ROI's position to the farthest point FUN_100a9410 can report a hit at.
+	 * @details [AI] Covers both the world bounding sphere and the box, used to find which path boundaries may hold a
+	 * collision with this ROI. [AI]
+	 */
+	float GetCollisionExtent();
+
 	/**
 	 * @brief [AI] Sets this ROI's name, replacing the previous (converted to lower-case).
 	 * @param p_name [AI] New name to assign, or NULL to clear.
@@ -0,0 +1,122 @@
+#ifndef MXBLITTER_H
+#define MXBLITTER_H
+
+#include "mxtypes.h"
+
+/**
+ * @brief [AI] Pixel kernels used by MxDisplaySurface to draw 8-bit indexed bitmaps.
+ * @details [AI] The kernels only see plain memory: a destination pointer and pitch, a source pointer and stride,
+ * and for 16-bit targets the 256-entry palette built by MxDisplaySurface::SetPalette. They can therefore be run
+ * and timed on ordinary buffers, without DirectDraw.
+ *
+ * Pitches and strides are in bytes and may be negative (bottom-up bitmaps). The doubled variants scale by two in
+ * both directions: each source pixel is written twice and each output row is repeated on the row below it.
+ * Index 0 is the transparent key of the Transparent variants.
+ *
+ * The inner loops load four source indices at once and combine destination pixels into 32-bit stores. These go
+ * through memcpy, so buffers need no particular alignment, but the packing assumes little-endian byte order.
+ */
+class MxBlitter {
+public:
+	/**
+	 * @brief [AI] Copies an 8-bit indexed rectangle to an 8-bit surface. [AI]
+	 */
+	static void Copy8(
+		MxU8* p_dest,
+		MxLong p_destPitch,
+		const MxU8* p_src,
+		MxLong p_srcStride,
+		MxS32 p_width,
+		MxS32 p_height
+	);
+
+	/**
+	 * @brief [AI] Copies an 8-bit indexed rectangle to an 8-bit surface at twice its size. [AI]
+	 */
+	static void CopyDoubled8(
+		MxU8* p_dest,
+		MxLong p_destPitch,
+		const MxU8* p_src,
+		MxLong p_srcStride,
+		MxS32 p_width,
+		MxS32 p_height
+	);
+
+	/**
+	 * @brief [AI] Copies the non-zero pixels of an 8-bit indexed rectangle to an 8-bit surface. [AI]
+	 */
+	static void CopyTransparent8(
+		MxU8* p_dest,
+		MxLong p_destPitch,
+		const MxU8* p_src,
+		MxLong p_srcStride,
+		MxS32 p_width,
+		MxS32 p_height
+	);
+
+	/**
+	 * @brief [AI] Converts an 8-bit indexed rectangle to 16-bit pixels through p_palette. [AI]
+	 */
+	static void Expand16(
+		MxU8* p_dest,
+		MxLong p_destPitch,
+		const MxU8* p_src,
+		MxLong p_srcStride,
+		MxS32 p_width,
+		MxS32 p_height,
+		const MxU16* p_palette
+	);
+
+	/**
+	 * @brief [AI] Converts an 8-bit indexed rectangle to 16-bit pixels at twice its size. [AI]
+	 */
+	static void ExpandDoubled16(
+		MxU8* p_dest,
+		MxLong p_destPitch,
+		const MxU8* p_src,
+		MxLong p_srcStride,
+		MxS32 p_width,
+		MxS32 p_height,
+		const MxU16* p_palette
+	);
+
+	/**
+	 * @brief [AI] Converts the non-zero pixels of an 8-bit indexed rectangle to 16-bit pixels. [AI]
+	 */
+	static void ExpandTransparent16(
+		MxU8* p_dest,
+		MxLong p_destPitch,
+		const MxU8* p_src,
+		MxLong p_srcStride,
+		MxS32 p_width,
+		MxS32 p_height,
+		const MxU16* p_palette
+	);
+
+	/**
+	 * @brief [AI] Converts p_count indices to 16-bit pixels. [AI]
+	 */
+	static void ExpandRow16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette);
+
+	/**
+	 * @brief [AI] Converts p_count indices to 2 * p_count 16-bit pixels, each pixel written twice. [AI]
+	 */
+	static void ExpandRowDoubled16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette);
+
+	/**
+	 * @brief [AI] Writes each of p_count indices twice. [AI]
+	 */
+	static void DoubleRow8(MxU8* p_dest, const MxU8* p_src, MxS32 p_count);
+
+	/**
+	 * @brief [AI] Copies the non-zero bytes of p_src, leaving the destination of zero bytes untouched. [AI]
+	 */
+	static void CopyTransparentRow8(MxU8* p_dest, const MxU8* p_src, MxS32 p_count);
+
+	/**
+	 * @brief [AI] Converts the non-zero indices of p_src, leaving the destination of zero indices untouched. [AI]
+	 */
+	static void ExpandTransparentRow16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette);
+};
+
+#endif // MXBLITTER_H
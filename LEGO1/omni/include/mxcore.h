@@ -2,6 +2,7 @@
 #define MXCORE_H
 
 #include "compat.h"
+#include "mxtypeid.h"
 #include "mxtypes.h"
 
 #include <string.h>
@@ -48,6 +49,11 @@ class MxCore {
 		return !strcmp(p_name, MxCore::ClassName());
 	}
 
+	/// \brief [AI] Cached equivalent of IsA(p_type.GetName()).
+	/// \details [AI] Prefer this over the string form wherever the class name is fixed at compile time; see MxTypeId.
+	/// \param p_type [AI] Interned class name, e.g. MX_TYPEID(MxPresenter).
+	MxBool IsKindOf(const MxTypeId& p_type) const { return MxTypeId::Check(this, p_type); }
+
 	/// \brief [AI] Gets the unique (per-process) id assigned to this object instance.
 	MxU32 GetId() { return m_id; }
 
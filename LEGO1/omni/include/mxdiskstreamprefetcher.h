@@ -0,0 +1,130 @@
+#ifndef MXDISKSTREAMPREFETCHER_H
+#define MXDISKSTREAMPREFETCHER_H
+
+#include "compat.h"
+#include "mxcriticalsection.h"
+#include "mxsemaphore.h"
+#include "mxthread.h"
+#include "mxtypes.h"
+
+class MxDSFile;
+
+/**
+ * @brief [AI] Read-ahead cache for MxDiskStreamProvider.
+ * @details [AI] Owns a second handle to the provider's SI file and a background thread that reads upcoming
+ * buffer-sized blocks into a small ring of slots while the provider thread is busy handing earlier blocks to
+ * the stream controller. The provider first asks the prefetcher for a block; only on a miss does it perform
+ * the blocking seek and read itself.
+ *
+ * Slots move through the states empty -> pending -> loading -> ready. Pending and loading slots are never
+ * evicted; ready slots are recycled least-recently-scheduled first.
+ */
+class MxDiskStreamPrefetcher : public MxThread {
+public:
+	MxDiskStreamPrefetcher();
+	~MxDiskStreamPrefetcher() override;
+
+	/**
+	 * @brief [AI] Opens a private handle to the SI file and starts the read-ahead thread.
+	 * @param p_filename Path of the SI file already opened by the provider. [AI]
+	 * @param p_blockSize Size of one streaming block in bytes (the SI header's buffer size). [AI]
+	 * @return SUCCESS if read-ahead is active; FAILURE if it is disabled or could not be started. [AI]
+	 */
+	MxResult Create(const char* p_filename, MxU32 p_blockSize);
+
+	/**
+	 * @brief [AI] Stops the read-ahead thread and releases the file handle and all slots. [AI]
+	 */
+	void Destroy();
+
+	/**
+	 * @brief [AI] Thread entry point; services pending slots until Destroy is called. [AI]
+	 */
+	MxResult Run() override;
+
+	/**
+	 * @brief [AI] Queues up to GetDepth() blocks of p_size bytes, starting at p_offset, for read-ahead.
+	 * @details [AI] Blocks that are already queued, loading or cached are skipped, as are blocks past the end of file.
+	 * @param p_offset File offset of the first block to read ahead. [AI]
+	 * @param p_size Size of each block in bytes. [AI]
+	 */
+	void Schedule(MxU32 p_offset, MxU32 p_size);
+
+	/**
+	 * @brief [AI] Copies a block out of the cache if it has been (or is being) read ahead.
+	 * @details [AI] If the block is still loading, waits on the slot's event rather than issuing a duplicate read.
+	 * @param p_offset File offset of the requested block. [AI]
+	 * @param p_dest Destination buffer. [AI]
+	 * @param p_size Number of bytes requested. [AI]
+	 * @return SUCCESS if the block was served from the cache, FAILURE on a miss. [AI]
+	 */
+	MxResult Read(MxU32 p_offset, MxU8* p_dest, MxU32 p_size);
+
+	/**
+	 * @brief [AI] Drops all blocks that are not currently loading. [AI]
+	 */
+	void Flush();
+
+	/**
+	 * @brief [AI] Returns the number of blocks served from the cache. [AI]
+	 */
+	MxU32 GetHits() const { return m_hits; }
+
+	/**
+	 * @brief [AI] Returns the number of blocks that had to be read synchronously. [AI]
+	 */
+	MxU32 GetMisses() const { return m_misses; }
+
+	/**
+	 * @brief [AI] Sets the number of blocks kept in flight per disk stream. 0 disables read-ahead.
+	 * @details [AI] Takes effect for providers created afterwards.
+	 */
+	static void SetDepth(MxU32 p_depth) { g_depth = p_depth; }
+
+	/**
+	 * @brief [AI] Returns the configured read-ahead depth. [AI]
+	 */
+	static MxU32 GetDepth() { return g_depth; }
+
+	/**
+	 * @brief [AI] State of a single read-ahead slot. [AI]
+	 */
+	enum SlotState {
+		e_empty = 0,   ///< [AI] Slot holds no data.
+		e_pending = 1, ///< [AI] Block is queued and waiting for the read-ahead thread.
+		e_loading = 2, ///< [AI] Block is being read by the read-ahead thread.
+		e_ready = 3    ///< [AI] Block is cached and can be handed out.
+	};
+
+	/**
+	 * @brief [AI] One block-sized read-ahead buffer. [AI]
+	 */
+	struct Slot {
+		MxU8* m_data;    ///< [AI] Block storage, m_capacity bytes.
+		MxU32 m_offset;  ///< [AI] File offset of the cached block.
+		MxU32 m_size;    ///< [AI] Size of the cached block in bytes.
+		MxU32 m_stamp;   ///< [AI] Scheduling sequence number, used to recycle the oldest ready slot.
+		MxU8 m_state;    ///< [AI] One of SlotState.
+		HANDLE m_loaded; ///< [AI] Manual-reset event, reset while the slot is loading and set once it is not.
+	};
+
+private:
+	Slot* FindSlot(MxU32 p_offset);
+	Slot* RecycleSlot();
+
+	static MxU32 g_depth;
+
+	MxDSFile* m_file;              ///< [AI] Private handle to the SI file, so reads never disturb the provider's file position.
+	Slot* m_slots;                 ///< [AI] Array of m_numSlots read-ahead slots.
+	MxU32 m_numSlots;              ///< [AI] Number of slots (the depth at creation time).
+	MxU32 m_capacity;              ///< [AI] Capacity of each slot in bytes.
+	MxU32 m_fileSize;              ///< [AI] Size of the SI file, used to stop read-ahead at end of file.
+	MxU32 m_stamp;                 ///< [AI] Next scheduling sequence number.
+	MxU32 m_hits;                  ///< [AI] Blocks served from the cache.
+	MxU32 m_misses;                ///< [AI] Blocks not found in the cache.
+	MxBool m_active;               ///< [AI] TRUE while the read-ahead thread should keep running.
+	MxSemaphore m_work;            ///< [AI] Counts pending slots; the thread waits on it.
+	MxCriticalSection m_lock;      ///< [AI] Guards m_slots and the counters.
+};
+
+#endif // MXDISKSTREAMPREFETCHER_H
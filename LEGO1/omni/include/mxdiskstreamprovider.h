@@ -4,6 +4,7 @@
 #include "compat.h"
 #include "decomp.h"
 #include "mxcriticalsection.h"
+#include "mxdiskstreamprefetcher.h"
 #include "mxdsaction.h"
 #include "mxstreamprovider.h"
 #include "mxthread.h"
@@ -16,6 +17,7 @@
  * SIZE: 0x1c [AI]
  */
 class MxDiskStreamProvider;
+class MxDSBuffer;
 class MxDSStreamingAction;
 
 class MxDiskStreamProviderThread : public MxThread {
@@ -53,7 +55,7 @@ class MxDiskStreamProviderThread : public MxThread {
  * @brief [AI] Disk-based stream provider for resource loading using background streaming and multithreading.
  * @details [AI] Handles asynchronous loading and management of resources from disk by employing internal buffering,
  * file/stream semantics, synchronization, and thread-based execution. Supports the LEGO SI file streaming system.
- * SIZE: 0x60 [AI]
+ * SIZE: 0x60 [AI] (retail, without read-ahead)
  */
 class MxDiskStreamProvider : public MxStreamProvider {
 public:
@@ -113,6 +115,16 @@ class MxDiskStreamProvider : public MxStreamProvider {
 	 */
 	MxResult FUN_100d1b20(MxDSStreamingAction* p_action);
 
+	/**
+	 * @brief [AI] Fills a buffer with the block at the given file offset.
+	 * @details [AI] Serves the block from the read-ahead cache when possible, otherwise seeks and reads synchronously.
+	 * Either way, the blocks following it are queued for read-ahead.
+	 * @param p_offset File offset of the block. [AI]
+	 * @param p_buffer Buffer to fill; its write offset is the number of bytes to read. [AI]
+	 * @return SUCCESS if the buffer was filled. [AI]
+	 */
+	MxResult ReadBlock(MxU32 p_offset, MxDSBuffer* p_buffer);
+
 	/**
 	 * @brief [AI] Opens and prepares a resource for streaming from disk based on the controller's atom (resource key).
 	 * @details [AI] Tries to open the resource from hard disk, then falls back to CD. Initializes queues and starts the thread.
@@ -181,6 +193,11 @@ class MxDiskStreamProvider : public MxStreamProvider {
 	 * @brief [AI] List of streaming actions to be processed/completed by the thread.
 	 */
 	MxDSObjectList m_list;               // 0x54
+
+	/**
+	 * @brief [AI] Keeps the next few buffer-sized blocks of the file in flight while the thread hands out the current one.
+	 */
+	MxDiskStreamPrefetcher m_prefetcher; // 0x60
 };
 
 #endif // MXDISKSTREAMPROVIDER_H
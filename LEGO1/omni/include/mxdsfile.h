@@ -101,12 +101,43 @@ class MxDSFile : public MxDSSource {
 	 */
 	void SetFileName(const char* p_filename) { m_filename = p_filename; }
 
+	/**
+	 * @brief [AI] Returns the SI file's name. [AI]
+	 */
+	const char* GetFileName() { return m_filename.GetData(); }
+
 	/**
 	 * @brief [AI] Calculates and returns the file size by querying the system (Windows GetFileSize).
 	 * @return The file's size, or an error code from GetFileSize. [AI]
 	 */
 	MxS32 CalcFileSize() { return GetFileSize(m_io.m_info.hmmio, NULL); }
 
+	/**
+	 * @brief [AI] Switches the open file to memory-mapped mode.
+	 * @details [AI] Maps the whole SI file as a copy-on-write view. Subsequent Read and Seek calls are served
+	 * straight from the view instead of going through MXIOINFO's buffered reads.
+	 * @return SUCCESS if the file is (now) mapped, FAILURE if mapping is not possible; the file then stays in buffered mode. [AI]
+	 */
+	MxResult MapView();
+
+	/**
+	 * @brief [AI] Returns the mapped view of the file, or NULL if the file is not mapped. [AI]
+	 */
+	MxU8* GetView() { return m_view; }
+
+	/**
+	 * @brief [AI] Returns the size of the mapped view in bytes. [AI]
+	 */
+	MxULong GetViewSize() { return m_viewSize; }
+
+	/**
+	 * @brief [AI] Transfers ownership of the mapped view to the caller.
+	 * @details [AI] The file falls back to buffered mode. The view stays valid after the file is closed or destroyed
+	 * and must be released with MXIOINFO::UnmapView.
+	 * @return The view, or NULL if the file was not mapped. [AI]
+	 */
+	MxU8* DetachView();
+
 	// SIZE 0x0c
 	/**
 	 * @brief [AI] Represents the SI file stream's header chunk, containing versioning and SI buffer info. [AI]
@@ -140,6 +171,9 @@ class MxDSFile : public MxDSSource {
 	 * @brief [AI] If false, SI chunks are read immediately on open; if true, chunks are deferred until ReadChunks is explicitly called. [AI]
 	 */
 	MxULong m_skipReadingChunks; // 0x78
+
+	MxU8* m_view;       ///< [AI] Copy-on-write view of the whole file when mapped, otherwise NULL. [AI]
+	MxULong m_viewSize; ///< [AI] Size of m_view in bytes. [AI]
 };
 
 #endif // MXDSFILE_H
\ No newline at end of file
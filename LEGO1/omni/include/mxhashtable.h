@@ -9,8 +9,9 @@
 
 /**
  * @class MxHashTableNode
- * @brief [AI] Node used within the MxHashTable to store an individual object and associated hash, for organizing elements in a bucketed linked list.
- * @details [AI] Each hash table slot contains a linked list of these nodes. Each node stores an object of type T and the corresponding hash, as well as pointers to previous and next nodes in the bucket's list.
+ * @brief [AI] One slot of the open-addressing MxHashTable: an object, its hash and its probe distance.
+ * @details [AI] The table is a flat array of these. A slot with m_distance == 0 is empty; otherwise m_distance is
+ * one more than the number of slots the object sits past its home slot (hash masked by the table size).
  * @tparam T [AI] Type of object stored in the hash table node.
  */
 template <class T>
@@ -19,21 +20,6 @@ class MxHashTableCursor;
 template <class T>
 class MxHashTableNode {
 public:
-	/**
-	 * @brief [AI] Constructor for a new hash node with its associated object, hash value, and linkage pointers.
-	 * @param p_obj [AI] The object value held by this node.
-	 * @param p_hash [AI] The precomputed hash for the stored object.
-	 * @param p_prev [AI] The node preceding this one in the bucket's linked list (can be nullptr).
-	 * @param p_next [AI] The node following this one in the bucket's linked list (can be nullptr).
-	 */
-	MxHashTableNode<T>(T p_obj, MxU32 p_hash, MxHashTableNode* p_prev, MxHashTableNode* p_next)
-	{
-		m_obj = p_obj;
-		m_hash = p_hash;
-		m_prev = p_prev;
-		m_next = p_next;
-	}
-
 	// DECOMP: Should use getter and setter methods here per the style guide.
 	// However, LEGO1D (with no functions inlined) does not use them.
 
@@ -41,68 +27,62 @@ class MxHashTableNode {
 	T m_obj;
 	/// @brief [AI] The hash value for m_obj, used for placement/search in the table.
 	MxU32 m_hash;
-	/// @brief [AI] Previous node in the linked list chain within the current bucket.
-	MxHashTableNode* m_prev;
-	/// @brief [AI] Next node in the linked list chain within the current bucket.
-	MxHashTableNode* m_next;
+	/// @brief [AI] Probe distance from the home slot plus one; 0 marks an empty slot.
+	MxU32 m_distance;
 };
 
 /**
  * @class MxHashTable
- * @brief [AI] Generic hash table collection implementing chained (bucketed) hashing, used for efficient lookup and storage of objects by key or value.
- * @details [AI] Inherits collection semantics from MxCollection<T> but also manages resizing, hash calculation, and separate chaining (via MxHashTableNode). Provides insert, deletion, and all-bucket purge operations. Resizing policies can be controlled via Option.
+ * @brief [AI] Generic open-addressing hash table, used for efficient lookup and storage of objects by key or value.
+ * @details [AI] Inherits collection semantics from MxCollection<T>. Objects live directly in a power-of-two array of
+ * slots using linear probing with Robin Hood placement: an inserted object displaces any resident that is closer to
+ * its own home slot, which keeps probe sequences short and lets a lookup stop as soon as it meets a resident closer
+ * to home than the probe. Removal shifts the following run back by one instead of leaving tombstones. The table
+ * doubles whenever it would become more than three quarters full.
+ *
+ * Besides lookup by object (Hash() and Compare()), the cursor supports heterogeneous lookup by a precomputed hash
+ * and a match function, so callers can search by a raw key without constructing a temporary T.
  * @tparam T [AI] Type of object managed by the hash table.
  */
 template <class T>
 class MxHashTable : protected MxCollection<T> {
 public:
 	/**
-	 * @brief [AI] Enum describing the strategy for resizing the hash table when load increases.
-	 */
-	enum Option {
-		e_noExpand = 0,    ///< [AI] Never resize (table will not expand regardless of load).
-		e_expandAll,       ///< [AI] Fixed amount of slots added on resize.
-		e_expandMultiply,  ///< [AI] Table size is multiplied by a factor on resize.
-	};
-
-	/**
-	 * @brief [AI] Default constructor. Initializes hash table with HASH_TABLE_INIT_SIZE slots and configures resizing behavior.
+	 * @brief [AI] Default constructor. Initializes the hash table with HASH_TABLE_INIT_SIZE empty slots.
 	 */
 	MxHashTable()
 	{
 		m_numSlots = HASH_TABLE_INIT_SIZE;
-		MxU32 unused = 0;
-		m_slots = new MxHashTableNode<T>*[m_numSlots];
-		memset(m_slots, 0, sizeof(MxHashTableNode<T>*) * m_numSlots);
-		m_resizeOption = e_noExpand;
+		m_slots = new MxHashTableNode<T>[m_numSlots];
+		memset(m_slots, 0, sizeof(MxHashTableNode<T>) * m_numSlots);
+		m_growThreshold = m_numSlots / 4 * 3;
 	}
 
 	/**
-	 * @brief [AI] Destructor. Purges all contained nodes and releases bucket array.
+	 * @brief [AI] Destructor. Destroys all contained objects and releases the slot array.
 	 */
 	~MxHashTable() override;
 
 	/**
-	 * @brief [AI] Expand/recreates the hash table according to the current resizing policy.
-	 * @details [AI] Moves nodes from the old bucket array to a newly sized one based on m_resizeOption, re-bucketing all nodes.
+	 * @brief [AI] Doubles the number of slots and re-inserts every object.
 	 */
 	void Resize();
 
 	/**
-	 * @brief [AI] Inserts a new item into the hash table, possibly resizing if automatic resize is enabled and load threshold is exceeded.
+	 * @brief [AI] Inserts a new item into the hash table, doubling the table first if it would exceed its load limit.
 	 * @param [AI] p_newobj The item to insert.
 	 */
 	void Add(T);
 
 	/**
-	 * @brief [AI] Removes and destructs all nodes in all hash buckets, clearing the table.
+	 * @brief [AI] Destroys all objects and empties every slot.
 	 */
 	void DeleteAll();
 
 	/**
 	 * @brief [AI] Computes the hash of the given object. Should be overridden for meaningful hash computation.
 	 * @param [AI] (unnamed) The object to compute the hash for.
-	 * @return [AI] Hash value appropriate for placing the object in a bucket.
+	 * @return [AI] Hash value appropriate for placing the object in a slot.
 	 */
 	virtual MxU32 Hash(T) { return 0; } // [AI] To be overridden by subclasses.
 
@@ -110,39 +90,33 @@ class MxHashTable : protected MxCollection<T> {
 
 protected:
 	/**
-	 * @brief [AI] Inserts a given node into the relevant hash bucket according to the node's hash value.
-	 * @param p_node [AI] Node (already allocated) to insert into appropriate bucket.
+	 * @brief [AI] Places an object with a known hash, assuming the table has room for it.
+	 * @param p_obj [AI] Object to insert.
+	 * @param p_hash [AI] Hash of p_obj.
 	 */
-	void NodeInsert(MxHashTableNode<T>*);
-
-	/// @brief [AI] Array of pointers to bucket heads; each slot is a chain of nodes (linked list) holding objects with equal (modulo table size) hashes.
-	MxHashTableNode<T>** m_slots; // 0x10
+	void NodeInsert(T p_obj, MxU32 p_hash);
 
-	/// @brief [AI] Number of hash buckets in the table; controls how hash values are mapped to buckets.
-	MxU32 m_numSlots;             // 0x14
+	/**
+	 * @brief [AI] Empties the slot at p_index by shifting the rest of its probe run back one slot.
+	 * @param p_index [AI] Index of an occupied slot.
+	 */
+	void NodeRemove(MxU32 p_index);
 
-	/// @brief [AI] Ratio at which the table will auto-resize (load factor denominator).
-	MxU32 m_autoResizeRatio;      // 0x18
+	/// @brief [AI] Array of m_numSlots slots holding the objects in place.
+	MxHashTableNode<T>* m_slots; // 0x10
 
-	/// @brief [AI] Strategy currently in use for resizing the table when needed.
-	Option m_resizeOption;        // 0x1c
+	/// @brief [AI] Number of slots in the table; always a power of two.
+	MxU32 m_numSlots;            // 0x14
 
-	/**
-	 * @brief [AI] Union holding the setting for table expansion:
-	 * - m_increaseAmount (when using e_expandAll): slots to add on resize.
-	 * - m_increaseFactor (when using e_expandMultiply): multiplicative factor for resizing (e.g. double the table).
-	 * Purpose is determined by m_resizeOption.
-	 */
-	union {
-		MxU32 m_increaseAmount;  // 0x20
-		double m_increaseFactor; // 0x20
-	};
+	/// @brief [AI] Object count above which the table doubles (three quarters of m_numSlots).
+	MxU32 m_growThreshold;       // 0x18
 };
 
 /**
  * @class MxHashTableCursor
  * @brief [AI] Non-intrusive search-and-edit cursor for navigating, querying, or deleting a specific entry in an MxHashTable.
- * @details [AI] Used to locate and possibly remove or edit a single object in the hash table by value, based on its hash and value equality.
+ * @details [AI] Used to locate and possibly remove or edit a single object in the hash table, either by value (using the
+ * table's Hash and Compare functions) or by a precomputed hash and a caller-supplied match function.
  * @tparam T [AI] The object type in the associated hash table.
  */
 template <class T>
@@ -155,17 +129,27 @@ class MxHashTableCursor : public MxCore {
 	MxHashTableCursor(MxHashTable<T>* p_table)
 	{
 		m_table = p_table;
-		m_match = NULL;
+		m_match = -1;
 	}
 
 	/**
-	 * @brief [AI] Finds and focuses the cursor on the first node matching the given object by hash and value; supports set-by-value semantics.
+	 * @brief [AI] Finds and focuses the cursor on the node matching the given object by hash and value; supports set-by-value semantics.
 	 * @param p_obj [AI] Value to search for in table using table's Compare and Hash functions.
 	 * @retval TRUE [AI] If a match was found and cursor now points to it.
 	 * @retval FALSE [AI] If no such object exists in table.
 	 */
 	MxBool Find(T p_obj);
 
+	/**
+	 * @brief [AI] Finds and focuses the cursor on the node whose object matches an arbitrary key.
+	 * @param p_hash [AI] Hash of the key, computed the same way the table's Hash() would for a matching object.
+	 * @param p_match [AI] Returns TRUE if the object matches the key.
+	 * @param p_key [AI] Key passed through to p_match.
+	 * @retval TRUE [AI] If a match was found and cursor now points to it.
+	 * @retval FALSE [AI] If no such object exists in table.
+	 */
+	MxBool Find(MxU32 p_hash, MxBool (*p_match)(T, const void*), const void* p_key);
+
 	/**
 	 * @brief [AI] Retrieves the object at the current match position, if valid.
 	 * @param p_obj [AI] (out parameter) Receives the matching object value if cursor is positioned on a node.
@@ -174,7 +158,7 @@ class MxHashTableCursor : public MxCore {
 	MxBool Current(T& p_obj);
 
 	/**
-	 * @brief [AI] If the cursor points to a match, removes it from table and destroys the node.
+	 * @brief [AI] If the cursor points to a match, removes it from table and destroys the object.
 	 */
 	void DeleteMatch();
 
@@ -182,55 +166,75 @@ class MxHashTableCursor : public MxCore {
 	/// @brief [AI] The hash table this cursor is operating upon.
 	MxHashTable<T>* m_table;
 
-	/// @brief [AI] Currently matched node (from a find), or nullptr if not positioned.
-	MxHashTableNode<T>* m_match;
+	/// @brief [AI] Slot index of the current match, or -1 if not positioned.
+	MxS32 m_match;
 };
 
 template <class T>
 MxBool MxHashTableCursor<T>::Find(T p_obj)
 {
 	MxU32 hash = m_table->Hash(p_obj);
+	MxU32 mask = m_table->m_numSlots - 1;
+	MxU32 index = hash & mask;
+
+	m_match = -1;
+
+	// Robin Hood invariant: once a resident is closer to home than our probe, the object is not in the table
+	for (MxU32 distance = 1; m_table->m_slots[index].m_distance >= distance; distance++) {
+		MxHashTableNode<T>* t = &m_table->m_slots[index];
 
-	for (MxHashTableNode<T>* t = m_table->m_slots[hash % m_table->m_numSlots]; t; t = t->m_next) {
 		if (t->m_hash == hash && !m_table->Compare(t->m_obj, p_obj)) {
-			m_match = t;
+			m_match = index;
+			break;
 		}
+
+		index = (index + 1) & mask;
 	}
 
-	return m_match != NULL;
+	return m_match != -1;
+}
+
+template <class T>
+MxBool MxHashTableCursor<T>::Find(MxU32 p_hash, MxBool (*p_match)(T, const void*), const void* p_key)
+{
+	MxU32 mask = m_table->m_numSlots - 1;
+	MxU32 index = p_hash & mask;
+
+	m_match = -1;
+
+	for (MxU32 distance = 1; m_table->m_slots[index].m_distance >= distance; distance++) {
+		MxHashTableNode<T>* t = &m_table->m_slots[index];
+
+		if (t->m_hash == p_hash && p_match(t->m_obj, p_key)) {
+			m_match = index;
+			break;
+		}
+
+		index = (index + 1) & mask;
+	}
+
+	return m_match != -1;
 }
 
 template <class T>
 MxBool MxHashTableCursor<T>::Current(T& p_obj)
 {
-	if (m_match) {
-		p_obj = m_match->m_obj;
+	if (m_match != -1) {
+		p_obj = m_table->m_slots[m_match].m_obj;
 	}
 
-	return m_match != NULL;
+	return m_match != -1;
 }
 
 template <class T>
 void MxHashTableCursor<T>::DeleteMatch()
 {
-	// Cut the matching node out of the linked list
-	// by updating pointer references.
-	if (m_match) {
-		if (m_match->m_prev) {
-			m_match->m_prev->m_next = m_match->m_next;
-		}
-		else {
-			// No "prev" node, so move "next" to the head of the list.
-			m_table->m_slots[m_match->m_hash % m_table->m_numSlots] = m_match->m_next;
-		}
-
-		if (m_match->m_next) {
-			m_match->m_next->m_prev = m_match->m_prev;
-		}
+	if (m_match != -1) {
+		T obj = m_table->m_slots[m_match].m_obj;
 
-		m_table->m_customDestructor(m_match->m_obj);
-		delete m_match;
-		m_table->m_count--;
+		m_table->NodeRemove(m_match);
+		m_table->m_customDestructor(obj);
+		m_match = -1;
 	}
 }
 
@@ -244,17 +248,14 @@ MxHashTable<T>::~MxHashTable()
 template <class T>
 void MxHashTable<T>::DeleteAll()
 {
-	for (MxS32 i = 0; i < m_numSlots; i++) {
-		MxHashTableNode<T>* next;
-		for (MxHashTableNode<T>* t = m_slots[i]; t != NULL; t = next) {
-			next = t->m_next;
-			this->m_customDestructor(t->m_obj);
-			delete t;
+	for (MxU32 i = 0; i < m_numSlots; i++) {
+		if (m_slots[i].m_distance) {
+			this->m_customDestructor(m_slots[i].m_obj);
 		}
 	}
 
 	this->m_count = 0;
-	memset(m_slots, 0, sizeof(MxHashTableNode<T>*) * m_numSlots);
+	memset(m_slots, 0, sizeof(MxHashTableNode<T>) * m_numSlots);
 }
 
 template <class T>
@@ -263,27 +264,17 @@ inline void MxHashTable<T>::Resize()
 	// Save a reference to the current table
 	// so we can walk nodes and re-insert
 	MxU32 oldSize = m_numSlots;
-	MxHashTableNode<T>** oldTable = m_slots;
-
-	switch (m_resizeOption) {
-	case e_expandAll:
-		m_numSlots += m_increaseAmount;
-		break;
-	case e_expandMultiply:
-		m_numSlots *= m_increaseFactor;
-		break;
-	}
+	MxHashTableNode<T>* oldTable = m_slots;
 
-	MxU32 unused = 0;
-	m_slots = new MxHashTableNode<T>*[m_numSlots];
-	memset(m_slots, 0, sizeof(MxHashTableNode<T>*) * m_numSlots);
+	m_numSlots *= 2;
+	m_slots = new MxHashTableNode<T>[m_numSlots];
+	memset(m_slots, 0, sizeof(MxHashTableNode<T>) * m_numSlots);
+	m_growThreshold = m_numSlots / 4 * 3;
 	this->m_count = 0;
 
-	for (MxS32 i = 0; i < oldSize; i++) {
-		MxHashTableNode<T>* next;
-		for (MxHashTableNode<T>* t = oldTable[i]; t != NULL; t = next) {
-			next = t->m_next;
-			NodeInsert(t);
+	for (MxU32 i = 0; i < oldSize; i++) {
+		if (oldTable[i].m_distance) {
+			NodeInsert(oldTable[i].m_obj, oldTable[i].m_hash);
 		}
 	}
 
@@ -291,33 +282,59 @@ inline void MxHashTable<T>::Resize()
 }
 
 template <class T>
-inline void MxHashTable<T>::NodeInsert(MxHashTableNode<T>* p_node)
+inline void MxHashTable<T>::NodeInsert(T p_obj, MxU32 p_hash)
 {
-	MxS32 bucket = p_node->m_hash % m_numSlots;
-
-	p_node->m_next = m_slots[bucket];
+	MxU32 mask = m_numSlots - 1;
+	MxU32 index = p_hash & mask;
+	MxHashTableNode<T> node;
+
+	node.m_obj = p_obj;
+	node.m_hash = p_hash;
+	node.m_distance = 1;
+
+	while (m_slots[index].m_distance) {
+		// Take the slot from a resident that is closer to its home, and carry it on instead
+		if (m_slots[index].m_distance < node.m_distance) {
+			MxHashTableNode<T> displaced = m_slots[index];
+			m_slots[index] = node;
+			node = displaced;
+		}
 
-	if (m_slots[bucket]) {
-		m_slots[bucket]->m_prev = p_node;
+		index = (index + 1) & mask;
+		node.m_distance++;
 	}
 
-	m_slots[bucket] = p_node;
+	m_slots[index] = node;
 	this->m_count++;
 }
 
+template <class T>
+inline void MxHashTable<T>::NodeRemove(MxU32 p_index)
+{
+	MxU32 mask = m_numSlots - 1;
+	MxU32 next = (p_index + 1) & mask;
+
+	// Pull the rest of the run back so lookups never need tombstones
+	while (m_slots[next].m_distance > 1) {
+		m_slots[p_index] = m_slots[next];
+		m_slots[p_index].m_distance--;
+		p_index = next;
+		next = (next + 1) & mask;
+	}
+
+	m_slots[p_index].m_distance = 0;
+	this->m_count--;
+}
+
 template <class T>
 inline void MxHashTable<T>::Add(T p_newobj)
 {
-	if (m_resizeOption && ((this->m_count + 1) / m_numSlots) > m_autoResizeRatio) {
+	if (this->m_count + 1 > m_growThreshold) {
 		MxHashTable<T>::Resize();
 	}
 
 	MxU32 hash = Hash(p_newobj);
-	MxU32 unused = 0;
-
-	MxHashTableNode<T>* node = new MxHashTableNode<T>(p_newobj, hash, NULL, NULL);
-
-	MxHashTable<T>::NodeInsert(node);
+	MxHashTable<T>::NodeInsert(p_newobj, hash);
 }
 
 #undef HASH_TABLE_INIT_SIZE
@@ -118,6 +118,22 @@ class MXIOINFO {
 	 */
 	MxU16 CreateChunk(MMCKINFO* p_chunkInfo, MxU16 p_create);
 
+	/**
+	 * @brief [AI] Maps the whole open file into memory as a copy-on-write view.
+	 * @details [AI] Pages are shared with the file cache until written to, so the caller may patch the data in place
+	 * without affecting the file on disk. The view does not depend on the file handle and stays valid after Close.
+	 * Only available for files opened read-only.
+	 * @param p_size Receives the size of the view in bytes (optional). [AI]
+	 * @return Pointer to the start of the view, or NULL if the file could not be mapped. [AI]
+	 */
+	MxU8* MapView(MxULong* p_size);
+
+	/**
+	 * @brief [AI] Releases a view previously returned by MapView.
+	 * @param p_view The view to release; NULL is ignored. [AI]
+	 */
+	static void UnmapView(MxU8* p_view);
+
 	/**
 	 * @brief [AI] Underlying MMIOINFO structure used for buffered and low-level file I/O.
 	 * @details [AI] In MXIOINFO, 'hmmio' (in MMIOINFO) is used as an HFILE rather than an HMMIO, supporting custom I/O operations.
@@ -2,7 +2,9 @@
 #define MXMEMORYPOOL_H
 
 #include "decomp.h"
+#include "mxautolock.h"
 #include "mxbitset.h"
+#include "mxcriticalsection.h"
 #include "mxdebug.h"
 #include "mxtypes.h"
 
@@ -12,7 +14,13 @@
  * @brief [AI] Fixed-size memory pool template for fast allocation and deallocation.
  * 
  * [AI] The MxMemoryPool class manages a pool of buffers of a fixed block size and count, providing fast and efficient memory
- * allocation and release. Internally, a bitset keeps track of used/free blocks and returns pointers to available blocks on request.
+ * allocation and release. Free blocks are chained through an intrusive free list (the first bytes of each free block hold
+ * the pointer to the next one), so Get and Release are O(1). A bitset still tracks which pool blocks are handed out in order
+ * to catch double releases.
+ *
+ * [AI] When all NB blocks are in use, Get overflows into a growable arena of heap blocks of the same size instead of failing.
+ * Released overflow blocks are kept on their own free list and reused, so a pool that is undersized for a scene only pays for
+ * heap allocations until it reaches its peak. The high-water mark, overflow and failure counters make that visible.
  *
  * @tparam BS [AI] Block size, in kilobytes (each allocation is BS*1024 bytes)
  * @tparam NB [AI] Number of blocks in the pool
@@ -24,33 +32,46 @@ class MxMemoryPool {
 	 * @brief [AI] Constructor. Initializes an empty pool with the specified block size.
 	 * @details [AI] The actual allocation is deferred until Allocate is called.
 	 */
-	MxMemoryPool() : m_pool(NULL), m_blockSize(BS) {}
+	MxMemoryPool()
+		: m_pool(NULL), m_blockSize(BS), m_freeList(NULL), m_overflowFreeList(NULL), m_busyCount(0), m_highWaterMark(0),
+		  m_overflowCount(0), m_failedCount(0)
+	{
+	}
 
 	/**
-	 * @brief [AI] Destructor. Destroys the memory pool and releases its memory.
+	 * @brief [AI] Destructor. Destroys the memory pool and releases its memory, including idle overflow blocks.
 	 */
-	~MxMemoryPool() { delete[] m_pool; }
+	~MxMemoryPool()
+	{
+		while (m_overflowFreeList != NULL) {
+			MxU8* next = NextFree(m_overflowFreeList);
+			delete[] m_overflowFreeList;
+			m_overflowFreeList = next;
+		}
+
+		delete[] m_pool;
+	}
 
 	/**
 	 * @brief [AI] Allocates the memory pool according to template parameters.
 	 * 
 	 * @return SUCCESS if allocation succeeded; FAILURE otherwise. [AI]
-	 * @details [AI] Allocates a contiguous memory block sufficient for NB blocks of BS*1024 bytes each.
-	 *               Panics if called more than once or with zero block size/count.
+	 * @details [AI] Allocates a contiguous memory block sufficient for NB blocks of BS*1024 bytes each and threads all of them
+	 *               onto the free list. Panics if called more than once or with zero block size/count.
 	 */
 	MxResult Allocate();
 
 	/**
-	 * @brief [AI] Gets a pointer to the next available block in the memory pool.
-	 * @return Pointer to available memory block, or NULL if all are in use. [AI]
-	 * @details [AI] Scans the block reference bitset for a free block, marks it as used and returns pointer to its start.
+	 * @brief [AI] Gets a pointer to a free block.
+	 * @return Pointer to a memory block, or NULL if the pool is exhausted and no overflow block could be allocated. [AI]
+	 * @details [AI] Pops the head of the free list. If the pool is exhausted, reuses an idle overflow block or allocates a new one.
 	 */
 	MxU8* Get();
 
 	/**
-	 * @brief [AI] Releases the block at the given pointer back into the pool.
-	 * @param p_buf Pointer within the memory pool to be released. [AI]
-	 * @details [AI] Calculates the block index from the pointer, marks it as free in the block reference bitset.
+	 * @brief [AI] Releases a block obtained from Get.
+	 * @param p_buf Pointer to the start of the block. [AI]
+	 * @details [AI] Pool blocks are pushed back onto the pool's free list; overflow blocks onto the overflow free list.
 	 */
 	void Release(MxU8* p_buf);
 
@@ -61,10 +82,51 @@ class MxMemoryPool {
 	 */
 	MxU32 GetPoolSize() const { return m_blockRef.Size(); }
 
+	/**
+	 * @brief [AI] Returns the number of blocks currently handed out, including overflow blocks. [AI]
+	 */
+	MxU32 GetBusyCount() const { return m_busyCount; }
+
+	/**
+	 * @brief [AI] Returns the highest number of blocks that were ever handed out at the same time. [AI]
+	 * @details [AI] A value above GetPoolSize() means the pool is undersized for the content being streamed.
+	 */
+	MxU32 GetHighWaterMark() const { return m_highWaterMark; }
+
+	/**
+	 * @brief [AI] Returns how many requests were served from the overflow arena because the pool was exhausted. [AI]
+	 */
+	MxU32 GetOverflowCount() const { return m_overflowCount; }
+
+	/**
+	 * @brief [AI] Returns how many requests could not be served at all. [AI]
+	 */
+	MxU32 GetFailedCount() const { return m_failedCount; }
+
 private:
-	MxU8* m_pool;            ///< @brief [AI] Pointer to the start of the pool's memory buffer.
-	MxU32 m_blockSize;       ///< @brief [AI] Block size in kilobytes (as given by BS).
-	MxBitset<NB> m_blockRef; ///< @brief [AI] Bitset tracking which blocks are currently allocated.
+	/**
+	 * @brief [AI] Reads the intrusive free-list link stored at the start of a free block. [AI]
+	 */
+	static MxU8*& NextFree(MxU8* p_block) { return *(MxU8**) p_block; }
+
+	/**
+	 * @brief [AI] Returns TRUE if the block lies inside the contiguous pool allocation. [AI]
+	 */
+	MxBool IsPoolBlock(MxU8* p_buf) const
+	{
+		return p_buf >= m_pool && p_buf < m_pool + GetPoolSize() * m_blockSize * 1024;
+	}
+
+	MxU8* m_pool;               ///< @brief [AI] Pointer to the start of the pool's memory buffer.
+	MxU32 m_blockSize;          ///< @brief [AI] Block size in kilobytes (as given by BS).
+	MxBitset<NB> m_blockRef;    ///< @brief [AI] Bitset tracking which blocks are currently allocated.
+	MxU8* m_freeList;           ///< @brief [AI] Head of the intrusive list of free pool blocks.
+	MxU8* m_overflowFreeList;   ///< @brief [AI] Head of the intrusive list of idle overflow blocks.
+	MxU32 m_busyCount;          ///< @brief [AI] Number of blocks currently handed out.
+	MxU32 m_highWaterMark;      ///< @brief [AI] Peak value of m_busyCount.
+	MxU32 m_overflowCount;      ///< @brief [AI] Number of requests served from the overflow arena.
+	MxU32 m_failedCount;        ///< @brief [AI] Number of requests that returned NULL.
+	MxCriticalSection m_lock;   ///< @brief [AI] Guards the free lists; blocks are released from the streaming threads.
 };
 
 template <size_t BS, size_t NB>
@@ -77,6 +139,15 @@ MxResult MxMemoryPool<BS, NB>::Allocate()
 	m_pool = new MxU8[GetPoolSize() * m_blockSize * 1024];
 	assert(m_pool);
 
+	if (m_pool) {
+		// Thread the blocks in address order so the first Get returns the start of the pool
+		for (MxU32 i = GetPoolSize(); i > 0; i--) {
+			MxU8* block = &m_pool[(i - 1) * m_blockSize * 1024];
+			NextFree(block) = m_freeList;
+			m_freeList = block;
+		}
+	}
+
 	return m_pool ? SUCCESS : FAILURE;
 }
 
@@ -87,17 +158,41 @@ MxU8* MxMemoryPool<BS, NB>::Get()
 	assert(m_blockSize);
 	assert(m_blockRef.Size());
 
-	for (MxU32 i = 0; i < GetPoolSize(); i++) {
-		if (!m_blockRef[i]) {
-			m_blockRef[i].Flip();
+	AUTOLOCK(m_lock);
+	MxU8* block = m_freeList;
 
-			MxTrace("Get> %d pool: busy %d blocks\n", m_blockSize, m_blockRef.Count());
+	if (block != NULL) {
+		m_freeList = NextFree(block);
 
-			return &m_pool[i * m_blockSize * 1024];
+		MxU32 i = (MxU32) (block - m_pool) / (m_blockSize * 1024);
+		assert(!m_blockRef[i]);
+		m_blockRef[i].Flip();
+	}
+	else {
+		block = m_overflowFreeList;
+
+		if (block != NULL) {
+			m_overflowFreeList = NextFree(block);
+		}
+		else {
+			block = new MxU8[m_blockSize * 1024];
 		}
+
+		if (block == NULL) {
+			m_failedCount++;
+			MxTrace("Get> %d pool: out of memory\n", m_blockSize);
+			return NULL;
+		}
+
+		m_overflowCount++;
+	}
+
+	if (++m_busyCount > m_highWaterMark) {
+		m_highWaterMark = m_busyCount;
 	}
 
-	return NULL;
+	MxTrace("Get> %d pool: busy %d blocks\n", m_blockSize, m_busyCount);
+	return block;
 }
 
 template <size_t BS, size_t NB>
@@ -107,16 +202,29 @@ void MxMemoryPool<BS, NB>::Release(MxU8* p_buf)
 	assert(m_blockSize);
 	assert(m_blockRef.Size());
 
-	MxU32 i = (MxU32) (p_buf - m_pool) / (m_blockSize * 1024);
+	AUTOLOCK(m_lock);
 
-	assert(i >= 0 && i < GetPoolSize());
-	assert(m_blockRef[i]);
+	if (IsPoolBlock(p_buf)) {
+		MxU32 i = (MxU32) (p_buf - m_pool) / (m_blockSize * 1024);
+
+		assert(i >= 0 && i < GetPoolSize());
+		assert(m_blockRef[i]);
+
+		if (!m_blockRef[i]) {
+			return;
+		}
 
-	if (m_blockRef[i]) {
 		m_blockRef[i].Flip();
+		NextFree(p_buf) = m_freeList;
+		m_freeList = p_buf;
+	}
+	else {
+		NextFree(p_buf) = m_overflowFreeList;
+		m_overflowFreeList = p_buf;
 	}
 
-	MxTrace("Release> %d pool: busy %d blocks\n", m_blockSize, m_blockRef.Count());
+	m_busyCount--;
+	MxTrace("Release> %d pool: busy %d blocks\n", m_blockSize, m_busyCount);
 }
 
 // TEMPLATE: BETA10 0x101464a0
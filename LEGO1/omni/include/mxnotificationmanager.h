@@ -22,6 +22,11 @@ class MxNotification {
 	 */
 	MxNotification(MxCore* p_target, const MxNotificationParam& p_param);
 
+	/**
+	 * @brief [AI] Constructs an empty notification, used for the manager's preallocated pool. [AI]
+	 */
+	MxNotification();
+
 	/**
 	 * @brief [AI] Destructor for MxNotification. Destroys the internally cloned parameter. [AI]
 	 */
@@ -39,16 +44,28 @@ class MxNotification {
 	 */
 	MxNotificationParam* GetParam() { return m_param; }
 
+	/**
+	 * @brief [AI] Re-targets a pooled notification and clones p_param into it. [AI]
+	 * @details [AI] The notification must be empty (freshly constructed or Reset()).
+	 */
+	void Set(MxCore* p_target, const MxNotificationParam& p_param);
+
+	/**
+	 * @brief [AI] Destroys the cloned parameter so the notification can go back to the pool. [AI]
+	 */
+	void Reset();
+
 private:
 	MxCore* m_target;             ///< [AI] Target object that will receive the notification
 	MxNotificationParam* m_param; ///< [AI] Cloned parameter object sent in the notification
 };
 
 /**
- * @brief [AI] List of object IDs used to track registered notification listeners. [AI]
- * @details [AI] Used by MxNotificationManager to identify registered recipients.
+ * @brief [AI] Sorted set of object IDs used to track registered notification listeners. [AI]
+ * @details [AI] Used by MxNotificationManager to identify registered recipients. Kept in ascending order so
+ * lookups are a binary search over contiguous memory rather than a walk over list nodes.
  */
-class MxIdList : public list<MxU32> {};
+class MxIdList : public vector<MxU32> {};
 
 /**
  * @brief [AI] List of notification pointers used to queue notifications for delivery. [AI]
@@ -64,13 +81,21 @@ class MxNotificationPtrList : public list<MxNotification*> {};
  *              Responsible for routing queued notifications to the correct object on each tick.
  */
 class MxNotificationManager : public MxCore {
+public:
+	enum {
+		e_poolSize = 512 ///< [AI] Number of preallocated notifications; further sends fall back to the heap
+	};
+
 private:
 	MxNotificationPtrList* m_queue;    ///< [AI] Primary notification queue, holds pending notifications for dispatch
-	MxNotificationPtrList* m_sendList; ///< [AI] Temporary list used when dispatching queued notifications during Tickle()
+	MxNotificationPtrList* m_sendList; ///< [AI] Notifications being dispatched by Tickle(); reused across ticks
 	MxCriticalSection m_lock;          ///< [AI] Internal lock for thread safety on notification queue
 	MxS32 m_unk0x2c;                   ///< [AI] [Unknown meaning, possibly internal state or reserved]
-	MxIdList m_listenerIds;            ///< [AI] Registered target MxCore IDs that may receive notifications
+	MxIdList m_listenerIds;            ///< [AI] Registered target MxCore IDs that may receive notifications, sorted ascending
 	MxBool m_active;                   ///< [AI] Controls whether notifications may be queued or dispatched
+	MxNotification* m_pool;            ///< [AI] Preallocated notifications, e_poolSize entries
+	MxNotification** m_freeList;       ///< [AI] Stack of unused entries in m_pool
+	MxU32 m_numFree;                   ///< [AI] Number of entries on m_freeList
 
 public:
 	/**
@@ -147,6 +172,21 @@ class MxNotificationManager : public MxCore {
 	 * @details [AI] Used to ensure no notifications for a deleted object remain. [AI]
 	 */
 	void FlushPending(MxCore* p_listener);
+
+	/**
+	 * @brief [AI] Returns the index of the first registered ID not less than p_id. [AI]
+	 */
+	MxU32 FindListener(MxU32 p_id);
+
+	/**
+	 * @brief [AI] Takes a notification from the pool, or the heap if the pool is exhausted. [AI]
+	 */
+	MxNotification* NewNotification(MxCore* p_target, const MxNotificationParam& p_param);
+
+	/**
+	 * @brief [AI] Returns a delivered notification to the pool, or deletes it if it came from the heap. [AI]
+	 */
+	void DeleteNotification(MxNotification* p_notification);
 };
 
 // TEMPLATE: LEGO1 0x100ac320
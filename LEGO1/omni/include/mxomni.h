@@ -78,6 +78,20 @@ class MxOmni : public MxCore {
 	 */
 	static void SetSound3D(MxBool p_use3dSound);
 
+	/**
+	 * @brief [AI] Returns whether the engine runs without presenting anything to the screen or a sound card. [AI]
+	 */
+	static MxBool IsHeadless();
+
+	/**
+	 * @brief [AI] Selects headless mode; must be called before Create.
+	 * @details [AI] Headless, the video manager does all of its per-frame work but neither rasterizes the 3D view
+	 * nor copies the back buffer to the window, and the sound manager mixes into a null MxSoundSink driven from
+	 * its Tickle. The DirectDraw and Direct3D objects are still created, so a software device is enough.
+	 * @param p_headless TRUE for headless mode. [AI]
+	 */
+	static void SetHeadless(MxBool p_headless);
+
 	/**
 	 * @brief [AI] Initializes default state. Does not create or allocate any subsystems. [AI]
 	 */
@@ -186,8 +186,21 @@ class MxPresenter : public MxCore {
 	}
 
 	/// @brief [AI] Sets the display Z (depth) order for the presenter.
+	/// @details [AI] A change flags the video manager's presenter list for re-sorting.
 	/// @param p_displayZ [AI] Z order value.
-	void SetDisplayZ(MxS32 p_displayZ) { m_displayZ = p_displayZ; }
+	void SetDisplayZ(MxS32 p_displayZ)
+	{
+		if (m_displayZ != p_displayZ) {
+			m_displayZ = p_displayZ;
+			g_displayZChanged = TRUE;
+		}
+	}
+
+	/// @brief [AI] Returns TRUE if any presenter's display Z changed since the last ClearDisplayZChanged. [AI]
+	static MxBool DisplayZChanged() { return g_displayZChanged; }
+
+	/// @brief [AI] Acknowledges display Z changes; called once the presenter list has been re-sorted. [AI]
+	static void ClearDisplayZChanged() { g_displayZChanged = FALSE; }
 
 	// SYNTHETIC: LEGO1 0x1000c070
 	// MxPresenter::`scalar deleting destructor'
@@ -215,6 +228,9 @@ class MxPresenter : public MxCore {
 
 	/// @brief [AI] Owner composite presenter, if any.
 	MxCompositePresenter* m_compositePresenter; // 0x3c
+
+private:
+	static MxBool g_displayZChanged;
 };
 
 /// @brief [AI] Provides a mapping from action object/type to the correct presenter handler class name based on action type and content.
@@ -80,6 +80,7 @@ class MxRAMStreamProvider : public MxStreamProvider {
 	MxU8* m_pBufferOfFileSize; ///< [AI] Pointer to full byte buffer with loaded SI file contents.
 	MxU32 m_lengthInDWords;    ///< [AI] Number of DWORD (4 byte) entries in buffer.
 	MxU32* m_bufferForDWords;  ///< [AI] Pointer to DWORD buffer for 4-byte-aligned access to SI chunk data.
+	MxBool m_mapped;           ///< [AI] TRUE if m_pBufferOfFileSize is a memory-mapped view of the SI file rather than a heap copy.
 };
 
 // SYNTHETIC: LEGO1 0x100d0a30
@@ -9,64 +9,35 @@
 
 struct MxBITMAPINFO;
 
-// These functions are not part of the public interface,
-// but present in SMACK.LIB and used directly by Mindscape.
 /**
- * @brief [AI] External functions from SMACK.LIB used for decoding Smacker video data.
- * @details [AI] These functions provide access to the internal Huffman table and frame decoding
- * routines of the Smacker codec. They are used to decompress and decode video streams in LEGO Island.
+ * @brief [AI] One of the four Huffman trees of a Smacker video, ready for decoding.
+ * @details [AI] m_nodes holds the tree in pre-order. An inner node has c_node set along with the number of entries
+ * in its 0 subtree, which directly follows it; a leaf holds its 16-bit value. Three leaves are escape codes that
+ * stand for the most recently decoded values, m_recent indexes them. m_lookup resolves the first c_lookupBits bits
+ * of a code in one step: each entry is the index of the node they lead to, shifted by c_lookupShift, together with
+ * the number of bits used and c_lookupNode if the code is longer.
  */
-extern "C"
-{
-	/**
-	 * @brief [AI] Returns the required size for Huffman tables used in Smacker video decoding.
-	 * @return [AI] Size in bytes needed for the tables.
-	 */
-	u32 SmackGetSizeTables();
+struct MxSmkTree {
+	enum {
+		c_node = 0x80000000,
+		c_lookupBits = 10,
+		c_lookupNode = 0x10,
+		c_lookupShift = 5
+	};
 
-	/**
-	 * @brief [AI] Generates Huffman tables required for decoding a Smacker frame.
-	 * @param p_huffmanTrees [AI] Pointer to the Huffman trees (input).
-	 * @param p_huffmanTables [AI] Buffer to receive generated Huffman tables (output).
-	 * @param p_codeSize [AI] Size of the code table.
-	 * @param p_abSize [AI] Size of the AB table.
-	 * @param p_detailSize [AI] Size of the detail table.
-	 * @param p_typeSize [AI] Size of the type table.
-	 * @details [AI] This function prepares the internal coding tables based on Huffman tree input, enabling Smacker frame decompression.
-	 */
-	void SmackDoTables(
-		u8* p_huffmanTrees,
-		u8* p_huffmanTables,
-		u32 p_codeSize,
-		u32 p_abSize,
-		u32 p_detailSize,
-		u32 p_typeSize
-	);
+	// Order of the trees in the file
+	enum {
+		e_monoMap = 0,
+		e_monoColors,
+		e_full,
+		e_type,
+		e_numTrees
+	};
 
-	/**
-	 * @brief [AI] Decompress a single Smacker video frame into a provided buffer.
-	 * @param p_source [AI] Source chunk/frame data to decode.
-	 * @param p_huffmanTables [AI] Prepared Huffman tables for decompression.
-	 * @param p_unk0x6b4 [AI] Buffer/context for decompression (decoded frame output or working state).
-	 * @details [AI] Called for each frame displayed; decompresses frame from compressed data into output bitmap.
-	 */
-	void SmackDoFrameToBuffer(u8* p_source, u8* p_huffmanTables, u8* p_unk0x6b4);
-
-	/**
-	 * @brief [AI] Returns the size required for frame delta data given width and height.
-	 * @param p_width [AI] Width of the frame.
-	 * @param p_height [AI] Height of the frame.
-	 */
-	u32 SmackGetSizeDeltas(u32 p_width, u32 p_height);
-
-	/**
-	 * @brief [AI] Reads a rectangle from the frame update information.
-	 * @param p_unk0x6b4 [AI] Frame decoder state/context.
-	 * @param p_rect [AI] Output array for rectangle dimensions (left,top,width,height).
-	 * @return [AI] Returns the rectangle descriptor (usually success state).
-	 */
-	u8 SmackGetRect(u8* p_unk0x6b4, u32* p_rect);
-}
+	MxU32* m_nodes;     ///< @brief [AI] Nodes and leaves of the tree in pre-order.
+	MxU32* m_lookup;    ///< @brief [AI] First-level lookup table with 1 << c_lookupBits entries.
+	MxU32 m_recent[3];  ///< @brief [AI] Indices of the leaves holding the three most recent values.
+};
 
 // SIZE 0x6b8
 /**
@@ -79,10 +50,10 @@ struct MxSmk {
 	undefined m_unk0x390[784]; ///< @brief [AI] Reserved/unused; aligns struct to file format ([AI_SUGGESTED_NAME: paddingOrWorkingBuffer])
 	MxU32* m_frameSizes;       ///< @brief [AI] Array of frame sizes (in bytes), one entry per video frame (plus ring frame if present).
 	MxU8* m_frameTypes;        ///< @brief [AI] Array of frame types, one entry per frame.
-	MxU8* m_huffmanTrees;      ///< @brief [AI] Huffman trees used for decompressing video frames.
-	MxU8* m_huffmanTables;     ///< @brief [AI] Generated decoding tables for use in SmackDoFrameToBuffer.
+	MxSmkTree* m_trees;        ///< @brief [AI] The four Huffman trees used for decompressing video frames.
+	MxU32* m_huffmanTables;    ///< @brief [AI] Nodes and lookup tables of m_trees, in a single allocation.
 	MxU32 m_maxFrameSize;      ///< @brief [AI] Maximum size of any frame, used for allocation.
-	MxU8* m_unk0x6b4;          ///< @brief [AI] Buffer/context for decoding frame delta data; referenced throughout decompression ([AI_SUGGESTED_NAME: frameDecompressionContext]).
+	MxRect32* m_rects;         ///< @brief [AI] Preallocated dirty rectangles of the frame last decoded by LoadFrame.
 
 	/**
 	 * @brief [AI] Loads the SMK header and initializes decoding structures for a Smacker video.
@@ -106,30 +77,22 @@ struct MxSmk {
 	 * @param p_bitmapData [AI] Pointer to target buffer for decompressed pixel data.
 	 * @param p_mxSmk [AI] Decoding context for current video stream.
 	 * @param p_chunkData [AI] Raw frame and palette chunk source data.
+	 * @param p_chunkLength [AI] Size of p_chunkData in bytes; the decoder never reads past it.
 	 * @param p_paletteChanged [AI] Indicates if the color palette chunk is included/has changed.
-	 * @param p_list [AI] List to be filled with rectangles (dirty regions) updated by this frame.
+	 * @param p_numRects [AI] Receives the number of dirty rectangles now in p_mxSmk->m_rects.
 	 * @return [AI] SUCCESS if frame is loaded properly, FAILURE otherwise.
-	 * @details [AI] Performs palette animation, decompresses frame, fills list of screen areas that changed.
+	 * @details [AI] Performs palette animation and decompresses the frame. Every band of consecutive block rows
+	 * touched by the frame comes back as one rectangle, without allocating.
 	 */
 	static MxResult LoadFrame(
 		MxBITMAPINFO* p_bitmapInfo,
 		MxU8* p_bitmapData,
 		MxSmk* p_mxSmk,
 		MxU8* p_chunkData,
+		MxU32 p_chunkLength,
 		MxBool p_paletteChanged,
-		MxRect32List* p_list
+		MxU32& p_numRects
 	);
-
-	/**
-	 * @brief [AI] Retrieves and merges rectangles describing updated regions of the current frame.
-	 * @param p_unk0x6b4 [AI] Current decoding context for frame.
-	 * @param p_und [AI] Input/output parameter controlling initial/continuation state.
-	 * @param p_smackRect [AI] Input/output buffer for SMK rectangle coordinates.
-	 * @param p_rect [AI] Output: receives merged rectangle for frame update.
-	 * @return [AI] TRUE if rectangle was found, FALSE if done with regions.
-	 * @details [AI] Called after each frame to help identify dirty regions (for partial redraw/optimizations).
-	 */
-	static MxBool GetRect(MxU8* p_unk0x6b4, MxU16* p_und, u32* p_smackRect, MxRect32* p_rect);
 };
 
 #endif // MXSMK_H
@@ -7,9 +7,11 @@
 
 #include <dsound.h>
 
+class MxSoundMixer;
+
 // VTABLE: LEGO1 0x100dc128
 // VTABLE: BETA10 0x101c1ce8
-// SIZE 0x3c
+// SIZE 0x40
 
 /**
  * @brief [AI] Manages DirectSound-based sound playback, implementing volume, resource, and device management.
@@ -29,6 +31,11 @@ class MxSoundManager : public MxAudioManager {
 	 */
 	~MxSoundManager() override; // vtable+0x00
 
+	/**
+	 * @brief [AI] Tickles the sound presenters, then runs the software mixer if it has no thread of its own. [AI]
+	 */
+	MxResult Tickle() override; // vtable+0x08
+
 	/**
 	 * @brief [AI] Releases sound resources and unregisters from tickle system.
 	 * @details [AI] Used to safely clean up all managed resources, either explicitly or from destruction.
@@ -69,6 +76,21 @@ class MxSoundManager : public MxAudioManager {
 	 */
 	LPDIRECTSOUND GetDirectSound() { return m_directSound; }
 
+	/**
+	 * @brief [AI] Returns the software mixer, or NULL if every sound gets its own DirectSound buffer. [AI]
+	 */
+	MxSoundMixer* GetMixer() { return m_mixer; }
+
+	/**
+	 * @brief [AI] Creates a secondary sound buffer for a presenter or cached sound.
+	 * @details [AI] Returns a voice of the software mixer if one is running, otherwise a DirectSound buffer.
+	 * Both are driven through the same IDirectSoundBuffer interface.
+	 * @param p_desc Buffer description, as for IDirectSound::CreateSoundBuffer. [AI]
+	 * @param p_buffer Receives the new buffer. [AI]
+	 * @return DS_OK on success, otherwise a DirectSound error code. [AI]
+	 */
+	HRESULT CreateSoundBuffer(LPCDSBUFFERDESC p_desc, LPDIRECTSOUNDBUFFER* p_buffer);
+
 	/**
 	 * @brief [AI] Maps a percentage volume (1-100) to a DirectSound-specific attenuation value.
 	 * @param p_volume The desired volume as a percentage, 1 (min, not zero) to 100 (max). [AI]
@@ -100,9 +122,17 @@ class MxSoundManager : public MxAudioManager {
 	 */
 	void Destroy(MxBool p_fromDestructor);
 
+	/**
+	 * @brief [AI] Opens the output selected with MxSoundMixer::SetOutput and starts the mixer thread.
+	 * @details [AI] Headless, the output is always a null sink or a WAVE file. Under a fixed timer step the mixer
+	 * gets no thread and is run from Tickle instead, so the mix advances in step with the virtual clock. [AI]
+	 */
+	MxResult CreateMixer();
+
 	LPDIRECTSOUND m_directSound;    ///< @brief [AI] Pointer to main DirectSound interface. Needed for all DirectSound operations.
 	LPDIRECTSOUNDBUFFER m_dsBuffer; ///< @brief [AI] Primary DirectSound buffer interface for setting output format/volume.
 	undefined m_unk0x38[4];         ///< @brief [AI] Unknown, reserved/unused memory or opaque data per binary compatibility. [AI_SUGGESTED_NAME: reserved] [AI]
+	MxSoundMixer* m_mixer;          ///< @brief [AI] Software mixer, if MxSoundMixer::SetOutput selected one. Offset 0x3c.
 };
 
 // SYNTHETIC: LEGO1 0x100ae7b0
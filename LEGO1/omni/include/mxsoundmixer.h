@@ -0,0 +1,206 @@
+#ifndef MXSOUNDMIXER_H
+#define MXSOUNDMIXER_H
+
+#include "compat.h"
+#include "mxcriticalsection.h"
+#include "mxthread.h"
+#include "mxtypes.h"
+
+#include <dsound.h>
+
+class MxSoundMixer;
+class MxSoundSink;
+
+/**
+ * @brief [AI] One voice of MxSoundMixer, exposed through the IDirectSoundBuffer interface.
+ * @details [AI] MxWavePresenter and LegoCacheSound keep driving their buffer exactly as they drive a DirectSound
+ * secondary buffer (Lock/Unlock, Play/Stop, cursors, volume, pan and frequency); the mixer thread reads the data
+ * from here instead of the sound card doing so. 8-bit data is widened to 16 bits on Unlock so the mixing kernels
+ * only ever see signed 16-bit samples.
+ *
+ * There is no 3D interface: QueryInterface fails and Lego3DSound falls back to MxSoundMixer's distance model.
+ */
+class MxSoundVoice : public IDirectSoundBuffer {
+public:
+	MxSoundVoice(MxSoundMixer* p_mixer);
+	virtual ~MxSoundVoice();
+
+	/**
+	 * @brief [AI] Allocates the voice's data for the buffer size and PCM format in p_desc. [AI]
+	 */
+	HRESULT Create(LPCDSBUFFERDESC p_desc);
+
+	// IUnknown
+	STDMETHOD(QueryInterface)(REFIID p_riid, LPVOID* p_object);
+	STDMETHOD_(ULONG, AddRef)();
+	STDMETHOD_(ULONG, Release)();
+
+	// IDirectSoundBuffer
+	STDMETHOD(GetCaps)(LPDSBCAPS p_caps);
+	STDMETHOD(GetCurrentPosition)(LPDWORD p_playCursor, LPDWORD p_writeCursor);
+	STDMETHOD(GetFormat)(LPWAVEFORMATEX p_format, DWORD p_size, LPDWORD p_sizeWritten);
+	STDMETHOD(GetVolume)(LPLONG p_volume);
+	STDMETHOD(GetPan)(LPLONG p_pan);
+	STDMETHOD(GetFrequency)(LPDWORD p_frequency);
+	STDMETHOD(GetStatus)(LPDWORD p_status);
+	STDMETHOD(Initialize)(LPDIRECTSOUND p_directSound, LPCDSBUFFERDESC p_desc);
+	STDMETHOD(Lock)(
+		DWORD p_offset,
+		DWORD p_bytes,
+		LPVOID* p_audioPtr1,
+		LPDWORD p_audioBytes1,
+		LPVOID* p_audioPtr2,
+		LPDWORD p_audioBytes2,
+		DWORD p_flags
+	);
+	STDMETHOD(Play)(DWORD p_reserved1, DWORD p_reserved2, DWORD p_flags);
+	STDMETHOD(SetCurrentPosition)(DWORD p_position);
+	STDMETHOD(SetFormat)(LPCWAVEFORMATEX p_format);
+	STDMETHOD(SetVolume)(LONG p_volume);
+	STDMETHOD(SetPan)(LONG p_pan);
+	STDMETHOD(SetFrequency)(DWORD p_frequency);
+	STDMETHOD(Stop)();
+	STDMETHOD(Unlock)(LPVOID p_audioPtr1, DWORD p_audioBytes1, LPVOID p_audioPtr2, DWORD p_audioBytes2);
+	STDMETHOD(Restore)();
+
+private:
+	friend class MxSoundMixer;
+
+	MxCriticalSection* GetLock();
+	void Widen(LPVOID p_audioPtr, DWORD p_bytes);
+	void UpdateGain();
+	void UpdateStep();
+
+	MxSoundMixer* m_mixer; ///< [AI] Owning mixer, or NULL once the mixer has been destroyed.
+	ULONG m_refCount;      ///< [AI] COM reference count; the voice deletes itself when it drops to zero.
+	WAVEFORMATEX m_format; ///< [AI] PCM format of the data (8 or 16 bit, mono or stereo).
+	DWORD m_flags;         ///< [AI] DSBCAPS_* flags from creation, reported by GetCaps.
+	MxU8* m_data;          ///< [AI] Buffer contents as written by the client, m_size bytes.
+	MxS16* m_samples;      ///< [AI] Data as signed 16-bit samples; aliases m_data for 16-bit formats.
+	MxU32 m_size;          ///< [AI] Buffer size in bytes.
+	MxU32 m_numFrames;     ///< [AI] Buffer size in frames.
+	MxU32 m_frame;         ///< [AI] Integer part of the play position, in frames.
+	MxU32 m_fraction;      ///< [AI] Fractional part of the play position, 16.16 fixed point.
+	MxU32 m_step;          ///< [AI] Source frames consumed per output frame, 16.16 fixed point.
+	DWORD m_frequency;     ///< [AI] Playback rate set by SetFrequency; 0 means the data's own rate.
+	LONG m_volume;         ///< [AI] DirectSound volume, hundredths of a dB.
+	LONG m_pan;            ///< [AI] DirectSound pan, hundredths of a dB of attenuation on the far side.
+	MxS32 m_gainLeft;      ///< [AI] Left channel gain derived from m_volume and m_pan, 2.14 fixed point.
+	MxS32 m_gainRight;     ///< [AI] Right channel gain derived from m_volume and m_pan, 2.14 fixed point.
+	MxBool m_playing;      ///< [AI] TRUE between Play and Stop (or the end of a non-looping buffer).
+	MxBool m_looping;      ///< [AI] TRUE if Play was called with DSBPLAY_LOOPING.
+};
+
+/**
+ * @brief [AI] Software mixer that replaces one DirectSound buffer per sound with a single output stream.
+ * @details [AI] MxSoundManager creates the mixer when an output is selected with SetOutput. All sound buffers
+ * requested through MxSoundManager::CreateSoundBuffer then become MxSoundVoice objects, and a thread mixes every
+ * playing voice into a 16-bit stereo stream at e_frequency and hands it to an MxSoundSink: a DirectSound buffer,
+ * a WAVE file or nothing at all. The last two need no audio device, so mixing cost can be measured headless.
+ *
+ * Mixing is done in fixed point: each voice is resampled with linear interpolation and scaled by its left and
+ * right gains into a 32-bit accumulator, which is clamped to 16 bits once per chunk.
+ */
+class MxSoundMixer : public MxThread {
+public:
+	/**
+	 * @brief [AI] Where the mix goes. [AI]
+	 */
+	enum Output {
+		e_none = 0,     ///< [AI] No mixer; every sound gets its own DirectSound buffer (the default).
+		e_device = 1,   ///< [AI] Mix into a single DirectSound buffer.
+		e_null = 2,     ///< [AI] Mix and discard, paced in real time.
+		e_waveFile = 3  ///< [AI] Mix into the WAVE file given to SetOutput, paced in real time.
+	};
+
+	enum {
+		e_frequency = 22050,  ///< [AI] Output rate in Hz.
+		e_chunkFrames = 512,  ///< [AI] Largest number of frames mixed in one pass.
+		e_updateInterval = 10 ///< [AI] Time the mixer thread sleeps between passes, in milliseconds.
+	};
+
+	MxSoundMixer();
+	~MxSoundMixer() override;
+
+	/**
+	 * @brief [AI] Opens p_sink and optionally starts the mixer thread.
+	 * @param p_sink Output backend; the mixer takes ownership, also on failure. [AI]
+	 * @param p_createThread If FALSE, nothing is mixed until Mix or Update is called. [AI]
+	 */
+	MxResult Create(MxSoundSink* p_sink, MxBool p_createThread);
+
+	/**
+	 * @brief [AI] Stops the thread, closes the sink and detaches all remaining voices. [AI]
+	 */
+	void Destroy();
+
+	/**
+	 * @brief [AI] Thread entry point; calls Update every e_updateInterval ms until Destroy. [AI]
+	 */
+	MxResult Run() override;
+
+	/**
+	 * @brief [AI] Mixes as many frames as the sink can currently take. [AI]
+	 */
+	void Update();
+
+	/**
+	 * @brief [AI] Mixes p_frames frames (at most e_chunkFrames) and writes them to the sink.
+	 * @return [AI] Number of voices that were mixed.
+	 */
+	MxU32 Mix(MxU32 p_frames);
+
+	/**
+	 * @brief [AI] Creates a voice; same contract as IDirectSound::CreateSoundBuffer for PCM secondary buffers. [AI]
+	 */
+	HRESULT CreateSoundBuffer(LPCDSBUFFERDESC p_desc, LPDIRECTSOUNDBUFFER* p_buffer);
+
+	/**
+	 * @brief [AI] Returns the number of voices currently alive. [AI]
+	 */
+	MxU32 GetNumVoices() const { return m_numVoices; }
+
+	/**
+	 * @brief [AI] Returns TRUE if Create started the mixer thread, FALSE if the owner has to call Update. [AI]
+	 */
+	MxBool IsThreaded() const { return m_threaded; }
+
+	/**
+	 * @brief [AI] Selects the mixer output. Takes effect when the sound manager is next created.
+	 * @param p_output One of Output. [AI]
+	 * @param p_filename File to write for e_waveFile; must outlive the mixer. [AI]
+	 */
+	static void SetOutput(MxU32 p_output, const char* p_filename);
+
+	/**
+	 * @brief [AI] Returns the selected output, one of Output. [AI]
+	 */
+	static MxU32 GetOutput() { return g_output; }
+
+	/**
+	 * @brief [AI] Returns the file selected for e_waveFile output. [AI]
+	 */
+	static const char* GetFilename() { return g_filename; }
+
+private:
+	friend class MxSoundVoice;
+
+	void AddVoice(MxSoundVoice* p_voice);
+	void RemoveVoice(MxSoundVoice* p_voice);
+	void MixVoice(MxSoundVoice* p_voice, MxS32* p_dest, MxU32 p_frames);
+
+	static MxU32 g_output;
+	static const char* g_filename;
+
+	MxSoundSink* m_sink;               ///< [AI] Output backend, owned.
+	MxSoundVoice** m_voices;           ///< [AI] All live voices, m_numVoices of m_maxVoices used.
+	MxU32 m_numVoices;                 ///< [AI] Number of entries in m_voices.
+	MxU32 m_maxVoices;                 ///< [AI] Capacity of m_voices.
+	MxS32 m_mix[e_chunkFrames * 2];    ///< [AI] Accumulator for one chunk, interleaved stereo.
+	MxS16 m_output[e_chunkFrames * 2]; ///< [AI] Clamped chunk handed to the sink.
+	MxBool m_active;                   ///< [AI] TRUE while the mixer thread should keep running.
+	MxBool m_threaded;                 ///< [AI] TRUE if Create started the mixer thread.
+	MxCriticalSection m_lock;          ///< [AI] Guards m_voices and the voices' playback state.
+};
+
+#endif // MXSOUNDMIXER_H
@@ -0,0 +1,111 @@
+#ifndef MXSOUNDSINK_H
+#define MXSOUNDSINK_H
+
+#include "mxtypes.h"
+
+#include <dsound.h>
+#include <stdio.h>
+
+/**
+ * @brief [AI] Output backend of MxSoundMixer.
+ * @details [AI] A sink accepts interleaved 16-bit stereo frames at the rate it was opened with. The mixer asks how
+ * many frames the sink can take right now and writes at most that many, so the sink also paces the mixer.
+ */
+class MxSoundSink {
+public:
+	virtual ~MxSoundSink() {}
+
+	/**
+	 * @brief [AI] Prepares the backend for 16-bit stereo output at p_frequency Hz. [AI]
+	 */
+	virtual MxResult Open(MxU32 p_frequency) = 0;
+
+	/**
+	 * @brief [AI] Stops output and releases the backend's resources. [AI]
+	 */
+	virtual void Close() = 0;
+
+	/**
+	 * @brief [AI] Returns the number of frames that can be written without blocking or running ahead of playback. [AI]
+	 */
+	virtual MxU32 GetFreeFrames() = 0;
+
+	/**
+	 * @brief [AI] Queues p_count interleaved stereo frames for output. [AI]
+	 */
+	virtual MxResult Write(const MxS16* p_frames, MxU32 p_count) = 0;
+};
+
+/**
+ * @brief [AI] Plays the mix through a single looping DirectSound buffer.
+ * @details [AI] The buffer holds a quarter of a second; the sink keeps about e_latencyMS of audio queued ahead of
+ * the play cursor and resynchronizes to the write cursor if the mixer ever falls behind.
+ */
+class MxDirectSoundSink : public MxSoundSink {
+public:
+	MxDirectSoundSink(LPDIRECTSOUND p_directSound);
+	~MxDirectSoundSink() override;
+
+	MxResult Open(MxU32 p_frequency) override;
+	void Close() override;
+	MxU32 GetFreeFrames() override;
+	MxResult Write(const MxS16* p_frames, MxU32 p_count) override;
+
+	enum {
+		e_latencyMS = 80 ///< [AI] Amount of audio kept queued ahead of the play cursor.
+	};
+
+private:
+	LPDIRECTSOUND m_directSound;     ///< [AI] Device the buffers are created on, owned by MxSoundManager.
+	LPDIRECTSOUNDBUFFER m_primary;   ///< [AI] Primary buffer, held to keep the output format.
+	LPDIRECTSOUNDBUFFER m_dsBuffer;  ///< [AI] Looping secondary buffer the mix is written into.
+	MxU32 m_bufferFrames;            ///< [AI] Size of m_dsBuffer in frames.
+	MxU32 m_latencyFrames;           ///< [AI] e_latencyMS expressed in frames.
+	MxU32 m_writeFrame;              ///< [AI] Frame at which the next Write starts.
+};
+
+/**
+ * @brief [AI] Discards the mix, consuming it at the rate of MxTimer::GetClock.
+ * @details [AI] Used to run the mixer without an audio device, e.g. to measure mixing cost and voice counts.
+ * Under a fixed timer step the sink therefore takes exactly as many frames as the virtual clock advanced.
+ */
+class MxNullSoundSink : public MxSoundSink {
+public:
+	MxNullSoundSink();
+
+	MxResult Open(MxU32 p_frequency) override;
+	void Close() override;
+	MxU32 GetFreeFrames() override;
+	MxResult Write(const MxS16* p_frames, MxU32 p_count) override;
+
+	/**
+	 * @brief [AI] Returns the number of frames written since Open. [AI]
+	 */
+	MxU32 GetFramesWritten() const { return m_framesWritten; }
+
+protected:
+	MxU32 m_frequency;     ///< [AI] Output rate in Hz.
+	MxU32 m_startTime;     ///< [AI] MxTimer::GetClock() at Open.
+	MxU32 m_framesWritten; ///< [AI] Frames consumed since Open.
+};
+
+/**
+ * @brief [AI] Records the mix to a 16-bit stereo RIFF WAVE file, paced like MxNullSoundSink. [AI]
+ */
+class MxWaveFileSoundSink : public MxNullSoundSink {
+public:
+	MxWaveFileSoundSink(const char* p_filename);
+	~MxWaveFileSoundSink() override;
+
+	MxResult Open(MxU32 p_frequency) override;
+	void Close() override;
+	MxResult Write(const MxS16* p_frames, MxU32 p_count) override;
+
+private:
+	void WriteHeader(MxU32 p_dataSize);
+
+	const char* m_filename; ///< [AI] Path of the file to write; must outlive the sink.
+	FILE* m_file;           ///< [AI] Open file, or NULL.
+};
+
+#endif // MXSOUNDSINK_H
@@ -176,10 +176,10 @@ class MxStreamer : public MxCore {
 
 	/**
 	 * @brief Allocate a temporary memory block from the streamer pool. [AI]
-	 * @details Allocates 64- or 128-byte blocks from specialized fixed-size pools to improve locality and reduce 
-	 * fragmentation. [AI]
-	 * @param p_blockSize Required block size [AI]
-	 * @return Pointer to the memory block, or NULL if not valid size [AI]
+	 * @details Allocates 64 KB or 128 KB blocks from specialized fixed-size pools to improve locality and reduce 
+	 * fragmentation. Exhausted pools overflow into heap blocks rather than failing; see GetPool64 and GetPool128 for usage counters. [AI]
+	 * @param p_blockSize Required block size in kilobytes [AI]
+	 * @return Pointer to the memory block, or NULL if not valid size or out of memory [AI]
 	 */
 	MxU8* GetMemoryBlock(MxU32 p_blockSize)
 	{
@@ -220,10 +220,25 @@ class MxStreamer : public MxCore {
 		}
 	}
 
+	/**
+	 * @brief Returns the 64 KB block pool, e.g. to read its usage counters. [AI]
+	 */
+	const MxMemoryPool64& GetPool64() const { return m_pool64; }
+
+	/**
+	 * @brief Returns the 128 KB block pool, e.g. to read its usage counters. [AI]
+	 */
+	const MxMemoryPool128& GetPool128() const { return m_pool128; }
+
+	/**
+	 * @brief Returns the open stream controllers, e.g. to look up their tickle cost. [AI]
+	 */
+	const list<MxStreamController*>& GetControllers() const { return m_controllers; }
+
 private:
 	list<MxStreamController*> m_controllers; ///< Open stream controllers (RAM and disk streams) [AI]
-	MxMemoryPool64 m_pool64;                 ///< Fixed-size 64-byte block allocator [AI]
-	MxMemoryPool128 m_pool128;               ///< Fixed-size 128-byte block allocator [AI]
+	MxMemoryPool64 m_pool64;                 ///< Fixed-size 64 KB block allocator [AI]
+	MxMemoryPool128 m_pool128;               ///< Fixed-size 128 KB block allocator [AI]
 };
 
 #endif // MXSTREAMER_H
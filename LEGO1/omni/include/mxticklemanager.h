@@ -5,7 +5,7 @@
 #include "mxstl/stlcompat.h"
 #include "mxtypes.h"
 
-// SIZE 0x10
+// SIZE 0x30
 /**
  * @brief [AI] Associates an MxCore object with tickle timing/interval information.
  *
@@ -63,26 +63,90 @@ class MxTickleClient {
 	 */
 	void SetFlags(MxU16 p_flags) { m_flags = p_flags; }
 
+	/**
+	 * @brief [AI] Returns the earliest time at which the client is due for its next tickle.
+	 * @details [AI] A client is tickled once the current time exceeds last update + interval. [AI]
+	 */
+	MxTime GetDueTime() const { return m_lastUpdateTime + m_interval + 1; }
+
+	/**
+	 * @brief [AI] Returns how many times the client has been tickled while profiling was enabled. [AI]
+	 */
+	MxU32 GetTickleCount() const { return m_tickleCount; }
+
+	/**
+	 * @brief [AI] Returns the total time spent in the client's Tickle() while profiling was enabled, in ms. [AI]
+	 */
+	MxDouble GetTickleCost() const { return m_tickleCost; }
+
+	/**
+	 * @brief [AI] Returns the longest single Tickle() of the client while profiling was enabled, in ms. [AI]
+	 */
+	MxDouble GetPeakTickleCost() const { return m_peakTickleCost; }
+
+	/**
+	 * @brief [AI] Accounts one profiled Tickle() call of p_cost ms. [AI]
+	 */
+	void AddTickleCost(MxDouble p_cost)
+	{
+		m_tickleCount++;
+		m_tickleCost += p_cost;
+		if (p_cost > m_peakTickleCost) {
+			m_peakTickleCost = p_cost;
+		}
+	}
+
+	/**
+	 * @brief [AI] Clears the profiling counters. [AI]
+	 */
+	void ResetTickleCost()
+	{
+		m_tickleCount = 0;
+		m_tickleCost = 0.0;
+		m_peakTickleCost = 0.0;
+	}
+
 private:
-	MxCore* m_client;        ///< [AI] The object to tickle (call Tickle() on periodically). [AI]
-	MxTime m_interval;       ///< [AI] How often to tickle the client (in ms). [AI]
-	MxTime m_lastUpdateTime; ///< [AI] The last time the client was tickled. [AI]
-	MxU16 m_flags;           ///< [AI] Bitflags for client status/intent. 0x01 indicates pending destruction. [AI]
+	friend class MxTickleManager;
+
+	MxCore* m_client;          ///< [AI] The object to tickle (call Tickle() on periodically). [AI]
+	MxTime m_interval;         ///< [AI] How often to tickle the client (in ms). [AI]
+	MxTime m_lastUpdateTime;   ///< [AI] The last time the client was tickled. [AI]
+	MxU16 m_flags;             ///< [AI] Bitflags for client status/intent. 0x01 indicates pending destruction. [AI]
+	MxU32 m_sequence;          ///< [AI] Registration order; clients due in the same pass are tickled in this order.
+	MxS32 m_heapIndex;         ///< [AI] Position in the manager's schedule heap, or -1 while not scheduled.
+	MxU32 m_tickleCount;       ///< [AI] Number of profiled Tickle() calls.
+	MxDouble m_tickleCost;     ///< [AI] Total profiled Tickle() time in ms.
+	MxDouble m_peakTickleCost; ///< [AI] Longest profiled Tickle() call in ms.
+};
+
+/// @brief [AI] Array of MxTickleClient pointers, used for the schedule heap and the per-pass due list. [AI]
+class MxTickleClientPtrVector : public vector<MxTickleClient*> {};
+
+/**
+ * @brief [AI] Orders MxCore pointers for MxTickleClientMap. [AI]
+ */
+struct MxTickleClientComparator {
+	MxBool operator()(MxCore* const& p_a, MxCore* const& p_b) const { return p_a < p_b; }
 };
 
-/// @brief [AI] List type for holding multiple MxTickleClient pointers (the tickle registry). [AI]
-typedef list<MxTickleClient*> MxTickleClientPtrList;
+/// @brief [AI] Maps a tickled object to its live (not pending destruction) client record. [AI]
+typedef map<MxCore*, MxTickleClient*, MxTickleClientComparator> MxTickleClientMap;
 
 // VTABLE: LEGO1 0x100d86d8
 // VTABLE: BETA10 0x101bc9d0
-// SIZE 0x14
+// SIZE 0x58
 /**
  * @brief [AI] Manages ticking ("tickling") a set of MxCore objects at specified intervals.
  *
- * MxTickleManager maintains a list of MxTickleClient entries—each representing a client object and its tickle interval.
- * On each Tickle() call, the manager updates all registered clients, invoking their Tickle() method as needed 
- * (if the interval has elapsed). Used throughout the engine to provide periodic updates for animation, streaming, 
- * and other time-dependent logic.
+ * MxTickleManager maintains a set of MxTickleClient entries—each representing a client object and its tickle interval.
+ * On each Tickle() call, the manager invokes Tickle() on the clients whose interval has elapsed. Used throughout the
+ * engine to provide periodic updates for animation, streaming, and other time-dependent logic.
+ *
+ * Clients are kept in a binary min-heap ordered by due time, so a pass only touches the clients that are due.
+ * Clients due in the same pass are tickled in registration order, as they were when the registry was a plain list.
+ * As with the list, a client registered by another client's Tickle() is tickled later in the same pass if it is due.
+ * Lookups by object go through a map instead of a scan.
  * @details [AI]
  * Intended to be used as a centralized update/ticking system for polymorphic objects, decoupling specific
  * object update logic from the main game/application loop.
@@ -92,7 +156,7 @@ class MxTickleManager : public MxCore {
 	/**
 	 * @brief [AI] Constructs an empty tickle manager. [AI]
 	 */
-	MxTickleManager() {}
+	MxTickleManager() : m_sequence(0), m_depth(0), m_lastTime(0), m_profiling(FALSE) {}
 
 	/**
 	 * @brief [AI] Destroys the tickle manager, unregistering and freeing all clients.
@@ -140,24 +204,64 @@ class MxTickleManager : public MxCore {
 	 */
 	virtual MxTime GetClientTickleInterval(MxCore* p_client);                  // vtable+0x20
 
+	/**
+	 * @brief [AI] Enables or disables measuring how long each client's Tickle() takes. Off by default.
+	 */
+	void SetProfiling(MxBool p_profiling) { m_profiling = p_profiling; }
+
+	/**
+	 * @brief [AI] Returns whether per-client tickle profiling is enabled. [AI]
+	 */
+	MxBool GetProfiling() const { return m_profiling; }
+
+	/**
+	 * @brief [AI] Looks up the profiled tickle cost of a registered client.
+	 * @param p_client The object to query. [AI]
+	 * @param p_count Receives the number of profiled Tickle() calls. [AI]
+	 * @param p_total Receives the total time spent in Tickle(), in ms. [AI]
+	 * @param p_peak Receives the longest single Tickle(), in ms. [AI]
+	 * @return SUCCESS if the client is registered, FAILURE otherwise. [AI]
+	 */
+	MxResult GetClientTickleCost(MxCore* p_client, MxU32& p_count, MxDouble& p_total, MxDouble& p_peak);
+
+	/**
+	 * @brief [AI] Returns the registered client with the highest total profiled tickle cost, or NULL. [AI]
+	 */
+	MxCore* GetCostliestClient();
+
+	/**
+	 * @brief [AI] Clears the profiling counters of all registered clients. [AI]
+	 */
+	void ResetTickleCosts();
+
 	// SYNTHETIC: LEGO1 0x1005a510
 	// SYNTHETIC: BETA10 0x100962f0
 	// MxTickleManager::`scalar deleting destructor'
 
 private:
-	MxTickleClientPtrList m_clients; ///< [AI] The current set of registered tickle clients. [AI]
-};
-
-#define TICKLE_MANAGER_NOT_FOUND 0x80000000 ///< [AI] Returned by GetClientTickleInterval when the client is not found. [AI]
+	MxTickleClient* FindClient(MxCore* p_client);
+	void Schedule(MxTickleClient* p_client);
+	void Unschedule(MxTickleClient* p_client);
+	void Reschedule(MxTickleClient* p_client);
+	void RebuildSchedule(MxTime p_time);
+	void CollectLateDue(MxTime p_time, MxU32 p_begin, MxU32 p_sequence);
+	void SiftUp(MxS32 p_index);
+	void SiftDown(MxS32 p_index);
+	void Place(MxTickleClient* p_client, MxS32 p_index);
+	void PurgeDestroyed();
 
-// TEMPLATE: LEGO1 0x1005a4a0
-// list<MxTickleClient *,allocator<MxTickleClient *> >::~list<MxTickleClient *,allocator<MxTickleClient *> >
+	static MxBool Before(MxTickleClient* p_a, MxTickleClient* p_b);
 
-// TEMPLATE: BETA10 0x10093870
-// List<MxTickleClient *>::List<MxTickleClient *>
+	MxTickleClientPtrVector m_heap;      ///< [AI] Live clients, min-heap on (due time, registration order).
+	MxTickleClientPtrVector m_due;       ///< [AI] Scratch list of clients popped as due in the current pass.
+	MxTickleClientMap m_clients;         ///< [AI] Live clients by object, for register/unregister/interval lookups.
+	MxTickleClientPtrVector m_destroyed; ///< [AI] Unregistered clients, deleted once no pass can still reference them.
+	MxU32 m_sequence;                    ///< [AI] Next registration sequence number.
+	MxS32 m_depth;                       ///< [AI] Nesting depth of Tickle(), so destroyed clients are not freed mid-pass.
+	MxTime m_lastTime;                   ///< [AI] Time of the previous pass, used to detect the timer going backwards.
+	MxBool m_profiling;                  ///< [AI] Whether client Tickle() calls are timed.
+};
 
-// TEMPLATE: LEGO1 0x1005a530
-// TEMPLATE: BETA10 0x10096340
-// List<MxTickleClient *>::~List<MxTickleClient *>
+#define TICKLE_MANAGER_NOT_FOUND 0x80000000 ///< [AI] Returned by GetClientTickleInterval when the client is not found. [AI]
 
 #endif // MXTICKLEMANAGER_H
@@ -58,6 +58,35 @@ class MxTimer : public MxCore {
 		}
 	}
 
+	/**
+	 * @brief [AI] Switches all timers to a virtual clock that only moves when Step is called.
+	 * @details [AI] Meant for headless benchmark runs: every frame sees exactly the same times no
+	 * matter how long it took. Must be called before the engine's timer is created. 0 restores timeGetTime.
+	 * @param p_step Milliseconds added to the clock by each Step. [AI]
+	 */
+	static void SetFixedStep(MxLong p_step);
+
+	/**
+	 * @brief [AI] Returns the step set with SetFixedStep, 0 if timers follow timeGetTime. [AI]
+	 */
+	static MxLong GetFixedStep() { return g_fixedStep; }
+
+	/**
+	 * @brief [AI] Advances the virtual clock by the fixed step. Does nothing while timers follow timeGetTime. [AI]
+	 */
+	static void Step();
+
+	/**
+	 * @brief [AI] Returns the system tick count in ms: the virtual clock if a fixed step is set, else timeGetTime. [AI]
+	 */
+	static MxLong GetClock();
+
+	/**
+	 * @brief [AI] Returns the performance counter in ms, 0 if the machine has none. [AI]
+	 * @details [AI] For measuring how long code runs: unlike GetClock it is never the virtual clock.
+	 */
+	static MxDouble GetProfileTime();
+
 	// SYNTHETIC: LEGO1 0x100ae0d0
 	// SYNTHETIC: BETA10 0x1012bf80
 	// MxTimer::`scalar deleting destructor'
@@ -68,6 +97,9 @@ class MxTimer : public MxCore {
 
 	static MxLong g_lastTimeCalculated;   ///< @brief Globally records the last tick count returned by GetRealTime. Used for consistency across timers. [AI]
 	static MxLong g_lastTimeTimerStarted; ///< @brief Globally records the time value at which a timer was last started. Used for elapsed time computation while running. [AI]
+	static MxLong g_fixedStep;            ///< [AI] Step of the virtual clock in ms, 0 if timers follow timeGetTime.
+	static MxLong g_fixedTime;            ///< [AI] Current value of the virtual clock in ms.
+	static MxDouble g_ticksPerMS;         ///< [AI] Performance counter ticks per ms, 0 without a counter, -1 until queried.
 };
 
 // SYNTHETIC: BETA10 0x1012bfc0
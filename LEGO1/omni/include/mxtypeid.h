@@ -0,0 +1,59 @@
+#ifndef MXTYPEID_H
+#define MXTYPEID_H
+
+#include "mxtypes.h"
+
+class MxCore;
+
+/**
+ * @brief [AI] Interned class name for fast MxCore type checks.
+ * @details [AI] Every MxTypeId receives a small index when it is constructed (at static initialization).
+ * MxCore::IsKindOf resolves IsA(GetName()) the first time a given class is tested against the id and
+ * remembers the answer in a per-class bitset keyed by the class's ClassName() pointer. Later checks are a
+ * table probe and a bit test instead of a strcmp for every ancestor.
+ *
+ * The answers are exactly those of the string-based IsA, which stays the entry point for names that are
+ * only known at runtime (script lookups, LegoWorld::Find by class name).
+ */
+class MxTypeId {
+public:
+	/**
+	 * @brief [AI] Registers a class name. p_name must outlive the id (normally a string literal). [AI]
+	 */
+	MxTypeId(const char* p_name);
+
+	/**
+	 * @brief [AI] Returns the class name this id stands for. [AI]
+	 */
+	const char* GetName() const { return m_name; }
+
+	/**
+	 * @brief [AI] Returns TRUE if p_object->IsA(p_type.GetName()) would, using the cached answer if there is one. [AI]
+	 */
+	static MxBool Check(const MxCore* p_object, const MxTypeId& p_type);
+
+private:
+	const char* m_name; ///< [AI] Class name passed to IsA on a cache miss.
+	MxU32 m_index;      ///< [AI] Bit index into the per-class answer sets.
+
+	static MxU32 g_numTypeIds;
+};
+
+/// @brief [AI] Name of the MxTypeId object for a class. [AI]
+#define MX_TYPEID(name) g_typeId##name
+
+/// @brief [AI] Declares the MxTypeId object for a class. [AI]
+#define DECLARE_MX_TYPEID(name) extern MxTypeId MX_TYPEID(name)
+
+/// @brief [AI] Defines the MxTypeId object for a class; use once per name, in a .cpp file. [AI]
+#define DEFINE_MX_TYPEID(name) MxTypeId MX_TYPEID(name)(#name)
+
+DECLARE_MX_TYPEID(MxCompositePresenter);
+DECLARE_MX_TYPEID(MxDSMediaAction);
+DECLARE_MX_TYPEID(MxDSMultiAction);
+DECLARE_MX_TYPEID(MxDSSerialAction);
+DECLARE_MX_TYPEID(MxEntity);
+DECLARE_MX_TYPEID(MxPresenter);
+DECLARE_MX_TYPEID(MxWavePresenter);
+
+#endif // MXTYPEID_H
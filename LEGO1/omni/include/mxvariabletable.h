@@ -7,7 +7,7 @@
 
 // VTABLE: LEGO1 0x100dc1c8
 // VTABLE: BETA10 0x101c1c78
-// SIZE 0x28
+// SIZE 0x1c
 
 /**
  * @brief MxVariableTable is a specialized hash table for storing key/value string variables used by the LEGO Island engine.
@@ -15,6 +15,8 @@
  * @details [AI]
  * MxVariableTable manages a table of MxVariable pointers, each storing a string key and a string value.
  * It provides methods to set and get variables by key, and uses custom hash and comparison functions for efficient lookups.
+ * Keys are case-insensitive (stored upper-cased); lookups by string hash and match the raw key directly, so reading or
+ * updating a variable does not allocate.
  * The engine uses this system as the "variable table" found on MxOmni and scripting components, usually for storing game, script or global state variables at runtime.
  */
 class MxVariableTable : public MxHashTable<MxVariable*> {
@@ -69,10 +71,26 @@ class MxVariableTable : public MxHashTable<MxVariable*> {
 	 * @brief Hashes the key of the given variable for use in the table. [AI]
 	 * @param [in] [AI] Pointer to MxVariable to hash.
 	 * @return MxU32 The calculated hash value based on its key. [AI]
-	 * @details [AI] Sums the ASCII values of all characters in the key string.
+	 * @details [AI] FNV-1a over the key string, see HashKey().
 	 */
 	MxU32 Hash(MxVariable*) override; // vtable+0x18
 
+	/**
+	 * @brief Hashes a variable key, ignoring case. [AI]
+	 * @param p_key Key string. [AI]
+	 * @return MxU32 32-bit FNV-1a hash of the upper-cased key. [AI]
+	 * @details [AI] Matches Hash() for a variable created with the same key in any case.
+	 */
+	static MxU32 HashKey(const char* p_key);
+
+	/**
+	 * @brief Returns whether a variable's key equals a raw key string, ignoring case. [AI]
+	 * @param p_var Variable to test. [AI]
+	 * @param p_key Key string (const char*). [AI]
+	 * @return TRUE if the keys match. [AI]
+	 */
+	static MxBool MatchKey(MxVariable* p_var, const void* p_key);
+
 	// SYNTHETIC: destructor and other template methods managed by base class
 };
 
@@ -147,9 +165,6 @@ class MxVariableTable : public MxHashTable<MxVariable*> {
 // TEMPLATE: BETA10 0x1012ad00
 // MxHashTableCursor<MxVariable *>::Find
 
-// TEMPLATE: BETA10 0x1012af90
-// MxHashTableNode<MxVariable *>::MxHashTableNode<MxVariable *>
-
 // TEMPLATE: BETA10 0x10132890
 // MxHashTable<MxVariable *>::MxHashTable<MxVariable *>
 
@@ -51,6 +51,11 @@ class MxVideoManager : public MxMediaManager {
 	 */
 	void Destroy() override;    // vtable+0x18
 
+	/**
+	 * @brief [AI] Registers a presenter and flags the presenter list for re-sorting by display Z.
+	 */
+	void RegisterPresenter(MxPresenter& p_presenter) override; // vtable+0x1c
+
 	/**
 	 * @brief [AI] Main DirectDraw/Direct3D allocator and presenter chain creation.
 	 * 
@@ -126,11 +131,13 @@ class MxVideoManager : public MxMediaManager {
 
 	/**
 	 * @brief [AI] Sorts presenters in descending Z order for proper overdraw order during tickle (bubble-sort).
+	 * @details [AI] Does nothing unless a presenter was registered or a display Z changed since the last sort.
 	 */
 	void SortPresenterList();
 
 	/**
 	 * @brief [AI] Updates the portion of the display surface that is marked dirty based on m_region, performs the actual onscreen blit.
+	 * @details [AI] Each rectangle of the region is displayed separately, so disjoint dirty areas do not pull in everything between them.
 	 */
 	void UpdateRegion();
 
@@ -162,6 +169,7 @@ class MxVideoManager : public MxMediaManager {
 	MxDisplaySurface* m_displaySurface; ///< [AI] Concrete blitting/output surface where final image is copied each frame. [0x58]
 	MxRegion* m_region;                 ///< [AI] Tracks regions that have been invalidated and need to be updated/redrawn. [0x5c]
 	MxBool m_unk0x60;                   ///< [AI] TRUE if manager owns the DirectDraw/Direct3D objects and should release them; FALSE if external. [0x60]
+	MxBool m_sortPresenters;            ///< [AI] TRUE if a presenter was registered since the last SortPresenterList. [0x61]
 };
 
 #endif // MXVIDEOMANAGER_H
\ No newline at end of file
@@ -78,7 +78,7 @@ MxLong MxDSParallelAction::GetDuration()
 		}
 
 		duration += action->GetStartTime();
-		if (action->IsA("MxDSMediaAction")) {
+		if (action->IsKindOf(MX_TYPEID(MxDSMediaAction))) {
 			MxLong sustainTime = ((MxDSMediaAction*) action)->GetSustainTime();
 
 			if (sustainTime == -1) {
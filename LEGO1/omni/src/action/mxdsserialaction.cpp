@@ -85,7 +85,7 @@ MxLong MxDSSerialAction::GetDuration()
 		if (action) {
 			m_duration += action->GetDuration() + action->GetStartTime();
 
-			if (action->IsA("MxDSMediaAction")) {
+			if (action->IsKindOf(MX_TYPEID(MxDSMediaAction))) {
 				MxLong sustainTime = ((MxDSMediaAction*) action)->GetSustainTime();
 
 				if (sustainTime && sustainTime != -1) {
@@ -5,11 +5,14 @@
 #include "mxmisc.h"
 #include "mxomni.h"
 #include "mxpresenter.h"
+#include "mxsoundmixer.h"
+#include "mxsoundsink.h"
 #include "mxticklemanager.h"
 #include "mxticklethread.h"
+#include "mxtimer.h"
 #include "mxwavepresenter.h"
 
-DECOMP_SIZE_ASSERT(MxSoundManager, 0x3c);
+DECOMP_SIZE_ASSERT(MxSoundManager, 0x40);
 
 // GLOBAL LEGO1 0x10101420
 MxS32 g_volumeAttenuation[100] = {-6643, -5643, -5058, -4643, -4321, -4058, -3836, -3643, -3473, -3321, -3184, -3058,
@@ -39,6 +42,7 @@ void MxSoundManager::Init()
 {
 	m_directSound = NULL;
 	m_dsBuffer = NULL;
+	m_mixer = NULL;
 }
 
 // FUNCTION: LEGO1 0x100ae840
@@ -54,6 +58,8 @@ void MxSoundManager::Destroy(MxBool p_fromDestructor)
 
 	m_criticalSection.Enter();
 
+	delete m_mixer;
+
 	if (m_dsBuffer) {
 		m_dsBuffer->Release();
 	}
@@ -80,56 +86,63 @@ MxResult MxSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 	m_criticalSection.Enter();
 	locked = TRUE;
 
-	if (DirectSoundCreate(NULL, &m_directSound, NULL) != DS_OK) {
-		goto done;
-	}
-
-	if (m_directSound->SetCooperativeLevel(MxOmni::GetInstance()->GetWindowHandle(), DSSCL_PRIORITY) != DS_OK) {
-		goto done;
-	}
-
-	DSBUFFERDESC desc;
-	memset(&desc, 0, sizeof(desc));
-	desc.dwSize = sizeof(desc);
-
-	if (MxOmni::IsSound3D()) {
-		desc.dwFlags = DSBCAPS_PRIMARYBUFFER | DSBCAPS_CTRL3D;
+	if (MxSoundMixer::GetOutput() != MxSoundMixer::e_none || MxOmni::IsHeadless()) {
+		if (CreateMixer() != SUCCESS) {
+			goto done;
+		}
 	}
 	else {
-		desc.dwFlags = DSBCAPS_PRIMARYBUFFER | DSBCAPS_CTRLVOLUME;
-	}
+		if (DirectSoundCreate(NULL, &m_directSound, NULL) != DS_OK) {
+			goto done;
+		}
 
-	if (m_directSound->CreateSoundBuffer(&desc, &m_dsBuffer, NULL) != DS_OK) {
-		if (!MxOmni::IsSound3D()) {
+		if (m_directSound->SetCooperativeLevel(MxOmni::GetInstance()->GetWindowHandle(), DSSCL_PRIORITY) != DS_OK) {
 			goto done;
 		}
 
-		MxOmni::SetSound3D(FALSE);
-		desc.dwFlags = DSBCAPS_PRIMARYBUFFER | DSBCAPS_CTRLVOLUME;
+		DSBUFFERDESC desc;
+		memset(&desc, 0, sizeof(desc));
+		desc.dwSize = sizeof(desc);
+
+		if (MxOmni::IsSound3D()) {
+			desc.dwFlags = DSBCAPS_PRIMARYBUFFER | DSBCAPS_CTRL3D;
+		}
+		else {
+			desc.dwFlags = DSBCAPS_PRIMARYBUFFER | DSBCAPS_CTRLVOLUME;
+		}
 
 		if (m_directSound->CreateSoundBuffer(&desc, &m_dsBuffer, NULL) != DS_OK) {
-			goto done;
+			if (!MxOmni::IsSound3D()) {
+				goto done;
+			}
+
+			MxOmni::SetSound3D(FALSE);
+			desc.dwFlags = DSBCAPS_PRIMARYBUFFER | DSBCAPS_CTRLVOLUME;
+
+			if (m_directSound->CreateSoundBuffer(&desc, &m_dsBuffer, NULL) != DS_OK) {
+				goto done;
+			}
 		}
-	}
 
-	WAVEFORMATEX format;
+		WAVEFORMATEX format;
 
-	format.wFormatTag = WAVE_FORMAT_PCM;
+		format.wFormatTag = WAVE_FORMAT_PCM;
 
-	if (MxOmni::IsSound3D()) {
-		format.nChannels = 2;
-	}
-	else {
-		format.nChannels = 1;
-	}
+		if (MxOmni::IsSound3D()) {
+			format.nChannels = 2;
+		}
+		else {
+			format.nChannels = 1;
+		}
 
-	format.nSamplesPerSec = 11025; // KHz
-	format.wBitsPerSample = 16;
-	format.nBlockAlign = format.nChannels * 2;
-	format.nAvgBytesPerSec = format.nBlockAlign * 11025;
-	format.cbSize = 0;
+		format.nSamplesPerSec = 11025; // KHz
+		format.wBitsPerSample = 16;
+		format.nBlockAlign = format.nChannels * 2;
+		format.nAvgBytesPerSec = format.nBlockAlign * 11025;
+		format.cbSize = 0;
 
-	status = m_dsBuffer->SetFormat(&format);
+		status = m_dsBuffer->SetFormat(&format);
+	}
 
 	if (p_createThread) {
 		m_thread = new MxTickleThread(this, p_frequencyMS);
@@ -155,6 +168,69 @@ MxResult MxSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 	return status;
 }
 
+MxResult MxSoundManager::CreateMixer()
+{
+	MxSoundSink* sink;
+
+	MxU32 output = MxSoundMixer::GetOutput();
+
+	// The mixer has no 3D buffers; Lego3DSound applies its own distance model instead
+	MxOmni::SetSound3D(FALSE);
+
+	if (MxOmni::IsHeadless() && output != MxSoundMixer::e_waveFile) {
+		output = MxSoundMixer::e_null;
+	}
+
+	switch (output) {
+	case MxSoundMixer::e_device:
+		if (DirectSoundCreate(NULL, &m_directSound, NULL) != DS_OK) {
+			return FAILURE;
+		}
+
+		if (m_directSound->SetCooperativeLevel(MxOmni::GetInstance()->GetWindowHandle(), DSSCL_PRIORITY) != DS_OK) {
+			return FAILURE;
+		}
+
+		sink = new MxDirectSoundSink(m_directSound);
+		break;
+	case MxSoundMixer::e_waveFile:
+		sink = new MxWaveFileSoundSink(MxSoundMixer::GetFilename());
+		break;
+	default:
+		sink = new MxNullSoundSink();
+		break;
+	}
+
+	m_mixer = new MxSoundMixer();
+
+	if (m_mixer == NULL) {
+		delete sink;
+		return FAILURE;
+	}
+
+	return m_mixer->Create(sink, MxTimer::GetFixedStep() == 0);
+}
+
+MxResult MxSoundManager::Tickle()
+{
+	MxAudioManager::Tickle();
+
+	if (m_mixer != NULL && !m_mixer->IsThreaded()) {
+		m_mixer->Update();
+	}
+
+	return SUCCESS;
+}
+
+HRESULT MxSoundManager::CreateSoundBuffer(LPCDSBUFFERDESC p_desc, LPDIRECTSOUNDBUFFER* p_buffer)
+{
+	if (m_mixer != NULL) {
+		return m_mixer->CreateSoundBuffer(p_desc, p_buffer);
+	}
+
+	return m_directSound->CreateSoundBuffer(p_desc, p_buffer, NULL);
+}
+
 // FUNCTION: LEGO1 0x100aeab0
 void MxSoundManager::Destroy()
 {
@@ -217,7 +293,7 @@ void MxSoundManager::Pause()
 	MxPresenterListCursor cursor(m_presenters);
 
 	while (cursor.Next(presenter)) {
-		if (presenter->IsA("MxWavePresenter")) {
+		if (presenter->IsKindOf(MX_TYPEID(MxWavePresenter))) {
 			((MxWavePresenter*) presenter)->Pause();
 		}
 	}
@@ -232,7 +308,7 @@ void MxSoundManager::Resume()
 	MxPresenterListCursor cursor(m_presenters);
 
 	while (cursor.Next(presenter)) {
-		if (presenter->IsA("MxWavePresenter")) {
+		if (presenter->IsKindOf(MX_TYPEID(MxWavePresenter))) {
 			((MxWavePresenter*) presenter)->Resume();
 		}
 	}
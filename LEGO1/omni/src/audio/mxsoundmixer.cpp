@@ -0,0 +1,715 @@
+#include "mxsoundmixer.h"
+
+#include "mxautolock.h"
+#include "mxsoundsink.h"
+
+#include <math.h>
+
+MxU32 MxSoundMixer::g_output = MxSoundMixer::e_none;
+const char* MxSoundMixer::g_filename = NULL;
+
+// Gain of a voice at DirectSound volume 0, 2.14 fixed point
+#define MXSOUNDMIXER_UNITY_GAIN 16384
+
+// Interpolates between two samples by the upper 15 bits of a 16-bit fraction
+#define LERP_SAMPLE(a, b, f) ((a) + ((((MxS32) (b) - (a)) * (MxS32) (f)) >> 15))
+
+// Resamples p_count mono frames starting at p_frame/p_fraction and adds them to both channels of p_dest.
+// The caller guarantees that p_frame + 1 stays inside the data for all p_count frames.
+static void MixMono(
+	MxS32* p_dest,
+	const MxS16* p_src,
+	MxU32 p_count,
+	MxU32& p_frame,
+	MxU32& p_fraction,
+	MxU32 p_step,
+	MxS32 p_gainLeft,
+	MxS32 p_gainRight
+)
+{
+	MxU32 frame = p_frame;
+	MxU32 fraction = p_fraction;
+
+	while (p_count--) {
+		MxS32 sample = LERP_SAMPLE(p_src[frame], p_src[frame + 1], fraction >> 1);
+
+		p_dest[0] += (sample * p_gainLeft) >> 14;
+		p_dest[1] += (sample * p_gainRight) >> 14;
+		p_dest += 2;
+
+		fraction += p_step;
+		frame += fraction >> 16;
+		fraction &= 0xffff;
+	}
+
+	p_frame = frame;
+	p_fraction = fraction;
+}
+
+// Stereo counterpart of MixMono; the left and right source channels keep their sides
+static void MixStereo(
+	MxS32* p_dest,
+	const MxS16* p_src,
+	MxU32 p_count,
+	MxU32& p_frame,
+	MxU32& p_fraction,
+	MxU32 p_step,
+	MxS32 p_gainLeft,
+	MxS32 p_gainRight
+)
+{
+	MxU32 frame = p_frame;
+	MxU32 fraction = p_fraction;
+
+	while (p_count--) {
+		const MxS16* src = p_src + frame * 2;
+		MxS32 f = fraction >> 1;
+
+		p_dest[0] += (LERP_SAMPLE(src[0], src[2], f) * p_gainLeft) >> 14;
+		p_dest[1] += (LERP_SAMPLE(src[1], src[3], f) * p_gainRight) >> 14;
+		p_dest += 2;
+
+		fraction += p_step;
+		frame += fraction >> 16;
+		fraction &= 0xffff;
+	}
+
+	p_frame = frame;
+	p_fraction = fraction;
+}
+
+MxSoundVoice::MxSoundVoice(MxSoundMixer* p_mixer)
+{
+	m_mixer = p_mixer;
+	m_refCount = 1;
+	memset(&m_format, 0, sizeof(m_format));
+	m_flags = 0;
+	m_data = NULL;
+	m_samples = NULL;
+	m_size = 0;
+	m_numFrames = 0;
+	m_frame = 0;
+	m_fraction = 0;
+	m_step = 0;
+	m_frequency = DSBFREQUENCY_ORIGINAL;
+	m_volume = DSBVOLUME_MAX;
+	m_pan = DSBPAN_CENTER;
+	m_gainLeft = MXSOUNDMIXER_UNITY_GAIN;
+	m_gainRight = MXSOUNDMIXER_UNITY_GAIN;
+	m_playing = FALSE;
+	m_looping = FALSE;
+}
+
+MxSoundVoice::~MxSoundVoice()
+{
+	if ((MxU8*) m_samples != m_data) {
+		delete[] m_samples;
+	}
+
+	delete[] m_data;
+}
+
+HRESULT MxSoundVoice::Create(LPCDSBUFFERDESC p_desc)
+{
+	LPWAVEFORMATEX format = p_desc->lpwfxFormat;
+
+	if (format == NULL || format->wFormatTag != WAVE_FORMAT_PCM || format->nChannels < 1 || format->nChannels > 2 ||
+		(format->wBitsPerSample != 8 && format->wBitsPerSample != 16) || p_desc->dwBufferBytes < format->nBlockAlign) {
+		return DSERR_BADFORMAT;
+	}
+
+	m_format = *format;
+	m_format.cbSize = 0;
+	m_flags = p_desc->dwFlags;
+	m_numFrames = p_desc->dwBufferBytes / format->nBlockAlign;
+	m_size = m_numFrames * format->nBlockAlign;
+	m_data = new MxU8[m_size];
+
+	if (m_data == NULL) {
+		return DSERR_OUTOFMEMORY;
+	}
+
+	if (format->wBitsPerSample == 16) {
+		m_samples = (MxS16*) m_data;
+		memset(m_data, 0, m_size);
+	}
+	else {
+		m_samples = new MxS16[m_size];
+
+		if (m_samples == NULL) {
+			return DSERR_OUTOFMEMORY;
+		}
+
+		memset(m_data, 0x80, m_size);
+		memset(m_samples, 0, m_size * sizeof(MxS16));
+	}
+
+	UpdateStep();
+	return DS_OK;
+}
+
+MxCriticalSection* MxSoundVoice::GetLock()
+{
+	return m_mixer != NULL ? &m_mixer->m_lock : NULL;
+}
+
+STDMETHODIMP MxSoundVoice::QueryInterface(REFIID p_riid, LPVOID* p_object)
+{
+	if (p_riid == IID_IUnknown || p_riid == IID_IDirectSoundBuffer) {
+		*p_object = this;
+		AddRef();
+		return S_OK;
+	}
+
+	*p_object = NULL;
+	return E_NOINTERFACE;
+}
+
+STDMETHODIMP_(ULONG) MxSoundVoice::AddRef()
+{
+	return ++m_refCount;
+}
+
+STDMETHODIMP_(ULONG) MxSoundVoice::Release()
+{
+	if (--m_refCount != 0) {
+		return m_refCount;
+	}
+
+	if (m_mixer != NULL) {
+		m_mixer->RemoveVoice(this);
+	}
+
+	delete this;
+	return 0;
+}
+
+STDMETHODIMP MxSoundVoice::GetCaps(LPDSBCAPS p_caps)
+{
+	p_caps->dwFlags = m_flags | DSBCAPS_LOCSOFTWARE;
+	p_caps->dwBufferBytes = m_size;
+	p_caps->dwUnlockTransferRate = 0;
+	p_caps->dwPlayCpuOverhead = 0;
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::GetCurrentPosition(LPDWORD p_playCursor, LPDWORD p_writeCursor)
+{
+	MxAutoLock lock(GetLock());
+
+	DWORD play = m_frame * m_format.nBlockAlign;
+
+	if (p_playCursor != NULL) {
+		*p_playCursor = play;
+	}
+
+	// The mixer reads one chunk at a time, stay a chunk's worth ahead of it
+	if (p_writeCursor != NULL) {
+		DWORD lead = ((m_step * MxSoundMixer::e_chunkFrames) >> 16) * m_format.nBlockAlign;
+		*p_writeCursor = m_playing ? (play + lead) % m_size : play;
+	}
+
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::GetFormat(LPWAVEFORMATEX p_format, DWORD p_size, LPDWORD p_sizeWritten)
+{
+	DWORD size = p_size < sizeof(m_format) ? p_size : sizeof(m_format);
+
+	if (p_format != NULL) {
+		memcpy(p_format, &m_format, size);
+	}
+
+	if (p_sizeWritten != NULL) {
+		*p_sizeWritten = p_format != NULL ? size : sizeof(m_format);
+	}
+
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::GetVolume(LPLONG p_volume)
+{
+	*p_volume = m_volume;
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::GetPan(LPLONG p_pan)
+{
+	*p_pan = m_pan;
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::GetFrequency(LPDWORD p_frequency)
+{
+	*p_frequency = m_frequency != DSBFREQUENCY_ORIGINAL ? m_frequency : m_format.nSamplesPerSec;
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::GetStatus(LPDWORD p_status)
+{
+	MxAutoLock lock(GetLock());
+
+	*p_status = 0;
+
+	if (m_playing) {
+		*p_status = DSBSTATUS_PLAYING;
+
+		if (m_looping) {
+			*p_status |= DSBSTATUS_LOOPING;
+		}
+	}
+
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::Initialize(LPDIRECTSOUND p_directSound, LPCDSBUFFERDESC p_desc)
+{
+	return DSERR_ALREADYINITIALIZED;
+}
+
+STDMETHODIMP MxSoundVoice::Lock(
+	DWORD p_offset,
+	DWORD p_bytes,
+	LPVOID* p_audioPtr1,
+	LPDWORD p_audioBytes1,
+	LPVOID* p_audioPtr2,
+	LPDWORD p_audioBytes2,
+	DWORD p_flags
+)
+{
+	if (p_flags & DSBLOCK_FROMWRITECURSOR) {
+		GetCurrentPosition(NULL, &p_offset);
+	}
+
+	if (p_offset >= m_size || p_bytes > m_size) {
+		return DSERR_INVALIDPARAM;
+	}
+
+	*p_audioPtr1 = m_data + p_offset;
+
+	if (p_offset + p_bytes <= m_size) {
+		*p_audioBytes1 = p_bytes;
+
+		if (p_audioPtr2 != NULL) {
+			*p_audioPtr2 = NULL;
+			*p_audioBytes2 = 0;
+		}
+	}
+	else {
+		*p_audioBytes1 = m_size - p_offset;
+
+		if (p_audioPtr2 == NULL) {
+			return DSERR_INVALIDPARAM;
+		}
+
+		*p_audioPtr2 = m_data;
+		*p_audioBytes2 = p_bytes - *p_audioBytes1;
+	}
+
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::Play(DWORD p_reserved1, DWORD p_reserved2, DWORD p_flags)
+{
+	MxAutoLock lock(GetLock());
+
+	m_playing = TRUE;
+	m_looping = (p_flags & DSBPLAY_LOOPING) != 0;
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::SetCurrentPosition(DWORD p_position)
+{
+	MxAutoLock lock(GetLock());
+
+	m_frame = (p_position % m_size) / m_format.nBlockAlign;
+	m_fraction = 0;
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::SetFormat(LPCWAVEFORMATEX p_format)
+{
+	return DSERR_INVALIDCALL;
+}
+
+STDMETHODIMP MxSoundVoice::SetVolume(LONG p_volume)
+{
+	if (p_volume < DSBVOLUME_MIN || p_volume > DSBVOLUME_MAX) {
+		return DSERR_INVALIDPARAM;
+	}
+
+	MxAutoLock lock(GetLock());
+
+	m_volume = p_volume;
+	UpdateGain();
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::SetPan(LONG p_pan)
+{
+	if (p_pan < DSBPAN_LEFT || p_pan > DSBPAN_RIGHT) {
+		return DSERR_INVALIDPARAM;
+	}
+
+	MxAutoLock lock(GetLock());
+
+	m_pan = p_pan;
+	UpdateGain();
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::SetFrequency(DWORD p_frequency)
+{
+	if (p_frequency != DSBFREQUENCY_ORIGINAL && (p_frequency < DSBFREQUENCY_MIN || p_frequency > DSBFREQUENCY_MAX)) {
+		return DSERR_INVALIDPARAM;
+	}
+
+	MxAutoLock lock(GetLock());
+
+	m_frequency = p_frequency;
+	UpdateStep();
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::Stop()
+{
+	MxAutoLock lock(GetLock());
+
+	m_playing = FALSE;
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::Unlock(LPVOID p_audioPtr1, DWORD p_audioBytes1, LPVOID p_audioPtr2, DWORD p_audioBytes2)
+{
+	if (m_format.wBitsPerSample == 8) {
+		Widen(p_audioPtr1, p_audioBytes1);
+
+		if (p_audioPtr2 != NULL) {
+			Widen(p_audioPtr2, p_audioBytes2);
+		}
+	}
+
+	return DS_OK;
+}
+
+STDMETHODIMP MxSoundVoice::Restore()
+{
+	// Voices live in system memory and are never lost
+	return DS_OK;
+}
+
+void MxSoundVoice::Widen(LPVOID p_audioPtr, DWORD p_bytes)
+{
+	MxU32 offset = (MxU8*) p_audioPtr - m_data;
+
+	if (offset >= m_size) {
+		return;
+	}
+
+	if (p_bytes > m_size - offset) {
+		p_bytes = m_size - offset;
+	}
+
+	const MxU8* src = m_data + offset;
+	MxS16* dest = m_samples + offset;
+
+	while (p_bytes--) {
+		*dest++ = (MxS16) ((*src++ - 0x80) << 8);
+	}
+}
+
+void MxSoundVoice::UpdateGain()
+{
+	// Like DirectSound, pan attenuates only the channel on the far side
+	LONG left = m_volume + (m_pan > 0 ? -m_pan : 0);
+	LONG right = m_volume + (m_pan < 0 ? m_pan : 0);
+
+	m_gainLeft = left <= DSBVOLUME_MIN ? 0 : (MxS32) (MXSOUNDMIXER_UNITY_GAIN * pow(10.0, left / 2000.0));
+	m_gainRight = right <= DSBVOLUME_MIN ? 0 : (MxS32) (MXSOUNDMIXER_UNITY_GAIN * pow(10.0, right / 2000.0));
+}
+
+void MxSoundVoice::UpdateStep()
+{
+	DWORD frequency = m_frequency != DSBFREQUENCY_ORIGINAL ? m_frequency : m_format.nSamplesPerSec;
+	m_step = (MxU32) ((double) frequency * 65536.0 / MxSoundMixer::e_frequency);
+}
+
+void MxSoundMixer::SetOutput(MxU32 p_output, const char* p_filename)
+{
+	g_output = p_output;
+	g_filename = p_filename;
+}
+
+MxSoundMixer::MxSoundMixer() : MxThread()
+{
+	m_sink = NULL;
+	m_voices = NULL;
+	m_numVoices = 0;
+	m_maxVoices = 0;
+	m_active = FALSE;
+	m_threaded = FALSE;
+}
+
+MxSoundMixer::~MxSoundMixer()
+{
+	Destroy();
+}
+
+MxResult MxSoundMixer::Create(MxSoundSink* p_sink, MxBool p_createThread)
+{
+	m_sink = p_sink;
+
+	if (m_sink == NULL || m_sink->Open(e_frequency) != SUCCESS) {
+		goto fail;
+	}
+
+	if (p_createThread) {
+		m_active = m_threaded = TRUE;
+
+		if (Start(0x1000, 0) != SUCCESS) {
+			m_active = m_threaded = FALSE;
+			goto fail;
+		}
+	}
+
+	return SUCCESS;
+
+fail:
+	Destroy();
+	return FAILURE;
+}
+
+void MxSoundMixer::Destroy()
+{
+	if (m_threaded) {
+		m_active = m_threaded = FALSE;
+		Terminate();
+	}
+
+	if (m_sink != NULL) {
+		m_sink->Close();
+		delete m_sink;
+		m_sink = NULL;
+	}
+
+	AUTOLOCK(m_lock);
+
+	// Voices still held by presenters keep working as silent buffers
+	for (MxU32 i = 0; i < m_numVoices; i++) {
+		m_voices[i]->m_mixer = NULL;
+		m_voices[i]->m_playing = FALSE;
+	}
+
+	delete[] m_voices;
+	m_voices = NULL;
+	m_numVoices = 0;
+	m_maxVoices = 0;
+}
+
+MxResult MxSoundMixer::Run()
+{
+	while (m_active) {
+		Update();
+		Sleep(e_updateInterval);
+	}
+
+	return MxThread::Run();
+}
+
+void MxSoundMixer::Update()
+{
+	MxU32 frames = m_sink->GetFreeFrames();
+
+	while (frames != 0) {
+		MxU32 count = frames < e_chunkFrames ? frames : e_chunkFrames;
+		Mix(count);
+		frames -= count;
+	}
+}
+
+MxU32 MxSoundMixer::Mix(MxU32 p_frames)
+{
+	MxU32 i;
+	MxU32 mixed = 0;
+
+	if (p_frames > e_chunkFrames) {
+		p_frames = e_chunkFrames;
+	}
+
+	memset(m_mix, 0, p_frames * 2 * sizeof(MxS32));
+
+	{
+		AUTOLOCK(m_lock);
+
+		for (i = 0; i < m_numVoices; i++) {
+			MxSoundVoice* voice = m_voices[i];
+
+			if (voice->m_playing && (voice->m_gainLeft | voice->m_gainRight) != 0) {
+				MixVoice(voice, m_mix, p_frames);
+				mixed++;
+			}
+			else if (voice->m_playing) {
+				// Inaudible voices still have to move on, or they would never finish
+				MxU32 advance = voice->m_fraction + voice->m_step * p_frames;
+				voice->m_frame += advance >> 16;
+				voice->m_fraction = advance & 0xffff;
+
+				if (voice->m_frame >= voice->m_numFrames) {
+					if (voice->m_looping) {
+						voice->m_frame %= voice->m_numFrames;
+					}
+					else {
+						voice->m_playing = FALSE;
+						voice->m_frame = voice->m_fraction = 0;
+					}
+				}
+			}
+		}
+	}
+
+	for (i = 0; i < p_frames * 2; i++) {
+		MxS32 sample = m_mix[i];
+
+		if (sample > 32767) {
+			sample = 32767;
+		}
+		else if (sample < -32768) {
+			sample = -32768;
+		}
+
+		m_output[i] = (MxS16) sample;
+	}
+
+	m_sink->Write(m_output, p_frames);
+	return mixed;
+}
+
+HRESULT MxSoundMixer::CreateSoundBuffer(LPCDSBUFFERDESC p_desc, LPDIRECTSOUNDBUFFER* p_buffer)
+{
+	*p_buffer = NULL;
+
+	if (p_desc->dwFlags & DSBCAPS_PRIMARYBUFFER) {
+		return DSERR_INVALIDCALL;
+	}
+
+	MxSoundVoice* voice = new MxSoundVoice(this);
+
+	if (voice == NULL) {
+		return DSERR_OUTOFMEMORY;
+	}
+
+	HRESULT result = voice->Create(p_desc);
+
+	if (result != DS_OK) {
+		voice->m_mixer = NULL;
+		voice->Release();
+		return result;
+	}
+
+	AddVoice(voice);
+	*p_buffer = voice;
+	return DS_OK;
+}
+
+void MxSoundMixer::AddVoice(MxSoundVoice* p_voice)
+{
+	AUTOLOCK(m_lock);
+
+	if (m_numVoices == m_maxVoices) {
+		MxU32 maxVoices = m_maxVoices ? m_maxVoices * 2 : 32;
+		MxSoundVoice** voices = new MxSoundVoice*[maxVoices];
+
+		if (m_numVoices) {
+			memcpy(voices, m_voices, m_numVoices * sizeof(*voices));
+		}
+
+		delete[] m_voices;
+		m_voices = voices;
+		m_maxVoices = maxVoices;
+	}
+
+	m_voices[m_numVoices++] = p_voice;
+}
+
+void MxSoundMixer::RemoveVoice(MxSoundVoice* p_voice)
+{
+	AUTOLOCK(m_lock);
+
+	for (MxU32 i = 0; i < m_numVoices; i++) {
+		if (m_voices[i] == p_voice) {
+			m_voices[i] = m_voices[--m_numVoices];
+			break;
+		}
+	}
+}
+
+// Called with m_lock held
+void MxSoundMixer::MixVoice(MxSoundVoice* p_voice, MxS32* p_dest, MxU32 p_frames)
+{
+	const MxS16* src = p_voice->m_samples;
+	MxU32 numFrames = p_voice->m_numFrames;
+	MxU32 channels = p_voice->m_format.nChannels;
+	MxU32 step = p_voice->m_step;
+	MxU32 frame = p_voice->m_frame;
+	MxU32 fraction = p_voice->m_fraction;
+
+	while (p_frames != 0) {
+		if (frame >= numFrames) {
+			if (!p_voice->m_looping) {
+				p_voice->m_playing = FALSE;
+				frame = fraction = 0;
+				break;
+			}
+
+			frame %= numFrames;
+		}
+
+		MxU32 count;
+
+		if (frame + 1 < numFrames) {
+			// Number of output frames before the position reaches the last source frame,
+			// so the kernels can read one frame ahead without checking for the end
+			double span = ((double) (numFrames - 1 - frame) * 65536.0 - fraction + step - 1) / step;
+			count = span < p_frames ? (MxU32) span : p_frames;
+
+			if (count == 0) {
+				count = 1;
+			}
+
+			if (channels == 1) {
+				MixMono(p_dest, src, count, frame, fraction, step, p_voice->m_gainLeft, p_voice->m_gainRight);
+			}
+			else {
+				MixStereo(p_dest, src, count, frame, fraction, step, p_voice->m_gainLeft, p_voice->m_gainRight);
+			}
+		}
+		else {
+			// On the last frame, interpolate towards the start if looping, otherwise hold the sample
+			const MxS16* a = src + frame * channels;
+			const MxS16* b = p_voice->m_looping ? src : a;
+			MxS32 f = fraction >> 1;
+
+			count = 1;
+
+			if (channels == 1) {
+				MxS32 sample = LERP_SAMPLE(a[0], b[0], f);
+				p_dest[0] += (sample * p_voice->m_gainLeft) >> 14;
+				p_dest[1] += (sample * p_voice->m_gainRight) >> 14;
+			}
+			else {
+				p_dest[0] += (LERP_SAMPLE(a[0], b[0], f) * p_voice->m_gainLeft) >> 14;
+				p_dest[1] += (LERP_SAMPLE(a[1], b[1], f) * p_voice->m_gainRight) >> 14;
+			}
+
+			fraction += step;
+			frame += fraction >> 16;
+			fraction &= 0xffff;
+		}
+
+		p_dest += count * 2;
+		p_frames -= count;
+	}
+
+	p_voice->m_frame = frame;
+	p_voice->m_fraction = fraction;
+}
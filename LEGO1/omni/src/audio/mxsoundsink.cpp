@@ -0,0 +1,258 @@
+#include "mxsoundsink.h"
+
+#include "mxtimer.h"
+
+#include <windows.h>
+
+MxDirectSoundSink::MxDirectSoundSink(LPDIRECTSOUND p_directSound)
+{
+	m_directSound = p_directSound;
+	m_primary = NULL;
+	m_dsBuffer = NULL;
+	m_bufferFrames = 0;
+	m_latencyFrames = 0;
+	m_writeFrame = 0;
+}
+
+MxDirectSoundSink::~MxDirectSoundSink()
+{
+	Close();
+}
+
+MxResult MxDirectSoundSink::Open(MxU32 p_frequency)
+{
+	WAVEFORMATEX format;
+	format.wFormatTag = WAVE_FORMAT_PCM;
+	format.nChannels = 2;
+	format.nSamplesPerSec = p_frequency;
+	format.wBitsPerSample = 16;
+	format.nBlockAlign = 4;
+	format.nAvgBytesPerSec = format.nBlockAlign * p_frequency;
+	format.cbSize = 0;
+
+	DSBUFFERDESC desc;
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+	desc.dwFlags = DSBCAPS_PRIMARYBUFFER;
+
+	// The primary format is only a hint to the driver, a failure here just means it resamples
+	if (m_directSound->CreateSoundBuffer(&desc, &m_primary, NULL) == DS_OK) {
+		m_primary->SetFormat(&format);
+	}
+
+	m_bufferFrames = p_frequency / 4;
+	m_latencyFrames = p_frequency * e_latencyMS / 1000;
+
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+	desc.dwFlags = DSBCAPS_GETCURRENTPOSITION2;
+	desc.dwBufferBytes = m_bufferFrames * format.nBlockAlign;
+	desc.lpwfxFormat = &format;
+
+	if (m_directSound->CreateSoundBuffer(&desc, &m_dsBuffer, NULL) != DS_OK) {
+		Close();
+		return FAILURE;
+	}
+
+	LPVOID pvAudioPtr1;
+	LPVOID pvAudioPtr2;
+	DWORD dwAudioBytes1;
+	DWORD dwAudioBytes2;
+
+	if (m_dsBuffer->Lock(0, desc.dwBufferBytes, &pvAudioPtr1, &dwAudioBytes1, &pvAudioPtr2, &dwAudioBytes2, 0) ==
+		DS_OK) {
+		memset(pvAudioPtr1, 0, dwAudioBytes1);
+		m_dsBuffer->Unlock(pvAudioPtr1, dwAudioBytes1, pvAudioPtr2, 0);
+	}
+
+	m_writeFrame = 0;
+
+	if (m_dsBuffer->Play(0, 0, DSBPLAY_LOOPING) != DS_OK) {
+		Close();
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+void MxDirectSoundSink::Close()
+{
+	if (m_dsBuffer) {
+		m_dsBuffer->Stop();
+		m_dsBuffer->Release();
+		m_dsBuffer = NULL;
+	}
+
+	if (m_primary) {
+		m_primary->Release();
+		m_primary = NULL;
+	}
+}
+
+MxU32 MxDirectSoundSink::GetFreeFrames()
+{
+	DWORD dwStatus;
+	DWORD dwPlayCursor, dwWriteCursor;
+
+	if (m_dsBuffer == NULL) {
+		return 0;
+	}
+
+	m_dsBuffer->GetStatus(&dwStatus);
+
+	if (dwStatus & DSBSTATUS_BUFFERLOST) {
+		if (m_dsBuffer->Restore() != DS_OK) {
+			return 0;
+		}
+
+		m_dsBuffer->Play(0, 0, DSBPLAY_LOOPING);
+	}
+
+	if (m_dsBuffer->GetCurrentPosition(&dwPlayCursor, &dwWriteCursor) != DS_OK) {
+		return 0;
+	}
+
+	MxU32 playFrame = dwPlayCursor / 4;
+	MxU32 queued = (m_writeFrame + m_bufferFrames - playFrame) % m_bufferFrames;
+
+	// We never queue more than the latency, so anything larger means the play
+	// cursor has overtaken us. Restart right behind the write cursor.
+	if (queued > m_latencyFrames) {
+		m_writeFrame = dwWriteCursor / 4;
+		queued = (m_writeFrame + m_bufferFrames - playFrame) % m_bufferFrames;
+	}
+
+	return queued < m_latencyFrames ? m_latencyFrames - queued : 0;
+}
+
+MxResult MxDirectSoundSink::Write(const MxS16* p_frames, MxU32 p_count)
+{
+	LPVOID pvAudioPtr1;
+	LPVOID pvAudioPtr2;
+	DWORD dwAudioBytes1;
+	DWORD dwAudioBytes2;
+
+	if (m_dsBuffer == NULL) {
+		return FAILURE;
+	}
+
+	DWORD dwOffset = m_writeFrame * 4;
+	if (m_dsBuffer->Lock(dwOffset, p_count * 4, &pvAudioPtr1, &dwAudioBytes1, &pvAudioPtr2, &dwAudioBytes2, 0) != DS_OK) {
+		return FAILURE;
+	}
+
+	memcpy(pvAudioPtr1, p_frames, dwAudioBytes1);
+
+	if (pvAudioPtr2 != NULL) {
+		memcpy(pvAudioPtr2, (const MxU8*) p_frames + dwAudioBytes1, dwAudioBytes2);
+	}
+
+	m_dsBuffer->Unlock(pvAudioPtr1, dwAudioBytes1, pvAudioPtr2, dwAudioBytes2);
+	m_writeFrame = (m_writeFrame + p_count) % m_bufferFrames;
+	return SUCCESS;
+}
+
+MxNullSoundSink::MxNullSoundSink()
+{
+	m_frequency = 0;
+	m_startTime = 0;
+	m_framesWritten = 0;
+}
+
+MxResult MxNullSoundSink::Open(MxU32 p_frequency)
+{
+	m_frequency = p_frequency;
+	m_startTime = MxTimer::GetClock();
+	m_framesWritten = 0;
+	return SUCCESS;
+}
+
+void MxNullSoundSink::Close()
+{
+}
+
+MxU32 MxNullSoundSink::GetFreeFrames()
+{
+	MxU32 due = (MxU32) ((double) (MxTimer::GetClock() - m_startTime) * m_frequency / 1000.0);
+
+	if (due <= m_framesWritten) {
+		return 0;
+	}
+
+	// Don't hand out more than a quarter of a second at once after a stall
+	MxU32 free = due - m_framesWritten;
+	return free < m_frequency / 4 ? free : m_frequency / 4;
+}
+
+MxResult MxNullSoundSink::Write(const MxS16* p_frames, MxU32 p_count)
+{
+	m_framesWritten += p_count;
+	return SUCCESS;
+}
+
+MxWaveFileSoundSink::MxWaveFileSoundSink(const char* p_filename)
+{
+	m_filename = p_filename;
+	m_file = NULL;
+}
+
+MxWaveFileSoundSink::~MxWaveFileSoundSink()
+{
+	Close();
+}
+
+MxResult MxWaveFileSoundSink::Open(MxU32 p_frequency)
+{
+	if (m_filename == NULL || (m_file = fopen(m_filename, "wb")) == NULL) {
+		return FAILURE;
+	}
+
+	MxNullSoundSink::Open(p_frequency);
+
+	// Sizes are patched in Close, once they are known
+	WriteHeader(0);
+	return SUCCESS;
+}
+
+void MxWaveFileSoundSink::Close()
+{
+	if (m_file) {
+		fseek(m_file, 0, SEEK_SET);
+		WriteHeader(m_framesWritten * 4);
+		fclose(m_file);
+		m_file = NULL;
+	}
+}
+
+MxResult MxWaveFileSoundSink::Write(const MxS16* p_frames, MxU32 p_count)
+{
+	if (m_file == NULL || fwrite(p_frames, 4, p_count, m_file) != p_count) {
+		return FAILURE;
+	}
+
+	return MxNullSoundSink::Write(p_frames, p_count);
+}
+
+void MxWaveFileSoundSink::WriteHeader(MxU32 p_dataSize)
+{
+	MxU32 riffSize = p_dataSize + 36;
+	MxU32 fmtSize = 16;
+	MxU32 byteRate = m_frequency * 4;
+	MxU16 formatTag = WAVE_FORMAT_PCM;
+	MxU16 channels = 2;
+	MxU16 blockAlign = 4;
+	MxU16 bitsPerSample = 16;
+
+	fwrite("RIFF", 4, 1, m_file);
+	fwrite(&riffSize, 4, 1, m_file);
+	fwrite("WAVEfmt ", 8, 1, m_file);
+	fwrite(&fmtSize, 4, 1, m_file);
+	fwrite(&formatTag, 2, 1, m_file);
+	fwrite(&channels, 2, 1, m_file);
+	fwrite(&m_frequency, 4, 1, m_file);
+	fwrite(&byteRate, 4, 1, m_file);
+	fwrite(&blockAlign, 2, 1, m_file);
+	fwrite(&bitsPerSample, 2, 1, m_file);
+	fwrite("data", 4, 1, m_file);
+	fwrite(&p_dataSize, 4, 1, m_file);
+}
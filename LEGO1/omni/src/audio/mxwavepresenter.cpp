@@ -175,7 +175,7 @@ void MxWavePresenter::StartingTickle()
 
 		desc.lpwfxFormat = &waveFormatEx;
 
-		if (MSoundManager()->GetDirectSound()->CreateSoundBuffer(&desc, &m_dsBuffer, NULL) != DS_OK) {
+		if (MSoundManager()->CreateSoundBuffer(&desc, &m_dsBuffer) != DS_OK) {
 			EndAction();
 		}
 		else {
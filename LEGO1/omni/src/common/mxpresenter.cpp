@@ -29,6 +29,8 @@
 
 DECOMP_SIZE_ASSERT(MxPresenter, 0x40);
 
+MxBool MxPresenter::g_displayZChanged = FALSE;
+
 // FUNCTION: LEGO1 0x100b4d50
 void MxPresenter::Init()
 {
@@ -48,7 +50,7 @@ MxResult MxPresenter::StartAction(MxStreamController*, MxDSAction* p_action)
 
 	m_action = p_action;
 	m_location = MxPoint32(m_action->GetLocation()[0], m_action->GetLocation()[1]);
-	m_displayZ = m_action->GetLocation()[2];
+	SetDisplayZ(m_action->GetLocation()[2]);
 
 	ProgressTickleState(e_ready);
 
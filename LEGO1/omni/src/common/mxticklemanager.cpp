@@ -9,8 +9,8 @@
 
 #define TICKLE_MANAGER_FLAG_DESTROY 0x01
 
-DECOMP_SIZE_ASSERT(MxTickleClient, 0x10);
-DECOMP_SIZE_ASSERT(MxTickleManager, 0x14);
+DECOMP_SIZE_ASSERT(MxTickleClient, 0x30);
+DECOMP_SIZE_ASSERT(MxTickleManager, 0x58);
 
 // FUNCTION: LEGO1 0x100bdd10
 MxTickleClient::MxTickleClient(MxCore* p_client, MxTime p_interval)
@@ -19,16 +19,21 @@ MxTickleClient::MxTickleClient(MxCore* p_client, MxTime p_interval)
 	m_client = p_client;
 	m_interval = p_interval;
 	m_lastUpdateTime = -m_interval;
+	m_sequence = 0;
+	m_heapIndex = -1;
+	ResetTickleCost();
 }
 
 // FUNCTION: LEGO1 0x100bdd30
 MxTickleManager::~MxTickleManager()
 {
-	while (m_clients.size() != 0) {
-		MxTickleClient* client = m_clients.front();
-		m_clients.pop_front();
-		delete client;
+	for (MxU32 i = 0; i < m_heap.size(); i++) {
+		delete m_heap[i];
 	}
+
+	m_heap.clear();
+	m_clients.clear();
+	PurgeDestroyed();
 }
 
 // FUNCTION: LEGO1 0x100bdde0
@@ -36,29 +41,71 @@ MxTickleManager::~MxTickleManager()
 MxResult MxTickleManager::Tickle()
 {
 	MxTime time = Timer()->GetTime();
-	MxTickleClientPtrList::iterator it;
+	MxU32 first = m_due.size();
+	MxU32 i;
+
+	// Clients unregistered since the last pass can only be freed when no outer pass is still walking m_due
+	if (m_depth++ == 0) {
+		PurgeDestroyed();
+	}
+
+	if (time < m_lastTime) {
+		RebuildSchedule(time);
+	}
+
+	m_lastTime = time;
+
+	while (m_heap.size() != 0 && m_heap[0]->GetDueTime() <= time) {
+		MxTickleClient* client = m_heap[0];
+		Unschedule(client);
+		m_due.push_back(client);
+	}
 
-	for (it = m_clients.begin(); !(it == m_clients.end());) {
-		MxTickleClient* client = *it;
+	// Tickle due clients in registration order. Usually only a handful are due, so insertion sort is fine.
+	for (i = first + 1; i < m_due.size(); i++) {
+		MxTickleClient* client = m_due[i];
+		MxU32 j = i;
+
+		while (j > first && m_due[j - 1]->m_sequence > client->m_sequence) {
+			m_due[j] = m_due[j - 1];
+			j--;
+		}
+
+		m_due[j] = client;
+	}
+
+	// A nested pass may append to m_due, so index it afresh every iteration
+	for (i = first; i < m_due.size(); i++) {
+		MxTickleClient* client = m_due[i];
+
+		if (client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY) {
+			continue;
+		}
 
-		if ((MxBool) client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY) {
-			m_clients.erase(it++);
-			delete client;
+		if (m_profiling) {
+			MxDouble start = MxTimer::GetProfileTime();
+			client->GetClient()->Tickle();
+			client->AddTickleCost(MxTimer::GetProfileTime() - start);
 		}
 		else {
-			it++;
+			client->GetClient()->Tickle();
+		}
+
+		client->SetLastUpdateTime(time);
 
-			if (client->GetLastUpdateTime() > time) {
-				client->SetLastUpdateTime(-client->GetTickleInterval());
-			}
+		if (!(client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY)) {
+			Schedule(client);
+		}
 
-			if ((client->GetTickleInterval() + client->GetLastUpdateTime()) < time) {
-				client->GetClient()->Tickle();
-				client->SetLastUpdateTime(time);
-			}
+		// Everything due was popped above, so a due client in the heap was registered or had its interval
+		// shortened by the Tickle just made. The list walk reached such a client later in the same pass.
+		if (m_heap.size() != 0 && m_heap[0]->GetDueTime() <= time) {
+			CollectLateDue(time, i + 1, client->m_sequence);
 		}
 	}
 
+	m_due.erase(m_due.begin() + first, m_due.end());
+	m_depth--;
 	return SUCCESS;
 }
 
@@ -66,11 +113,12 @@ MxResult MxTickleManager::Tickle()
 // FUNCTION: BETA10 0x1013ec5f
 void MxTickleManager::RegisterClient(MxCore* p_client, MxTime p_interval)
 {
-	MxTime interval = GetClientTickleInterval(p_client);
-	if (interval == TICKLE_MANAGER_NOT_FOUND) {
+	if (FindClient(p_client) == NULL) {
 		MxTickleClient* client = new MxTickleClient(p_client, p_interval);
 		if (client != NULL) {
-			m_clients.push_back(client);
+			client->m_sequence = m_sequence++;
+			m_clients[p_client] = client;
+			Schedule(client);
 		}
 	}
 }
@@ -79,15 +127,18 @@ void MxTickleManager::RegisterClient(MxCore* p_client, MxTime p_interval)
 // FUNCTION: BETA10 0x1013edd0
 void MxTickleManager::UnregisterClient(MxCore* p_client)
 {
-	MxTickleClientPtrList::iterator it = m_clients.begin();
-	while (it != m_clients.end()) {
-		MxTickleClient* client = *it;
-		if (client->GetClient() == p_client) {
-			client->SetFlags(client->GetFlags() | TICKLE_MANAGER_FLAG_DESTROY);
-			return;
+	MxTickleClientMap::iterator it = m_clients.find(p_client);
+
+	if (it != m_clients.end()) {
+		MxTickleClient* client = (*it).second;
+		client->SetFlags(client->GetFlags() | TICKLE_MANAGER_FLAG_DESTROY);
+		m_clients.erase(it);
+
+		if (client->m_heapIndex >= 0) {
+			Unschedule(client);
 		}
 
-		it++;
+		m_destroyed.push_back(client);
 	}
 }
 
@@ -95,11 +146,14 @@ void MxTickleManager::UnregisterClient(MxCore* p_client)
 // FUNCTION: BETA10 0x1013ee6d
 void MxTickleManager::SetClientTickleInterval(MxCore* p_client, MxTime p_interval)
 {
-	for (MxTickleClientPtrList::iterator it = m_clients.begin(); it != m_clients.end(); it++) {
-		MxTickleClient* client = *it;
-		if ((client->GetClient() == p_client) && ((client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY) == 0)) {
-			client->SetTickleInterval(p_interval);
-			return;
+	MxTickleClient* client = FindClient(p_client);
+
+	if (client != NULL) {
+		client->SetTickleInterval(p_interval);
+
+		// Clients being tickled right now are rescheduled with the new interval once they are done
+		if (client->m_heapIndex >= 0) {
+			Reschedule(client);
 		}
 	}
 }
@@ -108,15 +162,210 @@ void MxTickleManager::SetClientTickleInterval(MxCore* p_client, MxTime p_interva
 // FUNCTION: BETA10 0x1013ef2d
 MxTime MxTickleManager::GetClientTickleInterval(MxCore* p_client)
 {
-	MxTickleClientPtrList::iterator it = m_clients.begin();
-	while (it != m_clients.end()) {
-		MxTickleClient* client = *it;
-		if ((client->GetClient() == p_client) && ((client->GetFlags() & TICKLE_MANAGER_FLAG_DESTROY) == 0)) {
-			return client->GetTickleInterval();
-		}
+	MxTickleClient* client = FindClient(p_client);
 
-		it++;
+	if (client != NULL) {
+		return client->GetTickleInterval();
 	}
 
 	return TICKLE_MANAGER_NOT_FOUND;
 }
+
+MxResult MxTickleManager::GetClientTickleCost(MxCore* p_client, MxU32& p_count, MxDouble& p_total, MxDouble& p_peak)
+{
+	MxTickleClient* client = FindClient(p_client);
+
+	if (client == NULL) {
+		return FAILURE;
+	}
+
+	p_count = client->GetTickleCount();
+	p_total = client->GetTickleCost();
+	p_peak = client->GetPeakTickleCost();
+	return SUCCESS;
+}
+
+MxCore* MxTickleManager::GetCostliestClient()
+{
+	MxTickleClient* costliest = NULL;
+
+	for (MxTickleClientMap::iterator it = m_clients.begin(); it != m_clients.end(); it++) {
+		MxTickleClient* client = (*it).second;
+
+		if (client->GetTickleCount() != 0 &&
+			(costliest == NULL || client->GetTickleCost() > costliest->GetTickleCost())) {
+			costliest = client;
+		}
+	}
+
+	return costliest != NULL ? costliest->GetClient() : NULL;
+}
+
+void MxTickleManager::ResetTickleCosts()
+{
+	for (MxTickleClientMap::iterator it = m_clients.begin(); it != m_clients.end(); it++) {
+		(*it).second->ResetTickleCost();
+	}
+}
+
+MxTickleClient* MxTickleManager::FindClient(MxCore* p_client)
+{
+	MxTickleClientMap::iterator it = m_clients.find(p_client);
+	return it != m_clients.end() ? (*it).second : NULL;
+}
+
+void MxTickleManager::Schedule(MxTickleClient* p_client)
+{
+	assert(p_client->m_heapIndex < 0);
+
+	m_heap.push_back(p_client);
+	p_client->m_heapIndex = m_heap.size() - 1;
+	SiftUp(p_client->m_heapIndex);
+}
+
+void MxTickleManager::Unschedule(MxTickleClient* p_client)
+{
+	MxS32 index = p_client->m_heapIndex;
+	MxTickleClient* last = m_heap.back();
+
+	assert(index >= 0 && m_heap[index] == p_client);
+
+	m_heap.pop_back();
+	p_client->m_heapIndex = -1;
+
+	if (last != p_client) {
+		Place(last, index);
+		SiftUp(index);
+		SiftDown(last->m_heapIndex);
+	}
+}
+
+void MxTickleManager::Reschedule(MxTickleClient* p_client)
+{
+	SiftUp(p_client->m_heapIndex);
+	SiftDown(p_client->m_heapIndex);
+}
+
+// Moves the clients in the heap that are due at p_time and come after p_sequence in registration order into the
+// sorted remainder of m_due starting at p_begin. Due clients before p_sequence had their turn in this pass already
+// and stay scheduled for the next one.
+void MxTickleManager::CollectLateDue(MxTime p_time, MxU32 p_begin, MxU32 p_sequence)
+{
+	MxTickleClientPtrVector passed;
+	MxU32 i;
+
+	while (m_heap.size() != 0 && m_heap[0]->GetDueTime() <= p_time) {
+		MxTickleClient* client = m_heap[0];
+		Unschedule(client);
+
+		if (client->m_sequence < p_sequence) {
+			passed.push_back(client);
+			continue;
+		}
+
+		MxU32 j = m_due.size();
+		m_due.push_back(client);
+
+		while (j > p_begin && m_due[j - 1]->m_sequence > client->m_sequence) {
+			m_due[j] = m_due[j - 1];
+			j--;
+		}
+
+		m_due[j] = client;
+	}
+
+	for (i = 0; i < passed.size(); i++) {
+		Schedule(passed[i]);
+	}
+}
+
+// Applies the original per-client rule for a timer that went backwards (clients whose
+// last update lies in the future become due immediately) and rebuilds the heap.
+void MxTickleManager::RebuildSchedule(MxTime p_time)
+{
+	MxS32 i;
+
+	for (i = 0; i < (MxS32) m_heap.size(); i++) {
+		MxTickleClient* client = m_heap[i];
+
+		if (client->GetLastUpdateTime() > p_time) {
+			client->SetLastUpdateTime(-client->GetTickleInterval());
+		}
+	}
+
+	for (i = (MxS32) m_heap.size() / 2 - 1; i >= 0; i--) {
+		SiftDown(i);
+	}
+}
+
+void MxTickleManager::SiftUp(MxS32 p_index)
+{
+	MxTickleClient* client = m_heap[p_index];
+
+	while (p_index > 0) {
+		MxS32 parent = (p_index - 1) / 2;
+
+		if (!Before(client, m_heap[parent])) {
+			break;
+		}
+
+		Place(m_heap[parent], p_index);
+		p_index = parent;
+	}
+
+	Place(client, p_index);
+}
+
+void MxTickleManager::SiftDown(MxS32 p_index)
+{
+	MxS32 size = m_heap.size();
+	MxTickleClient* client = m_heap[p_index];
+
+	while (TRUE) {
+		MxS32 child = p_index * 2 + 1;
+
+		if (child >= size) {
+			break;
+		}
+
+		if (child + 1 < size && Before(m_heap[child + 1], m_heap[child])) {
+			child++;
+		}
+
+		if (!Before(m_heap[child], client)) {
+			break;
+		}
+
+		Place(m_heap[child], p_index);
+		p_index = child;
+	}
+
+	Place(client, p_index);
+}
+
+void MxTickleManager::Place(MxTickleClient* p_client, MxS32 p_index)
+{
+	m_heap[p_index] = p_client;
+	p_client->m_heapIndex = p_index;
+}
+
+void MxTickleManager::PurgeDestroyed()
+{
+	for (MxU32 i = 0; i < m_destroyed.size(); i++) {
+		delete m_destroyed[i];
+	}
+
+	m_destroyed.clear();
+}
+
+MxBool MxTickleManager::Before(MxTickleClient* p_a, MxTickleClient* p_b)
+{
+	MxTime dueA = p_a->GetDueTime();
+	MxTime dueB = p_b->GetDueTime();
+
+	if (dueA != dueB) {
+		return dueA < dueB;
+	}
+
+	return p_a->m_sequence < p_b->m_sequence;
+}
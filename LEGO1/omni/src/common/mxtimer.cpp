@@ -9,12 +9,16 @@ MxLong MxTimer::g_lastTimeCalculated = 0;
 // GLOBAL: LEGO1 0x10101418
 MxLong MxTimer::g_lastTimeTimerStarted = 0;
 
+MxLong MxTimer::g_fixedStep = 0;
+MxLong MxTimer::g_fixedTime = 0;
+MxDouble MxTimer::g_ticksPerMS = -1.0;
+
 // FUNCTION: LEGO1 0x100ae060
 // FUNCTION: BETA10 0x1012bea0
 MxTimer::MxTimer()
 {
 	m_isRunning = FALSE;
-	m_startTime = timeGetTime();
+	m_startTime = GetClock();
 	InitLastTimeCalculated();
 }
 
@@ -22,7 +26,7 @@ MxTimer::MxTimer()
 // FUNCTION: BETA10 0x1012bf23
 MxLong MxTimer::GetRealTime()
 {
-	MxTimer::g_lastTimeCalculated = timeGetTime();
+	MxTimer::g_lastTimeCalculated = GetClock();
 	return MxTimer::g_lastTimeCalculated - m_startTime;
 }
 
@@ -42,3 +46,34 @@ void MxTimer::Stop()
 	// this feels very stupid but it's what the assembly does
 	m_startTime = m_startTime + startTime - 5;
 }
+
+void MxTimer::SetFixedStep(MxLong p_step)
+{
+	g_fixedStep = p_step;
+	g_fixedTime = 0;
+}
+
+void MxTimer::Step()
+{
+	g_fixedTime += g_fixedStep;
+}
+
+MxLong MxTimer::GetClock()
+{
+	return g_fixedStep != 0 ? g_fixedTime : (MxLong) timeGetTime();
+}
+
+MxDouble MxTimer::GetProfileTime()
+{
+	LARGE_INTEGER value;
+
+	if (g_ticksPerMS < 0.0) {
+		g_ticksPerMS = QueryPerformanceFrequency(&value) ? (MxDouble) value.QuadPart / 1000.0 : 0.0;
+	}
+
+	if (g_ticksPerMS == 0.0 || !QueryPerformanceCounter(&value)) {
+		return 0.0;
+	}
+
+	return (MxDouble) value.QuadPart / g_ticksPerMS;
+}
@@ -0,0 +1,102 @@
+#include "mxtypeid.h"
+
+#include "mxautolock.h"
+#include "mxcore.h"
+#include "mxcriticalsection.h"
+
+#include <stddef.h>
+
+// Answers are cached for this many ids; any further ids fall back to IsA
+#define MXTYPEID_MAX_IDS 64
+
+// Number of classes that can be cached, must be a power of two
+#define MXTYPEID_NUM_RECORDS 512
+
+// Cached IsA answers for one class, identified by its ClassName() pointer.
+// Records are only ever added, and the class name is stored last, so readers
+// never need the lock: a record that is not (yet) visible is simply a miss.
+struct MxTypeRecord {
+	const char* volatile m_className;
+	volatile MxU32 m_known[MXTYPEID_MAX_IDS / 32];
+	volatile MxU32 m_result[MXTYPEID_MAX_IDS / 32];
+};
+
+MxU32 MxTypeId::g_numTypeIds = 0;
+
+static MxTypeRecord g_typeRecords[MXTYPEID_NUM_RECORDS];
+static MxCriticalSection g_typeRecordLock;
+
+DEFINE_MX_TYPEID(MxCompositePresenter);
+DEFINE_MX_TYPEID(MxDSMediaAction);
+DEFINE_MX_TYPEID(MxDSMultiAction);
+DEFINE_MX_TYPEID(MxDSSerialAction);
+DEFINE_MX_TYPEID(MxEntity);
+DEFINE_MX_TYPEID(MxPresenter);
+DEFINE_MX_TYPEID(MxWavePresenter);
+
+MxTypeId::MxTypeId(const char* p_name)
+{
+	m_name = p_name;
+	m_index = g_numTypeIds++;
+}
+
+static MxU32 FirstRecord(const char* p_className)
+{
+	return ((size_t) p_className >> 2) & (MXTYPEID_NUM_RECORDS - 1);
+}
+
+MxBool MxTypeId::Check(const MxCore* p_object, const MxTypeId& p_type)
+{
+	if (p_type.m_index >= MXTYPEID_MAX_IDS) {
+		return p_object->IsA(p_type.m_name);
+	}
+
+	const char* className = p_object->ClassName();
+	MxU32 word = p_type.m_index >> 5;
+	MxU32 bit = 1 << (p_type.m_index & 31);
+	MxU32 slot = FirstRecord(className);
+	MxU32 i;
+
+	for (i = 0; i < MXTYPEID_NUM_RECORDS; i++) {
+		MxTypeRecord& record = g_typeRecords[slot];
+
+		if (record.m_className == className) {
+			if (record.m_known[word] & bit) {
+				return (record.m_result[word] & bit) != 0;
+			}
+
+			break;
+		}
+
+		if (record.m_className == NULL) {
+			break;
+		}
+
+		slot = (slot + 1) & (MXTYPEID_NUM_RECORDS - 1);
+	}
+
+	MxBool result = p_object->IsA(p_type.m_name);
+
+	AUTOLOCK(g_typeRecordLock);
+
+	// Probe again under the lock, another thread may have added the class meanwhile
+	slot = FirstRecord(className);
+
+	for (i = 0; i < MXTYPEID_NUM_RECORDS; i++) {
+		MxTypeRecord& record = g_typeRecords[slot];
+
+		if (record.m_className == className || record.m_className == NULL) {
+			if (result) {
+				record.m_result[word] |= bit;
+			}
+
+			record.m_known[word] |= bit;
+			record.m_className = className;
+			break;
+		}
+
+		slot = (slot + 1) & (MXTYPEID_NUM_RECORDS - 1);
+	}
+
+	return result;
+}
@@ -122,7 +122,7 @@ MxBool KeyValueStringParse(char* p_output, const char* p_command, const char* p_
 MxBool ContainsPresenter(MxCompositePresenterList& p_presenterList, MxPresenter* p_presenter)
 {
 	for (MxCompositePresenterList::iterator it = p_presenterList.begin(); it != p_presenterList.end(); it++) {
-		if (p_presenter == *it || ((*it)->IsA("MxCompositePresenter") &&
+		if (p_presenter == *it || ((*it)->IsKindOf(MX_TYPEID(MxCompositePresenter)) &&
 								   ContainsPresenter(*((MxCompositePresenter*) *it)->GetList(), p_presenter))) {
 			return TRUE;
 		}
@@ -164,7 +164,7 @@ void FUN_100b7220(MxDSAction* p_action, MxU32 p_newFlags, MxBool p_setFlags)
 
 	p_action->SetFlags(newFlags);
 
-	if (p_action->IsA("MxDSMultiAction")) {
+	if (p_action->IsKindOf(MX_TYPEID(MxDSMultiAction))) {
 		MxDSActionListCursor cursor(((MxDSMultiAction*) p_action)->GetActionList());
 		MxDSAction* action;
 
@@ -1,5 +1,7 @@
 #include "mxvariabletable.h"
 
+#include <ctype.h>
+
 // FUNCTION: LEGO1 0x100b7330
 // FUNCTION: BETA10 0x1012a470
 MxS8 MxVariableTable::Compare(MxVariable* p_var0, MxVariable* p_var1)
@@ -11,30 +13,48 @@ MxS8 MxVariableTable::Compare(MxVariable* p_var0, MxVariable* p_var1)
 // FUNCTION: BETA10 0x1012a4a0
 MxU32 MxVariableTable::Hash(MxVariable* p_var)
 {
-	const char* str = p_var->GetKey()->GetData();
-	MxU32 value = 0;
+	return HashKey(p_var->GetKey()->GetData());
+}
+
+MxU32 MxVariableTable::HashKey(const char* p_key)
+{
+	// FNV-1a. Stored keys are upper case, so fold the query the same way.
+	MxU32 value = 2166136261U;
 
-	for (MxS32 i = 0; str[i]; i++) {
-		value += str[i];
+	for (MxS32 i = 0; p_key[i]; i++) {
+		value ^= (MxU8) toupper((MxU8) p_key[i]);
+		value *= 16777619U;
 	}
 
 	return value;
 }
 
+MxBool MxVariableTable::MatchKey(MxVariable* p_var, const void* p_key)
+{
+	const char* stored = p_var->GetKey()->GetData();
+	const char* key = (const char*) p_key;
+
+	while (*stored && toupper((MxU8) *key) == (MxU8) *stored) {
+		stored++;
+		key++;
+	}
+
+	return *stored == '\0' && *key == '\0';
+}
+
 // FUNCTION: LEGO1 0x100b73a0
 // FUNCTION: BETA10 0x1012a507
 void MxVariableTable::SetVariable(const char* p_key, const char* p_value)
 {
 	MxHashTableCursor<MxVariable*> cursor(this);
-	MxVariable* var = new MxVariable(p_key, p_value);
+	MxVariable* var;
 
-	if (cursor.Find(var)) {
-		delete var;
+	if (cursor.Find(HashKey(p_key), MatchKey, p_key)) {
 		cursor.Current(var);
 		var->SetValue(p_value);
 	}
 	else {
-		MxHashTable<MxVariable*>::Add(var);
+		MxHashTable<MxVariable*>::Add(new MxVariable(p_key, p_value));
 	}
 }
 
@@ -59,12 +79,9 @@ const char* MxVariableTable::GetVariable(const char* p_key)
 	// STRING: LEGO1 0x100f01d4
 	const char* value = "";
 	MxHashTableCursor<MxVariable*> cursor(this);
-	MxVariable* var = new MxVariable(p_key);
-
-	MxBool found = cursor.Find(var);
-	delete var;
+	MxVariable* var;
 
-	if (found) {
+	if (cursor.Find(HashKey(p_key), MatchKey, p_key)) {
 		cursor.Current(var);
 		value = var->GetValue()->GetData();
 	}
@@ -27,6 +27,8 @@ char g_cdPath[1024] = "E:";
 // GLOBAL: LEGO1 0x10101db8
 MxBool g_use3dSound = FALSE;
 
+MxBool g_headless = FALSE;
+
 // GLOBAL: LEGO1 0x101015b0
 MxOmni* MxOmni::g_instance = NULL;
 
@@ -307,7 +309,7 @@ MxBool MxOmni::ActionSourceEquals(MxDSAction* p_action, const char* p_name)
 		return TRUE;
 	}
 
-	if (p_action->IsA("MxDSMultiAction")) {
+	if (p_action->IsKindOf(MX_TYPEID(MxDSMultiAction))) {
 		MxDSActionListCursor cursor(((MxDSMultiAction*) p_action)->GetActionList());
 		MxDSAction* action;
 
@@ -395,6 +397,16 @@ void MxOmni::SetSound3D(MxBool p_use3dSound)
 	g_use3dSound = p_use3dSound;
 }
 
+MxBool MxOmni::IsHeadless()
+{
+	return g_headless;
+}
+
+void MxOmni::SetHeadless(MxBool p_headless)
+{
+	g_headless = p_headless;
+}
+
 // FUNCTION: LEGO1 0x100b09a0
 MxBool MxOmni::DoesEntityExist(MxDSAction& p_dsAction)
 {
@@ -10,7 +10,7 @@
 #include "mxtypes.h"
 
 DECOMP_SIZE_ASSERT(MxNotification, 0x08);
-DECOMP_SIZE_ASSERT(MxNotificationManager, 0x40);
+DECOMP_SIZE_ASSERT(MxNotificationManager, 0x50);
 
 // FUNCTION: LEGO1 0x100ac220
 MxNotification::MxNotification(MxCore* p_target, const MxNotificationParam& p_param)
@@ -19,12 +19,31 @@ MxNotification::MxNotification(MxCore* p_target, const MxNotificationParam& p_pa
 	m_param = p_param.Clone();
 }
 
+MxNotification::MxNotification()
+{
+	m_target = NULL;
+	m_param = NULL;
+}
+
 // FUNCTION: LEGO1 0x100ac240
 MxNotification::~MxNotification()
 {
 	delete m_param;
 }
 
+void MxNotification::Set(MxCore* p_target, const MxNotificationParam& p_param)
+{
+	m_target = p_target;
+	m_param = p_param.Clone();
+}
+
+void MxNotification::Reset()
+{
+	delete m_param;
+	m_target = NULL;
+	m_param = NULL;
+}
+
 // FUNCTION: LEGO1 0x100ac250
 // FUNCTION: BETA10 0x10125805
 MxNotificationManager::MxNotificationManager() : MxCore(), m_lock(), m_listenerIds()
@@ -33,6 +52,9 @@ MxNotificationManager::MxNotificationManager() : MxCore(), m_lock(), m_listenerI
 	m_queue = NULL;
 	m_active = TRUE;
 	m_sendList = NULL;
+	m_pool = NULL;
+	m_freeList = NULL;
+	m_numFree = 0;
 }
 
 // FUNCTION: LEGO1 0x100ac450
@@ -42,6 +64,14 @@ MxNotificationManager::~MxNotificationManager()
 	Tickle();
 	delete m_queue;
 	m_queue = NULL;
+	delete m_sendList;
+	m_sendList = NULL;
+
+	delete[] m_pool;
+	delete[] m_freeList;
+	m_pool = NULL;
+	m_freeList = NULL;
+	m_numFree = 0;
 
 	TickleManager()->UnregisterClient(this);
 }
@@ -51,11 +81,28 @@ MxResult MxNotificationManager::Create(MxU32 p_frequencyMS, MxBool p_createThrea
 {
 	MxResult result = SUCCESS;
 	m_queue = new MxNotificationPtrList();
+	m_sendList = new MxNotificationPtrList();
 
-	if (m_queue == NULL) {
+	if (m_queue == NULL || m_sendList == NULL) {
 		result = FAILURE;
 	}
 	else {
+		// The pool is an optimization only; without it every send goes to the heap
+		m_pool = new MxNotification[e_poolSize];
+		m_freeList = new MxNotification*[e_poolSize];
+
+		if (m_pool != NULL && m_freeList != NULL) {
+			for (m_numFree = 0; m_numFree < e_poolSize; m_numFree++) {
+				m_freeList[m_numFree] = &m_pool[e_poolSize - 1 - m_numFree];
+			}
+		}
+		else {
+			delete[] m_pool;
+			delete[] m_freeList;
+			m_pool = NULL;
+			m_freeList = NULL;
+		}
+
 		TickleManager()->RegisterClient(this, 10);
 	}
 
@@ -72,12 +119,13 @@ MxResult MxNotificationManager::Send(MxCore* p_listener, const MxNotificationPar
 		return FAILURE;
 	}
 
-	MxIdList::iterator it = find(m_listenerIds.begin(), m_listenerIds.end(), p_listener->GetId());
-	if (it == m_listenerIds.end()) {
+	MxU32 id = p_listener->GetId();
+	MxU32 index = FindListener(id);
+	if (index == m_listenerIds.size() || m_listenerIds[index] != id) {
 		return FAILURE;
 	}
 
-	MxNotification* notif = new MxNotification(p_listener, p_param);
+	MxNotification* notif = NewNotification(p_listener, p_param);
 	if (notif != NULL) {
 		m_queue->push_back(notif);
 		return SUCCESS;
@@ -89,30 +137,37 @@ MxResult MxNotificationManager::Send(MxCore* p_listener, const MxNotificationPar
 // FUNCTION: LEGO1 0x100ac800
 MxResult MxNotificationManager::Tickle()
 {
-	m_sendList = new MxNotificationPtrList();
 	if (m_sendList == NULL) {
 		return FAILURE;
 	}
-	else {
+
+	{
+		AUTOLOCK(m_lock);
+
+		// Relink everything queued so far onto the send list. Notifications sent while
+		// dispatching land in m_queue and are delivered on the next tick.
+		m_sendList->splice(m_sendList->end(), *m_queue);
+	}
+
+	while (TRUE) {
+		MxNotification* notif;
+
 		{
 			AUTOLOCK(m_lock);
-			MxNotificationPtrList* temp1 = m_queue;
-			MxNotificationPtrList* temp2 = m_sendList;
-			m_queue = temp2;
-			m_sendList = temp1;
-		}
 
-		while (m_sendList->size() != 0) {
-			MxNotification* notif = m_sendList->front();
+			if (m_sendList->empty()) {
+				break;
+			}
+
+			notif = m_sendList->front();
 			m_sendList->pop_front();
-			notif->GetTarget()->Notify(*notif->GetParam());
-			delete notif;
 		}
 
-		delete m_sendList;
-		m_sendList = NULL;
-		return SUCCESS;
+		notif->GetTarget()->Notify(*notif->GetParam());
+		DeleteNotification(notif);
 	}
+
+	return SUCCESS;
 }
 
 // FUNCTION: LEGO1 0x100ac990
@@ -160,7 +215,7 @@ void MxNotificationManager::FlushPending(MxCore* p_listener)
 		notif = pending.front();
 		pending.pop_front();
 		notif->GetTarget()->Notify(*notif->GetParam());
-		delete notif;
+		DeleteNotification(notif);
 	}
 }
 
@@ -169,12 +224,13 @@ void MxNotificationManager::Register(MxCore* p_listener)
 {
 	AUTOLOCK(m_lock);
 
-	MxIdList::iterator it = find(m_listenerIds.begin(), m_listenerIds.end(), p_listener->GetId());
-	if (it != m_listenerIds.end()) {
+	MxU32 id = p_listener->GetId();
+	MxU32 index = FindListener(id);
+	if (index != m_listenerIds.size() && m_listenerIds[index] == id) {
 		return;
 	}
 
-	m_listenerIds.push_back(p_listener->GetId());
+	m_listenerIds.insert(m_listenerIds.begin() + index, id);
 }
 
 // FUNCTION: LEGO1 0x100acdf0
@@ -183,10 +239,55 @@ void MxNotificationManager::Unregister(MxCore* p_listener)
 {
 	AUTOLOCK(m_lock);
 
-	MxIdList::iterator it = find(m_listenerIds.begin(), m_listenerIds.end(), p_listener->GetId());
+	MxU32 id = p_listener->GetId();
+	MxU32 index = FindListener(id);
 
-	if (it != m_listenerIds.end()) {
-		m_listenerIds.erase(it);
+	if (index != m_listenerIds.size() && m_listenerIds[index] == id) {
+		m_listenerIds.erase(m_listenerIds.begin() + index);
 		FlushPending(p_listener);
 	}
 }
+
+MxU32 MxNotificationManager::FindListener(MxU32 p_id)
+{
+	MxU32 low = 0;
+	MxU32 high = m_listenerIds.size();
+
+	while (low < high) {
+		MxU32 mid = low + (high - low) / 2;
+
+		if (m_listenerIds[mid] < p_id) {
+			low = mid + 1;
+		}
+		else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+MxNotification* MxNotificationManager::NewNotification(MxCore* p_target, const MxNotificationParam& p_param)
+{
+	// Called from Send with m_lock held
+	if (m_numFree != 0) {
+		MxNotification* notif = m_freeList[--m_numFree];
+		notif->Set(p_target, p_param);
+		return notif;
+	}
+
+	return new MxNotification(p_target, p_param);
+}
+
+void MxNotificationManager::DeleteNotification(MxNotification* p_notification)
+{
+	if (m_pool != NULL && p_notification >= m_pool && p_notification < m_pool + e_poolSize) {
+		p_notification->Reset();
+
+		AUTOLOCK(m_lock);
+		m_freeList[m_numFree++] = p_notification;
+	}
+	else {
+		delete p_notification;
+	}
+}
@@ -0,0 +1,273 @@
+#include "mxdiskstreamprefetcher.h"
+
+#include "mxautolock.h"
+#include "mxdsfile.h"
+
+#include <stdio.h>
+
+// Number of blocks kept in flight per disk stream
+MxU32 MxDiskStreamPrefetcher::g_depth = 4;
+
+MxDiskStreamPrefetcher::MxDiskStreamPrefetcher() : MxThread()
+{
+	m_file = NULL;
+	m_slots = NULL;
+	m_numSlots = 0;
+	m_capacity = 0;
+	m_fileSize = 0;
+	m_stamp = 0;
+	m_hits = 0;
+	m_misses = 0;
+	m_active = FALSE;
+}
+
+MxDiskStreamPrefetcher::~MxDiskStreamPrefetcher()
+{
+	Destroy();
+}
+
+MxResult MxDiskStreamPrefetcher::Create(const char* p_filename, MxU32 p_blockSize)
+{
+	MxU32 i;
+
+	if (g_depth == 0 || p_blockSize == 0 || m_slots != NULL) {
+		return FAILURE;
+	}
+
+	// The provider already parsed the header and offset table, this handle only reads blocks
+	m_file = new MxDSFile(p_filename, 1);
+	if (m_file == NULL || m_file->Open(OF_READ) != SUCCESS) {
+		goto fail;
+	}
+
+	m_fileSize = m_file->CalcFileSize();
+	m_capacity = p_blockSize;
+	m_numSlots = g_depth;
+	m_slots = new Slot[m_numSlots];
+
+	if (m_slots == NULL) {
+		goto fail;
+	}
+
+	memset(m_slots, 0, m_numSlots * sizeof(*m_slots));
+
+	for (i = 0; i < m_numSlots; i++) {
+		m_slots[i].m_data = new MxU8[m_capacity];
+
+		if (m_slots[i].m_data == NULL) {
+			goto fail;
+		}
+
+		if ((m_slots[i].m_loaded = CreateEvent(NULL, TRUE, TRUE, NULL)) == NULL) {
+			goto fail;
+		}
+	}
+
+	if (m_work.Init(0, 100) != SUCCESS) {
+		goto fail;
+	}
+
+	m_active = TRUE;
+	if (Start(0x1000, 0) != SUCCESS) {
+		m_active = FALSE;
+		goto fail;
+	}
+
+	return SUCCESS;
+
+fail:
+	Destroy();
+	return FAILURE;
+}
+
+void MxDiskStreamPrefetcher::Destroy()
+{
+	if (m_active) {
+		m_active = FALSE;
+		m_work.Release(1);
+		Terminate();
+	}
+
+	if (m_slots != NULL) {
+		for (MxU32 i = 0; i < m_numSlots; i++) {
+			delete[] m_slots[i].m_data;
+
+			if (m_slots[i].m_loaded != NULL) {
+				CloseHandle(m_slots[i].m_loaded);
+			}
+		}
+
+		delete[] m_slots;
+		m_slots = NULL;
+	}
+
+	m_numSlots = 0;
+
+	delete m_file;
+	m_file = NULL;
+}
+
+MxResult MxDiskStreamPrefetcher::Run()
+{
+	while (m_active) {
+		m_work.Wait(INFINITE);
+
+		while (m_active) {
+			Slot* slot = NULL;
+
+			{
+				AUTOLOCK(m_lock);
+
+				// Service the oldest request first, it is the one the provider needs next
+				for (MxU32 i = 0; i < m_numSlots; i++) {
+					if (m_slots[i].m_state == e_pending && (slot == NULL || m_slots[i].m_stamp < slot->m_stamp)) {
+						slot = &m_slots[i];
+					}
+				}
+
+				if (slot == NULL) {
+					break;
+				}
+
+				slot->m_state = e_loading;
+				ResetEvent(slot->m_loaded);
+			}
+
+			MxResult result = FAILURE;
+			if (m_file->Seek(slot->m_offset, SEEK_SET) == SUCCESS) {
+				result = m_file->Read(slot->m_data, slot->m_size);
+			}
+
+			{
+				AUTOLOCK(m_lock);
+				slot->m_state = result == SUCCESS ? e_ready : e_empty;
+				SetEvent(slot->m_loaded);
+			}
+		}
+	}
+
+	return MxThread::Run();
+}
+
+void MxDiskStreamPrefetcher::Schedule(MxU32 p_offset, MxU32 p_size)
+{
+	if (m_slots == NULL || p_size == 0 || p_size > m_capacity) {
+		return;
+	}
+
+	MxBool queued = FALSE;
+
+	{
+		AUTOLOCK(m_lock);
+
+		for (MxU32 i = 0; i < m_numSlots; i++) {
+			MxU32 offset = p_offset + i * p_size;
+
+			if (offset + p_size > m_fileSize) {
+				break;
+			}
+
+			Slot* slot = FindSlot(offset);
+			if (slot != NULL) {
+				slot->m_stamp = m_stamp++;
+				continue;
+			}
+
+			slot = RecycleSlot();
+			if (slot == NULL) {
+				break;
+			}
+
+			slot->m_offset = offset;
+			slot->m_size = p_size;
+			slot->m_stamp = m_stamp++;
+			slot->m_state = e_pending;
+			queued = TRUE;
+		}
+	}
+
+	if (queued) {
+		m_work.Release(1);
+	}
+}
+
+MxResult MxDiskStreamPrefetcher::Read(MxU32 p_offset, MxU8* p_dest, MxU32 p_size)
+{
+	if (m_slots == NULL) {
+		return FAILURE;
+	}
+
+	while (TRUE) {
+		HANDLE loaded;
+
+		{
+			AUTOLOCK(m_lock);
+
+			Slot* slot = FindSlot(p_offset);
+			if (slot == NULL || slot->m_size != p_size) {
+				m_misses++;
+				return FAILURE;
+			}
+
+			if (slot->m_state == e_ready) {
+				memcpy(p_dest, slot->m_data, p_size);
+				slot->m_state = e_empty;
+				m_hits++;
+				return SUCCESS;
+			}
+
+			if (slot->m_state == e_pending) {
+				// The read has not started yet; doing it synchronously is quicker
+				// than waiting behind whatever the thread is loading right now.
+				slot->m_state = e_empty;
+				m_misses++;
+				return FAILURE;
+			}
+
+			loaded = slot->m_loaded;
+		}
+
+		// The block is being read right now, wait for it rather than reading it twice.
+		// Loading slots are never recycled, so the slot still holds this block afterwards unless the read failed.
+		WaitForSingleObject(loaded, INFINITE);
+	}
+}
+
+void MxDiskStreamPrefetcher::Flush()
+{
+	AUTOLOCK(m_lock);
+
+	for (MxU32 i = 0; i < m_numSlots; i++) {
+		if (m_slots[i].m_state != e_loading) {
+			m_slots[i].m_state = e_empty;
+		}
+	}
+}
+
+MxDiskStreamPrefetcher::Slot* MxDiskStreamPrefetcher::FindSlot(MxU32 p_offset)
+{
+	for (MxU32 i = 0; i < m_numSlots; i++) {
+		if (m_slots[i].m_state != e_empty && m_slots[i].m_offset == p_offset) {
+			return &m_slots[i];
+		}
+	}
+
+	return NULL;
+}
+
+MxDiskStreamPrefetcher::Slot* MxDiskStreamPrefetcher::RecycleSlot()
+{
+	Slot* oldest = NULL;
+
+	for (MxU32 i = 0; i < m_numSlots; i++) {
+		if (m_slots[i].m_state == e_empty) {
+			return &m_slots[i];
+		}
+
+		if (m_slots[i].m_state == e_ready && (oldest == NULL || m_slots[i].m_stamp < oldest->m_stamp)) {
+			oldest = &m_slots[i];
+		}
+	}
+
+	return oldest;
+}
@@ -12,7 +12,7 @@
 #include "mxthread.h"
 
 DECOMP_SIZE_ASSERT(MxDiskStreamProviderThread, 0x1c)
-DECOMP_SIZE_ASSERT(MxDiskStreamProvider, 0x60);
+DECOMP_SIZE_ASSERT(MxDiskStreamProvider, 0x60 + sizeof(MxDiskStreamPrefetcher));
 
 // GLOBAL: LEGO1 0x10102878
 MxU32 g_unk0x10102878 = 0;
@@ -74,6 +74,8 @@ MxDiskStreamProvider::~MxDiskStreamProvider()
 		m_thread.Terminate();
 	}
 
+	m_prefetcher.Destroy();
+
 	if (m_pFile) {
 		delete m_pFile;
 	}
@@ -104,6 +106,9 @@ MxResult MxDiskStreamProvider::SetResourceToGet(MxStreamController* p_resource)
 		m_remainingWork = TRUE;
 		m_busySemaphore.Init(0, 100);
 
+		// Read-ahead is an optimization only; streaming works without it
+		m_prefetcher.Create(m_pFile->GetFileName(), m_pFile->GetBufferSize());
+
 		if (m_thread.StartWithTarget(this) == SUCCESS && p_resource != NULL) {
 			result = SUCCESS;
 		}
@@ -120,6 +125,7 @@ void MxDiskStreamProvider::VTable0x20(MxDSAction* p_action)
 
 	if (p_action->GetObjectId() == -1) {
 		m_unk0x35 = FALSE;
+		m_prefetcher.Flush();
 
 		do {
 			action = NULL;
@@ -204,6 +210,9 @@ MxResult MxDiskStreamProvider::FUN_100d1780(MxDSStreamingAction* p_action)
 		m_list.PushBack(p_action);
 	}
 
+	// The offset of the action's block is already known, start reading it ahead of the worker
+	m_prefetcher.Schedule(p_action->GetBufferOffset(), p_action->GetUnknowna0()->GetWriteOffset());
+
 	m_unk0x35 = TRUE;
 	m_busySemaphore.Release(1);
 	return SUCCESS;
@@ -244,27 +253,20 @@ void MxDiskStreamProvider::PerformWork()
 
 	buffer = ((MxDSStreamingAction*) streamingAction)->GetUnknowna0();
 
-	if (m_pFile->GetPosition() == ((MxDSStreamingAction*) streamingAction)->GetBufferOffset() ||
-		m_pFile->Seek(((MxDSStreamingAction*) streamingAction)->GetBufferOffset(), SEEK_SET) == 0) {
-		buffer->SetUnknown14(m_pFile->GetPosition());
-
-		if (m_pFile->ReadToBuffer(buffer) == SUCCESS) {
-			buffer->SetUnknown1c(m_pFile->GetPosition());
-
-			if (((MxDSStreamingAction*) streamingAction)->GetUnknown9c() > 0) {
-				FUN_100d1b20(((MxDSStreamingAction*) streamingAction));
+	if (ReadBlock(((MxDSStreamingAction*) streamingAction)->GetBufferOffset(), buffer) == SUCCESS) {
+		if (((MxDSStreamingAction*) streamingAction)->GetUnknown9c() > 0) {
+			FUN_100d1b20(((MxDSStreamingAction*) streamingAction));
+		}
+		else {
+			if (m_pLookup == NULL || !((MxDiskStreamController*) m_pLookup)->GetUnk0xc4()) {
+				controller->FUN_100c8670(((MxDSStreamingAction*) streamingAction));
 			}
 			else {
-				if (m_pLookup == NULL || !((MxDiskStreamController*) m_pLookup)->GetUnk0xc4()) {
-					controller->FUN_100c8670(((MxDSStreamingAction*) streamingAction));
-				}
-				else {
-					controller->FUN_100c7f40(((MxDSStreamingAction*) streamingAction));
-				}
+				controller->FUN_100c7f40(((MxDSStreamingAction*) streamingAction));
 			}
-
-			streamingAction = NULL;
 		}
+
+		streamingAction = NULL;
 	}
 
 done:
@@ -275,6 +277,30 @@ void MxDiskStreamProvider::PerformWork()
 	m_thread.Sleep(0);
 }
 
+MxResult MxDiskStreamProvider::ReadBlock(MxU32 p_offset, MxDSBuffer* p_buffer)
+{
+	MxResult result = FAILURE;
+
+	if (m_prefetcher.Read(p_offset, p_buffer->GetBuffer(), p_buffer->GetWriteOffset()) == SUCCESS) {
+		p_buffer->SetUnknown14(p_offset);
+		p_buffer->SetUnknown1c(p_offset + p_buffer->GetWriteOffset());
+		result = SUCCESS;
+	}
+	else if (m_pFile->GetPosition() == p_offset || m_pFile->Seek(p_offset, SEEK_SET) == 0) {
+		p_buffer->SetUnknown14(m_pFile->GetPosition());
+
+		if (m_pFile->ReadToBuffer(p_buffer) == SUCCESS) {
+			p_buffer->SetUnknown1c(m_pFile->GetPosition());
+			result = SUCCESS;
+		}
+	}
+
+	// Streaming actions walk the file one block at a time (see FUN_100d1b20),
+	// so the next reads are almost always the blocks directly after this one.
+	m_prefetcher.Schedule(p_offset + p_buffer->GetWriteOffset(), p_buffer->GetWriteOffset());
+	return result;
+}
+
 // FUNCTION: LEGO1 0x100d1af0
 MxBool MxDiskStreamProvider::FUN_100d1af0(MxDSStreamingAction* p_action)
 {
@@ -10,7 +10,7 @@
 
 DECOMP_SIZE_ASSERT(MxDSSource, 0x14)
 DECOMP_SIZE_ASSERT(MxDSFile::ChunkHeader, 0x0c)
-DECOMP_SIZE_ASSERT(MxDSFile, 0x7c)
+DECOMP_SIZE_ASSERT(MxDSFile, 0x84)
 
 // FUNCTION: LEGO1 0x100cc4b0
 // FUNCTION: BETA10 0x1015db90
@@ -18,6 +18,8 @@ MxDSFile::MxDSFile(const char* p_filename, MxULong p_skipReadingChunks)
 {
 	SetFileName(p_filename);
 	m_skipReadingChunks = p_skipReadingChunks;
+	m_view = NULL;
+	m_viewSize = 0;
 }
 
 // FUNCTION: LEGO1 0x100cc590
@@ -37,6 +39,10 @@ MxResult MxDSFile::Open(MxULong p_uStyle)
 	if (m_skipReadingChunks == 0) {
 		result = ReadChunks();
 	}
+	else {
+		// Only the raw file is wanted, as by the read-ahead handle of a disk stream
+		result = SUCCESS;
+	}
 
 	if (result != SUCCESS) {
 		Close();
@@ -91,6 +97,7 @@ MxResult MxDSFile::ReadChunks()
 // FUNCTION: BETA10 0x1015ded2
 MxLong MxDSFile::Close()
 {
+	MXIOINFO::UnmapView(DetachView());
 	m_io.Close(0);
 	m_position = -1;
 	memset(&m_header, 0, sizeof(m_header));
@@ -107,6 +114,16 @@ MxLong MxDSFile::Close()
 // FUNCTION: BETA10 0x1015df50
 MxResult MxDSFile::Read(unsigned char* p_buf, MxULong p_nbytes)
 {
+	if (m_view != NULL) {
+		if (m_position < 0 || m_position + p_nbytes > m_viewSize) {
+			return FAILURE;
+		}
+
+		memcpy(p_buf, m_view + m_position, p_nbytes);
+		m_position += p_nbytes;
+		return SUCCESS;
+	}
+
 	if (m_io.Read(p_buf, p_nbytes) != p_nbytes) {
 		return FAILURE;
 	}
@@ -119,6 +136,31 @@ MxResult MxDSFile::Read(unsigned char* p_buf, MxULong p_nbytes)
 // FUNCTION: BETA10 0x1015dfee
 MxResult MxDSFile::Seek(MxLong p_lOffset, MxS32 p_iOrigin)
 {
+	if (m_view != NULL) {
+		MxLong position;
+
+		switch (p_iOrigin) {
+		case SEEK_SET:
+			position = p_lOffset;
+			break;
+		case SEEK_CUR:
+			position = m_position + p_lOffset;
+			break;
+		case SEEK_END:
+			position = m_viewSize + p_lOffset;
+			break;
+		default:
+			return FAILURE;
+		}
+
+		if (position < 0 || (MxULong) position > m_viewSize) {
+			return FAILURE;
+		}
+
+		m_position = position;
+		return SUCCESS;
+	}
+
 	m_position = m_io.Seek(p_lOffset, p_iOrigin);
 	if (m_position == -1) {
 		return FAILURE;
@@ -140,3 +182,31 @@ MxULong MxDSFile::GetStreamBuffersNum()
 {
 	return m_header.m_streamBuffersNum;
 }
+
+MxResult MxDSFile::MapView()
+{
+	if (m_view == NULL) {
+		m_view = m_io.MapView(&m_viewSize);
+
+		if (m_view == NULL) {
+			m_viewSize = 0;
+			return FAILURE;
+		}
+	}
+
+	return SUCCESS;
+}
+
+MxU8* MxDSFile::DetachView()
+{
+	MxU8* view = m_view;
+
+	if (view != NULL) {
+		// Resume buffered reads where the mapped reads left off
+		m_io.Seek(m_position, SEEK_SET);
+	}
+
+	m_view = NULL;
+	m_viewSize = 0;
+	return view;
+}
@@ -652,3 +652,46 @@ MxU16 MXIOINFO::CreateChunk(MMCKINFO* p_chunkInfo, MxU16 p_create)
 	p_chunkInfo->dwFlags = MMIO_DIRTY;
 	return result;
 }
+
+// Maps the entire open file into memory as a copy-on-write view.
+// Pages stay backed by the file until they are written to, at which point
+// the system gives the process a private copy. This lets callers that patch
+// data in place (e.g. ReadData compacting split chunks) use the view directly.
+MxU8* MXIOINFO::MapView(MxULong* p_size)
+{
+	if (!RAW_M_FILE || (m_info.dwFlags & (MMIO_WRITE | MMIO_READWRITE))) {
+		return NULL;
+	}
+
+	HANDLE file = (HANDLE) M_FILE;
+	DWORD size = GetFileSize(file, NULL);
+
+	if (size == 0 || size == 0xffffffff) {
+		return NULL;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	if (mapping == NULL) {
+		return NULL;
+	}
+
+	MxU8* view = (MxU8*) MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+
+	// The view holds its own reference to the mapping object
+	CloseHandle(mapping);
+
+	if (view != NULL && p_size != NULL) {
+		*p_size = size;
+	}
+
+	return view;
+}
+
+// Releases a view obtained from MapView. Views are independent of the file
+// handle they were created from, so this may be called after Close.
+void MXIOINFO::UnmapView(MxU8* p_view)
+{
+	if (p_view != NULL) {
+		UnmapViewOfFile(p_view);
+	}
+}
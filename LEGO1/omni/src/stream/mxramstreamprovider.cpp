@@ -7,7 +7,7 @@
 #include "mxstreamcontroller.h"
 
 DECOMP_SIZE_ASSERT(MxStreamProvider, 0x10)
-DECOMP_SIZE_ASSERT(MxRAMStreamProvider, 0x24)
+DECOMP_SIZE_ASSERT(MxRAMStreamProvider, 0x28)
 
 // FUNCTION: LEGO1 0x100d0730
 MxRAMStreamProvider::MxRAMStreamProvider()
@@ -17,6 +17,7 @@ MxRAMStreamProvider::MxRAMStreamProvider()
 	m_pBufferOfFileSize = NULL;
 	m_lengthInDWords = 0;
 	m_bufferForDWords = NULL;
+	m_mapped = FALSE;
 }
 
 // FUNCTION: LEGO1 0x100d0930
@@ -49,7 +50,13 @@ MxRAMStreamProvider::~MxRAMStreamProvider()
 	m_bufferSize = 0;
 	m_fileSize = 0;
 
-	delete[] m_pBufferOfFileSize;
+	if (m_mapped) {
+		MXIOINFO::UnmapView(m_pBufferOfFileSize);
+		m_mapped = FALSE;
+	}
+	else {
+		delete[] m_pBufferOfFileSize;
+	}
 	m_pBufferOfFileSize = NULL;
 
 	m_lengthInDWords = 0;
@@ -81,9 +88,23 @@ MxResult MxRAMStreamProvider::SetResourceToGet(MxStreamController* p_resource)
 		m_fileSize = m_pFile->CalcFileSize();
 		if (m_fileSize != 0) {
 			m_bufferSize = m_pFile->GetBufferSize();
-			m_pBufferOfFileSize = new MxU8[m_fileSize];
-			if (m_pBufferOfFileSize != NULL &&
-				m_pFile->Read((unsigned char*) m_pBufferOfFileSize, m_fileSize) == SUCCESS) {
+
+			// Prefer handing out the file's pages directly. The view is copy-on-write,
+			// so ReadData may still rearrange chunks in place.
+			if (m_pFile->MapView() == SUCCESS && m_pFile->GetViewSize() == m_fileSize) {
+				m_pBufferOfFileSize = m_pFile->DetachView();
+				m_mapped = TRUE;
+			}
+			else {
+				m_pBufferOfFileSize = new MxU8[m_fileSize];
+				if (m_pBufferOfFileSize != NULL &&
+					m_pFile->Read((unsigned char*) m_pBufferOfFileSize, m_fileSize) != SUCCESS) {
+					delete[] m_pBufferOfFileSize;
+					m_pBufferOfFileSize = NULL;
+				}
+			}
+
+			if (m_pBufferOfFileSize != NULL) {
 				m_lengthInDWords = m_pFile->GetLengthInDWords();
 				m_bufferForDWords = new MxU32[m_lengthInDWords];
 
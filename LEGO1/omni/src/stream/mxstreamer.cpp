@@ -10,9 +10,9 @@
 #include <algorithm>
 #include <assert.h>
 
-DECOMP_SIZE_ASSERT(MxStreamer, 0x2c);
-DECOMP_SIZE_ASSERT(MxMemoryPool64, 0x0c);
-DECOMP_SIZE_ASSERT(MxMemoryPool128, 0x0c);
+DECOMP_SIZE_ASSERT(MxStreamer, 0x94);
+DECOMP_SIZE_ASSERT(MxMemoryPool64, 0x40);
+DECOMP_SIZE_ASSERT(MxMemoryPool128, 0x40);
 DECOMP_SIZE_ASSERT(MxBitset<22>, 0x04);
 DECOMP_SIZE_ASSERT(MxBitset<2>, 0x04);
 
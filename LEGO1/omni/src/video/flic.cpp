@@ -48,6 +48,17 @@ void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_dat
 void DecodeBlack(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
 void DecodeCopy(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
 
+// Fast path, used when the whole FLC frame fits inside the bitmap.
+// The scanline stride is computed once per frame, rows are checked once per line
+// and packets only need their right edge checked. Anything that would leave the
+// bitmap goes through the clamping WritePixel* functions above.
+void FillPixelPairs(BYTE* p_dest, WORD p_pixel, short p_count);
+void DecodeBrunFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeLCFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeSS2Fast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeBlackFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeCopyFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+
 // FUNCTION: LEGO1 0x100bd530
 // FUNCTION: BETA10 0x1013dd80
 void WritePixel(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, short p_column, short p_row, byte p_pixel)
@@ -183,6 +194,9 @@ short DecodeChunks(
 {
 	*p_decodedColorMap = FALSE;
 
+	// Clamp once per frame instead of once per packet
+	BOOL inBounds = p_flcHeader->width <= p_bitmapHeader->biWidth && p_flcHeader->height <= p_bitmapHeader->biHeight;
+
 	for (short subchunk = 0; subchunk < (short) p_flcFrame->chunks; subchunk++) {
 		FLIC_CHUNK* chunk = (FLIC_CHUNK*) p_flcSubchunks;
 		p_flcSubchunks += chunk->size;
@@ -193,23 +207,48 @@ short DecodeChunks(
 			*p_decodedColorMap = TRUE;
 			break;
 		case FLI_CHUNK_SS2:
-			DecodeSS2(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			if (inBounds) {
+				DecodeSS2Fast(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
+			else {
+				DecodeSS2(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
 			break;
 		case FLI_CHUNK_COLOR64:
 			DecodeColors64(p_bitmapHeader, (BYTE*) (chunk + 1));
 			*p_decodedColorMap = TRUE;
 			break;
 		case FLI_CHUNK_LC:
-			DecodeLC(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			if (inBounds) {
+				DecodeLCFast(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
+			else {
+				DecodeLC(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
 			break;
 		case FLI_CHUNK_BLACK:
-			DecodeBlack(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			if (inBounds) {
+				DecodeBlackFast(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
+			else {
+				DecodeBlack(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
 			break;
 		case FLI_CHUNK_BRUN:
-			DecodeBrun(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			if (inBounds) {
+				DecodeBrunFast(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
+			else {
+				DecodeBrun(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
 			break;
 		case FLI_CHUNK_COPY:
-			DecodeCopy(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			if (inBounds) {
+				DecodeCopyFast(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
+			else {
+				DecodeCopy(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			}
 			break;
 		default:
 			break;
@@ -452,6 +491,212 @@ void DecodeCopy(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_da
 	}
 }
 
+void FillPixelPairs(BYTE* p_dest, WORD p_pixel, short p_count)
+{
+	if ((p_pixel & 0xff) == (p_pixel >> 8)) {
+		memset(p_dest, (BYTE) p_pixel, p_count * 2);
+		return;
+	}
+
+	// Rows are byte aligned, so the pattern goes through memcpy rather than a DWORD store
+	DWORD pattern = p_pixel | ((DWORD) p_pixel << 16);
+
+	for (short i = p_count >> 1; i > 0; i--) {
+		memcpy(p_dest, &pattern, sizeof(pattern));
+		p_dest += sizeof(pattern);
+	}
+
+	if (p_count & 1) {
+		memcpy(p_dest, &p_pixel, sizeof(p_pixel));
+	}
+}
+
+void DecodeBrunFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+{
+	LONG stride = (p_bitmapHeader->biWidth + 3) & -4;
+	short width = p_flcHeader->width;
+	BYTE* data = p_data;
+	BYTE* line = stride * (p_flcHeader->height - 1) + p_pixelData;
+
+	for (short row = p_flcHeader->height; row > 0; row--) {
+		BYTE* offset = line;
+		short column = 0;
+		short count = 0;
+
+		data++; // packet count, unused
+		while ((column += count) < width) {
+			count = *((char*) data++);
+
+			if (count >= 0) {
+				memset(offset, *data, count);
+				offset += count;
+				data++;
+			}
+			else {
+				count = -count;
+				memcpy(offset, data, count);
+				offset += count;
+				data += count;
+			}
+		}
+
+		line -= stride;
+	}
+}
+
+void DecodeLCFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+{
+	LONG stride = (p_bitmapHeader->biWidth + 3) & -4;
+	LONG bmWidth = p_bitmapHeader->biWidth;
+	short* word_data = (short*) p_data;
+	BYTE* data = p_data + 4;
+	short row = p_flcHeader->height - word_data[0] - 1;
+	short lines = word_data[1];
+
+	while (--lines >= 0) {
+		BYTE* line = row >= 0 && row < p_bitmapHeader->biHeight ? stride * row + p_pixelData : NULL;
+		short column = 0;
+		BYTE packets = *data++;
+
+		while (packets > 0) {
+			column += *data++; // skip byte
+			short type = *((char*) data++);
+
+			if (type < 0) {
+				type = -type;
+
+				if (line != NULL && column + type <= bmWidth) {
+					memset(line + column, *data, type);
+				}
+				else {
+					WritePixelRun(p_bitmapHeader, p_pixelData, column, row, *data, type);
+				}
+
+				data++;
+			}
+			else {
+				if (line != NULL && column + type <= bmWidth) {
+					memcpy(line + column, data, type);
+				}
+				else {
+					WritePixels(p_bitmapHeader, p_pixelData, column, row, data, type);
+				}
+
+				data += type;
+			}
+
+			column += type;
+			packets--;
+		}
+
+		row--;
+	}
+}
+
+void DecodeSS2Fast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+{
+	LONG stride = (p_bitmapHeader->biWidth + 3) & -4;
+	LONG bmWidth = p_bitmapHeader->biWidth;
+	short width = (short) p_flcHeader->width - 1;
+	short row = (short) p_flcHeader->height - 1;
+	short lines = *((short*) p_data);
+	BYTE* data = p_data + 2;
+
+	while (--lines > 0) {
+		short token;
+
+		while (TRUE) {
+			token = *((short*) data);
+			data += 2;
+
+			if (token < 0) {
+				if (token & 0x4000) {
+					row += token;
+				}
+				else {
+					WritePixel(p_bitmapHeader, p_pixelData, width, row, token);
+					token = *((WORD*) data);
+					data += 2;
+
+					if (!token) {
+						row--;
+						if (--lines <= 0) {
+							return;
+						}
+					}
+					else {
+						break;
+					}
+				}
+			}
+			else {
+				break;
+			}
+		}
+
+		BYTE* line = row >= 0 && row < p_bitmapHeader->biHeight ? stride * row + p_pixelData : NULL;
+		short column = 0;
+
+		do {
+			column += *(data++);
+			short type = *((char*) data++);
+			type += type;
+
+			if (type >= 0) {
+				if (line != NULL && column + type <= bmWidth) {
+					memcpy(line + column, data, type);
+				}
+				else {
+					WritePixels(p_bitmapHeader, p_pixelData, column, row, data, type);
+				}
+
+				column += type;
+				data += type;
+			}
+			else {
+				type = -type;
+				WORD pixel = *((WORD*) data);
+				data += 2;
+
+				if (line != NULL && column + type <= bmWidth) {
+					FillPixelPairs(line + column, pixel, type >> 1);
+				}
+				else {
+					WritePixelPairs(p_bitmapHeader, p_pixelData, column, row, pixel, type >> 1);
+				}
+
+				column += type;
+			}
+		} while (--token);
+
+		row--;
+	}
+}
+
+void DecodeBlackFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+{
+	LONG stride = (p_bitmapHeader->biWidth + 3) & -4;
+	BYTE* line = p_pixelData;
+
+	for (short i = p_flcHeader->height; i > 0; i--) {
+		memset(line, 0, p_flcHeader->width);
+		line += stride;
+	}
+}
+
+void DecodeCopyFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+{
+	LONG stride = (p_bitmapHeader->biWidth + 3) & -4;
+	short width = p_flcHeader->width;
+	BYTE* line = p_pixelData + stride * (p_flcHeader->height - 1);
+
+	for (short i = p_flcHeader->height; i > 0; i--) {
+		memcpy(line, p_data, width);
+		p_data += width;
+		line -= stride;
+	}
+}
+
 // FUNCTION: LEGO1 0x100bdce0
 // FUNCTION: BETA10 0x1013e9a5
 void DecodeFLCFrame(
@@ -0,0 +1,252 @@
+#include "mxblitter.h"
+
+#include <string.h>
+
+// Non-zero if any of the four bytes of x is zero
+#define HAS_ZERO_BYTE(x) (((x) - 0x01010101) & ~(x) & 0x80808080)
+
+// Two 16-bit pixels in one 32-bit store, the first one in the low half
+#define PIXEL_PAIR(a, b) ((MxU32) (a) | ((MxU32) (b) << 16))
+
+// Bitmaps and surfaces give no alignment guarantee and are also accessed bytewise, so 32-bit loads and stores go
+// through memcpy, which compiles to a single move
+inline static MxU32 LoadU32(const void* p_src)
+{
+	MxU32 value;
+	memcpy(&value, p_src, sizeof(value));
+	return value;
+}
+
+inline static void StoreU32(void* p_dest, MxU32 p_value)
+{
+	memcpy(p_dest, &p_value, sizeof(p_value));
+}
+
+void MxBlitter::Copy8(
+	MxU8* p_dest,
+	MxLong p_destPitch,
+	const MxU8* p_src,
+	MxLong p_srcStride,
+	MxS32 p_width,
+	MxS32 p_height
+)
+{
+	while (p_height--) {
+		memcpy(p_dest, p_src, p_width);
+		p_src += p_srcStride;
+		p_dest += p_destPitch;
+	}
+}
+
+void MxBlitter::CopyDoubled8(
+	MxU8* p_dest,
+	MxLong p_destPitch,
+	const MxU8* p_src,
+	MxLong p_srcStride,
+	MxS32 p_width,
+	MxS32 p_height
+)
+{
+	while (p_height--) {
+		DoubleRow8(p_dest, p_src, p_width);
+		memcpy(p_dest + p_destPitch, p_dest, 2 * p_width);
+		p_src += p_srcStride;
+		p_dest += 2 * p_destPitch;
+	}
+}
+
+void MxBlitter::CopyTransparent8(
+	MxU8* p_dest,
+	MxLong p_destPitch,
+	const MxU8* p_src,
+	MxLong p_srcStride,
+	MxS32 p_width,
+	MxS32 p_height
+)
+{
+	while (p_height--) {
+		CopyTransparentRow8(p_dest, p_src, p_width);
+		p_src += p_srcStride;
+		p_dest += p_destPitch;
+	}
+}
+
+void MxBlitter::Expand16(
+	MxU8* p_dest,
+	MxLong p_destPitch,
+	const MxU8* p_src,
+	MxLong p_srcStride,
+	MxS32 p_width,
+	MxS32 p_height,
+	const MxU16* p_palette
+)
+{
+	while (p_height--) {
+		ExpandRow16((MxU16*) p_dest, p_src, p_width, p_palette);
+		p_src += p_srcStride;
+		p_dest += p_destPitch;
+	}
+}
+
+void MxBlitter::ExpandDoubled16(
+	MxU8* p_dest,
+	MxLong p_destPitch,
+	const MxU8* p_src,
+	MxLong p_srcStride,
+	MxS32 p_width,
+	MxS32 p_height,
+	const MxU16* p_palette
+)
+{
+	while (p_height--) {
+		ExpandRowDoubled16((MxU16*) p_dest, p_src, p_width, p_palette);
+		memcpy(p_dest + p_destPitch, p_dest, 4 * p_width);
+		p_src += p_srcStride;
+		p_dest += 2 * p_destPitch;
+	}
+}
+
+void MxBlitter::ExpandTransparent16(
+	MxU8* p_dest,
+	MxLong p_destPitch,
+	const MxU8* p_src,
+	MxLong p_srcStride,
+	MxS32 p_width,
+	MxS32 p_height,
+	const MxU16* p_palette
+)
+{
+	while (p_height--) {
+		ExpandTransparentRow16((MxU16*) p_dest, p_src, p_width, p_palette);
+		p_src += p_srcStride;
+		p_dest += p_destPitch;
+	}
+}
+
+void MxBlitter::ExpandRow16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette)
+{
+	for (; p_count >= 4; p_count -= 4) {
+		MxU32 indices = LoadU32(p_src);
+
+		StoreU32(p_dest, PIXEL_PAIR(p_palette[indices & 0xff], p_palette[(indices >> 8) & 0xff]));
+		StoreU32(p_dest + 2, PIXEL_PAIR(p_palette[(indices >> 16) & 0xff], p_palette[indices >> 24]));
+
+		p_src += 4;
+		p_dest += 4;
+	}
+
+	while (p_count--) {
+		*p_dest++ = p_palette[*p_src++];
+	}
+}
+
+void MxBlitter::ExpandRowDoubled16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette)
+{
+	MxU32 pixel;
+
+	for (; p_count >= 4; p_count -= 4) {
+		MxU32 indices = LoadU32(p_src);
+
+		pixel = p_palette[indices & 0xff];
+		StoreU32(p_dest, PIXEL_PAIR(pixel, pixel));
+		pixel = p_palette[(indices >> 8) & 0xff];
+		StoreU32(p_dest + 2, PIXEL_PAIR(pixel, pixel));
+		pixel = p_palette[(indices >> 16) & 0xff];
+		StoreU32(p_dest + 4, PIXEL_PAIR(pixel, pixel));
+		pixel = p_palette[indices >> 24];
+		StoreU32(p_dest + 6, PIXEL_PAIR(pixel, pixel));
+
+		p_src += 4;
+		p_dest += 8;
+	}
+
+	while (p_count--) {
+		pixel = p_palette[*p_src++];
+		*p_dest++ = pixel;
+		*p_dest++ = pixel;
+	}
+}
+
+void MxBlitter::DoubleRow8(MxU8* p_dest, const MxU8* p_src, MxS32 p_count)
+{
+	for (; p_count >= 4; p_count -= 4) {
+		MxU32 indices = LoadU32(p_src);
+
+		// (b0 | b1 << 16) * 0x101 spreads b0 b1 into b0 b0 b1 b1
+		StoreU32(p_dest, ((indices & 0xff) | ((indices & 0xff00) << 8)) * 0x101);
+		StoreU32(p_dest + 4, (((indices >> 16) & 0xff) | ((indices >> 8) & 0xff0000)) * 0x101);
+
+		p_src += 4;
+		p_dest += 8;
+	}
+
+	while (p_count--) {
+		*p_dest++ = *p_src;
+		*p_dest++ = *p_src++;
+	}
+}
+
+void MxBlitter::CopyTransparentRow8(MxU8* p_dest, const MxU8* p_src, MxS32 p_count)
+{
+	for (; p_count >= 4; p_count -= 4) {
+		MxU32 indices = LoadU32(p_src);
+
+		if (indices != 0) {
+			if (!HAS_ZERO_BYTE(indices)) {
+				StoreU32(p_dest, indices);
+			}
+			else {
+				for (MxS32 i = 0; i < 4; i++) {
+					if (p_src[i] != 0) {
+						p_dest[i] = p_src[i];
+					}
+				}
+			}
+		}
+
+		p_src += 4;
+		p_dest += 4;
+	}
+
+	while (p_count--) {
+		if (*p_src != 0) {
+			*p_dest = *p_src;
+		}
+
+		p_src++;
+		p_dest++;
+	}
+}
+
+void MxBlitter::ExpandTransparentRow16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette)
+{
+	for (; p_count >= 4; p_count -= 4) {
+		MxU32 indices = LoadU32(p_src);
+
+		if (indices != 0) {
+			if (!HAS_ZERO_BYTE(indices)) {
+				StoreU32(p_dest, PIXEL_PAIR(p_palette[indices & 0xff], p_palette[(indices >> 8) & 0xff]));
+				StoreU32(p_dest + 2, PIXEL_PAIR(p_palette[(indices >> 16) & 0xff], p_palette[indices >> 24]));
+			}
+			else {
+				for (MxS32 i = 0; i < 4; i++) {
+					if (p_src[i] != 0) {
+						p_dest[i] = p_palette[p_src[i]];
+					}
+				}
+			}
+		}
+
+		p_src += 4;
+		p_dest += 4;
+	}
+
+	while (p_count--) {
+		if (*p_src != 0) {
+			*p_dest = p_palette[*p_src];
+		}
+
+		p_src++;
+		p_dest++;
+	}
+}
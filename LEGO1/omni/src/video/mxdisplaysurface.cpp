@@ -1,6 +1,7 @@
 #include "mxdisplaysurface.h"
 
 #include "mxbitmap.h"
+#include "mxblitter.h"
 #include "mxdebug.h"
 #include "mxmisc.h"
 #include "mxomni.h"
@@ -370,6 +371,7 @@ void MxDisplaySurface::VTable0x28(
 	}
 
 	MxU8* data = p_bitmap->GetStart(p_left, p_top);
+	MxLong stride = GetAdjustedStride(p_bitmap);
 
 	if (m_videoParam.Flags().GetF1bit3()) {
 		p_bottom *= 2;
@@ -378,75 +380,12 @@ void MxDisplaySurface::VTable0x28(
 		switch (m_surfaceDesc.ddpfPixelFormat.dwRGBBitCount) {
 		case 8: {
 			MxU8* surface = (MxU8*) ddsd.lpSurface + p_right + (p_bottom * ddsd.lPitch);
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
-
-			MxLong length = -2 * p_width + ddsd.lPitch;
-			while (p_height--) {
-				MxU8* surfaceBefore = surface;
-
-				for (MxS32 i = 0; p_width > i; i++) {
-					*surface++ = *data;
-					*surface++ = *data++;
-				}
-
-				data += stride;
-				surface += length;
-
-				memcpy(surface, surfaceBefore, 2 * p_width);
-				surface += ddsd.lPitch;
-			}
+			MxBlitter::CopyDoubled8(surface, ddsd.lPitch, data, stride, p_width, p_height);
 			break;
 		}
 		case 16: {
 			MxU8* surface = (MxU8*) ddsd.lpSurface + (2 * p_right) + (p_bottom * ddsd.lPitch);
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
-
-			MxS32 length = -4 * p_width + ddsd.lPitch;
-			MxS32 height = p_height;
-			MxS32 width = p_width;
-			MxS32 copyWidth = width * 4;
-			MxU16* p16bitPal = m_16bitPal;
-
-			MxS32 i;
-			if (!stride && !length) {
-				while (height--) {
-					MxU8* surfaceBefore = surface;
-
-					for (i = 0; i < width; i++) {
-						MxU16 element = p16bitPal[*data];
-						*(MxU16*) surface = element;
-						surface += 2;
-						*(MxU16*) surface = element;
-
-						data++;
-						surface += 2;
-					}
-
-					memcpy(surface, surfaceBefore, copyWidth);
-					surface += ddsd.lPitch;
-				}
-			}
-			else {
-				while (height--) {
-					MxU8* surfaceBefore = surface;
-
-					for (i = 0; i < width; i++) {
-						MxU16 element = p16bitPal[*data];
-						*(MxU16*) surface = element;
-						surface += 2;
-						*(MxU16*) surface = element;
-
-						data++;
-						surface += 2;
-					}
-
-					data += stride;
-					surface += length;
-
-					memcpy(surface, surfaceBefore, p_width * 4);
-					surface += ddsd.lPitch;
-				}
-			}
+			MxBlitter::ExpandDoubled16(surface, ddsd.lPitch, data, stride, p_width, p_height, m_16bitPal);
 			break;
 		}
 		default:
@@ -457,30 +396,12 @@ void MxDisplaySurface::VTable0x28(
 		switch (m_surfaceDesc.ddpfPixelFormat.dwRGBBitCount) {
 		case 8: {
 			MxU8* surface = (MxU8*) ddsd.lpSurface + p_right + (p_bottom * ddsd.lPitch);
-			MxLong stride = GetAdjustedStride(p_bitmap);
-
-			MxLong length = ddsd.lPitch;
-			while (p_height--) {
-				memcpy(surface, data, p_width);
-				data += stride;
-				surface += length;
-			}
+			MxBlitter::Copy8(surface, ddsd.lPitch, data, stride, p_width, p_height);
 			break;
 		}
 		case 16: {
 			MxU8* surface = (MxU8*) ddsd.lpSurface + (2 * p_right) + (p_bottom * ddsd.lPitch);
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
-
-			MxLong length = -2 * p_width + ddsd.lPitch;
-			for (MxS32 i = 0; i < p_height; i++) {
-				for (MxS32 j = 0; j < p_width; j++) {
-					*(MxU16*) surface = m_16bitPal[*data++];
-					surface += 2;
-				}
-
-				data += stride;
-				surface += length;
-			}
+			MxBlitter::Expand16(surface, ddsd.lPitch, data, stride, p_width, p_height, m_16bitPal);
 			break;
 		}
 		default:
@@ -542,22 +463,8 @@ void MxDisplaySurface::VTable0x30(
 			DrawTransparentRLE(data, surface, size, p_width, p_height, ddsd.lPitch, 8);
 		}
 		else {
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
-
-			MxLong length = -p_width + ddsd.lPitch;
-			for (MxS32 i = 0; i < p_height; i++) {
-				for (MxS32 j = 0; j < p_width; j++) {
-					if (*data != 0) {
-						*surface = *data;
-					}
-
-					data++;
-					surface++;
-				}
-
-				data += stride;
-				surface += length;
-			}
+			MxLong stride = GetAdjustedStride(p_bitmap);
+			MxBlitter::CopyTransparent8(surface, ddsd.lPitch, data, stride, p_width, p_height);
 		}
 		break;
 	}
@@ -568,22 +475,8 @@ void MxDisplaySurface::VTable0x30(
 			DrawTransparentRLE(data, surface, size, p_width, p_height, ddsd.lPitch, 16);
 		}
 		else {
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
-
-			MxLong length = -2 * p_width + ddsd.lPitch;
-			for (MxS32 i = 0; i < p_height; i++) {
-				for (MxS32 j = 0; j < p_width; j++) {
-					if (*data != 0) {
-						*(MxU16*) surface = m_16bitPal[*data];
-					}
-
-					data++;
-					surface += 2;
-				}
-
-				data += stride;
-				surface += length;
-			}
+			MxLong stride = GetAdjustedStride(p_bitmap);
+			MxBlitter::ExpandTransparent16(surface, ddsd.lPitch, data, stride, p_width, p_height, m_16bitPal);
 		}
 		break;
 	}
@@ -671,11 +564,9 @@ void MxDisplaySurface::DrawTransparentRLE(
 			p_surfaceData += p_pitch - p_width;
 			MxS32 rows = drawCount / p_width;
 
-			for (MxU32 i = 0; i < rows; i++) {
-				memcpy(p_surfaceData, p_bitmapData, p_width);
-				p_bitmapData += p_width;
-				p_surfaceData += p_pitch;
-			}
+			MxBlitter::Copy8(p_surfaceData, p_pitch, p_bitmapData, p_width, p_width, rows);
+			p_surfaceData += p_pitch * rows;
+			p_bitmapData += p_width * rows;
 		}
 
 		MxS32 tail = drawCount % p_width;
@@ -718,34 +609,24 @@ void MxDisplaySurface::DrawTransparentRLE(
 		count += drawCount;
 
 		if (drawCount >= rowRemainder) {
-			// memcpy
-			for (MxU32 j = 0; j < rowRemainder; j++) {
-				*((MxU16*) p_surfaceData) = m_16bitPal[*p_bitmapData++];
-				p_surfaceData += 2;
-			}
+			MxBlitter::ExpandRow16((MxU16*) p_surfaceData, p_bitmapData, rowRemainder, m_16bitPal);
+			p_surfaceData += 2 * rowRemainder;
+			p_bitmapData += rowRemainder;
 
 			drawCount -= rowRemainder;
 
 			p_surfaceData += p_pitch - 2 * p_width;
 			MxS32 rows = drawCount / p_width;
 
-			for (MxU32 i = 0; i < rows; i++) {
-				// memcpy
-				for (MxS32 j = 0; j < p_width; j++) {
-					*((MxU16*) p_surfaceData) = m_16bitPal[*p_bitmapData++];
-					p_surfaceData += 2;
-				}
-
-				p_surfaceData += p_pitch - 2 * p_width;
-			}
+			MxBlitter::Expand16(p_surfaceData, p_pitch, p_bitmapData, p_width, p_width, rows, m_16bitPal);
+			p_surfaceData += p_pitch * rows;
+			p_bitmapData += p_width * rows;
 		}
 
 		MxS32 tail = drawCount % p_width;
-		// memcpy
-		for (MxS32 j = 0; j < tail; j++) {
-			*((MxU16*) p_surfaceData) = m_16bitPal[*p_bitmapData++];
-			p_surfaceData += 2;
-		}
+		MxBlitter::ExpandRow16((MxU16*) p_surfaceData, p_bitmapData, tail, m_16bitPal);
+		p_surfaceData += 2 * tail;
+		p_bitmapData += tail;
 	}
 }
 
@@ -1328,16 +1209,7 @@ void MxDisplaySurface::VTable0x2c(
 			DrawTransparentRLE(src, dest, p_bitmap->GetBmiHeader()->biSizeImage, p_width, p_height, p_desc->lPitch, 8);
 		}
 		else {
-			MxLong srcSkip = GetAdjustedStride(p_bitmap) - p_width;
-			MxLong destSkip = destStride - p_width;
-
-			for (MxS32 i = 0; i < p_height; i++, src += srcSkip, dest += destSkip) {
-				for (MxS32 j = 0; j < p_width; j++, src++, dest++) {
-					if (*src) {
-						*dest = *src;
-					}
-				}
-			}
+			MxBlitter::CopyTransparent8(dest, destStride, src, GetAdjustedStride(p_bitmap), p_width, p_height);
 		}
 		break;
 	}
@@ -1350,16 +1222,7 @@ void MxDisplaySurface::VTable0x2c(
 		}
 		else {
 			MxLong srcStride = GetAdjustedStride(p_bitmap);
-			MxLong srcSkip = srcStride - p_width;
-			MxLong destSkip = destStride - 2 * p_width;
-
-			for (MxS32 i = 0; i < p_height; i++, src += srcSkip, dest += destSkip) {
-				for (MxS32 j = 0; j < p_width; j++, src++, dest += 2) {
-					if (*src != 0) {
-						*(MxU16*) dest = m_16bitPal[*src];
-					}
-				}
-			}
+			MxBlitter::ExpandTransparent16(dest, destStride, src, srcStride, p_width, p_height, m_16bitPal);
 		}
 		break;
 	}
@@ -7,6 +7,256 @@
 DECOMP_SIZE_ASSERT(SmackTag, 0x390);
 DECOMP_SIZE_ASSERT(MxSmk, 0x6b8);
 
+// Reference: https://wiki.multimedia.cx/index.php/Smacker
+
+// Reads a Smacker bitstream, least significant bit first. Reads past the end yield zero bits.
+class MxSmkBitReader {
+public:
+	MxSmkBitReader(const MxU8* p_data, MxU32 p_length)
+	{
+		m_data = p_data;
+		m_end = p_data + p_length;
+		m_bits = 0;
+		m_count = 0;
+	}
+
+	// Makes sure at least 25 bits are buffered
+	void Refill()
+	{
+		while (m_count <= 24) {
+			m_bits |= (MxU32) (m_data < m_end ? *m_data++ : 0) << m_count;
+			m_count += 8;
+		}
+	}
+
+	MxU32 Peek() const { return m_bits; }
+
+	void Skip(MxU32 p_count)
+	{
+		m_bits >>= p_count;
+		m_count -= p_count;
+	}
+
+	// p_count is at most 16
+	MxU32 GetBits(MxU32 p_count)
+	{
+		Refill();
+		MxU32 value = m_bits & ((1 << p_count) - 1);
+		Skip(p_count);
+		return value;
+	}
+
+	MxU32 GetBit() { return GetBits(1); }
+
+private:
+	const MxU8* m_data;
+	const MxU8* m_end;
+	MxU32 m_bits;
+	MxU32 m_count;
+};
+
+#define SMK_MAX_TREE_DEPTH 32
+#define SMK_BYTE_TREE_SIZE 511
+
+// Walks a tree in the MxSmkTree::m_nodes layout one bit at a time
+inline static MxU32 WalkTree(MxSmkBitReader& p_reader, const MxU32* p_nodes, MxU32 p_index)
+{
+	while (p_nodes[p_index] & MxSmkTree::c_node) {
+		p_index += p_reader.GetBit() ? (p_nodes[p_index] & ~MxSmkTree::c_node) + 1 : 1;
+	}
+
+	return p_index;
+}
+
+// Reads one of the 8-bit trees that make up the values of a big tree
+static MxBool ReadByteTree(MxSmkBitReader& p_reader, MxU32* p_nodes, MxU32& p_count, MxU32 p_depth)
+{
+	if (p_depth > SMK_MAX_TREE_DEPTH || p_count >= SMK_BYTE_TREE_SIZE) {
+		return FALSE;
+	}
+
+	MxU32 index = p_count++;
+
+	if (!p_reader.GetBit()) {
+		p_nodes[index] = p_reader.GetBits(8);
+		return TRUE;
+	}
+
+	if (!ReadByteTree(p_reader, p_nodes, p_count, p_depth + 1)) {
+		return FALSE;
+	}
+
+	p_nodes[index] = MxSmkTree::c_node | (p_count - index - 1);
+	return ReadByteTree(p_reader, p_nodes, p_count, p_depth + 1);
+}
+
+// State shared by the recursion of ReadBigTree
+struct MxSmkBigTreeContext {
+	MxSmkBitReader* m_reader;
+	MxSmkTree* m_tree;
+	const MxU32* m_bytes[2];
+	MxU32 m_escapes[3];
+	MxU32 m_count;
+	MxU32 m_capacity;
+};
+
+static MxBool ReadBigTree(MxSmkBigTreeContext& p_context, MxU32 p_depth)
+{
+	if (p_depth > SMK_MAX_TREE_DEPTH || p_context.m_count >= p_context.m_capacity) {
+		return FALSE;
+	}
+
+	MxU32 index = p_context.m_count++;
+	MxU32* nodes = p_context.m_tree->m_nodes;
+
+	if (!p_context.m_reader->GetBit()) {
+		MxU32 value = 0;
+
+		for (MxU32 i = 0; i < 2; i++) {
+			if (p_context.m_bytes[i]) {
+				const MxU32* bytes = p_context.m_bytes[i];
+				value |= bytes[WalkTree(*p_context.m_reader, bytes, 0)] << (i * 8);
+			}
+		}
+
+		for (MxU32 j = 0; j < 3; j++) {
+			if (value == p_context.m_escapes[j]) {
+				p_context.m_tree->m_recent[j] = index;
+				value = 0;
+				break;
+			}
+		}
+
+		nodes[index] = value;
+		return TRUE;
+	}
+
+	if (!ReadBigTree(p_context, p_depth + 1)) {
+		return FALSE;
+	}
+
+	nodes[index] = MxSmkTree::c_node | (p_context.m_count - index - 1);
+	return ReadBigTree(p_context, p_depth + 1);
+}
+
+// Fills the lookup entries of all codes that start with the p_length bits of p_code
+static void FillLookup(MxSmkTree* p_tree, MxU32 p_index, MxU32 p_code, MxU32 p_length)
+{
+	MxU32 node = p_tree->m_nodes[p_index];
+
+	if (node & MxSmkTree::c_node && p_length < MxSmkTree::c_lookupBits) {
+		FillLookup(p_tree, p_index + 1, p_code, p_length + 1);
+		FillLookup(p_tree, p_index + (node & ~MxSmkTree::c_node) + 1, p_code | (1 << p_length), p_length + 1);
+		return;
+	}
+
+	MxU32 entry = (p_index << MxSmkTree::c_lookupShift) | p_length;
+
+	if (node & MxSmkTree::c_node) {
+		entry |= MxSmkTree::c_lookupNode;
+	}
+
+	for (MxU32 i = p_code; i < (1 << MxSmkTree::c_lookupBits); i += 1 << p_length) {
+		p_tree->m_lookup[i] = entry;
+	}
+}
+
+// Number of entries a tree of p_size bytes can have, three of them reserved for unused escapes
+inline static MxU32 TreeCapacity(MxU32 p_size)
+{
+	return ((p_size + 3) >> 2) + 4;
+}
+
+// Reads one of the four big trees from the trees section of the header
+static MxBool ReadTree(MxSmkBitReader& p_reader, MxSmkTree* p_tree, MxU32 p_size)
+{
+	MxU32 i;
+
+	p_tree->m_recent[0] = p_tree->m_recent[1] = p_tree->m_recent[2] = (MxU32) -1;
+
+	if (!p_reader.GetBit()) {
+		// Tree is not present, every code decodes to zero without reading any bits
+		p_tree->m_nodes[0] = 0;
+		p_tree->m_nodes[1] = 0;
+		p_tree->m_recent[0] = p_tree->m_recent[1] = p_tree->m_recent[2] = 1;
+		FillLookup(p_tree, 0, 0, 0);
+		return TRUE;
+	}
+
+	MxU32 bytes[2][SMK_BYTE_TREE_SIZE];
+	MxSmkBigTreeContext context;
+
+	context.m_reader = &p_reader;
+	context.m_tree = p_tree;
+
+	for (i = 0; i < 2; i++) {
+		context.m_bytes[i] = NULL;
+
+		if (p_reader.GetBit()) {
+			MxU32 count = 0;
+
+			if (!ReadByteTree(p_reader, bytes[i], count, 0)) {
+				return FALSE;
+			}
+
+			p_reader.GetBit();
+			context.m_bytes[i] = bytes[i];
+		}
+	}
+
+	for (i = 0; i < 3; i++) {
+		context.m_escapes[i] = p_reader.GetBits(16);
+	}
+
+	context.m_count = 0;
+	context.m_capacity = TreeCapacity(p_size);
+
+	// Leave room for the escapes that do not appear in the tree
+	if (context.m_capacity < 3 || !ReadBigTree(context, 0) || context.m_count > context.m_capacity - 3) {
+		return FALSE;
+	}
+
+	p_reader.GetBit();
+
+	for (i = 0; i < 3; i++) {
+		if (p_tree->m_recent[i] == (MxU32) -1) {
+			p_tree->m_recent[i] = context.m_count;
+			p_tree->m_nodes[context.m_count++] = 0;
+		}
+	}
+
+	FillLookup(p_tree, 0, 0, 0);
+	return TRUE;
+}
+
+// Decodes the next value of p_tree and makes it the most recent one
+inline static MxU32 DecodeValue(MxSmkBitReader& p_reader, MxSmkTree* p_tree)
+{
+	MxU32* nodes = p_tree->m_nodes;
+
+	p_reader.Refill();
+	MxU32 entry = p_tree->m_lookup[p_reader.Peek() & ((1 << MxSmkTree::c_lookupBits) - 1)];
+	MxU32 index = entry >> MxSmkTree::c_lookupShift;
+	p_reader.Skip(entry & (MxSmkTree::c_lookupNode - 1));
+
+	if (entry & MxSmkTree::c_lookupNode) {
+		// Rare code longer than the lookup table
+		index = WalkTree(p_reader, nodes, index);
+	}
+
+	MxU32 value = nodes[index];
+	MxU32* recent = p_tree->m_recent;
+
+	if (value != nodes[recent[0]]) {
+		nodes[recent[2]] = nodes[recent[1]];
+		nodes[recent[1]] = nodes[recent[0]];
+		nodes[recent[0]] = value;
+	}
+
+	return value;
+}
+
+
 // FUNCTION: LEGO1 0x100c5a90
 // FUNCTION: BETA10 0x10151e70
 MxResult MxSmk::LoadHeader(MxU8* p_data, MxSmk* p_mxSmk)
@@ -19,15 +269,13 @@ MxResult MxSmk::LoadHeader(MxU8* p_data, MxSmk* p_mxSmk)
 	MxResult result = SUCCESS;
 	MxU32* frameSizes = NULL;
 	MxU8* frameTypes = NULL;
-	MxU8* huffmanTrees = NULL;
-	MxU32 sizetables = 0;
+	MxSmkTree* trees = NULL;
 
 	// Forced to declare here because of the gotos.
 	MxU32 i;
-	MxU32 treeSize;
-	MxU32* data;
+	MxU32 treeSizes[MxSmkTree::e_numTrees];
 	MxU32 size;
-	MxS32 width;
+	MxU32* tables;
 
 	if (!p_data || !p_mxSmk) {
 		return FAILURE;
@@ -36,8 +284,9 @@ MxResult MxSmk::LoadHeader(MxU8* p_data, MxSmk* p_mxSmk)
 	SmackTag* smackTag = &p_mxSmk->m_smackTag;
 	p_mxSmk->m_frameTypes = NULL;
 	p_mxSmk->m_frameSizes = NULL;
-	p_mxSmk->m_huffmanTrees = NULL;
+	p_mxSmk->m_trees = NULL;
 	p_mxSmk->m_huffmanTables = NULL;
+	p_mxSmk->m_rects = NULL;
 
 	memcpy(smackTag, p_data, SmackHeaderSize(smackTag));
 	p_data += SmackHeaderSize(smackTag);
@@ -70,67 +319,54 @@ MxResult MxSmk::LoadHeader(MxU8* p_data, MxSmk* p_mxSmk)
 	memcpy(frameTypes, p_data, FRAME_COUNT(smackTag));
 	p_data += FRAME_COUNT(smackTag);
 
-	treeSize = smackTag->tablesize + 0x1000;
-	huffmanTrees = new MxU8[treeSize <= 0x2000 ? 0x2000 : treeSize];
+	treeSizes[MxSmkTree::e_monoMap] = smackTag->codesize;
+	treeSizes[MxSmkTree::e_monoColors] = smackTag->absize;
+	treeSizes[MxSmkTree::e_full] = smackTag->detailsize;
+	treeSizes[MxSmkTree::e_type] = smackTag->typesize;
+
+	size = 0;
+	for (i = 0; i < MxSmkTree::e_numTrees; i++) {
+		size += TreeCapacity(treeSizes[i]) + (1 << MxSmkTree::c_lookupBits);
+	}
 
-	if (!huffmanTrees) {
+	trees = new MxSmkTree[MxSmkTree::e_numTrees];
+	p_mxSmk->m_huffmanTables = new MxU32[size];
+
+	if (!trees || !p_mxSmk->m_huffmanTables) {
 		result = FAILURE;
 		goto done;
 	}
 
-	memcpy(huffmanTrees + 0x1000, p_data, smackTag->tablesize);
+	{
+		MxSmkBitReader reader(p_data, smackTag->tablesize);
+		tables = p_mxSmk->m_huffmanTables;
+
+		for (i = 0; i < MxSmkTree::e_numTrees; i++) {
+			trees[i].m_lookup = tables;
+			trees[i].m_nodes = tables + (1 << MxSmkTree::c_lookupBits);
+			tables = trees[i].m_nodes + TreeCapacity(treeSizes[i]);
+
+			if (!ReadTree(reader, &trees[i], treeSizes[i])) {
+				result = FAILURE;
+				goto done;
+			}
+		}
+	}
+
 	p_data += smackTag->tablesize;
 
-	sizetables = SmackGetSizeTables();
-	p_mxSmk->m_huffmanTables =
-		new MxU8[smackTag->codesize + smackTag->detailsize + smackTag->typesize + smackTag->absize + sizetables];
+	// Frames are decoded in bands of block rows separated by at least one unchanged row
+	p_mxSmk->m_rects = new MxRect32[smackTag->Height / 8 + 1];
 
-	if (!p_mxSmk->m_huffmanTables) {
+	if (!p_mxSmk->m_rects) {
 		result = FAILURE;
 		goto done;
 	}
 
-	SmackDoTables(
-		huffmanTrees,
-		p_mxSmk->m_huffmanTables,
-		smackTag->codesize,
-		smackTag->absize,
-		smackTag->detailsize,
-		smackTag->typesize
-	);
-
-	size = SmackGetSizeDeltas(smackTag->Width, smackTag->Height) + 32;
-	p_mxSmk->m_unk0x6b4 = new MxU8[size];
-	memset(p_mxSmk->m_unk0x6b4, 0, size);
-
-	width = p_mxSmk->m_smackTag.Width;
-	data = (MxU32*) p_mxSmk->m_unk0x6b4;
-
-	*data = 1;
-	data++;
-	*data = NULL; // MxU8* bitmapData
-	data++;
-	*data = smackTag->Width / 4;
-	data++;
-	*data = smackTag->Height / 4;
-	data++;
-	*data = width - 4;
-	data++;
-	*data = width * 3;
-	data++;
-	*data = width;
-	data++;
-	*data = width * 3 + (width - smackTag->Width);
-	data++;
-	data++;
-	*data = smackTag->Width;
-	data++;
-	*data = smackTag->Height;
-
 done:
 	p_mxSmk->m_frameTypes = frameTypes;
 	p_mxSmk->m_frameSizes = frameSizes;
-	p_mxSmk->m_huffmanTrees = huffmanTrees;
+	p_mxSmk->m_trees = trees;
 	return result;
 
 #undef FRAME_COUNT
@@ -146,14 +382,61 @@ void MxSmk::Destroy(MxSmk* p_mxSmk)
 	if (p_mxSmk->m_frameTypes) {
 		delete[] p_mxSmk->m_frameTypes;
 	}
-	if (p_mxSmk->m_huffmanTrees) {
-		delete[] p_mxSmk->m_huffmanTrees;
+	if (p_mxSmk->m_trees) {
+		delete[] p_mxSmk->m_trees;
 	}
 	if (p_mxSmk->m_huffmanTables) {
 		delete[] p_mxSmk->m_huffmanTables;
 	}
-	if (p_mxSmk->m_unk0x6b4) {
-		delete[] p_mxSmk->m_unk0x6b4;
+	if (p_mxSmk->m_rects) {
+		delete[] p_mxSmk->m_rects;
+	}
+}
+
+// Block types of a frame, in the low two bits of a type value
+enum {
+	e_mono = 0,
+	e_full = 1,
+	e_skip = 2,
+	e_fill = 3
+};
+
+// Number of blocks covered by a type value, indexed by its bits 2-7
+static const MxU16 g_blockRuns[64] = {
+	1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+	17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32,
+	33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48,
+	49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 128, 256, 512, 1024, 2048
+};
+
+// Bytes of a row of four pixels that take the second color of a mono block, indexed by its four map bits
+static const MxU32 g_monoMasks[16] = {
+	0x00000000,
+	0x000000ff,
+	0x0000ff00,
+	0x0000ffff,
+	0x00ff0000,
+	0x00ff00ff,
+	0x00ffff00,
+	0x00ffffff,
+	0xff000000,
+	0xff0000ff,
+	0xff00ff00,
+	0xff00ffff,
+	0xffff0000,
+	0xffff00ff,
+	0xffffff00,
+	0xffffffff
+};
+
+// Moves p_out from one 4x4 block to the next, wrapping to the next row of blocks
+inline static void NextBlock(MxU8*& p_out, MxU32& p_column, MxU32 p_blocksWide, MxU32 p_stride)
+{
+	p_out += 4;
+
+	if (++p_column == p_blocksWide) {
+		p_column = 0;
+		p_out += p_stride * 4 - p_blocksWide * 4;
 	}
 }
 
@@ -164,12 +447,13 @@ MxResult MxSmk::LoadFrame(
 	MxU8* p_bitmapData,
 	MxSmk* p_mxSmk,
 	MxU8* p_chunkData,
+	MxU32 p_chunkLength,
 	MxBool p_paletteChanged,
-	MxRect32List* p_list
+	MxU32& p_numRects
 )
 {
 	p_bitmapInfo->m_bmiHeader.biHeight = -MxBitmap::HeightAbs(p_bitmapInfo->m_bmiHeader.biHeight);
-	*(MxU8**) (p_mxSmk->m_unk0x6b4 + 4) = p_bitmapData;
+	p_numRects = 0;
 
 	// Reference: https://wiki.multimedia.cx/index.php/Smacker#Palette_Chunk
 	if (p_paletteChanged) {
@@ -214,57 +498,118 @@ MxResult MxSmk::LoadFrame(
 			p_bitmapInfo->m_bmiColors[i].rgbRed = palette[i * 3] * 4;
 		}
 
-		p_chunkData += *p_chunkData * 4;
-	}
+		MxU32 paletteSize = *p_chunkData * 4;
+
+		if (paletteSize > p_chunkLength) {
+			return FAILURE;
+		}
 
-	SmackDoFrameToBuffer(p_chunkData, p_mxSmk->m_huffmanTables, p_mxSmk->m_unk0x6b4);
+		p_chunkData += paletteSize;
+		p_chunkLength -= paletteSize;
+	}
 
-	MxU16 und = 1;
-	u32 smackRect[4];
-	MxRect32 rect;
+	MxSmkBitReader reader(p_chunkData, p_chunkLength);
+	MxSmkTree* trees = p_mxSmk->m_trees;
+	MxU32 i;
 
-	while (GetRect(p_mxSmk->m_unk0x6b4, &und, smackRect, &rect)) {
-		MxRect32* newRect = new MxRect32(rect);
-		p_list->Append(newRect);
+	for (i = 0; i < MxSmkTree::e_numTrees; i++) {
+		trees[i].m_nodes[trees[i].m_recent[0]] = 0;
+		trees[i].m_nodes[trees[i].m_recent[1]] = 0;
+		trees[i].m_nodes[trees[i].m_recent[2]] = 0;
 	}
 
-	return SUCCESS;
-}
+	MxU32 stride = (p_bitmapInfo->m_bmiHeader.biWidth + 3) & -4;
+	MxU32 blocksWide = p_mxSmk->m_smackTag.Width / 4;
+	MxU32 blocks = blocksWide * (p_mxSmk->m_smackTag.Height / 4);
+	MxU32 block = 0;
+	MxRect32* rects = p_mxSmk->m_rects;
 
-// FUNCTION: LEGO1 0x100c6050
-// FUNCTION: BETA10 0x10152739
-MxBool MxSmk::GetRect(MxU8* p_unk0x6b4, MxU16* p_und, u32* p_smackRect, MxRect32* p_rect)
-{
-	u32 left, bottom, top, right;
+	while (block < blocks) {
+		MxU32 type = DecodeValue(reader, &trees[MxSmkTree::e_type]);
+		MxU32 run = g_blockRuns[(type >> 2) & 0x3f];
 
-	if (!*p_und) {
-		return FALSE;
-	}
+		if (run > blocks - block) {
+			run = blocks - block;
+		}
 
-	if (*p_und == 1) {
-		if (!SmackGetRect(p_unk0x6b4, p_smackRect)) {
-			return FALSE;
+		if ((type & 3) == e_skip) {
+			block += run;
+			continue;
 		}
-		*p_und = 2;
-	}
 
-	left = p_smackRect[0];
-	top = p_smackRect[1];
-	right = p_smackRect[2] + p_smackRect[0];
-	bottom = p_smackRect[3] + p_smackRect[1];
+		// Extend the current band of dirty rows, or start a new one
+		MxU32 row = block / blocksWide;
+		MxU32 column = block % blocksWide;
+		MxU32 lastRow = (block + run - 1) / blocksWide;
+		MxS32 left = column * 4;
+		MxS32 right = lastRow == row ? (column + run) * 4 - 1 : blocksWide * 4 - 1;
 
-	while (SmackGetRect(p_unk0x6b4, p_smackRect)) {
-		if (left > p_smackRect[0]) {
-			left = p_smackRect[0];
+		if (lastRow != row) {
+			left = 0;
 		}
-		if (right < p_smackRect[0] + p_smackRect[2]) {
-			right = p_smackRect[0] + p_smackRect[2];
+
+		if (p_numRects && (MxS32) row * 4 <= rects[p_numRects - 1].GetBottom() + 1) {
+			MxRect32& rect = rects[p_numRects - 1];
+
+			if (left < rect.GetLeft()) {
+				rect.SetLeft(left);
+			}
+			if (right > rect.GetRight()) {
+				rect.SetRight(right);
+			}
+
+			rect.SetBottom(lastRow * 4 + 3);
+		}
+		else {
+			rects[p_numRects++] = MxRect32(left, row * 4, right, lastRow * 4 + 3);
 		}
 
-		bottom = p_smackRect[1] + p_smackRect[3];
+		// All blocks of a run are written one row of four pixels at a time
+		MxU8* out = p_bitmapData + row * 4 * stride + column * 4;
+		MxU32 end = block + run;
+
+		switch (type & 3) {
+		case e_mono:
+			for (; block < end; block++) {
+				MxU32 colors = DecodeValue(reader, &trees[MxSmkTree::e_monoColors]);
+				MxU32 map = DecodeValue(reader, &trees[MxSmkTree::e_monoMap]);
+				MxU32 low = (colors & 0xff) * 0x01010101;
+				MxU32 high = (colors >> 8) * 0x01010101;
+
+				for (i = 0; i < 4; i++) {
+					*(MxU32*) (out + i * stride) = low ^ ((low ^ high) & g_monoMasks[map & 0xf]);
+					map >>= 4;
+				}
+
+				NextBlock(out, column, blocksWide, stride);
+			}
+			break;
+		case e_full:
+			for (; block < end; block++) {
+				for (i = 0; i < 4; i++) {
+					// The first value holds the two pixels on the right
+					MxU32 pixels23 = DecodeValue(reader, &trees[MxSmkTree::e_full]);
+					MxU32 pixels01 = DecodeValue(reader, &trees[MxSmkTree::e_full]);
+					*(MxU32*) (out + i * stride) = pixels01 | (pixels23 << 16);
+				}
+
+				NextBlock(out, column, blocksWide, stride);
+			}
+			break;
+		case e_fill: {
+			MxU32 color = (type >> 8) * 0x01010101;
+
+			for (; block < end; block++) {
+				*(MxU32*) out = color;
+				*(MxU32*) (out + stride) = color;
+				*(MxU32*) (out + stride * 2) = color;
+				*(MxU32*) (out + stride * 3) = color;
+				NextBlock(out, column, blocksWide, stride);
+			}
+			break;
+		}
+		}
 	}
 
-	*p_und = 0;
-	*p_rect = MxRect32(left, top, right, bottom);
-	return TRUE;
+	return SUCCESS;
 }
@@ -72,19 +72,17 @@ void MxSmkPresenter::LoadFrame(MxStreamChunk* p_chunk)
 	m_currentFrame++;
 	VTable0x88();
 
-	MxRect32List rects(TRUE);
-	MxSmk::LoadFrame(bitmapInfo, bitmapData, &m_mxSmk, chunkData, paletteChanged, &rects);
+	MxU32 numRects;
+	MxSmk::LoadFrame(bitmapInfo, bitmapData, &m_mxSmk, chunkData, p_chunk->GetLength(), paletteChanged, numRects);
 
 	if (((MxDSMediaAction*) m_action)->GetPaletteManagement() && paletteChanged) {
 		RealizePalette();
 	}
 
 	MxRect32 invalidateRect;
-	MxRect32ListCursor cursor(&rects);
-	MxRect32* rect;
 
-	while (cursor.Next(rect)) {
-		invalidateRect = *rect;
+	for (MxU32 i = 0; i < numRects; i++) {
+		invalidateRect = m_mxSmk.m_rects[i];
 		invalidateRect += GetLocation();
 		MVideoManager()->InvalidateRect(invalidateRect);
 	}
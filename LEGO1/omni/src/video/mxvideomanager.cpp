@@ -38,6 +38,7 @@ MxResult MxVideoManager::Init()
 	m_region = NULL;
 	m_videoParam.SetPalette(NULL);
 	m_unk0x60 = FALSE;
+	m_sortPresenters = TRUE;
 	return SUCCESS;
 }
 
@@ -87,12 +88,24 @@ void MxVideoManager::Destroy(MxBool p_fromDestructor)
 // FUNCTION: BETA10 0x1012cdaa
 void MxVideoManager::UpdateRegion()
 {
+	// Headless there is nobody to show the back buffer to
+	if (MxOmni::IsHeadless()) {
+		return;
+	}
+
 	if (m_region->IsEmpty() == FALSE) {
-		MxRect32 rect(m_region->GetBoundingRect());
-		rect &= m_videoParam.GetRect();
+		MxRegionCursor cursor(m_region);
+		MxRect32* regionRect;
+
+		while ((regionRect = cursor.Next())) {
+			MxRect32 rect(*regionRect);
+			rect &= m_videoParam.GetRect();
 
-		m_displaySurface
-			->Display(rect.GetLeft(), rect.GetTop(), rect.GetLeft(), rect.GetTop(), rect.GetWidth(), rect.GetHeight());
+			if (rect.GetWidth() >= 1 && rect.GetHeight() >= 1) {
+				m_displaySurface
+					->Display(rect.GetLeft(), rect.GetTop(), rect.GetLeft(), rect.GetTop(), rect.GetWidth(), rect.GetHeight());
+			}
+		}
 	}
 }
 
@@ -100,6 +113,14 @@ void MxVideoManager::UpdateRegion()
 // FUNCTION: BETA10 0x1012ce5e
 void MxVideoManager::SortPresenterList()
 {
+	if (!m_sortPresenters && !MxPresenter::DisplayZChanged()) {
+		return;
+	}
+
+	// Clear the flags first, so a change made while sorting is picked up next time
+	m_sortPresenters = FALSE;
+	MxPresenter::ClearDisplayZChanged();
+
 	if (m_presenters->GetNumElements() <= 1) {
 		return;
 	}
@@ -297,6 +318,14 @@ void MxVideoManager::Destroy()
 	Destroy(FALSE);
 }
 
+void MxVideoManager::RegisterPresenter(MxPresenter& p_presenter)
+{
+	AUTOLOCK(m_criticalSection);
+
+	MxMediaManager::RegisterPresenter(p_presenter);
+	m_sortPresenters = TRUE;
+}
+
 // FUNCTION: LEGO1 0x100bea60
 void MxVideoManager::InvalidateRect(MxRect32& p_rect)
 {
@@ -125,8 +125,10 @@ void OrientableROI::SetLocalTransform(const Matrix4& p_transform)
 // FUNCTION: LEGO1 0x100a5960
 void OrientableROI::VTable0x24(const Matrix4& p_transform)
 {
-	MxMatrix l_matrix(m_local2world);
-	m_local2world.Product(p_transform, l_matrix);
+	// Multiply through the non-virtual row accessors; a copy is needed since MXM4 must not alias its source
+	float l_matrix[4][4];
+	SETMAT4(l_matrix, m_local2world);
+	MXM4(m_local2world, p_transform, l_matrix);
 	UpdateWorldBoundingVolumes();
 	UpdateWorldVelocity();
 }
@@ -134,8 +136,9 @@ void OrientableROI::VTable0x24(const Matrix4& p_transform)
 // FUNCTION: LEGO1 0x100a59b0
 void OrientableROI::UpdateWorldData(const Matrix4& p_transform)
 {
-	MxMatrix l_matrix(m_local2world);
-	m_local2world.Product(l_matrix, p_transform);
+	float l_matrix[4][4];
+	SETMAT4(l_matrix, m_local2world);
+	MXM4(m_local2world, l_matrix, p_transform);
 	UpdateWorldBoundingVolumes();
 	UpdateWorldVelocity();
 
@@ -0,0 +1,23 @@
+#include "impl.h"
+
+using namespace TglSoft;
+
+FrameData::FrameData()
+{
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			m_transformation[i][j] = i == j ? 1.0f : 0.0f;
+		}
+	}
+}
+
+void* CameraImpl::ImplementationDataPtr()
+{
+	return reinterpret_cast<void*>(&m_data);
+}
+
+Result CameraImpl::SetTransformation(FloatMatrix4& matrix)
+{
+	memcpy(m_data->m_transformation, matrix, sizeof(FloatMatrix4));
+	return Success;
+}
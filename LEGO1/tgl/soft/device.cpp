@@ -0,0 +1,335 @@
+#include "impl.h"
+
+#include <assert.h>
+
+using namespace TglSoft;
+
+DeviceData::DeviceData(unsigned long p_width, unsigned long p_height)
+{
+	m_width = p_width;
+	m_height = p_height;
+	m_color = new unsigned long[p_width * p_height];
+	m_depth = new float[p_width * p_height];
+	m_surface = NULL;
+	m_paletteSurface = NULL;
+	m_hWnd = NULL;
+	m_inversePalette = NULL;
+	memset(m_paletteColors, 0, sizeof(m_paletteColors));
+
+	if (m_color) {
+		memset(m_color, 0, p_width * p_height * sizeof(*m_color));
+	}
+
+	if (m_depth) {
+		for (unsigned long i = 0; i < p_width * p_height; i++) {
+			m_depth[i] = 1.0f;
+		}
+	}
+}
+
+DeviceData::~DeviceData()
+{
+#ifdef _WIN32
+	if (m_surface) {
+		m_surface->Release();
+	}
+
+	if (m_paletteSurface) {
+		m_paletteSurface->Release();
+	}
+#endif
+
+	delete[] m_color;
+	delete[] m_depth;
+	delete[] m_inversePalette;
+}
+
+void TglSoft::BuildInversePalette(const unsigned long* pColors, int count, unsigned char* pTable)
+{
+	for (int color = 0; color < 0x8000; color++) {
+		// Centers of the 5-bit ranges
+		int r = ((color >> 10) << 3) + 4;
+		int g = (((color >> 5) & 0x1f) << 3) + 4;
+		int b = ((color & 0x1f) << 3) + 4;
+		int best = 0;
+		int bestDistance = 0x7fffffff;
+
+		for (int i = 0; i < count; i++) {
+			int dr = (int) ((pColors[i] >> 16) & 0xff) - r;
+			int dg = (int) ((pColors[i] >> 8) & 0xff) - g;
+			int db = (int) (pColors[i] & 0xff) - b;
+			int distance = dr * dr + dg * dg + db * db;
+
+			if (distance < bestDistance) {
+				best = i;
+				bestDistance = distance;
+			}
+		}
+
+		pTable[color] = (unsigned char) best;
+	}
+}
+
+void* DeviceImpl::ImplementationDataPtr()
+{
+	return reinterpret_cast<void*>(&m_data);
+}
+
+unsigned long DeviceImpl::GetWidth()
+{
+	return m_data->m_width;
+}
+
+unsigned long DeviceImpl::GetHeight()
+{
+	return m_data->m_height;
+}
+
+Result DeviceImpl::SetColorModel(ColorModel)
+{
+	return Success;
+}
+
+Result DeviceImpl::SetShadingModel(ShadingModel)
+{
+	// Each mesh is rendered with its own shading model
+	return Success;
+}
+
+Result DeviceImpl::SetShadeCount(unsigned long)
+{
+	return Success;
+}
+
+Result DeviceImpl::SetDither(int)
+{
+	return Success;
+}
+
+#ifdef _WIN32
+
+// Shifts that move the top bits of an 8-bit channel into a color mask
+struct ChannelShift {
+	ChannelShift(DWORD p_mask)
+	{
+		int bits = 0;
+
+		for (m_left = 0; p_mask && !(p_mask & 1); p_mask >>= 1) {
+			m_left++;
+		}
+
+		for (; p_mask & 1; p_mask >>= 1) {
+			bits++;
+		}
+
+		m_right = 0;
+
+		if (bits < 8) {
+			m_right = 8 - bits;
+		}
+		else {
+			m_left += bits - 8;
+		}
+	}
+
+	DWORD Apply(unsigned long p_channel) const { return (p_channel >> m_right) << m_left; }
+
+	int m_right;
+	int m_left;
+};
+
+// Rebuilds the device's inverse palette if the palette of an 8-bit surface changed
+inline Result UpdateInversePalette(DeviceData* pDevice, IDirectDrawSurface* pSurface)
+{
+	IDirectDrawPalette* pPalette = NULL;
+	PALETTEENTRY entries[256];
+	unsigned long colors[256];
+	HRESULT result;
+
+	// The palette of a flipping chain is attached to its front buffer
+	if (pSurface->GetPalette(&pPalette) != DD_OK &&
+		(!pDevice->m_paletteSurface || pDevice->m_paletteSurface->GetPalette(&pPalette) != DD_OK)) {
+		return Error;
+	}
+
+	result = pPalette->GetEntries(0, 0, 256, entries);
+	pPalette->Release();
+
+	if (result != DD_OK) {
+		return Error;
+	}
+
+	for (int i = 0; i < 256; i++) {
+		colors[i] = ((unsigned long) entries[i].peRed << 16) | ((unsigned long) entries[i].peGreen << 8) |
+					(unsigned long) entries[i].peBlue;
+	}
+
+	if (pDevice->m_inversePalette && !memcmp(colors, pDevice->m_paletteColors, sizeof(colors))) {
+		return Success;
+	}
+
+	if (!pDevice->m_inversePalette) {
+		pDevice->m_inversePalette = new unsigned char[0x8000];
+	}
+
+	memcpy(pDevice->m_paletteColors, colors, sizeof(colors));
+	BuildInversePalette(colors, 256, pDevice->m_inversePalette);
+	return Success;
+}
+
+inline Result CopyToSurface(DeviceData* pDevice, IDirectDrawSurface* pSurface)
+{
+	DDPIXELFORMAT format;
+	DDSURFACEDESC desc;
+	HRESULT result;
+
+	memset(&format, 0, sizeof(format));
+	format.dwSize = sizeof(format);
+
+	if (pSurface->GetPixelFormat(&format) == DD_OK && (format.dwFlags & DDPF_PALETTEINDEXED8)) {
+		if (!UpdateInversePalette(pDevice, pSurface)) {
+			return Error;
+		}
+	}
+
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+
+	result = pSurface->Lock(NULL, &desc, DDLOCK_WAIT, NULL);
+
+	if (result == DDERR_SURFACELOST) {
+		pSurface->Restore();
+		result = pSurface->Lock(NULL, &desc, DDLOCK_WAIT, NULL);
+	}
+
+	if (result != DD_OK) {
+		return Error;
+	}
+
+	int bytesPerPixel = desc.ddpfPixelFormat.dwRGBBitCount / 8;
+	unsigned long width = pDevice->m_width < desc.dwWidth ? pDevice->m_width : desc.dwWidth;
+	unsigned long height = pDevice->m_height < desc.dwHeight ? pDevice->m_height : desc.dwHeight;
+
+	if (bytesPerPixel == 1 && pDevice->m_inversePalette) {
+		const unsigned char* inverse = pDevice->m_inversePalette;
+
+		for (unsigned long y = 0; y < height; y++) {
+			const unsigned long* source = pDevice->m_color + y * pDevice->m_width;
+			unsigned char* target = (unsigned char*) desc.lpSurface + y * desc.lPitch;
+
+			for (unsigned long x = 0; x < width; x++) {
+				unsigned long color = source[x];
+				target[x] = inverse[((color >> 9) & 0x7c00) | ((color >> 6) & 0x3e0) | ((color >> 3) & 0x1f)];
+			}
+		}
+
+		pSurface->Unlock(desc.lpSurface);
+		return Success;
+	}
+
+	if (bytesPerPixel < 2) {
+		// Palettized surfaces with fewer than 256 colors are not supported
+		pSurface->Unlock(desc.lpSurface);
+		return Error;
+	}
+
+	ChannelShift red(desc.ddpfPixelFormat.dwRBitMask);
+	ChannelShift green(desc.ddpfPixelFormat.dwGBitMask);
+	ChannelShift blue(desc.ddpfPixelFormat.dwBBitMask);
+
+	for (unsigned long y = 0; y < height; y++) {
+		const unsigned long* source = pDevice->m_color + y * pDevice->m_width;
+		unsigned char* target = (unsigned char*) desc.lpSurface + y * desc.lPitch;
+
+		for (unsigned long x = 0; x < width; x++, target += bytesPerPixel) {
+			unsigned long color = source[x];
+			DWORD pixel =
+				red.Apply((color >> 16) & 0xff) | green.Apply((color >> 8) & 0xff) | blue.Apply(color & 0xff);
+
+			switch (bytesPerPixel) {
+			case 2:
+				*(WORD*) target = (WORD) pixel;
+				break;
+			case 3:
+				target[0] = (unsigned char) pixel;
+				target[1] = (unsigned char) (pixel >> 8);
+				target[2] = (unsigned char) (pixel >> 16);
+				break;
+			default:
+				*(DWORD*) target = pixel;
+				break;
+			}
+		}
+	}
+
+	pSurface->Unlock(desc.lpSurface);
+	return Success;
+}
+
+Result DeviceImpl::Update()
+{
+	if (m_data->m_surface) {
+		return CopyToSurface(m_data, m_data->m_surface);
+	}
+
+	if (m_data->m_hWnd) {
+		HDC hdc = GetDC(m_data->m_hWnd);
+
+		if (hdc) {
+			HandlePaint(hdc);
+			ReleaseDC(m_data->m_hWnd, hdc);
+		}
+	}
+
+	return Success;
+}
+
+void DeviceImpl::HandleActivate(WORD)
+{
+}
+
+void DeviceImpl::HandlePaint(HDC hdc)
+{
+	BITMAPINFO info;
+
+	memset(&info, 0, sizeof(info));
+	info.bmiHeader.biSize = sizeof(info.bmiHeader);
+	info.bmiHeader.biWidth = m_data->m_width;
+	info.bmiHeader.biHeight = -(LONG) m_data->m_height; // Top-down
+	info.bmiHeader.biPlanes = 1;
+	info.bmiHeader.biBitCount = 32;
+	info.bmiHeader.biCompression = BI_RGB;
+
+	SetDIBitsToDevice(
+		hdc,
+		0,
+		0,
+		m_data->m_width,
+		m_data->m_height,
+		0,
+		0,
+		0,
+		m_data->m_height,
+		m_data->m_color,
+		&info,
+		DIB_RGB_COLORS
+	);
+}
+
+#else
+
+Result DeviceImpl::Update()
+{
+	// Without DirectDraw and GDI there is nothing to present to, the color buffer is the output
+	return Success;
+}
+
+void DeviceImpl::HandleActivate(WORD)
+{
+}
+
+void DeviceImpl::HandlePaint(HDC)
+{
+}
+
+#endif
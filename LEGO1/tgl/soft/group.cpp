@@ -0,0 +1,134 @@
+#include "impl.h"
+
+#include <assert.h>
+
+using namespace TglSoft;
+
+GroupData::GroupData()
+{
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			m_transformation[i][j] = i == j ? 1.0f : 0.0f;
+		}
+	}
+
+	StoreColor(m_color, 1.0f, 1.0f, 1.0f, 0.0f);
+	m_texture = NULL;
+	m_materialMode = FromMesh;
+}
+
+GroupData::~GroupData()
+{
+	SetReference(m_texture, (TextureData*) NULL);
+}
+
+void* GroupImpl::ImplementationDataPtr()
+{
+	return reinterpret_cast<void*>(&m_data);
+}
+
+Result GroupImpl::SetTransformation(FloatMatrix4& matrix)
+{
+	memcpy(m_data->m_transformation, matrix, sizeof(FloatMatrix4));
+	return Success;
+}
+
+Result GroupImpl::SetColor(float r, float g, float b, float a)
+{
+	StoreColor(m_data->m_color, r, g, b, a);
+	return Success;
+}
+
+Result GroupImpl::SetTexture(const Texture* pTexture)
+{
+	TextureData* pData = pTexture ? static_cast<const TextureImpl*>(pTexture)->ImplementationData() : NULL;
+	SetReference(m_data->m_texture, pData);
+	return Success;
+}
+
+Result GroupImpl::GetTexture(Texture*& pTexture)
+{
+	TextureData* pData = NULL;
+	SetReference(pData, m_data->m_texture);
+	pTexture = new TextureImpl(pData);
+	return Success;
+}
+
+Result GroupImpl::SetMaterialMode(MaterialMode mode)
+{
+	m_data->m_materialMode = mode;
+	return Success;
+}
+
+Result GroupImpl::Add(const Group* pGroup)
+{
+	const GroupImpl* pGroupImpl = static_cast<const GroupImpl*>(pGroup);
+	m_data->m_groups.Add(pGroupImpl->ImplementationData());
+	return Success;
+}
+
+Result GroupImpl::Add(const MeshBuilder* pMeshBuilder)
+{
+	const MeshBuilderImpl* pMeshBuilderImpl = static_cast<const MeshBuilderImpl*>(pMeshBuilder);
+	m_data->m_meshBuilders.Add(pMeshBuilderImpl->ImplementationData());
+	return Success;
+}
+
+Result GroupImpl::Remove(const Group* pGroup)
+{
+	const GroupImpl* pGroupImpl = static_cast<const GroupImpl*>(pGroup);
+	return m_data->m_groups.Remove(pGroupImpl->ImplementationData());
+}
+
+Result GroupImpl::Remove(const MeshBuilder* pMeshBuilder)
+{
+	const MeshBuilderImpl* pMeshBuilderImpl = static_cast<const MeshBuilderImpl*>(pMeshBuilder);
+	return m_data->m_meshBuilders.Remove(pMeshBuilderImpl->ImplementationData());
+}
+
+Result GroupImpl::RemoveAll()
+{
+	m_data->m_groups.RemoveAll();
+	m_data->m_meshBuilders.RemoveAll();
+	return Success;
+}
+
+// Like the Direct3D RM implementation, only the meshes directly in this group count, in their own coordinates
+Result GroupImpl::Bounds(D3DVECTOR* p_min, D3DVECTOR* p_max)
+{
+	p_min->x = p_min->y = p_min->z = 88888.f;
+	p_max->x = p_max->y = p_max->z = -88888.f;
+
+	for (int i = 0; i < m_data->m_meshBuilders.Size(); i++) {
+		const MeshBuilderData* pBuilder = m_data->m_meshBuilders[i];
+
+		for (int j = 0; j < pBuilder->m_groupCount; j++) {
+			const GeometryData* pGeometry = pBuilder->m_groups[j].m_geometry;
+
+			if (pGeometry->m_vertexCount == 0) {
+				continue;
+			}
+
+			if (pGeometry->m_min[0] < p_min->x) {
+				p_min->x = pGeometry->m_min[0];
+			}
+			if (pGeometry->m_min[1] < p_min->y) {
+				p_min->y = pGeometry->m_min[1];
+			}
+			if (pGeometry->m_min[2] < p_min->z) {
+				p_min->z = pGeometry->m_min[2];
+			}
+			if (p_max->x < pGeometry->m_max[0]) {
+				p_max->x = pGeometry->m_max[0];
+			}
+			if (p_max->y < pGeometry->m_max[1]) {
+				p_max->y = pGeometry->m_max[1];
+			}
+			if (p_max->z < pGeometry->m_max[2]) {
+				p_max->z = pGeometry->m_max[2];
+			}
+		}
+	}
+
+	return Success;
+}
@@ -0,0 +1,621 @@
+#ifndef _tglSoftImpl_h
+#define _tglSoftImpl_h
+
+#include "compat.h"
+#include "decomp.h"
+#include "rasterizer.h"
+#include "tgl/tgl.h"
+
+#include <string.h>
+
+/**
+ * @brief [AI] Software implementation of the Tgl interfaces, the counterpart of TglImpl without Direct3D.
+ * @details [AI] The scene objects mirror the Direct3D Retained Mode objects that TglImpl wraps: each Impl class holds
+ * a reference to a reference-counted data object, and groups, views and mesh builders hold references to the data
+ * they contain, so that deleting a Tgl object that is still part of a scene is safe.
+ *
+ * Coordinates follow Direct3D Retained Mode: left-handed, row vectors, the camera looking along its +z axis and
+ * lights shining along theirs. The camera and the lights of a view are placed relative to the group it renders.
+ * A view projects the scene with its frustum, lights it per face (Flat) or per vertex (Gouraud), clips it, and hands
+ * the triangles to a Rasterizer, which renders them on all cores into the device's 32-bit color and float depth
+ * buffers. DeviceImpl::Update copies the color buffer to the DirectDraw surface the device was created for, mapping
+ * it to the surface's palette if it has 8 bits per pixel. Without Windows only the memory devices exist.
+ */
+namespace TglSoft
+{
+
+using namespace Tgl;
+
+class RendererImpl;
+class DeviceImpl;
+class ViewImpl;
+class LightImpl;
+class CameraImpl;
+class GroupImpl;
+class MeshImpl;
+class TextureImpl;
+class MeshBuilderImpl;
+
+/**
+ * @brief [AI] Base of the shared data objects; starts with one reference owned by the creator. [AI]
+ */
+class RefCounted {
+public:
+	RefCounted() : m_refCount(1) {}
+	virtual ~RefCounted() {}
+
+	void AddRef() { m_refCount++; }
+
+	void Release()
+	{
+		if (--m_refCount == 0) {
+			delete this;
+		}
+	}
+
+private:
+	int m_refCount;
+};
+
+/**
+ * @brief [AI] Growable array of references to T, a RefCounted. [AI]
+ */
+template <class T>
+class RefArray {
+public:
+	RefArray() : m_items(NULL), m_count(0), m_capacity(0) {}
+	~RefArray()
+	{
+		RemoveAll();
+		delete[] m_items;
+	}
+
+	int Size() const { return m_count; }
+	T* operator[](int p_index) const { return m_items[p_index]; }
+
+	void Add(T* p_item)
+	{
+		if (m_count == m_capacity) {
+			int capacity = m_capacity ? m_capacity * 2 : 4;
+			T** items = new T*[capacity];
+
+			for (int i = 0; i < m_count; i++) {
+				items[i] = m_items[i];
+			}
+
+			delete[] m_items;
+			m_items = items;
+			m_capacity = capacity;
+		}
+
+		p_item->AddRef();
+		m_items[m_count++] = p_item;
+	}
+
+	Result Remove(T* p_item)
+	{
+		for (int i = 0; i < m_count; i++) {
+			if (m_items[i] == p_item) {
+				for (m_count--; i < m_count; i++) {
+					m_items[i] = m_items[i + 1];
+				}
+
+				p_item->Release();
+				return Success;
+			}
+		}
+
+		return Error;
+	}
+
+	void RemoveAll()
+	{
+		while (m_count) {
+			m_items[--m_count]->Release();
+		}
+	}
+
+private:
+	T** m_items;
+	int m_count;
+	int m_capacity;
+};
+
+/**
+ * @brief [AI] A view's rectangle on its device, in pixels; right and bottom are exclusive like a RECT's. [AI]
+ */
+struct ViewportRect {
+	long left;
+	long top;
+	long right;
+	long bottom;
+};
+
+/**
+ * @brief [AI] Color buffer, depth buffer and presentation target of a DeviceImpl. [AI]
+ */
+struct DeviceData : public RefCounted {
+	DeviceData(unsigned long p_width, unsigned long p_height);
+	~DeviceData() override;
+
+	unsigned long m_width;
+	unsigned long m_height;
+	unsigned long* m_color;        ///< [AI] 0x00RRGGBB pixels, m_width per row.
+	float* m_depth;                ///< [AI] Depth per pixel; 1 is the back clipping plane.
+	IDirectDrawSurface* m_surface; ///< [AI] Surface Update copies to, or NULL.
+	IDirectDrawSurface* m_paletteSurface; ///< [AI] Front buffer, whose palette applies if m_surface has none.
+	HWND m_hWnd;                   ///< [AI] Window of the device, or NULL.
+	unsigned char* m_inversePalette; ///< [AI] For 8-bit surfaces: palette index per 5:5:5 color, or NULL.
+	unsigned long m_paletteColors[256]; ///< [AI] Palette m_inversePalette was built for, as 0x00RRGGBB.
+};
+
+/**
+ * @brief [AI] 8-bit paletted image of a TextureImpl and its RasterTexture view. [AI]
+ */
+struct TextureData : public RefCounted {
+	TextureData();
+	~TextureData() override;
+
+	Result SetTexels(int p_width, int p_height, int p_depth, void* p_texels, int p_useBuffer);
+	void SetPalette(int p_entryCount, const PaletteEntry* p_entries);
+
+	int m_width;
+	int m_height;
+	int m_depth;
+	unsigned char* m_texels;
+	int m_texelsAllocatedByClient;
+	int m_paletteSize;
+	PaletteEntry m_palette[256];
+	unsigned long m_colors[256];
+	RasterTexture m_raster; ///< [AI] Valid if m_texels is not NULL.
+};
+
+/**
+ * @brief [AI] One vertex of a mesh, as built by MeshBuilderImpl::CreateMesh. [AI]
+ */
+struct Vertex {
+	float m_position[3];
+	float m_normal[3];
+	float m_tu;
+	float m_tv;
+};
+
+/**
+ * @brief [AI] Immutable vertices and triangles of a mesh, shared by its clones. [AI]
+ */
+struct GeometryData : public RefCounted {
+	GeometryData() : m_vertices(NULL), m_vertexCount(0), m_faces(NULL), m_faceCount(0) {}
+	~GeometryData() override
+	{
+		delete[] m_vertices;
+		delete[] m_faces;
+	}
+
+	Vertex* m_vertices;
+	unsigned long m_vertexCount;
+	unsigned long (*m_faces)[3];
+	unsigned long m_faceCount;
+	float m_min[3]; ///< [AI] Bounding box.
+	float m_max[3];
+};
+
+/**
+ * @brief [AI] A mesh and its material inside a MeshBuilderData, like a group of a Direct3D RM mesh. [AI]
+ */
+struct MeshGroup {
+	GeometryData* m_geometry;
+	float m_color[4];
+	TextureData* m_texture;
+	ShadingModel m_shadingModel;
+	TextureMappingMode m_mappingMode;
+};
+
+/**
+ * @brief [AI] The meshes of a MeshBuilderImpl; MeshImpl objects refer to them by index. [AI]
+ */
+struct MeshBuilderData : public RefCounted {
+	MeshBuilderData() : m_groups(NULL), m_groupCount(0), m_capacity(0) {}
+	~MeshBuilderData() override;
+
+	int AddGroup(const MeshGroup& p_group);
+
+	MeshGroup* m_groups;
+	int m_groupCount;
+	int m_capacity;
+};
+
+/**
+ * @brief [AI] Transformation of a camera or light. [AI]
+ */
+struct FrameData : public RefCounted {
+	FrameData();
+
+	FloatMatrix4 m_transformation;
+};
+
+/**
+ * @brief [AI] A light: its frame plus type and color. [AI]
+ */
+struct LightData : public FrameData {
+	LightType m_type;
+	float m_color[3];
+};
+
+/**
+ * @brief [AI] A scene graph node, like a Direct3D RM frame. [AI]
+ */
+struct GroupData : public RefCounted {
+	GroupData();
+	~GroupData() override;
+
+	FloatMatrix4 m_transformation; ///< [AI] Relative to the parent.
+	float m_color[4];
+	TextureData* m_texture;
+	MaterialMode m_materialMode;
+	RefArray<GroupData> m_groups;
+	RefArray<MeshBuilderData> m_meshBuilders;
+};
+
+/**
+ * @brief [AI] Implements Tgl::Renderer; a factory for the other TglSoft objects. [AI]
+ */
+class RendererImpl : public Renderer {
+public:
+	RendererImpl() : m_threadCount(0) {}
+
+	void* ImplementationDataPtr() override;
+
+	Device* CreateDevice(const DeviceDirectDrawCreateData&) override;
+	Device* CreateDevice(const DeviceDirect3DCreateData&) override;
+	View* CreateView(
+		const Device*,
+		const Camera*,
+		unsigned long x,
+		unsigned long y,
+		unsigned long width,
+		unsigned long height
+	) override;
+	Camera* CreateCamera() override;
+	Light* CreateLight(LightType, float r, float g, float b) override;
+	Group* CreateGroup(const Group* pParent) override;
+	MeshBuilder* CreateMeshBuilder() override;
+	Texture* CreateTexture(
+		int width,
+		int height,
+		int bitsPerTexel,
+		const void* pTexels,
+		int pTexelsArePersistent,
+		int paletteEntryCount,
+		const PaletteEntry* pEntries
+	) override;
+	Texture* CreateTexture() override;
+	Result SetTextureDefaultShadeCount(unsigned long) override;
+	Result SetTextureDefaultColorCount(unsigned long) override;
+
+	/**
+	 * @brief [AI] Creates a device that only renders to memory, e.g. for benchmarks. [AI]
+	 */
+	Device* CreateDevice(unsigned long width, unsigned long height);
+
+	/**
+	 * @brief [AI] Sets the number of threads views created afterwards render with; 0, the default, uses one per
+	 * processor. [AI]
+	 */
+	void SetThreadCount(int threadCount) { m_threadCount = threadCount; }
+
+private:
+	int m_threadCount;
+};
+
+/**
+ * @brief [AI] Implements Tgl::Device over a DeviceData. [AI]
+ */
+class DeviceImpl : public Device {
+public:
+	DeviceImpl(DeviceData* pData) : m_data(pData) {}
+	~DeviceImpl() override { m_data->Release(); }
+
+	void* ImplementationDataPtr() override;
+
+	unsigned long GetWidth() override;
+	unsigned long GetHeight() override;
+	Result SetColorModel(ColorModel) override;
+	Result SetShadingModel(ShadingModel) override;
+	Result SetShadeCount(unsigned long) override;
+	Result SetDither(int) override;
+	Result Update() override;
+	void HandleActivate(WORD) override;
+	void HandlePaint(HDC) override;
+
+	/**
+	 * @brief [AI] Returns the 0x00RRGGBB color buffer, GetWidth pixels per row. [AI]
+	 */
+	const unsigned long* GetColorBuffer() const { return m_data->m_color; }
+
+	DeviceData* ImplementationData() const { return m_data; }
+
+private:
+	DeviceData* m_data;
+};
+
+/**
+ * @brief [AI] Implements Tgl::View: a viewport of a device, its camera, lights and projection. [AI]
+ */
+class ViewImpl : public View {
+public:
+	ViewImpl();
+	~ViewImpl() override;
+
+	Result Create(DeviceData* pDevice, FrameData* pCamera, const ViewportRect& rViewport, int threadCount);
+
+	void* ImplementationDataPtr() override;
+
+	Result Add(const Light*) override;
+	Result Remove(const Light*) override;
+	Result SetCamera(const Camera*) override;
+	Result SetProjection(ProjectionType) override;
+	Result SetFrustrum(float frontClippingDistance, float backClippingDistance, float degrees) override;
+	Result SetBackgroundColor(float r, float g, float b) override;
+	Result GetBackgroundColor(float* r, float* g, float* b) override;
+	Result Clear() override;
+	Result Render(const Group*) override;
+	Result ForceUpdate(unsigned long x, unsigned long y, unsigned long width, unsigned long height) override;
+	Result TransformWorldToScreen(const float world[3], float screen[4]) override;
+	Result TransformScreenToWorld(const float screen[4], float world[3]) override;
+	Result Pick(
+		unsigned long x,
+		unsigned long y,
+		const Group** ppGroupsToPickFrom,
+		int groupsToPickFromCount,
+		const Group**& rppPickedGroups,
+		int& rPickedGroupCount
+	) override;
+
+	/**
+	 * @brief [AI] Returns the number of threads Render rasterizes with. [AI]
+	 */
+	int GetThreadCount() const { return m_rasterizer.GetThreadCount(); }
+
+private:
+	// Light of the scene being rendered, in camera coordinates
+	struct SceneLight {
+		LightType m_type;
+		float m_color[3];
+		float m_position[3];
+		float m_direction[3];
+	};
+
+	// Material inherited through the groups being rendered
+	struct Material {
+		const float* m_color;
+		TextureData* m_texture;
+	};
+
+	void UpdateProjection();
+	void UpdateCamera();
+	void RenderGroup(const GroupData* pGroup, const FloatMatrix4& rWorld, const Material* pMaterial);
+	void RenderMesh(const MeshGroup& rMesh, const FloatMatrix4& rWorld, const Material* pMaterial);
+	void DrawTriangle(const RasterVertex& rV0, const RasterVertex& rV1, const RasterVertex& rV2, const RasterState&);
+	void DrawClipped(const float* const pPositions[3], const RasterVertex* const pVertices[3], const RasterState&);
+	void Illuminate(const float normal[3], const float position[3], const float color[3], RasterVertex& rVertex) const;
+	void Project(const float camera[3], RasterVertex& rVertex) const;
+
+	DeviceData* m_device;
+	FrameData* m_camera;
+	RefArray<LightData> m_lights;
+	ViewportRect m_viewport;
+	ProjectionType m_projection;
+	float m_front;
+	float m_back;
+	float m_degrees;
+	float m_scale;           // Pixels per unit at distance 1 (perspective) or per unit (orthographic)
+	float m_background[3];
+	FloatMatrix4 m_worldToCamera;
+	FloatMatrix4 m_cameraToWorld;
+	SceneLight* m_sceneLights;
+	int m_sceneLightCount;
+	float m_ambient[3];
+	Rasterizer m_rasterizer;
+
+	FloatMatrix4 m_rootTransformation; // Frame the camera and lights are placed in, from the last Render
+
+	// Per-mesh vertex buffers, grown as needed
+	float (*m_cameraPositions)[3];
+	RasterVertex* m_rasterVertices;
+	int m_scratchSize;
+};
+
+/**
+ * @brief [AI] Implements Tgl::Camera over a FrameData. [AI]
+ */
+class CameraImpl : public Camera {
+public:
+	CameraImpl() : m_data(new FrameData) {}
+	~CameraImpl() override { m_data->Release(); }
+
+	void* ImplementationDataPtr() override;
+	Result SetTransformation(FloatMatrix4&) override;
+
+	FrameData* ImplementationData() const { return m_data; }
+
+private:
+	FrameData* m_data;
+};
+
+/**
+ * @brief [AI] Implements Tgl::Light over a LightData. [AI]
+ */
+class LightImpl : public Light {
+public:
+	LightImpl(LightType type, float r, float g, float b);
+	~LightImpl() override { m_data->Release(); }
+
+	void* ImplementationDataPtr() override;
+	Result SetTransformation(FloatMatrix4&) override;
+	Result SetColor(float r, float g, float b) override;
+
+	LightData* ImplementationData() const { return m_data; }
+
+private:
+	LightData* m_data;
+};
+
+/**
+ * @brief [AI] Implements Tgl::Group over a GroupData. [AI]
+ */
+class GroupImpl : public Group {
+public:
+	GroupImpl() : m_data(new GroupData) {}
+	~GroupImpl() override { m_data->Release(); }
+
+	void* ImplementationDataPtr() override;
+	Result SetTransformation(FloatMatrix4&) override;
+	Result SetColor(float r, float g, float b, float a) override;
+	Result SetTexture(const Texture*) override;
+	Result GetTexture(Texture*&) override;
+	Result SetMaterialMode(MaterialMode) override;
+	Result Add(const Group*) override;
+	Result Add(const MeshBuilder*) override;
+	Result Remove(const Group*) override;
+	Result Remove(const MeshBuilder*) override;
+	Result RemoveAll() override;
+	Result Bounds(D3DVECTOR*, D3DVECTOR*) override;
+
+	GroupData* ImplementationData() const { return m_data; }
+
+private:
+	GroupData* m_data;
+};
+
+/**
+ * @brief [AI] Implements Tgl::MeshBuilder over a MeshBuilderData. [AI]
+ */
+class MeshBuilderImpl : public MeshBuilder {
+public:
+	MeshBuilderImpl(MeshBuilderData* pData) : m_data(pData) {}
+	~MeshBuilderImpl() override { m_data->Release(); }
+
+	void* ImplementationDataPtr() override;
+	Mesh* CreateMesh(
+		unsigned long faceCount,
+		unsigned long vertexCount,
+		float (*pPositions)[3],
+		float (*pNormals)[3],
+		float (*pTextureCoordinates)[2],
+		unsigned long (*pFaceIndices)[3],
+		unsigned long (*pTextureIndices)[3],
+		ShadingModel shadingModel
+	) override;
+	Result GetBoundingBox(float min[3], float max[3]) const override;
+	MeshBuilder* Clone() override;
+
+	MeshBuilderData* ImplementationData() const { return m_data; }
+
+private:
+	MeshBuilderData* m_data;
+};
+
+/**
+ * @brief [AI] Implements Tgl::Mesh as a group index into a MeshBuilderData, like TglImpl::MeshImpl. [AI]
+ */
+class MeshImpl : public Mesh {
+public:
+	MeshImpl(MeshBuilderData* pBuilder, int index);
+	~MeshImpl() override { m_builder->Release(); }
+
+	void* ImplementationDataPtr() override;
+	Result SetColor(float r, float g, float b, float a) override;
+	Result SetTexture(const Texture*) override;
+	Result GetTexture(Texture*&) override;
+	Result SetTextureMappingMode(TextureMappingMode) override;
+	Result SetShadingModel(ShadingModel) override;
+	Mesh* DeepClone(MeshBuilder*) override;
+	Mesh* ShallowClone(MeshBuilder*) override;
+
+	MeshGroup& GetGroup() const { return m_builder->m_groups[m_index]; }
+
+private:
+	MeshBuilderData* m_builder;
+	int m_index;
+};
+
+/**
+ * @brief [AI] Implements Tgl::Texture over a TextureData. [AI]
+ */
+class TextureImpl : public Texture {
+public:
+	TextureImpl(TextureData* pData) : m_data(pData) {}
+	~TextureImpl() override
+	{
+		if (m_data) {
+			m_data->Release();
+		}
+	}
+
+	void* ImplementationDataPtr() override;
+	Result SetTexels(int width, int height, int bitsPerTexel, void* pTexels) override;
+	void FillRowsOfTexture(int y, int height, void* pBuffer) override;
+	Result Changed(int texelsChanged, int paletteChanged) override;
+	Result GetBufferAndPalette(
+		int* pWidth,
+		int* pHeight,
+		int* pDepth,
+		void** ppBuffer,
+		int* pPaletteSize,
+		PaletteEntry** ppPalette
+	) override;
+	Result SetPalette(int entryCount, PaletteEntry* pEntries) override;
+
+	TextureData* ImplementationData() const { return m_data; }
+
+private:
+	TextureData* m_data;
+};
+
+/**
+ * @brief [AI] Replaces the reference in rpData by one to pData, either of which may be NULL. [AI]
+ */
+template <class T>
+inline void SetReference(T*& rpData, T* pData)
+{
+	if (pData) {
+		pData->AddRef();
+	}
+
+	if (rpData) {
+		rpData->Release();
+	}
+
+	rpData = pData;
+}
+
+/**
+ * @brief [AI] Stores a Tgl color; like Direct3D RM, an alpha of zero or less means opaque. [AI]
+ */
+inline void StoreColor(float color[4], float r, float g, float b, float a)
+{
+	color[0] = r;
+	color[1] = g;
+	color[2] = b;
+	color[3] = a > 0.0f ? a : 1.0f;
+}
+
+/**
+ * @brief [AI] Sets rResult to rA * rB; rResult must not alias the operands. [AI]
+ */
+void Multiply(const FloatMatrix4& rA, const FloatMatrix4& rB, FloatMatrix4& rResult);
+
+/**
+ * @brief [AI] Fills pTable with the index of the nearest of the count colors (0x00RRGGBB) for every 5:5:5 color,
+ * red in the top bits; pTable has 0x8000 entries. [AI]
+ */
+void BuildInversePalette(const unsigned long* pColors, int count, unsigned char* pTable);
+
+/**
+ * @brief [AI] Transforms a point (p_w = 1) or direction (p_w = 0) by a row-vector matrix. [AI]
+ */
+void Transform(const float p[3], float w, const FloatMatrix4& rMatrix, float result[3]);
+
+} // namespace TglSoft
+
+#endif /* _tglSoftImpl_h */
@@ -0,0 +1,31 @@
+#include "impl.h"
+
+using namespace TglSoft;
+
+LightImpl::LightImpl(LightType type, float r, float g, float b)
+{
+	m_data = new LightData;
+	m_data->m_type = type;
+	m_data->m_color[0] = r;
+	m_data->m_color[1] = g;
+	m_data->m_color[2] = b;
+}
+
+void* LightImpl::ImplementationDataPtr()
+{
+	return reinterpret_cast<void*>(&m_data);
+}
+
+Result LightImpl::SetTransformation(FloatMatrix4& matrix)
+{
+	memcpy(m_data->m_transformation, matrix, sizeof(FloatMatrix4));
+	return Success;
+}
+
+Result LightImpl::SetColor(float r, float g, float b)
+{
+	m_data->m_color[0] = r;
+	m_data->m_color[1] = g;
+	m_data->m_color[2] = b;
+	return Success;
+}
@@ -0,0 +1,72 @@
+#include "impl.h"
+
+#include <assert.h>
+
+using namespace TglSoft;
+
+MeshImpl::MeshImpl(MeshBuilderData* pBuilder, int index)
+{
+	assert(index < pBuilder->m_groupCount);
+
+	m_builder = pBuilder;
+	m_builder->AddRef();
+	m_index = index;
+}
+
+void* MeshImpl::ImplementationDataPtr()
+{
+	return reinterpret_cast<void*>(&m_builder);
+}
+
+Result MeshImpl::SetColor(float r, float g, float b, float a)
+{
+	StoreColor(GetGroup().m_color, r, g, b, a);
+	return Success;
+}
+
+Result MeshImpl::SetTexture(const Texture* pTexture)
+{
+	TextureData* pData = pTexture ? static_cast<const TextureImpl*>(pTexture)->ImplementationData() : NULL;
+	SetReference(GetGroup().m_texture, pData);
+	return Success;
+}
+
+Result MeshImpl::GetTexture(Texture*& rpTexture)
+{
+	TextureData* pData = NULL;
+	SetReference(pData, GetGroup().m_texture);
+	rpTexture = new TextureImpl(pData);
+	return Success;
+}
+
+Result MeshImpl::SetTextureMappingMode(TextureMappingMode mode)
+{
+	GetGroup().m_mappingMode = mode;
+	return Success;
+}
+
+Result MeshImpl::SetShadingModel(ShadingModel model)
+{
+	GetGroup().m_shadingModel = model;
+	return Success;
+}
+
+Mesh* MeshImpl::DeepClone(MeshBuilder* pMesh)
+{
+	assert(pMesh);
+
+	MeshBuilderData* pBuilder = static_cast<MeshBuilderImpl*>(pMesh)->ImplementationData();
+	int index = pBuilder->AddGroup(GetGroup());
+	return new MeshImpl(pBuilder, index);
+}
+
+Mesh* MeshImpl::ShallowClone(MeshBuilder* pMeshBuilder)
+{
+	MeshBuilderData* pBuilder = static_cast<MeshBuilderImpl*>(pMeshBuilder)->ImplementationData();
+
+	if (m_index >= pBuilder->m_groupCount) {
+		return NULL;
+	}
+
+	return new MeshImpl(pBuilder, m_index);
+}
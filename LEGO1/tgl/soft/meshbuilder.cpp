@@ -0,0 +1,211 @@
+#include "impl.h"
+
+#include <assert.h>
+
+using namespace TglSoft;
+
+MeshBuilderData::~MeshBuilderData()
+{
+	for (int i = 0; i < m_groupCount; i++) {
+		m_groups[i].m_geometry->Release();
+		SetReference(m_groups[i].m_texture, (TextureData*) NULL);
+	}
+
+	delete[] m_groups;
+}
+
+int MeshBuilderData::AddGroup(const MeshGroup& p_group)
+{
+	// p_group may be one of m_groups
+	MeshGroup group = p_group;
+
+	if (m_groupCount == m_capacity) {
+		int capacity = m_capacity ? m_capacity * 2 : 4;
+		MeshGroup* groups = new MeshGroup[capacity];
+
+		for (int i = 0; i < m_groupCount; i++) {
+			groups[i] = m_groups[i];
+		}
+
+		delete[] m_groups;
+		m_groups = groups;
+		m_capacity = capacity;
+	}
+
+	group.m_geometry->AddRef();
+
+	if (group.m_texture) {
+		group.m_texture->AddRef();
+	}
+
+	m_groups[m_groupCount] = group;
+	return m_groupCount++;
+}
+
+void* MeshBuilderImpl::ImplementationDataPtr()
+{
+	return reinterpret_cast<void*>(&m_data);
+}
+
+// The face indices are packed as in TglImpl's CreateMesh: if bit 31 is set, the index starts a new vertex with
+// the position in the low word and the normal in bits 16-30, otherwise the low word is a vertex started earlier.
+inline Result CreateGeometry(
+	unsigned long faceCount,
+	unsigned long vertexCount,
+	float (*pPositions)[3],
+	float (*pNormals)[3],
+	float (*pTextureCoordinates)[2],
+	unsigned long (*pFaceIndices)[3],
+	unsigned long (*pTextureIndices)[3],
+	GeometryData& rGeometry
+)
+{
+	unsigned long* faceIndices = (unsigned long*) pFaceIndices;
+	unsigned long* textureIndices = pTextureCoordinates ? (unsigned long*) pTextureIndices : NULL;
+	unsigned long count = faceCount * 3;
+	unsigned long index = 0;
+	unsigned long i;
+
+	rGeometry.m_vertices = new Vertex[vertexCount];
+	rGeometry.m_faces = new unsigned long[faceCount][3];
+	memset(rGeometry.m_vertices, 0, sizeof(Vertex) * vertexCount);
+
+	for (i = 0; i < count; i++) {
+		unsigned long face = faceIndices[i];
+
+		if (face & 0x80000000) {
+			if (index >= vertexCount) {
+				return Error;
+			}
+
+			Vertex& vertex = rGeometry.m_vertices[index];
+			unsigned long j = face & 0xffff;
+			vertex.m_position[0] = pPositions[j][0];
+			vertex.m_position[1] = pPositions[j][1];
+			vertex.m_position[2] = pPositions[j][2];
+			j = (face >> 16) & 0x7fff;
+			vertex.m_normal[0] = pNormals[j][0];
+			vertex.m_normal[1] = pNormals[j][1];
+			vertex.m_normal[2] = pNormals[j][2];
+
+			if (textureIndices != NULL) {
+				j = textureIndices[i];
+				vertex.m_tu = pTextureCoordinates[j][0];
+				vertex.m_tv = pTextureCoordinates[j][1];
+			}
+
+			rGeometry.m_faces[i / 3][i % 3] = index++;
+		}
+		else {
+			if ((face & 0xffff) >= vertexCount) {
+				return Error;
+			}
+
+			rGeometry.m_faces[i / 3][i % 3] = face & 0xffff;
+		}
+	}
+
+	rGeometry.m_vertexCount = index;
+	rGeometry.m_faceCount = faceCount;
+
+	for (i = 0; i < 3; i++) {
+		rGeometry.m_min[i] = index ? rGeometry.m_vertices[0].m_position[i] : 0.0f;
+		rGeometry.m_max[i] = rGeometry.m_min[i];
+	}
+
+	for (i = 1; i < index; i++) {
+		for (int j = 0; j < 3; j++) {
+			float value = rGeometry.m_vertices[i].m_position[j];
+
+			if (value < rGeometry.m_min[j]) {
+				rGeometry.m_min[j] = value;
+			}
+			if (value > rGeometry.m_max[j]) {
+				rGeometry.m_max[j] = value;
+			}
+		}
+	}
+
+	return Success;
+}
+
+Mesh* MeshBuilderImpl::CreateMesh(
+	unsigned long faceCount,
+	unsigned long vertexCount,
+	float (*pPositions)[3],
+	float (*pNormals)[3],
+	float (*pTextureCoordinates)[2],
+	unsigned long (*pFaceIndices)[3],
+	unsigned long (*pTextureIndices)[3],
+	ShadingModel shadingModel
+)
+{
+	GeometryData* pGeometry = new GeometryData;
+
+	if (!CreateGeometry(
+			faceCount,
+			vertexCount,
+			pPositions,
+			pNormals,
+			pTextureCoordinates,
+			pFaceIndices,
+			pTextureIndices,
+			*pGeometry
+		)) {
+		pGeometry->Release();
+		return NULL;
+	}
+
+	MeshGroup group;
+	group.m_geometry = pGeometry;
+	StoreColor(group.m_color, 1.0f, 1.0f, 1.0f, 0.0f);
+	group.m_texture = NULL;
+	group.m_shadingModel = shadingModel;
+	group.m_mappingMode = PerspectiveCorrect;
+
+	int index = m_data->AddGroup(group);
+	pGeometry->Release();
+
+	return new MeshImpl(m_data, index);
+}
+
+Result MeshBuilderImpl::GetBoundingBox(float min[3], float max[3]) const
+{
+	int first = 1;
+
+	min[0] = min[1] = min[2] = 0.0f;
+	max[0] = max[1] = max[2] = 0.0f;
+
+	for (int i = 0; i < m_data->m_groupCount; i++) {
+		const GeometryData* pGeometry = m_data->m_groups[i].m_geometry;
+
+		if (pGeometry->m_vertexCount == 0) {
+			continue;
+		}
+
+		for (int j = 0; j < 3; j++) {
+			if (first || pGeometry->m_min[j] < min[j]) {
+				min[j] = pGeometry->m_min[j];
+			}
+			if (first || pGeometry->m_max[j] > max[j]) {
+				max[j] = pGeometry->m_max[j];
+			}
+		}
+
+		first = 0;
+	}
+
+	return Success;
+}
+
+// Geometry is never modified after CreateMesh, so the clone shares it and only copies the materials
+MeshBuilder* MeshBuilderImpl::Clone()
+{
+	MeshBuilderData* pData = new MeshBuilderData;
+
+	for (int i = 0; i < m_data->m_groupCount; i++) {
+		pData->AddGroup(m_data->m_groups[i]);
+	}
+
+	return new MeshBuilderImpl(pData);
+}
@@ -0,0 +1,707 @@
+#include "rasterizer.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+using namespace TglSoft;
+
+// Attribute order in Primitive::m_planes, matching RasterVertex
+enum {
+	c_z,
+	c_invW,
+	c_u,
+	c_v,
+	c_r,
+	c_g,
+	c_b
+};
+
+inline const float* Attributes(const RasterVertex& p_vertex)
+{
+	return &p_vertex.m_z;
+}
+
+inline RasterVertex Lerp(const RasterVertex& p_a, const RasterVertex& p_b, float p_t)
+{
+	RasterVertex result;
+	const float* a = &p_a.m_x;
+	const float* b = &p_b.m_x;
+	float* r = &result.m_x;
+
+	for (int i = 0; i < (int) (sizeof(RasterVertex) / sizeof(float)); i++) {
+		r[i] = a[i] + (b[i] - a[i]) * p_t;
+	}
+
+	return result;
+}
+
+// Signed distance of a vertex to one of the four viewport edges, >= 0 inside
+inline float ClipDistance(const RasterVertex& p_vertex, int p_plane, int p_width, int p_height)
+{
+	switch (p_plane) {
+	case 0:
+		return p_vertex.m_x;
+	case 1:
+		return p_width - p_vertex.m_x;
+	case 2:
+		return p_vertex.m_y;
+	default:
+		return p_height - p_vertex.m_y;
+	}
+}
+
+inline int ToFixed(float p_value, int p_max)
+{
+	int value = (int) (p_value * 16.0f + 0.5f);
+	return value < 0 ? 0 : value > p_max ? p_max : value;
+}
+
+inline int ClampColor(float p_value)
+{
+	int value = (int) p_value;
+	return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+Rasterizer::Rasterizer()
+{
+	m_color = NULL;
+	m_depth = NULL;
+	m_pitch = 0;
+	m_width = 0;
+	m_height = 0;
+	m_tilesX = 0;
+	m_tilesY = 0;
+	m_primitives = NULL;
+	m_numPrimitives = 0;
+	m_maxPrimitives = 0;
+	m_bins = NULL;
+	m_maxBins = 0;
+	m_workers = NULL;
+	m_numWorkers = 0;
+	m_nextTile = 0;
+	m_pending = 0;
+	m_quit = 0;
+}
+
+Rasterizer::~Rasterizer()
+{
+	int i;
+
+	AtomicStore(&m_quit, 1);
+
+	for (i = 0; i < m_numWorkers; i++) {
+		m_workers[i].m_start.Set();
+	}
+
+	for (i = 0; i < m_numWorkers; i++) {
+		m_workers[i].m_thread.Join();
+	}
+
+	for (i = 0; i < m_maxBins; i++) {
+		delete[] m_bins[i].m_primitives;
+	}
+
+	delete[] m_workers;
+	delete[] m_bins;
+	delete[] m_primitives;
+}
+
+int Rasterizer::Create(int p_threadCount)
+{
+	assert(!m_workers);
+
+	if (p_threadCount <= 1) {
+		return 1;
+	}
+
+	if (!m_done.Create()) {
+		return 0;
+	}
+
+	m_workers = new Worker[p_threadCount - 1];
+
+	for (int i = 0; i < p_threadCount - 1; i++) {
+		Worker& worker = m_workers[i];
+
+		worker.m_rasterizer = this;
+
+		if (!worker.m_start.Create() || !worker.m_thread.Start(&Rasterizer::WorkerProc, &worker)) {
+			return 0;
+		}
+
+		m_numWorkers++;
+	}
+
+	return 1;
+}
+
+int Rasterizer::SetTarget(unsigned long* p_color, float* p_depth, int p_pitch, int p_width, int p_height)
+{
+	if (p_width <= 0 || p_height <= 0 || p_width >= c_maxSize || p_height >= c_maxSize) {
+		return 0;
+	}
+
+	Flush();
+
+	m_color = p_color;
+	m_depth = p_depth;
+	m_pitch = p_pitch;
+	m_width = p_width;
+	m_height = p_height;
+	m_tilesX = (p_width + c_tileSize - 1) / c_tileSize;
+	m_tilesY = (p_height + c_tileSize - 1) / c_tileSize;
+
+	if (m_tilesX * m_tilesY > m_maxBins) {
+		Bin* bins = new Bin[m_tilesX * m_tilesY];
+
+		memset(bins, 0, sizeof(*bins) * m_tilesX * m_tilesY);
+
+		if (m_bins) {
+			memcpy(bins, m_bins, sizeof(*bins) * m_maxBins);
+			delete[] m_bins;
+		}
+
+		m_bins = bins;
+		m_maxBins = m_tilesX * m_tilesY;
+	}
+
+	return 1;
+}
+
+void Rasterizer::AddTriangle(
+	const RasterVertex& p_v0,
+	const RasterVertex& p_v1,
+	const RasterVertex& p_v2,
+	const RasterState& p_state
+)
+{
+	// A triangle clipped by four planes has at most seven corners
+	RasterVertex buffers[2][7];
+	RasterVertex* in = buffers[0];
+	RasterVertex* out = buffers[1];
+	int count = 3;
+	int plane, i;
+
+	in[0] = p_v0;
+	in[1] = p_v1;
+	in[2] = p_v2;
+
+	for (plane = 0; plane < 4; plane++) {
+		float distances[7];
+		int inside = 0;
+
+		for (i = 0; i < count; i++) {
+			distances[i] = ClipDistance(in[i], plane, m_width, m_height);
+			inside += distances[i] >= 0.0f;
+		}
+
+		if (inside == 0) {
+			return;
+		}
+
+		if (inside == count) {
+			continue;
+		}
+
+		int outCount = 0;
+
+		for (i = 0; i < count; i++) {
+			int next = (i + 1) % count;
+
+			if (distances[i] >= 0.0f) {
+				out[outCount++] = in[i];
+			}
+
+			if ((distances[i] >= 0.0f) != (distances[next] >= 0.0f)) {
+				out[outCount++] = Lerp(in[i], in[next], distances[i] / (distances[i] - distances[next]));
+			}
+		}
+
+		RasterVertex* swap = in;
+		in = out;
+		out = swap;
+		count = outCount;
+	}
+
+	for (i = 1; i < count - 1; i++) {
+		AddClippedTriangle(in[0], in[i], in[i + 1], p_state);
+	}
+}
+
+void Rasterizer::AddClippedTriangle(
+	const RasterVertex& p_v0,
+	const RasterVertex& p_v1,
+	const RasterVertex& p_v2,
+	const RasterState& p_state
+)
+{
+	const RasterVertex* vertices[3];
+	int x[3], y[3];
+	int i;
+
+	vertices[0] = &p_v0;
+	vertices[1] = &p_v1;
+	vertices[2] = &p_v2;
+
+	for (i = 0; i < 3; i++) {
+		x[i] = ToFixed(vertices[i]->m_x, m_width * 16);
+		y[i] = ToFixed(vertices[i]->m_y, m_height * 16);
+	}
+
+	int area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+
+	if (area == 0) {
+		return;
+	}
+
+	// Make the edge functions positive inside
+	if (area < 0) {
+		const RasterVertex* vertex = vertices[1];
+		vertices[1] = vertices[2];
+		vertices[2] = vertex;
+
+		int swap = x[1];
+		x[1] = x[2];
+		x[2] = swap;
+		swap = y[1];
+		y[1] = y[2];
+		y[2] = swap;
+	}
+
+	// Pixel centers are at 8 in 28.4
+	int minX = (x[0] < x[1] ? (x[0] < x[2] ? x[0] : x[2]) : (x[1] < x[2] ? x[1] : x[2]));
+	int maxX = (x[0] > x[1] ? (x[0] > x[2] ? x[0] : x[2]) : (x[1] > x[2] ? x[1] : x[2]));
+	int minY = (y[0] < y[1] ? (y[0] < y[2] ? y[0] : y[2]) : (y[1] < y[2] ? y[1] : y[2]));
+	int maxY = (y[0] > y[1] ? (y[0] > y[2] ? y[0] : y[2]) : (y[1] > y[2] ? y[1] : y[2]));
+
+	minX = (minX + 7) >> 4;
+	minY = (minY + 7) >> 4;
+	maxX = (maxX - 8) >> 4;
+	maxY = (maxY - 8) >> 4;
+
+	if (maxX >= m_width) {
+		maxX = m_width - 1;
+	}
+	if (maxY >= m_height) {
+		maxY = m_height - 1;
+	}
+
+	if (minX > maxX || minY > maxY) {
+		return;
+	}
+
+	Primitive* primitive = NewPrimitive();
+
+	for (i = 0; i < 3; i++) {
+		primitive->m_x[i] = x[i];
+		primitive->m_y[i] = y[i];
+	}
+
+	primitive->m_minX = minX;
+	primitive->m_minY = minY;
+	primitive->m_maxX = maxX;
+	primitive->m_maxY = maxY;
+	primitive->m_isLine = 0;
+	primitive->m_state = p_state;
+
+	// Attribute planes over the snapped positions
+	float x0 = x[0] / 16.0f, y0 = y[0] / 16.0f;
+	float dx1 = (x[1] - x[0]) / 16.0f, dy1 = (y[1] - y[0]) / 16.0f;
+	float dx2 = (x[2] - x[0]) / 16.0f, dy2 = (y[2] - y[0]) / 16.0f;
+	float invDet = 1.0f / (dx1 * dy2 - dx2 * dy1);
+
+	for (i = 0; i < c_numAttributes; i++) {
+		float q0 = Attributes(*vertices[0])[i];
+		float dq1 = Attributes(*vertices[1])[i] - q0;
+		float dq2 = Attributes(*vertices[2])[i] - q0;
+		float ddx = (dq1 * dy2 - dq2 * dy1) * invDet;
+		float ddy = (dq2 * dx1 - dq1 * dx2) * invDet;
+
+		primitive->m_planes[i][0] = q0 - ddx * x0 - ddy * y0;
+		primitive->m_planes[i][1] = ddx;
+		primitive->m_planes[i][2] = ddy;
+	}
+
+	BinPrimitive(m_numPrimitives - 1);
+}
+
+void Rasterizer::AddLine(const RasterVertex& p_v0, const RasterVertex& p_v1, const RasterState& p_state)
+{
+	RasterVertex v0 = p_v0;
+	RasterVertex v1 = p_v1;
+
+	// Clip to the points that round to a pixel of the viewport
+	for (int plane = 0; plane < 4; plane++) {
+		float d0 = ClipDistance(v0, plane, m_width - 1, m_height - 1) + 0.5f;
+		float d1 = ClipDistance(v1, plane, m_width - 1, m_height - 1) + 0.5f;
+
+		if (d0 < 0.0f && d1 < 0.0f) {
+			return;
+		}
+
+		if (d0 < 0.0f) {
+			v0 = Lerp(v0, v1, d0 / (d0 - d1));
+		}
+		else if (d1 < 0.0f) {
+			v1 = Lerp(v1, v0, d1 / (d1 - d0));
+		}
+	}
+
+	Primitive* primitive = NewPrimitive();
+
+	primitive->m_isLine = 1;
+	primitive->m_lineX[0] = v0.m_x;
+	primitive->m_lineY[0] = v0.m_y;
+	primitive->m_lineX[1] = v1.m_x;
+	primitive->m_lineY[1] = v1.m_y;
+	primitive->m_minX = (int) ((v0.m_x < v1.m_x ? v0.m_x : v1.m_x) + 0.5f);
+	primitive->m_minY = (int) ((v0.m_y < v1.m_y ? v0.m_y : v1.m_y) + 0.5f);
+	primitive->m_maxX = (int) ((v0.m_x > v1.m_x ? v0.m_x : v1.m_x) + 0.5f);
+	primitive->m_maxY = (int) ((v0.m_y > v1.m_y ? v0.m_y : v1.m_y) + 0.5f);
+
+	if (primitive->m_maxX >= m_width) {
+		primitive->m_maxX = m_width - 1;
+	}
+	if (primitive->m_maxY >= m_height) {
+		primitive->m_maxY = m_height - 1;
+	}
+	primitive->m_state = p_state;
+
+	for (int i = 0; i < c_numAttributes; i++) {
+		primitive->m_planes[i][0] = Attributes(v0)[i];
+		primitive->m_planes[i][1] = Attributes(v1)[i] - Attributes(v0)[i];
+	}
+
+	BinPrimitive(m_numPrimitives - 1);
+}
+
+Rasterizer::Primitive* Rasterizer::NewPrimitive()
+{
+	if (m_numPrimitives == m_maxPrimitives) {
+		int maxPrimitives = m_maxPrimitives ? m_maxPrimitives * 2 : 1024;
+		Primitive* primitives = new Primitive[maxPrimitives];
+
+		if (m_primitives) {
+			memcpy(primitives, m_primitives, sizeof(*primitives) * m_numPrimitives);
+			delete[] m_primitives;
+		}
+
+		m_primitives = primitives;
+		m_maxPrimitives = maxPrimitives;
+	}
+
+	return &m_primitives[m_numPrimitives++];
+}
+
+void Rasterizer::BinPrimitive(int p_index)
+{
+	const Primitive& primitive = m_primitives[p_index];
+	int tileX, tileY;
+
+	for (tileY = primitive.m_minY / c_tileSize; tileY <= primitive.m_maxY / c_tileSize; tileY++) {
+		for (tileX = primitive.m_minX / c_tileSize; tileX <= primitive.m_maxX / c_tileSize; tileX++) {
+			if (!primitive.m_isLine) {
+				// Skip tiles that lie entirely outside one of the edges
+				int minX = tileX * c_tileSize, minY = tileY * c_tileSize;
+				int maxX = minX + c_tileSize - 1, maxY = minY + c_tileSize - 1;
+				int edge;
+
+				minX = (minX < primitive.m_minX ? primitive.m_minX : minX) * 16 + 8;
+				minY = (minY < primitive.m_minY ? primitive.m_minY : minY) * 16 + 8;
+				maxX = (maxX > primitive.m_maxX ? primitive.m_maxX : maxX) * 16 + 8;
+				maxY = (maxY > primitive.m_maxY ? primitive.m_maxY : maxY) * 16 + 8;
+
+				for (edge = 0; edge < 3; edge++) {
+					int next = edge == 2 ? 0 : edge + 1;
+					int a = primitive.m_y[edge] - primitive.m_y[next];
+					int b = primitive.m_x[next] - primitive.m_x[edge];
+					int cx = a > 0 ? maxX : minX;
+					int cy = b > 0 ? maxY : minY;
+
+					if (a * (cx - primitive.m_x[edge]) + b * (cy - primitive.m_y[edge]) < 0) {
+						break;
+					}
+				}
+
+				if (edge < 3) {
+					continue;
+				}
+			}
+
+			Bin& bin = m_bins[tileY * m_tilesX + tileX];
+
+			if (bin.m_count == bin.m_capacity) {
+				int capacity = bin.m_capacity ? bin.m_capacity * 2 : 64;
+				int* primitives = new int[capacity];
+
+				if (bin.m_primitives) {
+					memcpy(primitives, bin.m_primitives, sizeof(*primitives) * bin.m_count);
+					delete[] bin.m_primitives;
+				}
+
+				bin.m_primitives = primitives;
+				bin.m_capacity = capacity;
+			}
+
+			bin.m_primitives[bin.m_count++] = p_index;
+		}
+	}
+}
+
+void Rasterizer::Flush()
+{
+	if (m_numPrimitives == 0) {
+		return;
+	}
+
+	m_nextTile = 0;
+
+	if (m_numWorkers) {
+		m_pending = m_numWorkers;
+
+		for (int i = 0; i < m_numWorkers; i++) {
+			m_workers[i].m_start.Set();
+		}
+	}
+
+	RasterizeTiles();
+
+	if (m_numWorkers) {
+		m_done.Wait();
+	}
+
+	for (int i = 0; i < m_tilesX * m_tilesY; i++) {
+		m_bins[i].m_count = 0;
+	}
+
+	m_numPrimitives = 0;
+}
+
+void Rasterizer::WorkerProc(void* p_worker)
+{
+	Worker* worker = (Worker*) p_worker;
+	Rasterizer* rasterizer = worker->m_rasterizer;
+
+	for (;;) {
+		worker->m_start.Wait();
+
+		if (rasterizer->m_quit) {
+			break;
+		}
+
+		rasterizer->RasterizeTiles();
+
+		if (AtomicDecrement(&rasterizer->m_pending) == 0) {
+			rasterizer->m_done.Set();
+		}
+	}
+}
+
+void Rasterizer::RasterizeTiles()
+{
+	int numTiles = m_tilesX * m_tilesY;
+	int tile;
+
+	while ((tile = AtomicIncrement(&m_nextTile) - 1) < numTiles) {
+		if (m_bins[tile].m_count) {
+			RasterizeTile(tile);
+		}
+	}
+}
+
+void Rasterizer::RasterizeTile(int p_tile)
+{
+	const Bin& bin = m_bins[p_tile];
+	int tileX = (p_tile % m_tilesX) * c_tileSize;
+	int tileY = (p_tile / m_tilesX) * c_tileSize;
+
+	for (int i = 0; i < bin.m_count; i++) {
+		const Primitive& primitive = m_primitives[bin.m_primitives[i]];
+		int minX = tileX < primitive.m_minX ? primitive.m_minX : tileX;
+		int minY = tileY < primitive.m_minY ? primitive.m_minY : tileY;
+		int maxX = tileX + c_tileSize - 1 > primitive.m_maxX ? primitive.m_maxX : tileX + c_tileSize - 1;
+		int maxY = tileY + c_tileSize - 1 > primitive.m_maxY ? primitive.m_maxY : tileY + c_tileSize - 1;
+
+		if (primitive.m_isLine) {
+			RasterizeLine(primitive, minX, minY, maxX, maxY);
+		}
+		else {
+			RasterizeTriangle(primitive, minX, minY, maxX, maxY);
+		}
+	}
+}
+
+void Rasterizer::RasterizeTriangle(const Primitive& p_primitive, int p_minX, int p_minY, int p_maxX, int p_maxY)
+{
+	int a[3], b[3], bias[3];
+	int edge, blockX, blockY, x, y;
+
+	for (edge = 0; edge < 3; edge++) {
+		int next = edge == 2 ? 0 : edge + 1;
+
+		a[edge] = p_primitive.m_y[edge] - p_primitive.m_y[next];
+		b[edge] = p_primitive.m_x[next] - p_primitive.m_x[edge];
+
+		// Top-left fill rule: pixels exactly on a right or bottom edge are not drawn
+		bias[edge] = (a[edge] > 0 || (a[edge] == 0 && b[edge] > 0)) ? 0 : -1;
+	}
+
+	for (blockY = p_minY; blockY <= p_maxY; blockY += c_blockSize) {
+		int blockMaxY = blockY + c_blockSize - 1 > p_maxY ? p_maxY : blockY + c_blockSize - 1;
+
+		for (blockX = p_minX; blockX <= p_maxX; blockX += c_blockSize) {
+			int blockMaxX = blockX + c_blockSize - 1 > p_maxX ? p_maxX : blockX + c_blockSize - 1;
+			int width = blockMaxX - blockX + 1;
+			int rowStart[3];
+			int inside = 0;
+
+			// Edge values at the block's pixel centers are linear, so its corners bound them
+			for (edge = 0; edge < 3; edge++) {
+				int e = a[edge] * (blockX * 16 + 8 - p_primitive.m_x[edge]) +
+						b[edge] * (blockY * 16 + 8 - p_primitive.m_y[edge]) + bias[edge];
+				int dx = a[edge] * (width - 1) * 16;
+				int dy = b[edge] * (blockMaxY - blockY) * 16;
+				int minimum = e + (dx < 0 ? dx : 0) + (dy < 0 ? dy : 0);
+				int maximum = e + (dx > 0 ? dx : 0) + (dy > 0 ? dy : 0);
+
+				if (maximum < 0) {
+					break;
+				}
+
+				inside += minimum >= 0;
+				rowStart[edge] = e;
+			}
+
+			if (edge < 3) {
+				continue;
+			}
+
+			unsigned int fullMask = (1 << width) - 1;
+
+			for (y = blockY; y <= blockMaxY; y++) {
+				unsigned int mask = fullMask;
+
+				if (inside < 3) {
+					int e0 = rowStart[0], e1 = rowStart[1], e2 = rowStart[2];
+
+					mask = 0;
+
+					for (x = 0; x < width; x++) {
+						if ((e0 | e1 | e2) >= 0) {
+							mask |= 1 << x;
+						}
+
+						e0 += a[0] * 16;
+						e1 += a[1] * 16;
+						e2 += a[2] * 16;
+					}
+
+					rowStart[0] += b[0] * 16;
+					rowStart[1] += b[1] * 16;
+					rowStart[2] += b[2] * 16;
+				}
+
+				if (mask) {
+					ShadeSpan(p_primitive, blockX, y, width, mask);
+				}
+			}
+		}
+	}
+}
+
+void Rasterizer::RasterizeLine(const Primitive& p_primitive, int p_minX, int p_minY, int p_maxX, int p_maxY)
+{
+	float x0 = p_primitive.m_lineX[0], y0 = p_primitive.m_lineY[0];
+	float dx = p_primitive.m_lineX[1] - x0, dy = p_primitive.m_lineY[1] - y0;
+	float adx = dx < 0.0f ? -dx : dx, ady = dy < 0.0f ? -dy : dy;
+	int steps = (int) (adx > ady ? adx : ady) + 1;
+	float invSteps = steps > 1 ? 1.0f / (steps - 1) : 0.0f;
+
+	// One pixel per step along the major axis
+	for (int i = 0; i < steps; i++) {
+		float t = i * invSteps;
+		int x = (int) (x0 + dx * t + 0.5f);
+		int y = (int) (y0 + dy * t + 0.5f);
+
+		if (x < p_minX || x > p_maxX || y < p_minY || y > p_maxY) {
+			continue;
+		}
+
+		int offset = y * m_pitch + x;
+		float z = p_primitive.m_planes[c_z][0] + p_primitive.m_planes[c_z][1] * t;
+
+		if (z < m_depth[offset]) {
+			m_depth[offset] = z;
+			m_color[offset] =
+				(ClampColor(p_primitive.m_planes[c_r][0] + p_primitive.m_planes[c_r][1] * t) << 16) |
+				(ClampColor(p_primitive.m_planes[c_g][0] + p_primitive.m_planes[c_g][1] * t) << 8) |
+				ClampColor(p_primitive.m_planes[c_b][0] + p_primitive.m_planes[c_b][1] * t);
+		}
+	}
+}
+
+void Rasterizer::ShadeSpan(const Primitive& p_primitive, int p_x, int p_y, int p_count, unsigned int p_mask)
+{
+	const RasterTexture* texture = p_primitive.m_state.m_texture;
+	float alpha = p_primitive.m_state.m_alpha;
+	int blend = alpha < 1.0f;
+	int opacity = (int) (alpha * 256.0f);
+	float values[c_numAttributes];
+	float steps[c_numAttributes];
+	int i;
+
+	for (i = 0; i < c_numAttributes; i++) {
+		const float* plane = p_primitive.m_planes[i];
+
+		values[i] = plane[0] + plane[1] * (p_x + 0.5f) + plane[2] * (p_y + 0.5f);
+		steps[i] = plane[1];
+	}
+
+	unsigned long* color = m_color + p_y * m_pitch + p_x;
+	float* depth = m_depth + p_y * m_pitch + p_x;
+
+	for (i = 0; i < p_count; i++) {
+		if ((p_mask & (1 << i)) && values[c_z] < depth[i]) {
+			int r = ClampColor(values[c_r]);
+			int g = ClampColor(values[c_g]);
+			int b = ClampColor(values[c_b]);
+
+			if (texture) {
+				float u = values[c_u];
+				float v = values[c_v];
+
+				if (p_primitive.m_state.m_perspective) {
+					float w = 1.0f / values[c_invW];
+					u *= w;
+					v *= w;
+				}
+
+				int tu = (int) (u * (texture->m_widthMask + 1)) & texture->m_widthMask;
+				int tv = (int) (v * (texture->m_heightMask + 1)) & texture->m_heightMask;
+				unsigned long texel = texture->m_colors[texture->m_texels[(tv << texture->m_widthShift) + tu]];
+
+				r = (((texel >> 16) & 0xff) * (r + 1)) >> 8;
+				g = (((texel >> 8) & 0xff) * (g + 1)) >> 8;
+				b = ((texel & 0xff) * (b + 1)) >> 8;
+			}
+
+			if (blend) {
+				unsigned long dest = color[i];
+
+				r = (r * opacity + (int) ((dest >> 16) & 0xff) * (256 - opacity)) >> 8;
+				g = (g * opacity + (int) ((dest >> 8) & 0xff) * (256 - opacity)) >> 8;
+				b = (b * opacity + (int) (dest & 0xff) * (256 - opacity)) >> 8;
+			}
+			else {
+				depth[i] = values[c_z];
+			}
+
+			color[i] = (r << 16) | (g << 8) | b;
+		}
+
+		for (int j = 0; j < c_numAttributes; j++) {
+			values[j] += steps[j];
+		}
+	}
+}
@@ -0,0 +1,170 @@
+#ifndef _tglSoftRasterizer_h
+#define _tglSoftRasterizer_h
+
+#include "threads.h"
+
+namespace TglSoft
+{
+
+/**
+ * @brief [AI] Texture as seen by the rasterizer: power-of-two 8-bit texels and their palette as 0x00RRGGBB. [AI]
+ */
+struct RasterTexture {
+	const unsigned char* m_texels; ///< [AI] width * height palette indices, row by row.
+	const unsigned long* m_colors; ///< [AI] 256 palette colors.
+	int m_widthShift;              ///< [AI] log2 of the width.
+	int m_widthMask;               ///< [AI] Width - 1.
+	int m_heightMask;              ///< [AI] Height - 1.
+};
+
+/**
+ * @brief [AI] Screen-space vertex handed to the rasterizer. [AI]
+ * @details [AI] x and y are in pixels relative to the viewport, z is the depth in [0, 1]. For perspective-correct
+ * primitives u and v are premultiplied by invW, so that all fields vary linearly across the screen. r, g and b are
+ * the lit color in [0, 255].
+ */
+struct RasterVertex {
+	float m_x;
+	float m_y;
+	float m_z;
+	float m_invW;
+	float m_u;
+	float m_v;
+	float m_r;
+	float m_g;
+	float m_b;
+};
+
+/**
+ * @brief [AI] Render state of a primitive. [AI]
+ */
+struct RasterState {
+	const RasterTexture* m_texture; ///< [AI] Texture, or NULL for plain color.
+	int m_perspective;              ///< [AI] Non-zero for perspective-correct texture coordinates.
+	float m_alpha;                  ///< [AI] Opacity; primitives with m_alpha < 1 are blended and do not write depth.
+};
+
+/**
+ * @brief [AI] Tile-binning triangle and line rasterizer with a z-buffer, used by the software Tgl backend.
+ * @details [AI] Primitives are set up and sorted into bins of c_tileSize square tiles as they are added. Flush then
+ * rasterizes the tiles, taking them one at a time from a shared counter on the calling thread and on the worker
+ * threads given to Create. A tile's primitives are drawn in the order they were added, so the result does not
+ * depend on the number of threads.
+ *
+ * Inside a tile, triangles are walked in c_blockSize square blocks: a block outside one of the edges is skipped
+ * and a block inside all three is filled without per-pixel edge tests. Edge functions use 4 bits of sub-pixel
+ * precision and the top-left fill rule, which keeps them in 32 bits for targets smaller than c_maxSize pixels.
+ *
+ * The color target holds 0x00RRGGBB pixels and the depth target floats, less-than test.
+ */
+class Rasterizer {
+public:
+	enum {
+		c_tileSize = 32,
+		c_blockSize = 8,
+		c_maxSize = 2048,
+		c_numAttributes = 7
+	};
+
+	Rasterizer();
+	~Rasterizer();
+
+	/**
+	 * @brief [AI] Starts p_threadCount - 1 worker threads; the thread calling Flush is the remaining one. [AI]
+	 */
+	int Create(int p_threadCount);
+
+	/**
+	 * @brief [AI] Sets the target for the following primitives; the viewport is p_width * p_height pixels at
+	 * p_color and p_depth, whose rows are p_pitch pixels apart. Flushes primitives for the previous target. [AI]
+	 */
+	int SetTarget(unsigned long* p_color, float* p_depth, int p_pitch, int p_width, int p_height);
+
+	/**
+	 * @brief [AI] Clips a triangle against the viewport and bins it. Either winding is accepted. [AI]
+	 */
+	void AddTriangle(
+		const RasterVertex& p_v0,
+		const RasterVertex& p_v1,
+		const RasterVertex& p_v2,
+		const RasterState& p_state
+	);
+
+	/**
+	 * @brief [AI] Clips a one pixel wide line against the viewport and bins it. [AI]
+	 */
+	void AddLine(const RasterVertex& p_v0, const RasterVertex& p_v1, const RasterState& p_state);
+
+	/**
+	 * @brief [AI] Rasterizes all binned primitives and empties the bins. [AI]
+	 */
+	void Flush();
+
+	int GetThreadCount() const { return m_numWorkers + 1; }
+
+private:
+	struct Primitive {
+		int m_x[3];            // 28.4 fixed point
+		int m_y[3];            // 28.4 fixed point
+		int m_minX;            // Pixel bounds, inclusive
+		int m_minY;
+		int m_maxX;
+		int m_maxY;
+		int m_isLine;
+		float m_lineX[2];      // Line end points
+		float m_lineY[2];
+		float m_planes[c_numAttributes][3]; // Triangles: value at (0, 0), d/dx, d/dy. Lines: value at m_lineX[0], delta
+		RasterState m_state;
+	};
+
+	struct Bin {
+		int* m_primitives;
+		int m_count;
+		int m_capacity;
+	};
+
+	struct Worker {
+		Rasterizer* m_rasterizer;
+		Thread m_thread;
+		Event m_start;
+	};
+
+	void AddClippedTriangle(
+		const RasterVertex& p_v0,
+		const RasterVertex& p_v1,
+		const RasterVertex& p_v2,
+		const RasterState& p_state
+	);
+	Primitive* NewPrimitive();
+	void BinPrimitive(int p_index);
+	void RasterizeTiles();
+	void RasterizeTile(int p_tile);
+	void RasterizeTriangle(const Primitive& p_primitive, int p_minX, int p_minY, int p_maxX, int p_maxY);
+	void RasterizeLine(const Primitive& p_primitive, int p_minX, int p_minY, int p_maxX, int p_maxY);
+	void ShadeSpan(const Primitive& p_primitive, int p_x, int p_y, int p_count, unsigned int p_mask);
+
+	static void WorkerProc(void* p_worker);
+
+	unsigned long* m_color;   // Target color pixels
+	float* m_depth;           // Target depth values
+	int m_pitch;              // Row distance of both targets in pixels
+	int m_width;              // Viewport size
+	int m_height;
+	int m_tilesX;             // Number of tiles per row
+	int m_tilesY;             // Number of tile rows
+	Primitive* m_primitives;  // Primitives added since the last flush
+	int m_numPrimitives;
+	int m_maxPrimitives;
+	Bin* m_bins;              // One bin per tile
+	int m_maxBins;
+	Worker* m_workers;
+	int m_numWorkers;
+	Event m_done;             // Signaled when the last worker has finished a flush
+	volatile AtomicCounter m_nextTile; // Next tile to rasterize
+	volatile AtomicCounter m_pending;  // Workers still busy with the current flush
+	volatile AtomicCounter m_quit;     // Set to stop the workers
+};
+
+} // namespace TglSoft
+
+#endif /* _tglSoftRasterizer_h */
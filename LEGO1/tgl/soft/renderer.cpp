@@ -0,0 +1,218 @@
+#include "impl.h"
+
+#include <assert.h>
+
+using namespace TglSoft;
+
+Renderer* Tgl::CreateSoftRenderer()
+{
+	return new RendererImpl();
+}
+
+void* RendererImpl::ImplementationDataPtr()
+{
+	return reinterpret_cast<void*>(this);
+}
+
+#ifdef _WIN32
+
+inline Result GetSurfaceSize(IDirectDrawSurface* pSurface, unsigned long& rWidth, unsigned long& rHeight)
+{
+	DDSURFACEDESC desc;
+
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+
+	if (pSurface->GetSurfaceDesc(&desc) != DD_OK) {
+		return Error;
+	}
+
+	rWidth = desc.dwWidth;
+	rHeight = desc.dwHeight;
+	return Success;
+}
+
+Device* RendererImpl::CreateDevice(const DeviceDirectDrawCreateData& data)
+{
+	IDirectDrawSurface* pSurface = data.m_pBackBuffer ? data.m_pBackBuffer : data.m_pFrontBuffer;
+	unsigned long width = 0;
+	unsigned long height = 0;
+
+	if (pSurface) {
+		if (!GetSurfaceSize(pSurface, width, height)) {
+			return NULL;
+		}
+	}
+	else if (data.m_hWnd) {
+		RECT rect;
+
+		if (!GetClientRect(data.m_hWnd, &rect)) {
+			return NULL;
+		}
+
+		width = rect.right - rect.left;
+		height = rect.bottom - rect.top;
+	}
+
+	DeviceImpl* device = static_cast<DeviceImpl*>(CreateDevice(width, height));
+
+	if (device) {
+		DeviceData* pData = device->ImplementationData();
+
+		pData->m_hWnd = data.m_hWnd;
+		pData->m_surface = pSurface;
+
+		if (pSurface) {
+			pSurface->AddRef();
+		}
+
+		if (data.m_pFrontBuffer && data.m_pFrontBuffer != pSurface) {
+			pData->m_paletteSurface = data.m_pFrontBuffer;
+			pData->m_paletteSurface->AddRef();
+		}
+	}
+
+	return device;
+}
+
+#else
+
+Device* RendererImpl::CreateDevice(const DeviceDirectDrawCreateData&)
+{
+	return NULL;
+}
+
+#endif
+
+Device* RendererImpl::CreateDevice(const DeviceDirect3DCreateData&)
+{
+	// Rendering through a Direct3D device is what this renderer replaces
+	return NULL;
+}
+
+Device* RendererImpl::CreateDevice(unsigned long width, unsigned long height)
+{
+	if (width == 0 || height == 0 || width >= Rasterizer::c_maxSize || height >= Rasterizer::c_maxSize) {
+		return NULL;
+	}
+
+	DeviceData* pData = new DeviceData(width, height);
+
+	if (!pData->m_color || !pData->m_depth) {
+		pData->Release();
+		return NULL;
+	}
+
+	return new DeviceImpl(pData);
+}
+
+View* RendererImpl::CreateView(
+	const Device* pDevice,
+	const Camera* pCamera,
+	unsigned long x,
+	unsigned long y,
+	unsigned long width,
+	unsigned long height
+)
+{
+	assert(pDevice);
+	assert(pCamera);
+
+	DeviceData* pDeviceData = static_cast<const DeviceImpl*>(pDevice)->ImplementationData();
+	ViewportRect viewport;
+
+	if (x + width > pDeviceData->m_width || y + height > pDeviceData->m_height) {
+		return NULL;
+	}
+
+	viewport.left = x;
+	viewport.top = y;
+	viewport.right = x + width;
+	viewport.bottom = y + height;
+
+	int threadCount = m_threadCount;
+
+	if (threadCount <= 0) {
+		threadCount = GetProcessorCount();
+	}
+
+	ViewImpl* view = new ViewImpl();
+
+	if (!view->Create(
+			pDeviceData,
+			static_cast<const CameraImpl*>(pCamera)->ImplementationData(),
+			viewport,
+			threadCount
+		)) {
+		delete view;
+		view = NULL;
+	}
+
+	return view;
+}
+
+Camera* RendererImpl::CreateCamera()
+{
+	return new CameraImpl();
+}
+
+Light* RendererImpl::CreateLight(LightType type, float r, float g, float b)
+{
+	return new LightImpl(type, r, g, b);
+}
+
+Group* RendererImpl::CreateGroup(const Group* pParent)
+{
+	GroupImpl* group = new GroupImpl();
+
+	if (pParent) {
+		static_cast<const GroupImpl*>(pParent)->ImplementationData()->m_groups.Add(group->ImplementationData());
+	}
+
+	return group;
+}
+
+MeshBuilder* RendererImpl::CreateMeshBuilder()
+{
+	return new MeshBuilderImpl(new MeshBuilderData);
+}
+
+Texture* RendererImpl::CreateTexture(
+	int width,
+	int height,
+	int bitsPerTexel,
+	const void* pTexels,
+	int texelsArePersistent,
+	int paletteEntryCount,
+	const PaletteEntry* pEntries
+)
+{
+	TextureData* pData = new TextureData;
+
+	if (pTexels && !pData->SetTexels(width, height, bitsPerTexel, const_cast<void*>(pTexels), texelsArePersistent)) {
+		pData->Release();
+		return NULL;
+	}
+
+	if (pEntries) {
+		pData->SetPalette(paletteEntryCount, pEntries);
+	}
+
+	return new TextureImpl(pData);
+}
+
+Texture* RendererImpl::CreateTexture()
+{
+	return new TextureImpl(new TextureData);
+}
+
+Result RendererImpl::SetTextureDefaultShadeCount(unsigned long)
+{
+	// Texels are shaded in true color, there are no shade tables
+	return Success;
+}
+
+Result RendererImpl::SetTextureDefaultColorCount(unsigned long)
+{
+	return Success;
+}
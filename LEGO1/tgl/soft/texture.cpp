@@ -0,0 +1,134 @@
+#include "impl.h"
+
+#include <assert.h>
+
+using namespace TglSoft;
+
+inline static int Log2(int v)
+{
+	int log = 0;
+
+	while ((1 << log) < v) {
+		log++;
+	}
+
+	return (1 << log) == v ? log : -1;
+}
+
+TextureData::TextureData()
+{
+	m_width = 0;
+	m_height = 0;
+	m_depth = 0;
+	m_texels = NULL;
+	m_texelsAllocatedByClient = 0;
+	m_paletteSize = 0;
+	memset(m_palette, 0, sizeof(m_palette));
+	memset(m_colors, 0, sizeof(m_colors));
+	m_raster.m_texels = NULL;
+	m_raster.m_colors = m_colors;
+	m_raster.m_widthShift = 0;
+	m_raster.m_widthMask = 0;
+	m_raster.m_heightMask = 0;
+}
+
+TextureData::~TextureData()
+{
+	if (!m_texelsAllocatedByClient) {
+		delete[] m_texels;
+	}
+}
+
+// Same restrictions as TglD3DRMIMAGE::CreateBuffer, so that both renderers accept the same textures
+Result TextureData::SetTexels(int p_width, int p_height, int p_depth, void* p_texels, int p_useBuffer)
+{
+	int widthShift = Log2(p_width);
+	int heightShift = Log2(p_height);
+
+	if (widthShift < 1 || heightShift < 1 || p_width % 4 != 0 || p_depth != 8) {
+		return Error;
+	}
+
+	if (!m_texelsAllocatedByClient) {
+		delete[] m_texels;
+	}
+
+	if (p_useBuffer) {
+		m_texels = (unsigned char*) p_texels;
+		m_texelsAllocatedByClient = 1;
+	}
+	else {
+		m_texels = new unsigned char[p_width * p_height];
+		memcpy(m_texels, p_texels, p_width * p_height);
+		m_texelsAllocatedByClient = 0;
+	}
+
+	m_width = p_width;
+	m_height = p_height;
+	m_depth = p_depth;
+	m_raster.m_texels = m_texels;
+	m_raster.m_widthShift = widthShift;
+	m_raster.m_widthMask = p_width - 1;
+	m_raster.m_heightMask = p_height - 1;
+	return Success;
+}
+
+void TextureData::SetPalette(int p_entryCount, const PaletteEntry* p_entries)
+{
+	if (p_entryCount > (int) sizeOfArray(m_palette)) {
+		p_entryCount = sizeOfArray(m_palette);
+	}
+
+	for (int i = 0; i < p_entryCount; i++) {
+		m_palette[i] = p_entries[i];
+		m_colors[i] = (p_entries[i].m_red << 16) | (p_entries[i].m_green << 8) | p_entries[i].m_blue;
+	}
+
+	m_paletteSize = p_entryCount;
+}
+
+void* TextureImpl::ImplementationDataPtr()
+{
+	return reinterpret_cast<void*>(&m_data);
+}
+
+Result TextureImpl::SetTexels(int width, int height, int bitsPerTexel, void* pTexels)
+{
+	return m_data->SetTexels(width, height, bitsPerTexel, pTexels, 1);
+}
+
+void TextureImpl::FillRowsOfTexture(int y, int height, void* pBuffer)
+{
+	assert(m_data->m_texels);
+	memcpy(m_data->m_texels + y * m_data->m_width, pBuffer, height * m_data->m_width);
+}
+
+Result TextureImpl::Changed(int, int)
+{
+	// Texels and palette are read when rendering, there is nothing to update
+	return Success;
+}
+
+Result TextureImpl::GetBufferAndPalette(
+	int* pWidth,
+	int* pHeight,
+	int* pDepth,
+	void** ppBuffer,
+	int* pPaletteSize,
+	PaletteEntry** ppPalette
+)
+{
+	*pWidth = m_data->m_width;
+	*pHeight = m_data->m_height;
+	*pDepth = m_data->m_depth;
+	*ppBuffer = m_data->m_texels;
+	*pPaletteSize = m_data->m_paletteSize;
+	*ppPalette = m_data->m_palette;
+	return Success;
+}
+
+Result TextureImpl::SetPalette(int entryCount, PaletteEntry* pEntries)
+{
+	m_data->SetPalette(entryCount, pEntries);
+	return Success;
+}
@@ -0,0 +1,208 @@
+#include "threads.h"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace TglSoft;
+
+#ifdef _WIN32
+
+long TglSoft::AtomicIncrement(volatile AtomicCounter* p_counter)
+{
+	return InterlockedIncrement((LONG*) p_counter);
+}
+
+long TglSoft::AtomicDecrement(volatile AtomicCounter* p_counter)
+{
+	return InterlockedDecrement((LONG*) p_counter);
+}
+
+void TglSoft::AtomicStore(volatile AtomicCounter* p_counter, long p_value)
+{
+	InterlockedExchange((LONG*) p_counter, p_value);
+}
+
+int TglSoft::GetProcessorCount()
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+}
+
+Event::Event()
+{
+	m_handle = NULL;
+}
+
+Event::~Event()
+{
+	if (m_handle) {
+		CloseHandle(m_handle);
+	}
+}
+
+int Event::Create()
+{
+	return (m_handle = CreateEvent(NULL, FALSE, FALSE, NULL)) != NULL;
+}
+
+void Event::Set()
+{
+	SetEvent(m_handle);
+}
+
+void Event::Wait()
+{
+	WaitForSingleObject(m_handle, INFINITE);
+}
+
+Thread::Thread()
+{
+	m_handle = NULL;
+	m_procedure = NULL;
+	m_argument = NULL;
+}
+
+Thread::~Thread()
+{
+	Join();
+}
+
+int Thread::Start(Procedure p_procedure, void* p_argument)
+{
+	unsigned threadId;
+
+	m_procedure = p_procedure;
+	m_argument = p_argument;
+	m_handle = (HANDLE) _beginthreadex(NULL, 0, &Thread::Entry, this, 0, &threadId);
+	return m_handle != NULL;
+}
+
+void Thread::Join()
+{
+	if (m_handle) {
+		WaitForSingleObject(m_handle, INFINITE);
+		CloseHandle(m_handle);
+		m_handle = NULL;
+	}
+}
+
+unsigned __stdcall Thread::Entry(void* p_thread)
+{
+	Thread* thread = (Thread*) p_thread;
+	thread->m_procedure(thread->m_argument);
+	return 0;
+}
+
+#else
+
+long TglSoft::AtomicIncrement(volatile AtomicCounter* p_counter)
+{
+	return __sync_add_and_fetch(p_counter, 1);
+}
+
+long TglSoft::AtomicDecrement(volatile AtomicCounter* p_counter)
+{
+	return __sync_sub_and_fetch(p_counter, 1);
+}
+
+void TglSoft::AtomicStore(volatile AtomicCounter* p_counter, long p_value)
+{
+	__sync_lock_test_and_set(p_counter, p_value);
+	__sync_synchronize();
+}
+
+int TglSoft::GetProcessorCount()
+{
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (int) count : 1;
+}
+
+Event::Event()
+{
+	m_signaled = 0;
+	m_created = 0;
+}
+
+Event::~Event()
+{
+	if (m_created) {
+		pthread_cond_destroy(&m_condition);
+		pthread_mutex_destroy(&m_mutex);
+	}
+}
+
+int Event::Create()
+{
+	if (pthread_mutex_init(&m_mutex, NULL) != 0) {
+		return 0;
+	}
+
+	if (pthread_cond_init(&m_condition, NULL) != 0) {
+		pthread_mutex_destroy(&m_mutex);
+		return 0;
+	}
+
+	m_created = 1;
+	return 1;
+}
+
+void Event::Set()
+{
+	pthread_mutex_lock(&m_mutex);
+	m_signaled = 1;
+	pthread_cond_signal(&m_condition);
+	pthread_mutex_unlock(&m_mutex);
+}
+
+void Event::Wait()
+{
+	pthread_mutex_lock(&m_mutex);
+
+	while (!m_signaled) {
+		pthread_cond_wait(&m_condition, &m_mutex);
+	}
+
+	m_signaled = 0;
+	pthread_mutex_unlock(&m_mutex);
+}
+
+Thread::Thread()
+{
+	m_started = 0;
+	m_procedure = NULL;
+	m_argument = NULL;
+}
+
+Thread::~Thread()
+{
+	Join();
+}
+
+int Thread::Start(Procedure p_procedure, void* p_argument)
+{
+	m_procedure = p_procedure;
+	m_argument = p_argument;
+	m_started = pthread_create(&m_handle, NULL, &Thread::Entry, this) == 0;
+	return m_started;
+}
+
+void Thread::Join()
+{
+	if (m_started) {
+		pthread_join(m_handle, NULL);
+		m_started = 0;
+	}
+}
+
+void* Thread::Entry(void* p_thread)
+{
+	Thread* thread = (Thread*) p_thread;
+	thread->m_procedure(thread->m_argument);
+	return NULL;
+}
+
+#endif
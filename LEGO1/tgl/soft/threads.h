@@ -0,0 +1,96 @@
+#ifndef _tglSoftThreads_h
+#define _tglSoftThreads_h
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace TglSoft
+{
+
+/**
+ * @brief [AI] Counter that threads change with atomic read-modify-write operations. [AI]
+ */
+#ifdef _WIN32
+typedef LONG AtomicCounter;
+#else
+typedef long AtomicCounter;
+#endif
+
+/**
+ * @brief [AI] Atomically adds one to the counter and returns the new value. [AI]
+ */
+long AtomicIncrement(volatile AtomicCounter* p_counter);
+
+/**
+ * @brief [AI] Atomically subtracts one from the counter and returns the new value. [AI]
+ */
+long AtomicDecrement(volatile AtomicCounter* p_counter);
+
+/**
+ * @brief [AI] Atomically stores a value, visible to other threads before any later store of the caller. [AI]
+ */
+void AtomicStore(volatile AtomicCounter* p_counter, long p_value);
+
+/**
+ * @brief [AI] Returns the number of processors the threads are scheduled on, at least 1. [AI]
+ */
+int GetProcessorCount();
+
+/**
+ * @brief [AI] Auto-reset event: Wait returns once per Set, and a Set before the Wait is not lost. [AI]
+ */
+class Event {
+public:
+	Event();
+	~Event();
+
+	int Create();
+	void Set();
+	void Wait();
+
+private:
+#ifdef _WIN32
+	HANDLE m_handle;
+#else
+	pthread_mutex_t m_mutex;
+	pthread_cond_t m_condition;
+	int m_signaled;
+	int m_created;
+#endif
+};
+
+/**
+ * @brief [AI] A thread running a function; Join waits for it to return. [AI]
+ */
+class Thread {
+public:
+	typedef void (*Procedure)(void* p_argument);
+
+	Thread();
+	~Thread();
+
+	int Start(Procedure p_procedure, void* p_argument);
+	void Join();
+
+private:
+#ifdef _WIN32
+	static unsigned __stdcall Entry(void* p_thread);
+
+	HANDLE m_handle;
+#else
+	static void* Entry(void* p_thread);
+
+	pthread_t m_handle;
+	int m_started;
+#endif
+
+	Procedure m_procedure;
+	void* m_argument;
+};
+
+} // namespace TglSoft
+
+#endif /* _tglSoftThreads_h */
@@ -0,0 +1,706 @@
+#include "impl.h"
+
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+using namespace TglSoft;
+
+void TglSoft::Multiply(const FloatMatrix4& rA, const FloatMatrix4& rB, FloatMatrix4& rResult)
+{
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			rResult[i][j] = rA[i][0] * rB[0][j] + rA[i][1] * rB[1][j] + rA[i][2] * rB[2][j] + rA[i][3] * rB[3][j];
+		}
+	}
+}
+
+void TglSoft::Transform(const float p[3], float w, const FloatMatrix4& rMatrix, float result[3])
+{
+	float x = p[0];
+	float y = p[1];
+	float z = p[2];
+
+	for (int j = 0; j < 3; j++) {
+		result[j] = x * rMatrix[0][j] + y * rMatrix[1][j] + z * rMatrix[2][j] + w * rMatrix[3][j];
+	}
+}
+
+inline float Dot(const float a[3], const float b[3])
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline void Normalize(float v[3])
+{
+	float length = (float) sqrt(Dot(v, v));
+
+	if (length > 0.0f) {
+		v[0] /= length;
+		v[1] /= length;
+		v[2] /= length;
+	}
+}
+
+// Inverse of an affine transformation, i.e. one whose last column is (0, 0, 0, 1)
+inline void InvertAffine(const FloatMatrix4& rMatrix, FloatMatrix4& rResult)
+{
+	const float(*m)[4] = rMatrix;
+	float det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+				m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+	float inv = det != 0.0f ? 1.0f / det : 0.0f;
+
+	rResult[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) * inv;
+	rResult[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv;
+	rResult[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv;
+	rResult[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * inv;
+	rResult[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv;
+	rResult[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv;
+	rResult[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * inv;
+	rResult[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv;
+	rResult[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv;
+
+	for (int j = 0; j < 3; j++) {
+		rResult[3][j] = -(m[3][0] * rResult[0][j] + m[3][1] * rResult[1][j] + m[3][2] * rResult[2][j]);
+		rResult[j][3] = 0.0f;
+	}
+
+	rResult[3][3] = 1.0f;
+}
+
+inline void SetIdentity(FloatMatrix4& rMatrix)
+{
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			rMatrix[i][j] = i == j ? 1.0f : 0.0f;
+		}
+	}
+}
+
+inline void SetVertexColor(RasterVertex& rVertex, const float color[3], const float intensity[3])
+{
+	float r = color[0] * intensity[0];
+	float g = color[1] * intensity[1];
+	float b = color[2] * intensity[2];
+
+	rVertex.m_r = r < 1.0f ? r * 255.0f : 255.0f;
+	rVertex.m_g = g < 1.0f ? g * 255.0f : 255.0f;
+	rVertex.m_b = b < 1.0f ? b * 255.0f : 255.0f;
+}
+
+// Interpolates the attributes a vertex has before projection
+inline void LerpAttributes(const RasterVertex& rA, const RasterVertex& rB, float t, RasterVertex& rResult)
+{
+	rResult.m_u = rA.m_u + (rB.m_u - rA.m_u) * t;
+	rResult.m_v = rA.m_v + (rB.m_v - rA.m_v) * t;
+	rResult.m_r = rA.m_r + (rB.m_r - rA.m_r) * t;
+	rResult.m_g = rA.m_g + (rB.m_g - rA.m_g) * t;
+	rResult.m_b = rA.m_b + (rB.m_b - rA.m_b) * t;
+}
+
+ViewImpl::ViewImpl()
+{
+	m_device = NULL;
+	m_camera = NULL;
+	memset(&m_viewport, 0, sizeof(m_viewport));
+	m_projection = Perspective;
+	m_front = 1.0f;
+	m_back = 100.0f;
+	m_degrees = 90.0f;
+	m_scale = 1.0f;
+	m_background[0] = m_background[1] = m_background[2] = 0.0f;
+	SetIdentity(m_worldToCamera);
+	SetIdentity(m_cameraToWorld);
+	SetIdentity(m_rootTransformation);
+	m_sceneLights = NULL;
+	m_sceneLightCount = 0;
+	m_ambient[0] = m_ambient[1] = m_ambient[2] = 0.0f;
+	m_cameraPositions = NULL;
+	m_rasterVertices = NULL;
+	m_scratchSize = 0;
+}
+
+ViewImpl::~ViewImpl()
+{
+	SetReference(m_device, (DeviceData*) NULL);
+	SetReference(m_camera, (FrameData*) NULL);
+	delete[] m_sceneLights;
+	delete[] m_cameraPositions;
+	delete[] m_rasterVertices;
+}
+
+Result ViewImpl::Create(DeviceData* pDevice, FrameData* pCamera, const ViewportRect& rViewport, int threadCount)
+{
+	SetReference(m_device, pDevice);
+	SetReference(m_camera, pCamera);
+	m_viewport = rViewport;
+
+	if (!m_rasterizer.Create(threadCount)) {
+		return Error;
+	}
+
+	UpdateProjection();
+	return Success;
+}
+
+void* ViewImpl::ImplementationDataPtr()
+{
+	return reinterpret_cast<void*>(this);
+}
+
+Result ViewImpl::Add(const Light* pLight)
+{
+	m_lights.Add(static_cast<const LightImpl*>(pLight)->ImplementationData());
+	return Success;
+}
+
+Result ViewImpl::Remove(const Light* pLight)
+{
+	return m_lights.Remove(static_cast<const LightImpl*>(pLight)->ImplementationData());
+}
+
+Result ViewImpl::SetCamera(const Camera* pCamera)
+{
+	SetReference(m_camera, static_cast<const CameraImpl*>(pCamera)->ImplementationData());
+	return Success;
+}
+
+Result ViewImpl::SetProjection(ProjectionType type)
+{
+	m_projection = type;
+	UpdateProjection();
+	return Success;
+}
+
+Result ViewImpl::SetFrustrum(float frontClippingDistance, float backClippingDistance, float degrees)
+{
+	if (frontClippingDistance <= 0.0f || backClippingDistance <= frontClippingDistance) {
+		return Error;
+	}
+
+	m_front = frontClippingDistance;
+	m_back = backClippingDistance;
+	m_degrees = degrees;
+	UpdateProjection();
+	return Success;
+}
+
+// Like TglImpl::ViewImpl::SetFrustrum, the field is half the height of the front clipping plane
+void ViewImpl::UpdateProjection()
+{
+	float field = m_front * (float) tan(DegreesToRadians(m_degrees / 2));
+	float halfHeight = (m_viewport.bottom - m_viewport.top) * 0.5f;
+
+	if (field <= 0.0f) {
+		field = m_front;
+	}
+
+	m_scale = m_projection == Perspective ? halfHeight * m_front / field : halfHeight / field;
+}
+
+Result ViewImpl::SetBackgroundColor(float r, float g, float b)
+{
+	m_background[0] = r;
+	m_background[1] = g;
+	m_background[2] = b;
+	return Success;
+}
+
+Result ViewImpl::GetBackgroundColor(float* r, float* g, float* b)
+{
+	*r = m_background[0];
+	*g = m_background[1];
+	*b = m_background[2];
+	return Success;
+}
+
+Result ViewImpl::Clear()
+{
+	RasterVertex background;
+	float unlit[3] = {1.0f, 1.0f, 1.0f};
+
+	SetVertexColor(background, m_background, unlit);
+
+	unsigned long color = ((unsigned long) background.m_r << 16) | ((unsigned long) background.m_g << 8) |
+						  (unsigned long) background.m_b;
+
+	for (long y = m_viewport.top; y < m_viewport.bottom; y++) {
+		unsigned long* pColor = m_device->m_color + y * m_device->m_width;
+		float* pDepth = m_device->m_depth + y * m_device->m_width;
+
+		for (long x = m_viewport.left; x < m_viewport.right; x++) {
+			pColor[x] = color;
+			pDepth[x] = 1.0f;
+		}
+	}
+
+	return Success;
+}
+
+// Like Direct3D RM, where TglImpl adds the camera and light frames to the scene while rendering it, they are
+// placed relative to the group rendered last
+void ViewImpl::UpdateCamera()
+{
+	Multiply(m_camera->m_transformation, m_rootTransformation, m_cameraToWorld);
+	InvertAffine(m_cameraToWorld, m_worldToCamera);
+}
+
+Result ViewImpl::Render(const Group* pGroup)
+{
+	const GroupData* pRoot = static_cast<const GroupImpl*>(pGroup)->ImplementationData();
+	int i;
+
+	memcpy(m_rootTransformation, pRoot->m_transformation, sizeof(FloatMatrix4));
+	UpdateCamera();
+
+	delete[] m_sceneLights;
+	m_sceneLights = new SceneLight[m_lights.Size()];
+	m_sceneLightCount = 0;
+	m_ambient[0] = m_ambient[1] = m_ambient[2] = 0.0f;
+
+	for (i = 0; i < m_lights.Size(); i++) {
+		const LightData* pLight = m_lights[i];
+
+		if (pLight->m_type == Ambient) {
+			m_ambient[0] += pLight->m_color[0];
+			m_ambient[1] += pLight->m_color[1];
+			m_ambient[2] += pLight->m_color[2];
+			continue;
+		}
+
+		FloatMatrix4 world;
+		FloatMatrix4 camera;
+		SceneLight& rLight = m_sceneLights[m_sceneLightCount++];
+
+		Multiply(pLight->m_transformation, m_rootTransformation, world);
+		Multiply(world, m_worldToCamera, camera);
+
+		rLight.m_type = pLight->m_type;
+		memcpy(rLight.m_color, pLight->m_color, sizeof(rLight.m_color));
+		memcpy(rLight.m_position, camera[3], sizeof(rLight.m_position));
+		memcpy(rLight.m_direction, camera[2], sizeof(rLight.m_direction));
+		Normalize(rLight.m_direction);
+	}
+
+	long offset = m_viewport.top * m_device->m_width + m_viewport.left;
+
+	m_rasterizer.SetTarget(
+		m_device->m_color + offset,
+		m_device->m_depth + offset,
+		m_device->m_width,
+		m_viewport.right - m_viewport.left,
+		m_viewport.bottom - m_viewport.top
+	);
+
+	RenderGroup(pRoot, pRoot->m_transformation, NULL);
+	m_rasterizer.Flush();
+	return Success;
+}
+
+void ViewImpl::RenderGroup(const GroupData* pGroup, const FloatMatrix4& rWorld, const Material* pMaterial)
+{
+	Material material;
+	int i;
+
+	switch (pGroup->m_materialMode) {
+	case FromFrame:
+		material.m_color = pGroup->m_color;
+		material.m_texture = pGroup->m_texture;
+		pMaterial = &material;
+		break;
+	case FromMesh:
+		pMaterial = NULL;
+		break;
+	case FromParent:
+		break;
+	}
+
+	for (i = 0; i < pGroup->m_meshBuilders.Size(); i++) {
+		const MeshBuilderData* pBuilder = pGroup->m_meshBuilders[i];
+
+		for (int j = 0; j < pBuilder->m_groupCount; j++) {
+			RenderMesh(pBuilder->m_groups[j], rWorld, pMaterial);
+		}
+	}
+
+	for (i = 0; i < pGroup->m_groups.Size(); i++) {
+		const GroupData* pChild = pGroup->m_groups[i];
+		FloatMatrix4 world;
+
+		Multiply(pChild->m_transformation, rWorld, world);
+		RenderGroup(pChild, world, pMaterial);
+	}
+}
+
+void ViewImpl::RenderMesh(const MeshGroup& rMesh, const FloatMatrix4& rWorld, const Material* pMaterial)
+{
+	const GeometryData* pGeometry = rMesh.m_geometry;
+	const float* color = pMaterial ? pMaterial->m_color : rMesh.m_color;
+	TextureData* pTexture = pMaterial ? pMaterial->m_texture : rMesh.m_texture;
+	ShadingModel shading = rMesh.m_shadingModel;
+	int perspective = m_projection == Perspective;
+	FloatMatrix4 toCamera;
+	unsigned long i;
+
+	if (pGeometry->m_faceCount == 0) {
+		return;
+	}
+
+	Multiply(rWorld, m_worldToCamera, toCamera);
+
+	// Skip meshes whose bounding sphere is outside the frustum
+	float center[3];
+	float radius = 0.0f;
+	float scale = 0.0f;
+
+	for (i = 0; i < 3; i++) {
+		float extent = (pGeometry->m_max[i] - pGeometry->m_min[i]) * 0.5f;
+		float axis = Dot(toCamera[i], toCamera[i]);
+
+		center[i] = pGeometry->m_min[i] + extent;
+		radius += extent * extent;
+
+		if (axis > scale) {
+			scale = axis;
+		}
+	}
+
+	radius = (float) sqrt(radius * scale);
+	Transform(center, 1.0f, toCamera, center);
+
+	if (center[2] + radius < m_front || center[2] - radius > m_back) {
+		return;
+	}
+
+	float halfWidth = (m_viewport.right - m_viewport.left) * 0.5f;
+	float halfHeight = (m_viewport.bottom - m_viewport.top) * 0.5f;
+
+	if (perspective) {
+		// Distance to the side planes x = +-z * kx and y = +-z * ky
+		float kx = halfWidth / m_scale;
+		float ky = halfHeight / m_scale;
+
+		if ((float) fabs(center[0]) - center[2] * kx > radius * (float) sqrt(1.0f + kx * kx) ||
+			(float) fabs(center[1]) - center[2] * ky > radius * (float) sqrt(1.0f + ky * ky)) {
+			return;
+		}
+	}
+	else if ((float) fabs(center[0]) - halfWidth / m_scale > radius ||
+			 (float) fabs(center[1]) - halfHeight / m_scale > radius) {
+		return;
+	}
+
+	if (pGeometry->m_vertexCount > (unsigned long) m_scratchSize) {
+		delete[] m_cameraPositions;
+		delete[] m_rasterVertices;
+		m_scratchSize = pGeometry->m_vertexCount;
+		m_cameraPositions = new float[m_scratchSize][3];
+		m_rasterVertices = new RasterVertex[m_scratchSize];
+	}
+
+	RasterState state;
+	state.m_texture = pTexture && pTexture->m_texels ? &pTexture->m_raster : NULL;
+	state.m_perspective = state.m_texture && perspective && rMesh.m_mappingMode == PerspectiveCorrect;
+	state.m_alpha = color[3];
+
+	float unlit[3] = {1.0f, 1.0f, 1.0f};
+
+	// Transform, light and project each vertex once; faces share them
+	for (i = 0; i < pGeometry->m_vertexCount; i++) {
+		const Vertex& rSource = pGeometry->m_vertices[i];
+		float* position = m_cameraPositions[i];
+		RasterVertex& rVertex = m_rasterVertices[i];
+
+		Transform(rSource.m_position, 1.0f, toCamera, position);
+		rVertex.m_u = rSource.m_tu;
+		rVertex.m_v = rSource.m_tv;
+
+		if (shading == Gouraud || shading == Phong) {
+			float normal[3];
+
+			Transform(rSource.m_normal, 0.0f, toCamera, normal);
+			Normalize(normal);
+			Illuminate(normal, position, color, rVertex);
+		}
+		else {
+			SetVertexColor(rVertex, color, unlit);
+		}
+
+		if (position[2] >= m_front) {
+			Project(position, rVertex);
+		}
+	}
+
+	for (i = 0; i < pGeometry->m_faceCount; i++) {
+		const unsigned long* face = pGeometry->m_faces[i];
+		const float* positions[3];
+		const RasterVertex* vertices[3];
+		int behind = 0;
+		int beyond = 0;
+		int k;
+
+		for (k = 0; k < 3; k++) {
+			positions[k] = m_cameraPositions[face[k]];
+			vertices[k] = &m_rasterVertices[face[k]];
+			behind += positions[k][2] < m_front;
+			beyond += positions[k][2] > m_back;
+		}
+
+		if (behind == 3 || beyond == 3) {
+			continue;
+		}
+
+		// Front faces are clockwise as seen from the camera, so their normal points towards it
+		float edge1[3];
+		float edge2[3];
+		float normal[3];
+
+		for (k = 0; k < 3; k++) {
+			edge1[k] = positions[1][k] - positions[0][k];
+			edge2[k] = positions[2][k] - positions[0][k];
+		}
+
+		normal[0] = edge1[1] * edge2[2] - edge1[2] * edge2[1];
+		normal[1] = edge1[2] * edge2[0] - edge1[0] * edge2[2];
+		normal[2] = edge1[0] * edge2[1] - edge1[1] * edge2[0];
+
+		if (perspective ? Dot(normal, positions[0]) >= 0.0f : normal[2] >= 0.0f) {
+			continue;
+		}
+
+		if (shading == Wireframe) {
+			if (behind == 0) {
+				m_rasterizer.AddLine(*vertices[0], *vertices[1], state);
+				m_rasterizer.AddLine(*vertices[1], *vertices[2], state);
+				m_rasterizer.AddLine(*vertices[2], *vertices[0], state);
+			}
+
+			continue;
+		}
+
+		RasterVertex flat[3];
+
+		if (shading == Flat) {
+			float center[3];
+
+			for (k = 0; k < 3; k++) {
+				center[k] = (positions[0][k] + positions[1][k] + positions[2][k]) * (1.0f / 3.0f);
+			}
+
+			RasterVertex lit;
+			Normalize(normal);
+			Illuminate(normal, center, color, lit);
+
+			for (k = 0; k < 3; k++) {
+				flat[k] = *vertices[k];
+				flat[k].m_r = lit.m_r;
+				flat[k].m_g = lit.m_g;
+				flat[k].m_b = lit.m_b;
+				vertices[k] = &flat[k];
+			}
+		}
+
+		if (behind == 0) {
+			DrawTriangle(*vertices[0], *vertices[1], *vertices[2], state);
+		}
+		else {
+			DrawClipped(positions, vertices, state);
+		}
+	}
+}
+
+void ViewImpl::DrawTriangle(
+	const RasterVertex& rV0,
+	const RasterVertex& rV1,
+	const RasterVertex& rV2,
+	const RasterState& rState
+)
+{
+	if (rState.m_perspective) {
+		RasterVertex v0 = rV0;
+		RasterVertex v1 = rV1;
+		RasterVertex v2 = rV2;
+
+		v0.m_u *= v0.m_invW;
+		v0.m_v *= v0.m_invW;
+		v1.m_u *= v1.m_invW;
+		v1.m_v *= v1.m_invW;
+		v2.m_u *= v2.m_invW;
+		v2.m_v *= v2.m_invW;
+		m_rasterizer.AddTriangle(v0, v1, v2, rState);
+	}
+	else {
+		m_rasterizer.AddTriangle(rV0, rV1, rV2, rState);
+	}
+}
+
+// Clips a triangle with at least one vertex in front of the front clipping plane against it, in camera space
+void ViewImpl::DrawClipped(
+	const float* const pPositions[3],
+	const RasterVertex* const pVertices[3],
+	const RasterState& rState
+)
+{
+	float positions[4][3];
+	RasterVertex vertices[4];
+	int count = 0;
+
+	for (int i = 0; i < 3; i++) {
+		int next = i == 2 ? 0 : i + 1;
+		float distance = pPositions[i][2] - m_front;
+		float nextDistance = pPositions[next][2] - m_front;
+
+		if (distance >= 0.0f) {
+			memcpy(positions[count], pPositions[i], sizeof(positions[count]));
+			vertices[count++] = *pVertices[i];
+		}
+
+		if ((distance >= 0.0f) != (nextDistance >= 0.0f)) {
+			float t = distance / (distance - nextDistance);
+
+			for (int k = 0; k < 3; k++) {
+				positions[count][k] = pPositions[i][k] + (pPositions[next][k] - pPositions[i][k]) * t;
+			}
+
+			// Exactly on the plane, whatever the rounding
+			positions[count][2] = m_front;
+			LerpAttributes(*pVertices[i], *pVertices[next], t, vertices[count]);
+			Project(positions[count], vertices[count]);
+			count++;
+		}
+	}
+
+	for (int i = 1; i + 1 < count; i++) {
+		DrawTriangle(vertices[0], vertices[i], vertices[i + 1], rState);
+	}
+}
+
+void ViewImpl::Illuminate(const float normal[3], const float position[3], const float color[3], RasterVertex& rVertex)
+	const
+{
+	float intensity[3];
+
+	intensity[0] = m_ambient[0];
+	intensity[1] = m_ambient[1];
+	intensity[2] = m_ambient[2];
+
+	for (int i = 0; i < m_sceneLightCount; i++) {
+		const SceneLight& rLight = m_sceneLights[i];
+		float factor;
+
+		if (rLight.m_type == Directional || rLight.m_type == ParallelPoint) {
+			factor = -Dot(normal, rLight.m_direction);
+		}
+		else {
+			// Point and spot lights, without attenuation or cone
+			float direction[3];
+
+			direction[0] = rLight.m_position[0] - position[0];
+			direction[1] = rLight.m_position[1] - position[1];
+			direction[2] = rLight.m_position[2] - position[2];
+			Normalize(direction);
+			factor = Dot(normal, direction);
+		}
+
+		if (factor > 0.0f) {
+			intensity[0] += rLight.m_color[0] * factor;
+			intensity[1] += rLight.m_color[1] * factor;
+			intensity[2] += rLight.m_color[2] * factor;
+		}
+	}
+
+	SetVertexColor(rVertex, color, intensity);
+}
+
+void ViewImpl::Project(const float camera[3], RasterVertex& rVertex) const
+{
+	float centerX = (m_viewport.right - m_viewport.left) * 0.5f;
+	float centerY = (m_viewport.bottom - m_viewport.top) * 0.5f;
+
+	if (m_projection == Perspective) {
+		float invW = 1.0f / camera[2];
+
+		rVertex.m_x = centerX + camera[0] * m_scale * invW;
+		rVertex.m_y = centerY - camera[1] * m_scale * invW;
+		rVertex.m_z = (1.0f / m_front - invW) / (1.0f / m_front - 1.0f / m_back);
+		rVertex.m_invW = invW;
+	}
+	else {
+		rVertex.m_x = centerX + camera[0] * m_scale;
+		rVertex.m_y = centerY - camera[1] * m_scale;
+		rVertex.m_z = (camera[2] - m_front) / (m_back - m_front);
+		rVertex.m_invW = 1.0f;
+	}
+}
+
+Result ViewImpl::ForceUpdate(unsigned long, unsigned long, unsigned long, unsigned long)
+{
+	// Render writes straight to the device's buffers
+	return Success;
+}
+
+// Returns the homogeneous screen position, i.e. the device coordinates and depth multiplied by w, like Direct3D RM
+Result ViewImpl::TransformWorldToScreen(const float world[3], float screen[4])
+{
+	float camera[3];
+	RasterVertex vertex;
+
+	UpdateCamera();
+	Transform(world, 1.0f, m_worldToCamera, camera);
+
+	if (m_projection == Perspective && camera[2] == 0.0f) {
+		return Error;
+	}
+
+	Project(camera, vertex);
+
+	float w = m_projection == Perspective ? camera[2] : 1.0f;
+	screen[0] = (vertex.m_x + m_viewport.left) * w;
+	screen[1] = (vertex.m_y + m_viewport.top) * w;
+	screen[2] = vertex.m_z * w;
+	screen[3] = w;
+	return Success;
+}
+
+Result ViewImpl::TransformScreenToWorld(const float screen[4], float world[3])
+{
+	float camera[3];
+	float w = screen[3];
+
+	if (w == 0.0f) {
+		return Error;
+	}
+
+	float x = screen[0] / w - m_viewport.left - (m_viewport.right - m_viewport.left) * 0.5f;
+	float y = (m_viewport.bottom - m_viewport.top) * 0.5f - (screen[1] / w - m_viewport.top);
+
+	if (m_projection == Perspective) {
+		camera[2] = w;
+		camera[0] = x * w / m_scale;
+		camera[1] = y * w / m_scale;
+	}
+	else {
+		camera[2] = m_front + screen[2] / w * (m_back - m_front);
+		camera[0] = x / m_scale;
+		camera[1] = y / m_scale;
+	}
+
+	UpdateCamera();
+	Transform(camera, 1.0f, m_cameraToWorld, world);
+	return Success;
+}
+
+Result ViewImpl::Pick(
+	unsigned long,
+	unsigned long,
+	const Group**,
+	int,
+	const Group**& rppPickedGroups,
+	int& rPickedGroupCount
+)
+{
+	// Picking is left to the callers' own bounding volume tests
+	rppPickedGroups = NULL;
+	rPickedGroupCount = 0;
+	return Error;
+}
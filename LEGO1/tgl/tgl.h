@@ -3,9 +3,30 @@
 
 #include "tglvector.h"
 
+#ifdef _WIN32
 #include <d3d.h>
 #include <ddraw.h>
 #include <windows.h>
+#else
+// Only the software renderer builds without Windows. It fills in D3DVECTORs; the other types are only passed through
+struct _D3DVECTOR {
+	float x;
+	float y;
+	float z;
+};
+
+struct GUID;
+struct HWND__;
+struct HDC__;
+struct IDirect3D2;
+struct IDirect3DDevice2;
+struct IDirectDraw;
+struct IDirectDrawSurface;
+typedef HWND__* HWND;
+typedef HDC__* HDC;
+typedef unsigned short WORD;
+typedef _D3DVECTOR D3DVECTOR;
+#endif
 
 namespace Tgl
 {
@@ -308,6 +329,13 @@ class Renderer : public Object {
  */
 Renderer* CreateRenderer();
 
+/**
+ * @brief [AI] Instantiates the software renderer, which rasterizes on the CPU instead of using Direct3D. [AI]
+ * @details [AI] Defined by the tglsoft library, see TglSoft::RendererImpl. [AI]
+ * @return Renderer* New renderer or nullptr on error. [AI]
+ */
+Renderer* CreateSoftRenderer();
+
 // VTABLE: LEGO1 0x100db9b8
 // VTABLE: BETA10 0x101c32b0
 /**
@@ -6,7 +6,7 @@
 
 #include <vec.h>
 
-DECOMP_SIZE_ASSERT(ViewManager, 0x1bc)
+DECOMP_SIZE_ASSERT(ViewManager, 0x1c4)
 
 // GLOBAL: LEGO1 0x100dbc78
 int g_boundingBoxCornerMap[8][3] =
@@ -30,6 +30,8 @@ float g_unk0x1010105c = 0.000125F;
 // GLOBAL: LEGO1 0x10101060
 float g_elapsedSeconds = 0;
 
+double g_totalUpdateSeconds = 0;
+
 inline void SetAppData(ViewROI* p_roi, LPD3DRM_APPDATA data);
 inline undefined4 GetD3DRM(IDirect3DRM2*& d3drm, Tgl::Renderer* pRenderer);
 inline undefined4 GetFrame(IDirect3DRMFrame2*& frame, Tgl::Group* scene);
@@ -51,6 +53,8 @@ ViewManager::ViewManager(Tgl::Renderer* pRenderer, Tgl::Group* scene, const Orie
 
 	memset(transformed_points, 0, sizeof(transformed_points));
 	seconds_allowed = 1.0;
+	visible_roi_count = 0;
+	culled_roi_count = 0;
 }
 
 // FUNCTION: LEGO1 0x100a60c0
@@ -91,6 +95,30 @@ unsigned int ViewManager::IsBoundingBoxInFrustum(const BoundingBox& p_bounding_b
 	return TRUE;
 }
 
+inline int ViewManager::IsSphereInFrustum(const BoundingSphere& p_sphere, unsigned int& p_planes)
+{
+	const Vector3& center = p_sphere.Center();
+	float radius = p_sphere.Radius();
+
+	for (int i = 0; i < 6; i++) {
+		if (p_planes & (1 << i)) {
+			// Planes are unit length and face inwards, see IsBoundingBoxInFrustum
+			float distance = frustum_planes[i][0] * center[0] + frustum_planes[i][1] * center[1] +
+							 frustum_planes[i][2] * center[2] + frustum_planes[i][3];
+
+			if (distance < -radius) {
+				return FALSE;
+			}
+
+			if (distance >= radius) {
+				p_planes &= ~(1 << i);
+			}
+		}
+	}
+
+	return TRUE;
+}
+
 // FUNCTION: LEGO1 0x100a6410
 void ViewManager::Remove(ViewROI* p_roi)
 {
@@ -220,7 +248,7 @@ void ViewManager::RemoveROIDetailFromScene(ViewROI* p_roi)
 }
 
 // FUNCTION: LEGO1 0x100a66f0
-inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_roi, int p_und)
+inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_roi, int p_und, unsigned int p_planes)
 {
 	if (!p_roi->GetVisibility() && p_und != -2) {
 		ManageVisibilityAndDetailRecursively(p_roi, -2);
@@ -228,6 +256,25 @@ inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_roi, in
 	else {
 		const CompoundObject* comp = p_roi->GetComp();
 
+		if (p_und != -2 && p_planes != 0 && (flags & c_frustumValid) &&
+			p_roi->GetWorldBoundingSphere().Radius() > 0.001F &&
+			!IsSphereInFrustum(p_roi->GetWorldBoundingSphere(), p_planes)) {
+			culled_roi_count++;
+
+			// A compound that is already hidden as a whole does not need its subtree walked again
+			if (p_roi->GetUnknown0xe0() == -2) {
+				return;
+			}
+
+			ManageVisibilityAndDetailRecursively(p_roi, -2);
+
+			if (comp != NULL) {
+				p_roi->SetUnknown0xe0(-2);
+			}
+
+			return;
+		}
+
 		if (p_und == -1) {
 			if (p_roi->GetWorldBoundingSphere().Radius() > 0.001F) {
 				float und = ProjectedSize(p_roi->GetWorldBoundingSphere());
@@ -260,6 +307,11 @@ inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_roi, in
 		else if (comp == NULL) {
 			if (p_roi->GetLODs() != NULL && p_roi->GetLODCount() > 0) {
 				UpdateROIDetailBasedOnLOD(p_roi, p_und);
+
+				if (p_roi->GetUnknown0xe0() >= 0) {
+					visible_roi_count++;
+				}
+
 				return;
 			}
 		}
@@ -267,7 +319,7 @@ inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_roi, in
 			p_roi->SetUnknown0xe0(-1);
 
 			for (CompoundObject::const_iterator it = comp->begin(); !(it == comp->end()); it++) {
-				ManageVisibilityAndDetailRecursively((ViewROI*) *it, p_und);
+				ManageVisibilityAndDetailRecursively((ViewROI*) *it, p_und, p_planes);
 			}
 		}
 	}
@@ -289,12 +341,21 @@ void ViewManager::Update(float p_previousRenderTime, float)
 		UpdateViewTransformations();
 	}
 
+	visible_roi_count = 0;
+	culled_roi_count = 0;
+
 	for (CompoundObject::iterator it = rois.begin(); it != rois.end(); it++) {
 		ManageVisibilityAndDetailRecursively((ViewROI*) *it, -1);
 	}
 
 	stopWatch.Stop();
 	g_elapsedSeconds = stopWatch.ElapsedSeconds();
+	g_totalUpdateSeconds += stopWatch.ElapsedSeconds();
+}
+
+double ViewManager::GetTotalUpdateSeconds()
+{
+	return g_totalUpdateSeconds;
 }
 
 inline int ViewManager::CalculateFrustumTransformations()
@@ -302,6 +363,7 @@ inline int ViewManager::CalculateFrustumTransformations()
 	flags &= ~c_bit3;
 
 	if (height == 0.0F || front == 0.0F) {
+		flags &= ~c_frustumValid;
 		return -1;
 	}
 	else {
@@ -346,6 +408,7 @@ inline int ViewManager::CalculateFrustumTransformations()
 		// clang-format on
 
 		UpdateViewTransformations();
+		flags |= c_frustumValid;
 		return 0;
 	}
 }
@@ -422,23 +485,23 @@ void ViewManager::UpdateViewTransformations()
 	}
 
 	for (i = 0; i < 6; i++) {
-		Vector3 a(transformed_points[g_planePointIndexMap[i * 3]]);
-		Vector3 b(transformed_points[g_planePointIndexMap[i * 3 + 1]]);
-		Vector3 c(transformed_points[g_planePointIndexMap[i * 3 + 2]]);
-		Mx3DPointFloat x;
-		Mx3DPointFloat y;
-		Vector3 normal(frustum_planes[i]);
-
-		x = c;
-		x -= b;
-
-		y = a;
-		y -= b;
-
-		normal.EqualsCross(x, y);
-		normal.Unitize();
+		const float* a = transformed_points[g_planePointIndexMap[i * 3]];
+		const float* b = transformed_points[g_planePointIndexMap[i * 3 + 1]];
+		const float* c = transformed_points[g_planePointIndexMap[i * 3 + 2]];
+		float x[3];
+		float y[3];
+		float* normal = frustum_planes[i];
+
+		VMV3(x, c, b);
+		VMV3(y, a, b);
+		VXV3(normal, x, y);
+
+		float len = sqrt(NORMSQRD3(normal));
+		if (len > 0.0f) {
+			VDS3(normal, normal, len);
+		}
 
-		frustum_planes[i][3] = -normal.Dot(normal, a);
+		frustum_planes[i][3] = -DOT3(normal, a);
 	}
 
 	flags |= c_bit4;
@@ -8,7 +8,7 @@
 #include <d3drm.h>
 
 // VTABLE: LEGO1 0x100dbd88
-// SIZE 0x1bc
+// SIZE 0x1c4
 /**
  * @brief [AI] Manages all ViewROI objects that are rendered in a given scene, handles frustum culling, LOD management, and visibility determination for 3D ROI objects. Coordinates detail level based on view parameters and maintains view transformation matrices for efficient rendering.
  * @details [AI] ViewManager is responsible for controlling the rendering of all 3D real-time object instances (ROIs) in the current scene. It maintains a collection of ViewROI objects, calculates visibility based on the camera's frustum, manages geometric detail levels according to projected object size and LOD thresholds, and applies transformations for the scene's camera (point-of-view) parameters. It provides utility for picking ROI objects using screen coordinates and is tightly bound to the Direct3DRM retained mode pipeline.
@@ -22,7 +22,12 @@ class ViewManager {
 		c_bit1 = 0x01, ///< [AI] Used to signals a pending operation (exact purpose is contextually flagged during update routines).
 		c_bit2 = 0x02, ///< [AI] Indicates the need to update view transformation matrices.
 		c_bit3 = 0x04, ///< [AI] Indicates the need to recalculate frustum parameters (e.g., due to a resolution or frustum change).
-		c_bit4 = 0x08  ///< [AI] Signals that the frustum parameters/planes are valid and up to date.
+		c_bit4 = 0x08, ///< [AI] Signals that the frustum parameters/planes are valid and up to date.
+		c_frustumValid = 0x10 ///< [AI] The frustum planes were computed from a real resolution and frustum, so Update() may cull against them.
+	};
+
+	enum {
+		c_allPlanes = 0x3f ///< [AI] Plane mask selecting all six frustum planes, see IsSphereInFrustum().
 	};
 
 	/**
@@ -111,8 +116,18 @@ class ViewManager {
 	 * @brief [AI] Recursively traverses and updates the visibility and LOD detail of a ROI and its children, based on projected size and thresholds.
 	 * @param p_roi [AI] The starting ROI for recursive update.
 	 * @param p_und [AI] LOD index, or -1 to auto-calculate, or -2 to hide.
+	 * @param p_planes [AI] Frustum planes the ROI still has to be tested against. ROIs fully outside one of them are
+	 * hidden together with their whole subtree; planes the ROI lies fully inside of are not tested again for its children.
 	 */
-	inline void ManageVisibilityAndDetailRecursively(ViewROI* p_roi, int p_und);
+	inline void ManageVisibilityAndDetailRecursively(ViewROI* p_roi, int p_und, unsigned int p_planes = c_allPlanes);
+
+	/**
+	 * @brief [AI] Tests a bounding sphere against the frustum planes selected by p_planes.
+	 * @param p_sphere [AI] World space bounding sphere.
+	 * @param p_planes [AI] In: planes to test. Out: the subset the sphere straddles, which is all its children need testing against.
+	 * @return [AI] FALSE if the sphere lies entirely outside one of the planes, TRUE otherwise.
+	 */
+	inline int IsSphereInFrustum(const BoundingSphere& p_sphere, unsigned int& p_planes);
 
 	/**
 	 * @brief [AI] Performs the per-frame update: applies frustum/view updates if needed and recurses the ROI graph for visibility/LOD/detail management.
@@ -160,6 +175,21 @@ class ViewManager {
 	 */
 	void Add(ViewROI* p_roi) { rois.push_back(p_roi); }
 
+	/**
+	 * @brief [AI] Number of ROIs given geometry by the last Update().
+	 */
+	int GetVisibleROICount() const { return visible_roi_count; }
+
+	/**
+	 * @brief [AI] Number of ROIs (whole subtrees counted once) rejected by frustum culling in the last Update().
+	 */
+	int GetCulledROICount() const { return culled_roi_count; }
+
+	/**
+	 * @brief [AI] Total time spent in Update() by all view managers since startup, in seconds.
+	 */
+	static double GetTotalUpdateSeconds();
+
 	// SYNTHETIC: LEGO1 0x100a6000
 	// ViewManager::`scalar deleting destructor'
 
@@ -183,6 +213,8 @@ class ViewManager {
 	IDirect3DRM2* d3drm;            ///< [AI] Pointer to the Direct3DRM2 interface for scene and geometry operations.
 	IDirect3DRMFrame2* frame;       ///< [AI] The root Direct3DRM frame for the managed scene.
 	float seconds_allowed;          ///< [AI] Timing threshold, used in projected size and LOD visibility cutoff (to skip too small/insignificant objects).
+	int visible_roi_count;          ///< [AI] ROIs given geometry during the last Update().
+	int culled_roi_count;           ///< [AI] ROIs rejected by frustum culling during the last Update().
 };
 
 // TEMPLATE: LEGO1 0x10022030
@@ -0,0 +1,341 @@
+#include "flic.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Runs random BRUN, LC, SS2, BLACK and COPY chunks through the clamping FLC decoders and through the fast ones used
+// when the frame fits inside the bitmap, and compares the bitmaps byte for byte. LC and SS2 packets may run past the
+// right edge of the bitmap and SS2 rows past its bottom, which the fast decoders hand back to the clamping helpers.
+// -frames N instead decodes one full-size chunk of each type N times with both decoders and reports frames per second.
+//
+//   flictest [-frames N] [-size WIDTHxHEIGHT]
+
+void DecodeBrun(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeLC(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeBlack(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeCopy(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeBrunFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeLCFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeSS2Fast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeBlackFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeCopyFast(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+
+typedef void (*Decoder)(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+
+enum ChunkType {
+	e_brun,
+	e_lc,
+	e_ss2,
+	e_black,
+	e_copy,
+	e_numChunkTypes
+};
+
+struct ChunkDecoders {
+	const char* m_name;
+	Decoder m_clamping;
+	Decoder m_fast;
+};
+
+static const ChunkDecoders g_decoders[e_numChunkTypes] = {
+	{"BRUN", DecodeBrun, DecodeBrunFast},
+	{"LC", DecodeLC, DecodeLCFast},
+	{"SS2", DecodeSS2, DecodeSS2Fast},
+	{"BLACK", DecodeBlack, DecodeBlackFast},
+	{"COPY", DecodeCopy, DecodeCopyFast}
+};
+
+enum {
+	c_maxBitmapSize = 1024 * 1024,
+	c_maxChunkSize = 4 * 1024 * 1024,
+	c_guard = 64
+};
+
+static BYTE g_chunk[c_maxChunkSize];
+static BYTE g_expected[c_maxBitmapSize + c_guard];
+static BYTE g_actual[c_maxBitmapSize + c_guard];
+static DWORD g_seed = 1;
+
+static DWORD Random(DWORD p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return (g_seed >> 16) % p_range;
+}
+
+// Appends little-endian values to g_chunk
+class ChunkWriter {
+public:
+	ChunkWriter() : m_size(0) {}
+
+	void Put8(int p_value) { g_chunk[m_size++] = (BYTE) p_value; }
+
+	void Put16(int p_value)
+	{
+		Put8(p_value & 0xff);
+		Put8((p_value >> 8) & 0xff);
+	}
+
+	void PutRandom(int p_count)
+	{
+		while (p_count--) {
+			Put8(Random(256));
+		}
+	}
+
+private:
+	DWORD m_size;
+};
+
+// Every line is covered exactly by runs and literals, as the format requires
+static void WriteBrun(ChunkWriter& p_writer, int p_width, int p_height)
+{
+	for (int row = 0; row < p_height; row++) {
+		p_writer.Put8(0); // packet count, ignored by the decoders
+
+		for (int column = 0; column < p_width;) {
+			int count = 1 + Random(p_width - column < 127 ? p_width - column : 127);
+
+			if (Random(2)) {
+				p_writer.Put8(count);
+				p_writer.Put8(Random(256));
+			}
+			else {
+				p_writer.Put8(-count);
+				p_writer.PutRandom(count);
+			}
+
+			column += count;
+		}
+	}
+}
+
+// Skip bytes and packet lengths are random, so some packets end past the right edge of the bitmap
+static void WriteLC(ChunkWriter& p_writer, int p_width, int p_height)
+{
+	int skip = Random(p_height);
+	int lines = Random(p_height - skip + 1);
+
+	p_writer.Put16(skip);
+	p_writer.Put16(lines);
+
+	while (lines--) {
+		int packets = Random(6);
+		p_writer.Put8(packets);
+
+		while (packets--) {
+			int count = Random(p_width / 2 + 2);
+
+			p_writer.Put8(Random(p_width / 2 + 1));
+
+			if (count > 0 && Random(2)) {
+				p_writer.Put8(-(count > 127 ? 127 : count));
+				p_writer.Put8(Random(256));
+			}
+			else {
+				count = count > 127 ? 127 : count;
+				p_writer.Put8(count);
+				p_writer.PutRandom(count);
+			}
+		}
+	}
+}
+
+// Lines may start with a line skip and a last-pixel word, and skips may move rows below the bottom of the bitmap
+static void WriteSS2(ChunkWriter& p_writer, int p_width, int p_height)
+{
+	int lines = 1 + Random(p_height + 1);
+
+	// The decoder handles one line fewer than the count it reads
+	p_writer.Put16(lines + 1);
+
+	while (lines--) {
+		if (Random(4) == 0) {
+			p_writer.Put16(-(int) (1 + Random(3)));
+		}
+
+		if (Random(4) == 0) {
+			p_writer.Put16(0x8000 | Random(256));
+		}
+
+		int packets = 1 + Random(4);
+		p_writer.Put16(packets);
+
+		while (packets--) {
+			int pairs = Random(p_width / 4 + 2);
+			pairs = pairs > 127 ? 127 : pairs;
+
+			p_writer.Put8(Random(p_width / 2 + 1));
+
+			if (pairs > 0 && Random(2)) {
+				p_writer.Put8(-pairs);
+
+				// Pairs of equal bytes take the memset path of the fast decoder
+				int pixel = Random(256);
+				p_writer.Put8(pixel);
+				p_writer.Put8(Random(2) ? pixel : Random(256));
+			}
+			else {
+				p_writer.Put8(pairs);
+				p_writer.PutRandom(pairs * 2);
+			}
+		}
+	}
+}
+
+static void WriteChunk(ChunkWriter& p_writer, ChunkType p_type, int p_width, int p_height)
+{
+	switch (p_type) {
+	case e_brun:
+		WriteBrun(p_writer, p_width, p_height);
+		break;
+	case e_lc:
+		WriteLC(p_writer, p_width, p_height);
+		break;
+	case e_ss2:
+		WriteSS2(p_writer, p_width, p_height);
+		break;
+	case e_copy:
+		p_writer.PutRandom(p_width * p_height);
+		break;
+	default:
+		break;
+	}
+}
+
+static DWORD GetBitmapSize(const BITMAPINFOHEADER& p_header)
+{
+	return ((p_header.biWidth + 3) & -4) * p_header.biHeight;
+}
+
+static int RunCase(ChunkType p_type, int p_width, int p_height, int p_extraWidth, int p_extraHeight)
+{
+	FLIC_HEADER flcHeader;
+	BITMAPINFOHEADER bitmapHeader;
+	ChunkWriter writer;
+
+	memset(&flcHeader, 0, sizeof(flcHeader));
+	flcHeader.width = p_width;
+	flcHeader.height = p_height;
+
+	memset(&bitmapHeader, 0, sizeof(bitmapHeader));
+	bitmapHeader.biSize = sizeof(bitmapHeader);
+	bitmapHeader.biWidth = p_width + p_extraWidth;
+	bitmapHeader.biHeight = p_height + p_extraHeight;
+
+	WriteChunk(writer, p_type, p_width, p_height);
+
+	DWORD size = GetBitmapSize(bitmapHeader) + c_guard;
+	for (DWORD i = 0; i < size; i++) {
+		g_expected[i] = Random(256);
+	}
+	memcpy(g_actual, g_expected, size);
+
+	g_decoders[p_type].m_clamping(&bitmapHeader, g_expected, g_chunk, &flcHeader);
+	g_decoders[p_type].m_fast(&bitmapHeader, g_actual, g_chunk, &flcHeader);
+
+	if (memcmp(g_expected, g_actual, size)) {
+		printf(
+			"%s differs: frame %dx%d, bitmap %dx%d\n",
+			g_decoders[p_type].m_name,
+			p_width,
+			p_height,
+			(int) bitmapHeader.biWidth,
+			(int) bitmapHeader.biHeight
+		);
+		return 1;
+	}
+
+	return 0;
+}
+
+static void Benchmark(int p_frames, int p_width, int p_height)
+{
+	FLIC_HEADER flcHeader;
+	BITMAPINFOHEADER bitmapHeader;
+
+	memset(&flcHeader, 0, sizeof(flcHeader));
+	flcHeader.width = p_width;
+	flcHeader.height = p_height;
+
+	memset(&bitmapHeader, 0, sizeof(bitmapHeader));
+	bitmapHeader.biSize = sizeof(bitmapHeader);
+	bitmapHeader.biWidth = p_width;
+	bitmapHeader.biHeight = p_height;
+
+	for (int type = 0; type < e_numChunkTypes; type++) {
+		ChunkWriter writer;
+		DWORD elapsed[2];
+
+		WriteChunk(writer, (ChunkType) type, p_width, p_height);
+
+		for (int fast = 0; fast < 2; fast++) {
+			Decoder decoder = fast ? g_decoders[type].m_fast : g_decoders[type].m_clamping;
+			DWORD start = GetTickCount();
+
+			for (int frame = 0; frame < p_frames; frame++) {
+				decoder(&bitmapHeader, g_actual, g_chunk, &flcHeader);
+			}
+
+			elapsed[fast] = GetTickCount() - start;
+		}
+
+		printf(
+			"%-5s %dx%d: %8.0f frames/s clamping, %8.0f frames/s fast\n",
+			g_decoders[type].m_name,
+			p_width,
+			p_height,
+			p_frames * 1000.0 / (elapsed[0] ? elapsed[0] : 1),
+			p_frames * 1000.0 / (elapsed[1] ? elapsed[1] : 1)
+		);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int width = 640;
+	int height = 480;
+	int frames = 0;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (!strcmp(argv[i], "-frames")) {
+			frames = atoi(argv[i + 1]);
+		}
+		else if (!strcmp(argv[i], "-size")) {
+			sscanf(argv[i + 1], "%dx%d", &width, &height);
+		}
+		else {
+			printf("unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (frames > 0) {
+		if (width < 1 || height < 1 || ((width + 3) & -4) * height > c_maxBitmapSize) {
+			printf("cannot decode %dx%d\n", width, height);
+			return 1;
+		}
+
+		Benchmark(frames, width, height);
+		return 0;
+	}
+
+	int failures = 0;
+	int cases = 0;
+
+	for (int type = 0; type < e_numChunkTypes; type++) {
+		for (int i = 0; i < 500; i++) {
+			failures += RunCase((ChunkType) type, 1 + Random(80), 1 + Random(40), Random(8), Random(4));
+			cases++;
+		}
+	}
+
+	if (failures) {
+		printf("%d of %d cases failed\n", failures, cases);
+		return 1;
+	}
+
+	printf("ok, %d cases\n", cases);
+	return 0;
+}
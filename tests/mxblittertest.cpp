@@ -0,0 +1,210 @@
+#include "mxblitter.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Runs every MxBlitter kernel against a plain per-pixel version of it and compares the whole destination buffer,
+// including the bytes around the rectangle. Covers widths around the four pixel loop, unaligned sources, unaligned
+// 8-bit destinations, bottom-up pitches and sources with runs of transparent (zero) indices.
+
+enum {
+	c_maxWidth = 19,
+	c_maxHeight = 3,
+	c_padding = 8,
+	c_srcStride = c_maxWidth + 5,
+	c_destPitch = 4 * c_maxWidth + 6,
+	c_srcSize = c_srcStride * c_maxHeight + 2 * c_padding,
+	c_destSize = c_destPitch * 2 * c_maxHeight + 2 * c_padding
+};
+
+enum Kernel {
+	e_copy8,
+	e_copyDoubled8,
+	e_copyTransparent8,
+	e_expand16,
+	e_expandDoubled16,
+	e_expandTransparent16,
+	e_numKernels
+};
+
+static const char* g_kernelNames[e_numKernels] =
+	{"Copy8", "CopyDoubled8", "CopyTransparent8", "Expand16", "ExpandDoubled16", "ExpandTransparent16"};
+
+static MxU32 g_seed = 1;
+
+static MxU32 Random()
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return g_seed >> 16;
+}
+
+static void StorePixel(MxU8* p_dest, MxU16 p_pixel)
+{
+	memcpy(p_dest, &p_pixel, sizeof(p_pixel));
+}
+
+static void Reference(
+	Kernel p_kernel,
+	MxU8* p_dest,
+	MxLong p_destPitch,
+	const MxU8* p_src,
+	MxLong p_srcStride,
+	MxS32 p_width,
+	MxS32 p_height,
+	const MxU16* p_palette
+)
+{
+	for (MxS32 y = 0; y < p_height; y++) {
+		const MxU8* src = p_src + y * p_srcStride;
+
+		for (MxS32 x = 0; x < p_width; x++) {
+			MxU8 index = src[x];
+
+			switch (p_kernel) {
+			case e_copy8:
+				p_dest[y * p_destPitch + x] = index;
+				break;
+			case e_copyDoubled8:
+				for (MxS32 i = 0; i < 4; i++) {
+					p_dest[(2 * y + i / 2) * p_destPitch + 2 * x + i % 2] = index;
+				}
+				break;
+			case e_copyTransparent8:
+				if (index != 0) {
+					p_dest[y * p_destPitch + x] = index;
+				}
+				break;
+			case e_expand16:
+				StorePixel(p_dest + y * p_destPitch + 2 * x, p_palette[index]);
+				break;
+			case e_expandDoubled16:
+				for (MxS32 i = 0; i < 4; i++) {
+					StorePixel(p_dest + (2 * y + i / 2) * p_destPitch + 4 * x + 2 * (i % 2), p_palette[index]);
+				}
+				break;
+			case e_expandTransparent16:
+				if (index != 0) {
+					StorePixel(p_dest + y * p_destPitch + 2 * x, p_palette[index]);
+				}
+				break;
+			default:
+				break;
+			}
+		}
+	}
+}
+
+static void Run(
+	Kernel p_kernel,
+	MxU8* p_dest,
+	MxLong p_destPitch,
+	const MxU8* p_src,
+	MxLong p_srcStride,
+	MxS32 p_width,
+	MxS32 p_height,
+	const MxU16* p_palette
+)
+{
+	switch (p_kernel) {
+	case e_copy8:
+		MxBlitter::Copy8(p_dest, p_destPitch, p_src, p_srcStride, p_width, p_height);
+		break;
+	case e_copyDoubled8:
+		MxBlitter::CopyDoubled8(p_dest, p_destPitch, p_src, p_srcStride, p_width, p_height);
+		break;
+	case e_copyTransparent8:
+		MxBlitter::CopyTransparent8(p_dest, p_destPitch, p_src, p_srcStride, p_width, p_height);
+		break;
+	case e_expand16:
+		MxBlitter::Expand16(p_dest, p_destPitch, p_src, p_srcStride, p_width, p_height, p_palette);
+		break;
+	case e_expandDoubled16:
+		MxBlitter::ExpandDoubled16(p_dest, p_destPitch, p_src, p_srcStride, p_width, p_height, p_palette);
+		break;
+	case e_expandTransparent16:
+		MxBlitter::ExpandTransparent16(p_dest, p_destPitch, p_src, p_srcStride, p_width, p_height, p_palette);
+		break;
+	default:
+		break;
+	}
+}
+
+static MxU16 g_palette[256];
+static MxU8 g_src[c_srcSize];
+static MxU8 g_expected[c_destSize];
+static MxU8 g_actual[c_destSize];
+
+int main()
+{
+	MxS32 i;
+
+	for (i = 0; i < 256; i++) {
+		g_palette[i] = (MxU16) Random();
+	}
+
+	for (i = 0; i < c_srcSize; i++) {
+		// Mostly zero in some stretches, so that all-transparent, mixed and opaque groups of four occur
+		g_src[i] = (i / 8) % 3 == 0 ? 0 : (Random() % 4 == 0 ? 0 : (MxU8) Random());
+	}
+
+	int failures = 0;
+	int cases = 0;
+
+	for (MxS32 kernel = 0; kernel < e_numKernels; kernel++) {
+		for (MxS32 width = 0; width <= c_maxWidth; width++) {
+			for (MxS32 height = 1; height <= c_maxHeight; height++) {
+				for (MxS32 srcOffset = 0; srcOffset < 4; srcOffset++) {
+					// 16-bit surfaces keep their pixels 16-bit aligned
+					for (MxS32 destOffset = 0; destOffset < 4; destOffset += kernel >= e_expand16 ? 2 : 1) {
+						for (MxS32 bottomUp = 0; bottomUp < 2; bottomUp++) {
+							MxS32 rows = kernel == e_copyDoubled8 || kernel == e_expandDoubled16 ? 2 * height : height;
+							const MxU8* src = g_src + c_padding + srcOffset;
+							MxLong srcStride = c_srcStride;
+							MxU8* expected = g_expected + c_padding + destOffset;
+							MxU8* actual = g_actual + c_padding + destOffset;
+							MxLong destPitch = c_destPitch;
+
+							if (bottomUp) {
+								src += (height - 1) * c_srcStride;
+								srcStride = -srcStride;
+								expected += (rows - 1) * c_destPitch;
+								actual += (rows - 1) * c_destPitch;
+								destPitch = -destPitch;
+							}
+
+							for (i = 0; i < c_destSize; i++) {
+								g_expected[i] = (MxU8) Random();
+							}
+							memcpy(g_actual, g_expected, sizeof(g_actual));
+
+							Reference((Kernel) kernel, expected, destPitch, src, srcStride, width, height, g_palette);
+							Run((Kernel) kernel, actual, destPitch, src, srcStride, width, height, g_palette);
+							cases++;
+
+							if (memcmp(g_expected, g_actual, sizeof(g_actual))) {
+								printf(
+									"%s differs: width %d, height %d, source offset %d, destination offset %d%s\n",
+									g_kernelNames[kernel],
+									width,
+									height,
+									srcOffset,
+									destOffset,
+									bottomUp ? ", bottom-up" : ""
+								);
+								failures++;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (failures) {
+		printf("%d of %d cases failed\n", failures, cases);
+		return 1;
+	}
+
+	printf("ok, %d cases\n", cases);
+	return 0;
+}
@@ -0,0 +1,267 @@
+#include "mxbitmap.h"
+#include "mxsmk.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Decodes a 16x8 Smacker frame built by hand and compares it against the pixels its blocks describe.
+// The stream holds one run of every block type: mono, full, fill, skip and a two block mono run.
+
+// Writes bits starting with the least significant bit of each byte, the order Smacker reads them in
+class BitWriter {
+public:
+	BitWriter() : m_count(0) { memset(m_data, 0, sizeof(m_data)); }
+
+	void Put(MxU32 p_value, MxU32 p_count)
+	{
+		for (MxU32 i = 0; i < p_count; i++, m_count++) {
+			m_data[m_count / 8] |= ((p_value >> i) & 1) << (m_count % 8);
+		}
+	}
+
+	const MxU8* GetData() const { return m_data; }
+	MxU32 GetSize() const { return (m_count + 7) / 8; }
+
+private:
+	MxU8 m_data[512];
+	MxU32 m_count;
+};
+
+// Distinct values of one Huffman tree, each leaf of a balanced tree over them
+struct Tree {
+	const MxU32* m_values;
+	MxU32 m_count;
+	MxU32 m_bytes[2][16];
+	MxU32 m_byteCounts[2];
+
+	void Init(const MxU32* p_values, MxU32 p_count)
+	{
+		m_values = p_values;
+		m_count = p_count;
+		m_byteCounts[0] = m_byteCounts[1] = 0;
+
+		for (MxU32 i = 0; i < p_count; i++) {
+			for (MxU32 j = 0; j < 2; j++) {
+				MxU32 byte = (p_values[i] >> (j * 8)) & 0xff;
+				MxU32 k;
+
+				for (k = 0; k < m_byteCounts[j] && m_bytes[j][k] != byte; k++) {
+				}
+
+				if (k == m_byteCounts[j]) {
+					m_bytes[j][m_byteCounts[j]++] = byte;
+				}
+			}
+		}
+	}
+};
+
+// Writes the code of p_value in the balanced tree over p_values[p_begin, p_end)
+static void WriteCode(BitWriter& p_writer, const MxU32* p_values, MxU32 p_begin, MxU32 p_end, MxU32 p_value)
+{
+	while (p_end - p_begin > 1) {
+		MxU32 middle = (p_begin + p_end) / 2;
+		MxU32 i;
+
+		for (i = p_begin; i < middle && p_values[i] != p_value; i++) {
+		}
+
+		if (i < middle) {
+			p_writer.Put(0, 1);
+			p_end = middle;
+		}
+		else {
+			p_writer.Put(1, 1);
+			p_begin = middle;
+		}
+	}
+}
+
+static void WriteByteTree(BitWriter& p_writer, const MxU32* p_values, MxU32 p_begin, MxU32 p_end)
+{
+	if (p_end - p_begin == 1) {
+		p_writer.Put(0, 1);
+		p_writer.Put(p_values[p_begin], 8);
+		return;
+	}
+
+	MxU32 middle = (p_begin + p_end) / 2;
+	p_writer.Put(1, 1);
+	WriteByteTree(p_writer, p_values, p_begin, middle);
+	WriteByteTree(p_writer, p_values, middle, p_end);
+}
+
+static void WriteBigTree(BitWriter& p_writer, const Tree& p_tree, MxU32 p_begin, MxU32 p_end)
+{
+	if (p_end - p_begin == 1) {
+		MxU32 value = p_tree.m_values[p_begin];
+		p_writer.Put(0, 1);
+		WriteCode(p_writer, p_tree.m_bytes[0], 0, p_tree.m_byteCounts[0], value & 0xff);
+		WriteCode(p_writer, p_tree.m_bytes[1], 0, p_tree.m_byteCounts[1], value >> 8);
+		return;
+	}
+
+	MxU32 middle = (p_begin + p_end) / 2;
+	p_writer.Put(1, 1);
+	WriteBigTree(p_writer, p_tree, p_begin, middle);
+	WriteBigTree(p_writer, p_tree, middle, p_end);
+}
+
+static void WriteTree(BitWriter& p_writer, const Tree& p_tree)
+{
+	p_writer.Put(1, 1);
+
+	for (MxU32 i = 0; i < 2; i++) {
+		p_writer.Put(1, 1);
+		WriteByteTree(p_writer, p_tree.m_bytes[i], 0, p_tree.m_byteCounts[i]);
+		p_writer.Put(0, 1);
+	}
+
+	// Escape values that no leaf uses
+	p_writer.Put(0xfffd, 16);
+	p_writer.Put(0xfffe, 16);
+	p_writer.Put(0xffff, 16);
+
+	WriteBigTree(p_writer, p_tree, 0, p_tree.m_count);
+	p_writer.Put(0, 1);
+}
+
+static void WriteValue(BitWriter& p_writer, const Tree& p_tree, MxU32 p_value)
+{
+	WriteCode(p_writer, p_tree.m_values, 0, p_tree.m_count, p_value);
+}
+
+// Type values: the block type in bits 0-1, the run length index in bits 2-7 and the fill color in bits 8-15
+static const MxU32 g_types[] = {
+	0x0000, // mono, one block
+	0x0001, // full, one block
+	0x5a07, // fill with 0x5a, two blocks
+	0x0006, // skip, two blocks
+	0x0004  // mono, two blocks
+};
+
+// Mono colors: the color of set map bits in the high byte, the other one in the low byte
+static const MxU32 g_monoColors[] = {0x2211, 0x4433, 0x6655};
+
+// Mono maps: four bits per row of the block, the lowest bit for the leftmost pixel
+static const MxU32 g_monoMaps[] = {0x8421, 0x000f, 0x1111};
+
+// Full block rows: the first value holds pixels 2 and 3 of a row, the second one pixels 0 and 1
+static const MxU32 g_full[] = {0x8382, 0x8180, 0x8786, 0x8584, 0x8b8a, 0x8988, 0x8f8e, 0x8d8c};
+
+static const MxU8 g_expected[8][16] = {
+	{0x22, 0x11, 0x11, 0x11, 0x80, 0x81, 0x82, 0x83, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a},
+	{0x11, 0x22, 0x11, 0x11, 0x84, 0x85, 0x86, 0x87, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a},
+	{0x11, 0x11, 0x22, 0x11, 0x88, 0x89, 0x8a, 0x8b, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a},
+	{0x11, 0x11, 0x11, 0x22, 0x8c, 0x8d, 0x8e, 0x8f, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a},
+	{0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0x44, 0x44, 0x44, 0x44, 0x66, 0x55, 0x55, 0x55},
+	{0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0x33, 0x33, 0x33, 0x33, 0x66, 0x55, 0x55, 0x55},
+	{0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0x33, 0x33, 0x33, 0x33, 0x66, 0x55, 0x55, 0x55},
+	{0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0x33, 0x33, 0x33, 0x33, 0x66, 0x55, 0x55, 0x55}
+};
+
+#define COUNT(array) (sizeof(array) / sizeof(array[0]))
+
+static MxSmk g_smk;
+static MxU8 g_header[1024];
+
+int main()
+{
+	Tree trees[MxSmkTree::e_numTrees];
+	trees[MxSmkTree::e_monoMap].Init(g_monoMaps, COUNT(g_monoMaps));
+	trees[MxSmkTree::e_monoColors].Init(g_monoColors, COUNT(g_monoColors));
+	trees[MxSmkTree::e_full].Init(g_full, COUNT(g_full));
+	trees[MxSmkTree::e_type].Init(g_types, COUNT(g_types));
+
+	BitWriter tables;
+	MxU32 i;
+
+	for (i = 0; i < MxSmkTree::e_numTrees; i++) {
+		WriteTree(tables, trees[i]);
+	}
+
+	BitWriter frame;
+	WriteValue(frame, trees[MxSmkTree::e_type], 0x0000);
+	WriteValue(frame, trees[MxSmkTree::e_monoColors], 0x2211);
+	WriteValue(frame, trees[MxSmkTree::e_monoMap], 0x8421);
+	WriteValue(frame, trees[MxSmkTree::e_type], 0x0001);
+
+	for (i = 0; i < COUNT(g_full); i++) {
+		WriteValue(frame, trees[MxSmkTree::e_full], g_full[i]);
+	}
+
+	WriteValue(frame, trees[MxSmkTree::e_type], 0x5a07);
+	WriteValue(frame, trees[MxSmkTree::e_type], 0x0006);
+	WriteValue(frame, trees[MxSmkTree::e_type], 0x0004);
+	WriteValue(frame, trees[MxSmkTree::e_monoColors], 0x4433);
+	WriteValue(frame, trees[MxSmkTree::e_monoMap], 0x000f);
+	WriteValue(frame, trees[MxSmkTree::e_monoColors], 0x6655);
+	WriteValue(frame, trees[MxSmkTree::e_monoMap], 0x1111);
+
+	SmackTag tag;
+	memset(&tag, 0, sizeof(tag));
+	tag.Version = 0x324b4d53; // "SMK2"
+	tag.Width = 16;
+	tag.Height = 8;
+	tag.Frames = 1;
+	tag.tablesize = tables.GetSize();
+	tag.codesize = tag.absize = tag.detailsize = tag.typesize = 64;
+
+	MxU8* header = g_header;
+	MxU32 frameSize = frame.GetSize();
+	memcpy(header, &tag, SmackHeaderSize(&tag));
+	header += SmackHeaderSize(&tag);
+	memcpy(header, &frameSize, sizeof(frameSize));
+	header += sizeof(frameSize);
+	*header++ = 0;
+	memcpy(header, tables.GetData(), tables.GetSize());
+
+	if (MxSmk::LoadHeader(g_header, &g_smk) != SUCCESS) {
+		printf("LoadHeader failed\n");
+		return 1;
+	}
+
+	MxBITMAPINFO bitmapInfo;
+	MxU8 pixels[8][16];
+	MxU8 chunk[512];
+	MxU32 numRects;
+
+	memset(&bitmapInfo, 0, sizeof(bitmapInfo));
+	bitmapInfo.m_bmiHeader.biWidth = 16;
+	bitmapInfo.m_bmiHeader.biHeight = 8;
+	memset(pixels, 0xee, sizeof(pixels));
+	memcpy(chunk, frame.GetData(), frameSize);
+
+	if (MxSmk::LoadFrame(&bitmapInfo, &pixels[0][0], &g_smk, chunk, frameSize, FALSE, numRects) != SUCCESS) {
+		printf("LoadFrame failed\n");
+		return 1;
+	}
+
+	int failures = 0;
+
+	for (MxU32 y = 0; y < 8; y++) {
+		for (MxU32 x = 0; x < 16; x++) {
+			if (pixels[y][x] != g_expected[y][x]) {
+				printf("pixel %u,%u is 0x%02x, expected 0x%02x\n", x, y, pixels[y][x], g_expected[y][x]);
+				failures++;
+			}
+		}
+	}
+
+	// Both block rows changed, so they come back as one band over the whole frame
+	MxRect32& rect = g_smk.m_rects[0];
+	if (numRects != 1 || rect.GetLeft() != 0 || rect.GetTop() != 0 || rect.GetRight() != 15 ||
+		rect.GetBottom() != 7) {
+		printf("unexpected dirty rectangles\n");
+		failures++;
+	}
+
+	MxSmk::Destroy(&g_smk);
+
+	if (failures) {
+		return 1;
+	}
+
+	printf("ok\n");
+	return 0;
+}
@@ -0,0 +1,355 @@
+#include "mxsoundmixer.h"
+#include "mxsoundsink.h"
+#include "mxtimer.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Plays random voices through MxSoundMixer and compares every mixed chunk with a plain per-sample mixer.
+// The voices have random formats (8 or 16 bit, mono or stereo), rates, volumes, pans, lengths and start positions,
+// so resampling, the end of looping and one-shot buffers, gain and the 16-bit clamp are all covered.
+// -voices N instead times Mix(e_chunkFrames) with N looping voices going into MxNullSoundSink.
+//
+//   mxsoundmixertest [-voices N] [-chunks N]
+
+enum {
+	c_maxVoices = 8,
+	c_maxFrames = 2000,
+	c_cases = 200,
+	c_chunksPerCase = 20
+};
+
+// Keeps the last chunk the mixer wrote
+class CaptureSoundSink : public MxSoundSink {
+public:
+	MxResult Open(MxU32 p_frequency) override { return SUCCESS; }
+	void Close() override {}
+	MxU32 GetFreeFrames() override { return 0; }
+
+	MxResult Write(const MxS16* p_frames, MxU32 p_count) override
+	{
+		memcpy(m_frames, p_frames, p_count * 2 * sizeof(MxS16));
+		m_count = p_count;
+		return SUCCESS;
+	}
+
+	MxS16 m_frames[MxSoundMixer::e_chunkFrames * 2];
+	MxU32 m_count;
+};
+
+// What the reference mixer knows about a voice
+struct ReferenceVoice {
+	MxS16 m_samples[c_maxFrames * 2];
+	MxU32 m_channels;
+	MxU32 m_blockAlign;
+	MxU32 m_numFrames;
+	MxU32 m_frame;
+	MxU32 m_fraction;
+	MxU32 m_step;
+	MxS32 m_gain[2];
+	MxBool m_playing;
+	MxBool m_looping;
+};
+
+static ReferenceVoice g_reference[c_maxVoices];
+static MxS16 g_expected[MxSoundMixer::e_chunkFrames * 2];
+static MxU32 g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return (g_seed >> 16) % p_range;
+}
+
+static MxS32 Gain(LONG p_attenuation)
+{
+	return p_attenuation <= DSBVOLUME_MIN ? 0 : (MxS32) (16384 * pow(10.0, p_attenuation / 2000.0));
+}
+
+static void MixReference(MxU32 p_numVoices, MxU32 p_frames)
+{
+	static MxS32 mix[MxSoundMixer::e_chunkFrames * 2];
+	MxU32 i;
+
+	memset(mix, 0, sizeof(mix));
+
+	for (MxU32 v = 0; v < p_numVoices; v++) {
+		ReferenceVoice& voice = g_reference[v];
+
+		if (!voice.m_playing) {
+			continue;
+		}
+
+		if ((voice.m_gain[0] | voice.m_gain[1]) == 0) {
+			// Silent voices are only moved on, once per chunk
+			MxU32 advance = voice.m_fraction + voice.m_step * p_frames;
+			voice.m_frame += advance >> 16;
+			voice.m_fraction = advance & 0xffff;
+
+			if (voice.m_frame >= voice.m_numFrames) {
+				if (voice.m_looping) {
+					voice.m_frame %= voice.m_numFrames;
+				}
+				else {
+					voice.m_playing = FALSE;
+					voice.m_frame = voice.m_fraction = 0;
+				}
+			}
+
+			continue;
+		}
+
+		for (i = 0; i < p_frames; i++) {
+			if (voice.m_frame >= voice.m_numFrames) {
+				if (!voice.m_looping) {
+					voice.m_playing = FALSE;
+					voice.m_frame = voice.m_fraction = 0;
+					break;
+				}
+
+				voice.m_frame %= voice.m_numFrames;
+			}
+
+			// The last frame interpolates towards the start of a looping buffer and holds otherwise
+			MxU32 next = voice.m_frame + 1;
+			if (next == voice.m_numFrames) {
+				next = voice.m_looping ? 0 : voice.m_frame;
+			}
+
+			for (MxU32 c = 0; c < 2; c++) {
+				MxU32 channel = voice.m_channels == 2 ? c : 0;
+				MxS32 a = voice.m_samples[voice.m_frame * voice.m_channels + channel];
+				MxS32 b = voice.m_samples[next * voice.m_channels + channel];
+				MxS32 sample = a + (((b - a) * (MxS32) (voice.m_fraction >> 1)) >> 15);
+
+				mix[i * 2 + c] += (sample * voice.m_gain[c]) >> 14;
+			}
+
+			voice.m_fraction += voice.m_step;
+			voice.m_frame += voice.m_fraction >> 16;
+			voice.m_fraction &= 0xffff;
+		}
+	}
+
+	for (i = 0; i < p_frames * 2; i++) {
+		g_expected[i] = (MxS16) (mix[i] > 32767 ? 32767 : (mix[i] < -32768 ? -32768 : mix[i]));
+	}
+}
+
+// Creates a voice on p_mixer and the matching reference voice
+static LPDIRECTSOUNDBUFFER CreateVoice(MxSoundMixer& p_mixer, ReferenceVoice& p_voice, MxBool p_random)
+{
+	static const DWORD rates[] = {11025, 22050, 44100, 8000};
+	WAVEFORMATEX format;
+	DSBUFFERDESC desc;
+	LPDIRECTSOUNDBUFFER buffer;
+
+	memset(&format, 0, sizeof(format));
+	format.wFormatTag = WAVE_FORMAT_PCM;
+	format.nChannels = 1 + Random(2);
+	format.wBitsPerSample = Random(2) ? 16 : 8;
+	format.nSamplesPerSec = rates[Random(4)];
+	format.nBlockAlign = format.nChannels * format.wBitsPerSample / 8;
+	format.nAvgBytesPerSec = format.nSamplesPerSec * format.nBlockAlign;
+
+	MxU32 numFrames = p_random ? 1 + Random(Random(4) ? c_maxFrames : 4) : c_maxFrames;
+
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+	desc.dwBufferBytes = numFrames * format.nBlockAlign;
+	desc.lpwfxFormat = &format;
+
+	if (p_mixer.CreateSoundBuffer(&desc, &buffer) != DS_OK) {
+		return NULL;
+	}
+
+	LPVOID data;
+	DWORD bytes;
+	buffer->Lock(0, desc.dwBufferBytes, &data, &bytes, NULL, NULL, 0);
+
+	for (MxU32 i = 0; i < numFrames * format.nChannels; i++) {
+		// Mostly loud samples, so that a few voices together need clamping
+		MxS16 sample = (MxS16) (Random(65536) - 32768);
+
+		if (format.wBitsPerSample == 16) {
+			((MxS16*) data)[i] = sample;
+			p_voice.m_samples[i] = sample;
+		}
+		else {
+			MxU8 byte = (MxU8) (sample >> 8) + 0x80;
+			((MxU8*) data)[i] = byte;
+			p_voice.m_samples[i] = (MxS16) ((byte - 0x80) << 8);
+		}
+	}
+
+	buffer->Unlock(data, bytes, NULL, 0);
+
+	DWORD frequency = format.nSamplesPerSec;
+	LONG volume = DSBVOLUME_MAX;
+	LONG pan = DSBPAN_CENTER;
+	MxU32 start = 0;
+
+	if (p_random) {
+		if (Random(2)) {
+			frequency = DSBFREQUENCY_MIN + Random(DSBFREQUENCY_MAX - DSBFREQUENCY_MIN + 1);
+			buffer->SetFrequency(frequency);
+		}
+
+		volume = Random(4) ? -(LONG) Random(2000) : (Random(2) ? DSBVOLUME_MIN : -(LONG) Random(10001));
+		pan = (LONG) Random(20001) - 10000;
+		start = Random(numFrames);
+
+		buffer->SetVolume(volume);
+		buffer->SetPan(pan);
+		buffer->SetCurrentPosition(start * format.nBlockAlign);
+	}
+
+	p_voice.m_looping = p_random ? Random(2) : TRUE;
+	buffer->Play(0, 0, p_voice.m_looping ? DSBPLAY_LOOPING : 0);
+
+	p_voice.m_channels = format.nChannels;
+	p_voice.m_blockAlign = format.nBlockAlign;
+	p_voice.m_numFrames = numFrames;
+	p_voice.m_frame = start;
+	p_voice.m_fraction = 0;
+	p_voice.m_step = (MxU32) ((double) frequency * 65536.0 / MxSoundMixer::e_frequency);
+	p_voice.m_gain[0] = Gain(volume + (pan > 0 ? -pan : 0));
+	p_voice.m_gain[1] = Gain(volume + (pan < 0 ? pan : 0));
+	p_voice.m_playing = TRUE;
+	return buffer;
+}
+
+static int RunCase(int p_case)
+{
+	LPDIRECTSOUNDBUFFER buffers[c_maxVoices];
+	CaptureSoundSink* sink = new CaptureSoundSink;
+	MxSoundMixer* mixer = new MxSoundMixer;
+	MxU32 numVoices = 1 + Random(c_maxVoices);
+	MxU32 v;
+	int failures = 0;
+
+	if (mixer->Create(sink, FALSE) != SUCCESS) {
+		printf("case %d: cannot create the mixer\n", p_case);
+		delete mixer;
+		return 1;
+	}
+
+	for (v = 0; v < numVoices; v++) {
+		buffers[v] = CreateVoice(*mixer, g_reference[v], TRUE);
+	}
+
+	for (int chunk = 0; chunk < c_chunksPerCase && !failures; chunk++) {
+		MxU32 frames = 1 + Random(MxSoundMixer::e_chunkFrames);
+
+		mixer->Mix(frames);
+		MixReference(numVoices, frames);
+
+		if (sink->m_count != frames || memcmp(sink->m_frames, g_expected, frames * 2 * sizeof(MxS16))) {
+			printf("case %d, chunk %d: mix differs\n", p_case, chunk);
+			failures++;
+		}
+
+		for (v = 0; v < numVoices && !failures; v++) {
+			DWORD play;
+			DWORD status;
+
+			buffers[v]->GetCurrentPosition(&play, NULL);
+			buffers[v]->GetStatus(&status);
+
+			if (play != g_reference[v].m_frame * g_reference[v].m_blockAlign ||
+				((status & DSBSTATUS_PLAYING) != 0) != (g_reference[v].m_playing != FALSE)) {
+				printf("case %d, chunk %d: voice %u position differs\n", p_case, chunk, v);
+				failures++;
+			}
+		}
+	}
+
+	for (v = 0; v < numVoices; v++) {
+		buffers[v]->Release();
+	}
+
+	delete mixer;
+	return failures;
+}
+
+static int Benchmark(MxU32 p_numVoices, int p_chunks)
+{
+	LPDIRECTSOUNDBUFFER* buffers = new LPDIRECTSOUNDBUFFER[p_numVoices];
+	MxSoundMixer* mixer = new MxSoundMixer;
+	MxU32 v;
+
+	if (mixer->Create(new MxNullSoundSink, FALSE) != SUCCESS) {
+		printf("cannot create the mixer\n");
+		delete mixer;
+		delete[] buffers;
+		return 1;
+	}
+
+	for (v = 0; v < p_numVoices; v++) {
+		buffers[v] = CreateVoice(*mixer, g_reference[0], FALSE);
+	}
+
+	MxDouble start = MxTimer::GetProfileTime();
+
+	for (int chunk = 0; chunk < p_chunks; chunk++) {
+		mixer->Mix(MxSoundMixer::e_chunkFrames);
+	}
+
+	MxDouble perChunk = (MxTimer::GetProfileTime() - start) / p_chunks;
+	MxDouble chunkLength = MxSoundMixer::e_chunkFrames * 1000.0 / MxSoundMixer::e_frequency;
+
+	printf(
+		"%u voices: %.4f ms per %d-frame chunk, %.2f%% of real time\n",
+		p_numVoices,
+		perChunk,
+		MxSoundMixer::e_chunkFrames,
+		perChunk * 100.0 / chunkLength
+	);
+
+	for (v = 0; v < p_numVoices; v++) {
+		buffers[v]->Release();
+	}
+
+	delete mixer;
+	delete[] buffers;
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	int voices = 0;
+	int chunks = 1000;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (!strcmp(argv[i], "-voices")) {
+			voices = atoi(argv[i + 1]);
+		}
+		else if (!strcmp(argv[i], "-chunks")) {
+			chunks = atoi(argv[i + 1]);
+		}
+		else {
+			printf("unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (voices > 0) {
+		return Benchmark(voices, chunks > 0 ? chunks : 1);
+	}
+
+	int failures = 0;
+
+	for (int i = 0; i < c_cases; i++) {
+		failures += RunCase(i);
+	}
+
+	if (failures) {
+		printf("%d of %d cases failed\n", failures, c_cases);
+		return 1;
+	}
+
+	printf("ok, %d cases\n", c_cases);
+	return 0;
+}
@@ -0,0 +1,201 @@
+#include "mxgeometry/mxgeometry3d.h"
+#include "mxgeometry/mxmatrix.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vec.h>
+
+// Compares the virtual Matrix4 and Vector3 math with the vec.h macros that replaced it on the transform paths
+// (OrientableROI::UpdateWorldData, the LegoROI frame walkers and the ViewManager frustum planes).
+// Without arguments it checks that both give the same results; -iterations N runs each version N times over
+// c_count inputs and reports the time.
+//
+//   realtimetest [-iterations N]
+
+enum {
+	c_count = 1024
+};
+
+static MxMatrix g_local2world[c_count];
+static MxMatrix g_transforms[c_count];
+static MxMatrix g_products[c_count];
+static float g_expectedProducts[c_count][4][4];
+
+// Reached through pointers, as in the engine, so that the compiler cannot resolve the virtual calls
+static Matrix4* g_local2worldPointers[c_count];
+static Matrix4* g_transformPointers[c_count];
+static Matrix4* g_productPointers[c_count];
+
+static float g_points[c_count][3][3];
+static float g_planes[c_count][4];
+static float g_expectedPlanes[c_count][4];
+
+static unsigned int g_seed = 1;
+
+static float Random()
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 16) & 0x7fff) / 16384.0f - 1.0f;
+}
+
+// OrientableROI::UpdateWorldData before it moved to MXM4
+static void ProductVirtual()
+{
+	for (int i = 0; i < c_count; i++) {
+		MxMatrix l_matrix(*g_local2worldPointers[i]);
+		g_productPointers[i]->Product(l_matrix, *g_transformPointers[i]);
+	}
+}
+
+static void ProductMacro()
+{
+	for (int i = 0; i < c_count; i++) {
+		float l_matrix[4][4];
+		SETMAT4(l_matrix, *g_local2worldPointers[i]);
+		MXM4(g_expectedProducts[i], l_matrix, *g_transformPointers[i]);
+	}
+}
+
+// ViewManager::UpdateViewTransformations before it moved to VMV3, VXV3 and DOT3
+static void PlanesVirtual()
+{
+	for (int i = 0; i < c_count; i++) {
+		Vector3 a(g_points[i][0]);
+		Vector3 b(g_points[i][1]);
+		Vector3 c(g_points[i][2]);
+		Mx3DPointFloat x;
+		Mx3DPointFloat y;
+		Vector3 normal(g_planes[i]);
+
+		x = c;
+		x -= b;
+
+		y = a;
+		y -= b;
+
+		normal.EqualsCross(x, y);
+		normal.Unitize();
+
+		g_planes[i][3] = -normal.Dot(normal, a);
+	}
+}
+
+static void PlanesMacro()
+{
+	for (int i = 0; i < c_count; i++) {
+		const float* a = g_points[i][0];
+		const float* b = g_points[i][1];
+		const float* c = g_points[i][2];
+		float x[3];
+		float y[3];
+		float* normal = g_expectedPlanes[i];
+
+		VMV3(x, c, b);
+		VMV3(y, a, b);
+		VXV3(normal, x, y);
+
+		float len = sqrt(NORMSQRD3(normal));
+		if (len > 0.0f) {
+			VDS3(normal, normal, len);
+		}
+
+		g_expectedPlanes[i][3] = -DOT3(normal, a);
+	}
+}
+
+static int Differs(float p_a, float p_b)
+{
+	return fabs(p_a - p_b) > 1e-5f * (1.0f + fabs(p_a));
+}
+
+static int Check()
+{
+	int failures = 0;
+
+	ProductVirtual();
+	ProductMacro();
+	PlanesVirtual();
+	PlanesMacro();
+
+	for (int i = 0; i < c_count; i++) {
+		for (int j = 0; j < 16; j++) {
+			if (Differs(g_products[i][j / 4][j % 4], g_expectedProducts[i][j / 4][j % 4])) {
+				printf("product %d differs at [%d][%d]\n", i, j / 4, j % 4);
+				failures++;
+				break;
+			}
+		}
+
+		for (int k = 0; k < 4; k++) {
+			if (Differs(g_planes[i][k], g_expectedPlanes[i][k])) {
+				printf("plane %d differs at [%d]\n", i, k);
+				failures++;
+				break;
+			}
+		}
+	}
+
+	return failures;
+}
+
+static void Time(const char* p_name, void (*p_function)(), int p_iterations)
+{
+	DWORD start = GetTickCount();
+
+	for (int i = 0; i < p_iterations; i++) {
+		p_function();
+	}
+
+	DWORD elapsed = GetTickCount() - start;
+	printf("%-24s %d x %d: %lu ms\n", p_name, p_iterations, c_count, (unsigned long) elapsed);
+}
+
+int main(int argc, char** argv)
+{
+	int iterations = 0;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (!strcmp(argv[i], "-iterations")) {
+			iterations = atoi(argv[i + 1]);
+		}
+		else {
+			printf("unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	for (int i = 0; i < c_count; i++) {
+		for (int j = 0; j < 16; j++) {
+			g_local2world[i][j / 4][j % 4] = Random();
+			g_transforms[i][j / 4][j % 4] = Random();
+		}
+
+		for (int k = 0; k < 9; k++) {
+			g_points[i][k / 3][k % 3] = Random();
+		}
+
+		g_local2worldPointers[i] = &g_local2world[i];
+		g_transformPointers[i] = &g_transforms[i];
+		g_productPointers[i] = &g_products[i];
+	}
+
+	if (iterations > 0) {
+		Time("Matrix4::Product", ProductVirtual, iterations);
+		Time("MXM4", ProductMacro, iterations);
+		Time("Vector3 frustum planes", PlanesVirtual, iterations);
+		Time("vec.h frustum planes", PlanesMacro, iterations);
+		return 0;
+	}
+
+	int failures = Check();
+
+	if (failures) {
+		printf("%d of %d cases failed\n", failures, 2 * c_count);
+		return 1;
+	}
+
+	printf("ok, %d cases\n", 2 * c_count);
+	return 0;
+}
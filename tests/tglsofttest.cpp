@@ -0,0 +1,423 @@
+#include "tgl/soft/impl.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+// Renders a fixed scene with the software Tgl renderer, without a window or DirectDraw.
+// Without arguments it checks the result; -frames N renders N frames and reports the time per frame.
+//
+//   tglsofttest [-frames N] [-threads N] [-size WIDTHxHEIGHT] [-dump FILE.ppm]
+
+using namespace Tgl;
+
+enum {
+	c_cubeRows = 6,
+	c_cubeColumns = 8
+};
+
+static unsigned long GetMilliseconds()
+{
+#ifdef _WIN32
+	return GetTickCount();
+#else
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	return now.tv_sec * 1000 + now.tv_usec / 1000;
+#endif
+}
+
+static void SetPosition(FloatMatrix4& p_matrix, float p_angle, float p_x, float p_y, float p_z)
+{
+	float c = (float) cos(p_angle);
+	float s = (float) sin(p_angle);
+
+	memset(p_matrix, 0, sizeof(FloatMatrix4));
+	p_matrix[0][0] = c;
+	p_matrix[0][2] = -s;
+	p_matrix[1][1] = 1.0f;
+	p_matrix[2][0] = s;
+	p_matrix[2][2] = c;
+	p_matrix[3][0] = p_x;
+	p_matrix[3][1] = p_y;
+	p_matrix[3][2] = p_z;
+	p_matrix[3][3] = 1.0f;
+}
+
+// Adds p_quads quads, four corners each, clockwise as seen from their front. Each corner is a new vertex.
+static Mesh* CreateQuads(
+	MeshBuilder* p_builder,
+	int p_quads,
+	float (*p_positions)[3],
+	float (*p_normals)[3],
+	ShadingModel p_shading
+)
+{
+	float textureCoordinates[4][2] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+	float(*coordinates)[2] = new float[p_quads * 4][2];
+	unsigned long(*faces)[3] = new unsigned long[p_quads * 2][3];
+	unsigned long(*textureIndices)[3] = new unsigned long[p_quads * 2][3];
+	int i;
+
+	for (i = 0; i < p_quads * 4; i++) {
+		coordinates[i][0] = textureCoordinates[i % 4][0];
+		coordinates[i][1] = textureCoordinates[i % 4][1];
+	}
+
+	for (i = 0; i < p_quads; i++) {
+		unsigned long first = i * 4;
+
+		// The first use of a corner starts its vertex, with the position and normal of the same index
+		faces[i * 2][0] = 0x80000000 | (first << 16) | first;
+		faces[i * 2][1] = 0x80000000 | ((first + 1) << 16) | (first + 1);
+		faces[i * 2][2] = 0x80000000 | ((first + 2) << 16) | (first + 2);
+		faces[i * 2 + 1][0] = first;
+		faces[i * 2 + 1][1] = first + 2;
+		faces[i * 2 + 1][2] = 0x80000000 | ((first + 3) << 16) | (first + 3);
+
+		textureIndices[i * 2][0] = first;
+		textureIndices[i * 2][1] = first + 1;
+		textureIndices[i * 2][2] = first + 2;
+		textureIndices[i * 2 + 1][0] = first;
+		textureIndices[i * 2 + 1][1] = first + 2;
+		textureIndices[i * 2 + 1][2] = first + 3;
+	}
+
+	Mesh* mesh = p_builder->CreateMesh(
+		p_quads * 2,
+		p_quads * 4,
+		p_positions,
+		p_normals,
+		coordinates,
+		faces,
+		textureIndices,
+		p_shading
+	);
+
+	delete[] coordinates;
+	delete[] faces;
+	delete[] textureIndices;
+	return mesh;
+}
+
+// A square facing the camera, which looks along +z
+static Mesh* CreateSquare(MeshBuilder* p_builder, float p_x, float p_y, float p_z, float p_size)
+{
+	float positions[4][3] = {
+		{p_x - p_size, p_y + p_size, p_z},
+		{p_x + p_size, p_y + p_size, p_z},
+		{p_x + p_size, p_y - p_size, p_z},
+		{p_x - p_size, p_y - p_size, p_z}
+	};
+	float normals[4][3] = {{0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, -1.0f}};
+
+	return CreateQuads(p_builder, 1, positions, normals, UnlitFlat);
+}
+
+static Mesh* CreateCube(MeshBuilder* p_builder, float p_size)
+{
+	// Normal, then the right and up directions of each side as seen from outside
+	static const float g_sides[6][3][3] = {
+		{{0, 0, -1}, {1, 0, 0}, {0, 1, 0}},
+		{{0, 0, 1}, {-1, 0, 0}, {0, 1, 0}},
+		{{1, 0, 0}, {0, 0, 1}, {0, 1, 0}},
+		{{-1, 0, 0}, {0, 0, -1}, {0, 1, 0}},
+		{{0, 1, 0}, {1, 0, 0}, {0, 0, 1}},
+		{{0, -1, 0}, {1, 0, 0}, {0, 0, -1}}
+	};
+	static const float g_corners[4][2] = {{-1, 1}, {1, 1}, {1, -1}, {-1, -1}};
+	float positions[24][3];
+	float normals[24][3];
+
+	for (int side = 0; side < 6; side++) {
+		for (int corner = 0; corner < 4; corner++) {
+			for (int k = 0; k < 3; k++) {
+				positions[side * 4 + corner][k] =
+					(g_sides[side][0][k] + g_sides[side][1][k] * g_corners[corner][0] +
+					 g_sides[side][2][k] * g_corners[corner][1]) *
+					p_size;
+				normals[side * 4 + corner][k] = g_sides[side][0][k];
+			}
+		}
+	}
+
+	return CreateQuads(p_builder, 6, positions, normals, Gouraud);
+}
+
+class Scene {
+public:
+	Scene(TglSoft::RendererImpl* p_renderer, unsigned long p_width, unsigned long p_height);
+	~Scene();
+
+	int IsValid() const { return m_view != NULL; }
+	void Render(int p_frame);
+	const unsigned long* GetPixels() const { return m_device->GetColorBuffer(); }
+
+private:
+	TglSoft::DeviceImpl* m_device;
+	Camera* m_camera;
+	View* m_view;
+	Light* m_ambient;
+	Light* m_sun;
+	Group* m_root;
+	Group* m_overlay;
+	Group* m_cubes[c_cubeRows * c_cubeColumns];
+	MeshBuilder* m_backgroundBuilder;
+	MeshBuilder* m_overlayBuilder;
+	MeshBuilder* m_cubeBuilder;
+	Mesh* m_meshes[4];
+	Texture* m_texture;
+};
+
+Scene::Scene(TglSoft::RendererImpl* p_renderer, unsigned long p_width, unsigned long p_height)
+{
+	FloatMatrix4 identity;
+	SetPosition(identity, 0.0f, 0.0f, 0.0f, 0.0f);
+
+	m_device = static_cast<TglSoft::DeviceImpl*>(p_renderer->CreateDevice(p_width, p_height));
+	m_camera = p_renderer->CreateCamera();
+	m_camera->SetTransformation(identity);
+	m_view = m_device ? p_renderer->CreateView(m_device, m_camera, 0, 0, p_width, p_height) : NULL;
+
+	m_ambient = p_renderer->CreateLight(Ambient, 0.3f, 0.3f, 0.3f);
+	m_sun = p_renderer->CreateLight(Directional, 0.7f, 0.7f, 0.7f);
+	m_sun->SetTransformation(identity);
+
+	if (m_view) {
+		m_view->SetFrustrum(1.0f, 100.0f, 90.0f);
+		m_view->SetBackgroundColor(0.0f, 0.0f, 0.5f);
+		m_view->Add(m_ambient);
+		m_view->Add(m_sun);
+	}
+
+	// Behind everything, a red wall with a green square in front of it and a half transparent blue one on top
+	m_root = p_renderer->CreateGroup(NULL);
+	m_backgroundBuilder = p_renderer->CreateMeshBuilder();
+	m_meshes[0] = CreateSquare(m_backgroundBuilder, 0.0f, 0.0f, 40.0f, 30.0f);
+	m_meshes[0]->SetColor(1.0f, 0.0f, 0.0f, 0.0f);
+	m_meshes[1] = CreateSquare(m_backgroundBuilder, -4.0f, 0.0f, 20.0f, 1.0f);
+	m_meshes[1]->SetColor(0.0f, 1.0f, 0.0f, 0.0f);
+	m_root->Add(m_backgroundBuilder);
+
+	m_overlay = p_renderer->CreateGroup(m_root);
+	m_overlayBuilder = p_renderer->CreateMeshBuilder();
+	m_meshes[2] = CreateSquare(m_overlayBuilder, 4.0f, 0.0f, 20.0f, 1.0f);
+	m_meshes[2]->SetColor(0.0f, 0.0f, 1.0f, 0.5f);
+	m_overlay->Add(m_overlayBuilder);
+
+	// Textured, lit cubes turning above and below the squares
+	static const PaletteEntry g_palette[2] = {{0xff, 0xff, 0xff}, {0x40, 0x40, 0x80}};
+	unsigned char texels[8 * 8];
+
+	for (int i = 0; i < 8 * 8; i++) {
+		texels[i] = ((i >> 3) ^ i) & 1;
+	}
+
+	m_texture = p_renderer->CreateTexture(8, 8, 8, texels, 0, 2, g_palette);
+	m_cubeBuilder = p_renderer->CreateMeshBuilder();
+	m_meshes[3] = CreateCube(m_cubeBuilder, 0.5f);
+	m_meshes[3]->SetColor(1.0f, 0.8f, 0.6f, 0.0f);
+	m_meshes[3]->SetTexture(m_texture);
+	m_meshes[3]->SetTextureMappingMode(PerspectiveCorrect);
+
+	for (int j = 0; j < c_cubeRows * c_cubeColumns; j++) {
+		m_cubes[j] = p_renderer->CreateGroup(m_root);
+		m_cubes[j]->Add(m_cubeBuilder);
+	}
+}
+
+Scene::~Scene()
+{
+	int i;
+
+	for (i = 0; i < c_cubeRows * c_cubeColumns; i++) {
+		delete m_cubes[i];
+	}
+
+	for (i = 0; i < (int) (sizeof(m_meshes) / sizeof(m_meshes[0])); i++) {
+		delete m_meshes[i];
+	}
+
+	delete m_texture;
+	delete m_cubeBuilder;
+	delete m_overlayBuilder;
+	delete m_backgroundBuilder;
+	delete m_overlay;
+	delete m_root;
+	delete m_sun;
+	delete m_ambient;
+	delete m_view;
+	delete m_camera;
+	delete m_device;
+}
+
+void Scene::Render(int p_frame)
+{
+	for (int row = 0; row < c_cubeRows; row++) {
+		for (int column = 0; column < c_cubeColumns; column++) {
+			int i = row * c_cubeColumns + column;
+			FloatMatrix4 position;
+
+			// Three rows above the squares and three below them
+			SetPosition(
+				position,
+				0.05f * (p_frame + i),
+				(column - (c_cubeColumns - 1) * 0.5f) * 1.6f,
+				(row < c_cubeRows / 2 ? row + 2 : c_cubeRows - row - 5) * 1.4f,
+				12.0f + row
+			);
+			m_cubes[i]->SetTransformation(position);
+		}
+	}
+
+	m_view->Clear();
+	m_view->Render(m_root);
+}
+
+static int CheckPixel(const Scene& p_scene, unsigned long p_width, int p_x, int p_y, unsigned long p_expected)
+{
+	unsigned long pixel = p_scene.GetPixels()[p_y * p_width + p_x];
+
+	if (pixel != p_expected) {
+		printf("pixel %d,%d is 0x%06lx, expected 0x%06lx\n", p_x, p_y, pixel, p_expected);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int CheckInversePalette()
+{
+	static const unsigned long g_colors[5] = {0x000000, 0xff0000, 0x00ff00, 0x0000ff, 0xffffff};
+	static const int g_expected[][2] = {{0x0000, 0}, {0x7c00, 1}, {0x03e0, 2}, {0x001f, 3}, {0x7fff, 4}, {0x6000, 1}};
+	unsigned char* table = new unsigned char[0x8000];
+	int failures = 0;
+
+	TglSoft::BuildInversePalette(g_colors, 5, table);
+
+	for (int i = 0; i < (int) (sizeof(g_expected) / sizeof(g_expected[0])); i++) {
+		if (table[g_expected[i][0]] != g_expected[i][1]) {
+			printf("color 0x%04x maps to %d, expected %d\n", g_expected[i][0], table[g_expected[i][0]], g_expected[i][1]);
+			failures++;
+		}
+	}
+
+	delete[] table;
+	return failures;
+}
+
+static void Dump(const Scene& p_scene, unsigned long p_width, unsigned long p_height, const char* p_filename)
+{
+	FILE* file = fopen(p_filename, "wb");
+
+	if (file) {
+		fprintf(file, "P6\n%lu %lu\n255\n", p_width, p_height);
+
+		for (unsigned long i = 0; i < p_width * p_height; i++) {
+			unsigned long pixel = p_scene.GetPixels()[i];
+			fputc((int) (pixel >> 16) & 0xff, file);
+			fputc((int) (pixel >> 8) & 0xff, file);
+			fputc((int) pixel & 0xff, file);
+		}
+
+		fclose(file);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	unsigned long width = 320;
+	unsigned long height = 240;
+	int frames = 0;
+	int threads = 0;
+	const char* dump = NULL;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (!strcmp(argv[i], "-frames")) {
+			frames = atoi(argv[i + 1]);
+		}
+		else if (!strcmp(argv[i], "-threads")) {
+			threads = atoi(argv[i + 1]);
+		}
+		else if (!strcmp(argv[i], "-size")) {
+			sscanf(argv[i + 1], "%lux%lu", &width, &height);
+		}
+		else if (!strcmp(argv[i], "-dump")) {
+			dump = argv[i + 1];
+		}
+		else {
+			printf("unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	TglSoft::RendererImpl* renderer = static_cast<TglSoft::RendererImpl*>(CreateSoftRenderer());
+	renderer->SetThreadCount(threads);
+	Scene scene(renderer, width, height);
+
+	if (!scene.IsValid()) {
+		printf("cannot render %lux%lu\n", width, height);
+		return 1;
+	}
+
+	if (frames > 0) {
+		unsigned long start = GetMilliseconds();
+
+		for (int frame = 0; frame < frames; frame++) {
+			scene.Render(frame);
+		}
+
+		unsigned long elapsed = GetMilliseconds() - start;
+		printf(
+			"%d frames at %lux%lu: %.2f ms per frame\n",
+			frames,
+			width,
+			height,
+			elapsed / (double) frames
+		);
+
+		if (dump) {
+			Dump(scene, width, height, dump);
+		}
+
+		delete renderer;
+		return 0;
+	}
+
+	// Tiles are rasterized in parallel, but the image must not depend on the number of threads
+	renderer->SetThreadCount(1);
+	Scene reference(renderer, width, height);
+	int failures = CheckInversePalette();
+
+	scene.Render(0);
+	reference.Render(0);
+
+	if (dump) {
+		Dump(scene, width, height, dump);
+	}
+
+	if (memcmp(scene.GetPixels(), reference.GetPixels(), width * height * sizeof(unsigned long))) {
+		printf("rendering with one thread gives a different image\n");
+		failures++;
+	}
+
+	if (width == 320 && height == 240) {
+		failures += CheckPixel(scene, width, 0, 0, 0x00007f);   // Background
+		failures += CheckPixel(scene, width, 160, 120, 0xff0000); // Wall
+		failures += CheckPixel(scene, width, 136, 120, 0x00ff00); // Green square in front of the wall
+		failures += CheckPixel(scene, width, 184, 120, 0x7f007f); // Blue square blended over the wall
+	}
+
+	delete renderer;
+
+	if (failures) {
+		return 1;
+	}
+
+	printf("ok\n");
+	return 0;
+}
@@ -10,7 +10,9 @@
 // Disable "identifier was truncated to '255' characters" warning.
 // Impossible to avoid this if using STL map or set.
 // This removes most (but not all) occurrences of the warning.
+#ifdef _MSC_VER
 #pragma warning(disable : 4786)
+#endif
 
 #define MSVC420_VERSION 1020
 